@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include "xf_fal.h"
+#include "xf_fal_sim.h"
 #include "mock_flash.h"
 
 int main(void)
@@ -95,5 +96,10 @@ int main(void)
         printf("Partition read after erase failed: %d\n", xf_ret);
     }
 
+#if XF_FAL_SIM_ENABLE
+    /* 以上操作在真实 SPI NOR 上所需的时间 */
+    xf_fal_show_sim();
+#endif
+
     return 0;
 }
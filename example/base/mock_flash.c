@@ -15,6 +15,7 @@
 #include <string.h>
 
 #include "xf_fal.h"
+#include "xf_fal_sim.h"
 #include "mock_flash.h"
 
 /* ==================== [Defines] =========================================== */
@@ -79,7 +80,12 @@ static const xf_fal_partition_t mock_flash_partition_table[] = MOCK_FLASH_PART_T
 
 void mock_flash_register_to_xf_fal(void)
 {
+#if XF_FAL_SIM_ENABLE
+    /* 经时序模拟设备注册，按 SPI NOR 的典型耗时累计虚拟时钟 */
+    xf_fal_register_flash_device(xf_fal_sim_wrap(&mock_flash_dev, NULL));
+#else
     xf_fal_register_flash_device(&mock_flash_dev);
+#endif
     xf_fal_register_partition_table(
         mock_flash_partition_table, ARRAY_SIZE(mock_flash_partition_table));
 }
@@ -136,11 +142,11 @@ static xf_err_t mock_flash_erase(size_t offset, size_t size)
     if (offset + size > sizeof(mock_flash_memory)) {
         return XF_FAIL;
     }
-    /* TODO 对齐到扇区大小擦除 */
-    // if ((offset % mock_flash_dev.sector_size != 0)
-    //         || ((size % mock_flash_dev.sector_size != 0))) {
-    //     return XF_FAIL;
-    // }
+    /* xf_fal 保证擦除范围对齐到扇区 */
+    if ((offset % mock_flash_dev.sector_size != 0)
+            || ((size % mock_flash_dev.sector_size != 0))) {
+        return XF_FAIL;
+    }
     memset(&mock_flash_memory[mock_flash_dev.addr + offset], 0xFF, size);
     return XF_OK;
 }
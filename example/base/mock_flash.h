@@ -31,10 +31,10 @@ extern "C" {
 
 #define MOCK_FLASH_PART_TABLE                                           \
     {                                                                   \
-        {"bl",          MOCK_FLASH_NAME,   0,          64        },     \
-        {"app",         MOCK_FLASH_NAME,   64,         1024 * 10 },     \
-        {"easyflash",   MOCK_FLASH_NAME,   1024 * 10,  1024 * 20 },     \
-        {"download",    MOCK_FLASH_NAME,   1024 * 20,  1024 * 40 },     \
+        {"bl",          MOCK_FLASH_NAME,   0,          1024 * 4  },     \
+        {"app",         MOCK_FLASH_NAME,   1024 * 4,   1024 * 12 },     \
+        {"easyflash",   MOCK_FLASH_NAME,   1024 * 16,  1024 * 20 },     \
+        {"download",    MOCK_FLASH_NAME,   1024 * 36,  1024 * 40 },     \
     }
 
 /* ==================== [Typedefs] ========================================== */
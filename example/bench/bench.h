@@ -0,0 +1,84 @@
+/**
+ * @file bench.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 基准测试公共定义。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdint.h>
+#include <time.h>
+
+#include "xf_fal.h"
+#include "bench_flash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @name bench_cases
+ * @brief 各项基准测试，见 main.c 中的 bench_case_table.
+ * @{
+ */
+void bench_find(void);
+void bench_handle(void);
+void bench_snapshot(void);
+void bench_devlock(void);
+void bench_async(void);
+void bench_vec(void);
+void bench_split(void);
+void bench_erase(void);
+void bench_blank(void);
+void bench_rcache(void);
+void bench_wbuf(void);
+void bench_update(void);
+void bench_copy(void);
+void bench_stream(void);
+void bench_crc(void);
+void bench_stat(void);
+void bench_trace(void);
+void bench_wear(void);
+void bench_wl(void);
+void bench_kv(void);
+void bench_ring(void);
+void bench_file(void);
+void bench_sim(void);
+void bench_suite(void);
+void bench_static(void);
+/**
+ * End of bench_cases
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 获取单调时钟，单位: ns.
+ */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __BENCH_H__
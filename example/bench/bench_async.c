@@ -0,0 +1,154 @@
+/**
+ * @file bench_async.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 异步请求队列基准：擦除与计算重叠 vs. 同步擦除。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "bench.h"
+#include "xf_fal_async.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_ASYNC_ROUNDS              (50)
+#define BENCH_ASYNC_ERASE_US            (2000)
+#define BENCH_ASYNC_COMPUTE_US          (2000)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_async_notify(size_t dev_idx);
+static void *bench_async_worker(void *arg);
+static void bench_async_compute(uint32_t us);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_async_table[] = {
+    {"async",   BENCH_FLASH1_NAME,  0,  256 * 1024},
+};
+
+static sem_t bench_async_sem[XF_FAL_FLASH_DEVICE_NUM];
+static volatile int bench_async_stop;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_async(void)
+{
+    const xf_fal_partition_t *part;
+    xf_fal_async_req_t req = {0};
+    pthread_t worker[XF_FAL_FLASH_DEVICE_NUM];
+    uint64_t t0;
+    uint64_t t_sync;
+    uint64_t t_async;
+    size_t err = 0;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_async_table, ARRAY_SIZE(bench_async_table));
+    xf_fal_init();
+    part = xf_fal_partition_find("async");
+
+    /* 每个 flash 设备一个工作线程 */
+    bench_async_stop = 0;
+    xf_fal_async_init(bench_async_notify);
+    for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        sem_init(&bench_async_sem[i], 0, 0);
+        pthread_create(&worker[i], NULL, bench_async_worker, (void *)i);
+    }
+
+    bench_flash_set_delay(0, 0, BENCH_ASYNC_ERASE_US);
+
+    /* 同步：擦除完成后再计算 */
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_ASYNC_ROUNDS; i++) {
+        if (XF_OK != xf_fal_partition_erase(part, 0, BENCH_FLASH_SECTOR_SIZE)) {
+            err++;
+        }
+        bench_async_compute(BENCH_ASYNC_COMPUTE_US);
+    }
+    t_sync = bench_now_ns() - t0;
+
+    /* 异步：提交擦除后立即计算，计算完再等待擦除完成 */
+    req.op      = XF_FAL_OP_ERASE;
+    req.part    = part;
+    req.offset  = 0;
+    req.size    = BENCH_FLASH_SECTOR_SIZE;
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_ASYNC_ROUNDS; i++) {
+        if (XF_OK != xf_fal_async_submit(&req)) {
+            err++;
+        }
+        bench_async_compute(BENCH_ASYNC_COMPUTE_US);
+        while (!xf_fal_async_is_done(&req)) {
+            sched_yield();
+        }
+        if (XF_OK != req.result) {
+            err++;
+        }
+    }
+    t_async = bench_now_ns() - t0;
+
+    printf("erase %uus + compute %uus x %u: sync=%6.2f ms async=%6.2f ms speedup=%4.2fx err=%u\n",
+           BENCH_ASYNC_ERASE_US, BENCH_ASYNC_COMPUTE_US, BENCH_ASYNC_ROUNDS,
+           (double)t_sync / 1e6, (double)t_async / 1e6,
+           (double)t_sync / (double)t_async, (unsigned)err);
+
+    bench_flash_set_delay(0, 0, 0);
+    bench_async_stop = 1;
+    for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        sem_post(&bench_async_sem[i]);
+        pthread_join(worker[i], NULL);
+        sem_destroy(&bench_async_sem[i]);
+    }
+    xf_fal_async_deinit();
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_async_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_async_notify(size_t dev_idx)
+{
+    sem_post(&bench_async_sem[dev_idx]);
+}
+
+static void *bench_async_worker(void *arg)
+{
+    size_t dev_idx = (size_t)arg;
+
+    while (1) {
+        sem_wait(&bench_async_sem[dev_idx]);
+        if (bench_async_stop) {
+            break;
+        }
+        while (XF_OK == xf_fal_async_process(dev_idx)) {
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 模拟占用 CPU 的计算。
+ */
+static void bench_async_compute(uint32_t us)
+{
+    uint64_t end = bench_now_ns() + (uint64_t)us * 1000;
+
+    while (bench_now_ns() < end) {
+    }
+}
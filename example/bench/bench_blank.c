@@ -0,0 +1,113 @@
+/**
+ * @file bench_blank.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 擦除基准：普通擦除 vs. 跳过空白扇区的擦除。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_BLANK_PART_LEN            (1024 * 1024)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_blank_prepare(const xf_fal_partition_t *part, size_t dirty_percent);
+static void bench_blank_run(const xf_fal_partition_t *part, size_t dirty_percent);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_blank_table[] = {
+    {"ota",     BENCH_FLASH1_NAME,  0,          BENCH_BLANK_PART_LEN},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_blank(void)
+{
+    static const size_t dirty_percent_arr[] = {0, 10, 50, 100};
+    const xf_fal_partition_t *part;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_blank_table, ARRAY_SIZE(bench_blank_table));
+    xf_fal_init();
+
+    part = xf_fal_partition_find("ota");
+    for (size_t i = 0; i < ARRAY_SIZE(dirty_percent_arr); i++) {
+        bench_blank_run(part, dirty_percent_arr[i]);
+    }
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_blank_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 擦除整个分区后，在分散的约 dirty_percent% 的扇区末尾写入 1 字节。
+ *
+ * 写在扇区末尾，使空白检查必须扫描整个扇区才能发现。
+ */
+static void bench_blank_prepare(const xf_fal_partition_t *part, size_t dirty_percent)
+{
+    const uint8_t zero = 0;
+    const size_t sector_num = part->len / BENCH_FLASH_SECTOR_SIZE;
+
+    xf_fal_partition_erase_all(part);
+    for (size_t i = 0; i < sector_num; i++) {
+        /* 37 与 100 互素，各扇区分散地落在 0~99 上 */
+        if ((i * 37 % 100) < dirty_percent) {
+            xf_fal_partition_write(part, (i + 1) * BENCH_FLASH_SECTOR_SIZE - 1, &zero, 1);
+        }
+    }
+}
+
+static void bench_blank_run(const xf_fal_partition_t *part, size_t dirty_percent)
+{
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    xf_fal_erase_result_t result;
+    uint64_t plain_model_us;
+    size_t plain_cnt;
+    uint64_t t0;
+    uint64_t t;
+    size_t err = 0;
+
+    bench_blank_prepare(part, dirty_percent);
+    bench_flash_reset_stat();
+    if (XF_OK != xf_fal_partition_erase_all(part)) {
+        err++;
+    }
+    plain_model_us  = stat->erase_model_us;
+    plain_cnt       = stat->erase_cnt;
+
+    bench_blank_prepare(part, dirty_percent);
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    if (XF_OK != xf_fal_partition_erase_ex(part, 0, part->len,
+                                           XF_FAL_ERASE_FLAG_SKIP_BLANK, &result)) {
+        err++;
+    }
+    t = bench_now_ns() - t0;
+
+    printf("dirty=%3u%% plain: %2u calls %7.1f ms | skip_blank: erased=%3u skipped=%3u "
+           "%2u calls %7.1f ms (+%5.1f us check, %u KiB read) err=%u\n",
+           (unsigned)dirty_percent,
+           (unsigned)plain_cnt, (double)plain_model_us / 1000.0,
+           (unsigned)result.erased_num, (unsigned)result.skipped_num,
+           (unsigned)stat->erase_cnt, (double)stat->erase_model_us / 1000.0,
+           (double)t / 1000.0, (unsigned)(stat->read_bytes / 1024), (unsigned)err);
+}
@@ -0,0 +1,185 @@
+/**
+ * @file bench_copy.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 分区间复制基准：用户读写循环 vs. xf_fal_partition_copy().
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "bench.h"
+#include "xf_fal_async.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_COPY_LEN                  (256 * 1024)
+#define BENCH_COPY_NAIVE_BUF_SIZE       (256)
+#define BENCH_COPY_READ_US              (100)
+#define BENCH_COPY_WRITE_US             (100)
+#define BENCH_COPY_ERASE_US             (2000)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_copy_naive(const char *src_name, const char *dst_name);
+static void bench_copy_report(const char *name, const char *dst_name, uint64_t t);
+static void bench_copy_notify(size_t dev_idx);
+static void *bench_copy_worker(void *arg);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_copy_table[] = {
+    {"app",         BENCH_FLASH1_NAME,  0,                  BENCH_COPY_LEN},
+    {"backup",      BENCH_FLASH1_NAME,  BENCH_COPY_LEN,     BENCH_COPY_LEN},
+    {"download",    BENCH_FLASH2_NAME,  0,                  BENCH_COPY_LEN},
+};
+
+static uint8_t bench_copy_image[BENCH_COPY_LEN];
+static uint8_t bench_copy_chk[BENCH_COPY_LEN];
+
+static sem_t bench_copy_sem[XF_FAL_FLASH_DEVICE_NUM];
+static volatile int bench_copy_stop;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_copy(void)
+{
+    const xf_fal_partition_t *app;
+    const xf_fal_partition_t *download;
+    pthread_t worker[XF_FAL_FLASH_DEVICE_NUM];
+    uint64_t t0;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_copy_table, ARRAY_SIZE(bench_copy_table));
+    xf_fal_init();
+
+    app         = xf_fal_partition_find("app");
+    download    = xf_fal_partition_find("download");
+    for (size_t i = 0; i < sizeof(bench_copy_image); i++) {
+        bench_copy_image[i] = (uint8_t)(i * 7 + (i >> 9));
+    }
+    xf_fal_partition_erase_all(download);
+    xf_fal_partition_write(download, 0, bench_copy_image, BENCH_COPY_LEN);
+    xf_fal_partition_erase_all(app);
+    xf_fal_partition_write(app, 0, bench_copy_image, BENCH_COPY_LEN);
+
+    printf("copy %u KiB, read %uus write %uus erase %uus per driver call\n",
+           (unsigned)(BENCH_COPY_LEN / 1024), BENCH_COPY_READ_US,
+           BENCH_COPY_WRITE_US, BENCH_COPY_ERASE_US);
+    bench_flash_set_delay(BENCH_COPY_READ_US, BENCH_COPY_WRITE_US, BENCH_COPY_ERASE_US);
+
+    bench_copy_naive("download", "backup");
+    bench_copy_naive("app", "backup");
+
+    /* 异步队列未初始化：同步双缓冲退化为单缓冲 */
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    xf_fal_partition_copy(download, 0, xf_fal_partition_find("backup"), 0, BENCH_COPY_LEN);
+    bench_copy_report("copy flash2->flash1 sync", "backup", bench_now_ns() - t0);
+
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    xf_fal_partition_copy(app, 0, xf_fal_partition_find("backup"), 0, BENCH_COPY_LEN);
+    bench_copy_report("copy flash1->flash1", "backup", bench_now_ns() - t0);
+
+    /* 每个 flash 设备一个工作线程，跨设备复制时读写重叠 */
+    bench_copy_stop = 0;
+    xf_fal_async_init(bench_copy_notify);
+    for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        sem_init(&bench_copy_sem[i], 0, 0);
+        pthread_create(&worker[i], NULL, bench_copy_worker, (void *)i);
+    }
+
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    xf_fal_partition_copy(download, 0, xf_fal_partition_find("backup"), 0, BENCH_COPY_LEN);
+    bench_copy_report("copy flash2->flash1 overlap", "backup", bench_now_ns() - t0);
+
+    bench_copy_stop = 1;
+    for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        sem_post(&bench_copy_sem[i]);
+        pthread_join(worker[i], NULL);
+        sem_destroy(&bench_copy_sem[i]);
+    }
+    xf_fal_async_deinit();
+    bench_flash_set_delay(0, 0, 0);
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_copy_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 用户常见的复制循环：先擦除整个目标，再用小缓冲区逐块按名字查找分区读写。
+ */
+static void bench_copy_naive(const char *src_name, const char *dst_name)
+{
+    uint8_t buf[BENCH_COPY_NAIVE_BUF_SIZE];
+    char name[48];
+    uint64_t t0;
+
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    xf_fal_partition_erase_all(xf_fal_partition_find(dst_name));
+    for (size_t off = 0; off < BENCH_COPY_LEN; off += sizeof(buf)) {
+        xf_fal_partition_read(xf_fal_partition_find(src_name), off, buf, sizeof(buf));
+        xf_fal_partition_write(xf_fal_partition_find(dst_name), off, buf, sizeof(buf));
+    }
+    snprintf(name, sizeof(name), "naive %s->%s", src_name, dst_name);
+    bench_copy_report(name, dst_name, bench_now_ns() - t0);
+}
+
+static void bench_copy_report(const char *name, const char *dst_name, uint64_t t)
+{
+    size_t read_cnt = 0;
+    size_t write_cnt = 0;
+    size_t erase_cnt = 0;
+
+    for (size_t i = 0; i < BENCH_FLASH_NUM; i++) {
+        read_cnt    += bench_flash_get_stat(i)->read_cnt;
+        write_cnt   += bench_flash_get_stat(i)->write_cnt;
+        erase_cnt   += bench_flash_get_stat(i)->erase_cnt;
+    }
+    memset(bench_copy_chk, 0, sizeof(bench_copy_chk));
+    xf_fal_partition_read(xf_fal_partition_find(dst_name), 0, bench_copy_chk, BENCH_COPY_LEN);
+
+    printf("%-28s %8.2f ms %6.2f MiB/s | read %4u write %4u erase %3u | %s\n",
+           name, (double)t / 1e6,
+           (double)BENCH_COPY_LEN / (1024.0 * 1024.0) / ((double)t / 1e9),
+           (unsigned)read_cnt, (unsigned)write_cnt, (unsigned)erase_cnt,
+           memcmp(bench_copy_chk, bench_copy_image, BENCH_COPY_LEN) ? "MISMATCH" : "ok");
+}
+
+static void bench_copy_notify(size_t dev_idx)
+{
+    sem_post(&bench_copy_sem[dev_idx]);
+}
+
+static void *bench_copy_worker(void *arg)
+{
+    size_t dev_idx = (size_t)arg;
+
+    while (1) {
+        sem_wait(&bench_copy_sem[dev_idx]);
+        if (bench_copy_stop) {
+            break;
+        }
+        while (XF_OK == xf_fal_async_process(dev_idx)) {
+        }
+    }
+
+    return NULL;
+}
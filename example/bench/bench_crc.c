@@ -0,0 +1,158 @@
+/**
+ * @file bench_crc.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief CRC-32 基准：各实现的吞吐，以及分区校验 vs. 用户读取循环。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_CRC_LEN                   (1024 * 1024)
+#define BENCH_CRC_ROUNDS                (16)
+#define BENCH_CRC_USER_BUF_SIZE         (64)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static uint32_t bench_crc_bitwise(uint32_t crc, const uint8_t *p, size_t size);
+static void bench_crc_impl(void);
+static void bench_crc_partition(void);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_crc_table[] = {
+    {"image",   BENCH_FLASH1_NAME,  0,          BENCH_CRC_LEN},
+};
+
+static uint8_t bench_crc_data[BENCH_CRC_LEN];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_crc(void)
+{
+    for (size_t i = 0; i < sizeof(bench_crc_data); i++) {
+        bench_crc_data[i] = (uint8_t)(i * 29 + (i >> 10));
+    }
+
+    bench_crc_impl();
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_crc_table, ARRAY_SIZE(bench_crc_table));
+    xf_fal_init();
+    bench_crc_partition();
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_crc_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 常见的逐位计算，作为用户代码的基线。
+ */
+static uint32_t bench_crc_bitwise(uint32_t crc, const uint8_t *p, size_t size)
+{
+    crc = ~crc;
+    while (size--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * @brief 内存中 1 MiB 数据的 CRC-32 吞吐。
+ */
+static void bench_crc_impl(void)
+{
+    static const char *const impl_name[XF_FAL_CRC32_IMPL_MAX] = {
+        "auto", "nibble", "slice8", "accel",
+    };
+    uint32_t ref;
+    uint32_t crc;
+    uint64_t t0;
+    uint64_t t;
+
+    t0  = bench_now_ns();
+    ref = bench_crc_bitwise(0, bench_crc_data, BENCH_CRC_LEN);
+    t   = bench_now_ns() - t0;
+    printf("%-8s %9.1f MB/s crc=0x%08X\n", "bitwise",
+           (double)BENCH_CRC_LEN / 1e6 / ((double)t / 1e9), (unsigned)ref);
+
+    for (int impl = XF_FAL_CRC32_IMPL_NIBBLE; impl < XF_FAL_CRC32_IMPL_MAX; impl++) {
+        crc = 0;
+        if (XF_OK != xf_fal_crc32_ex((xf_fal_crc32_impl_t)impl, &crc, bench_crc_data, 64)) {
+            printf("%-8s not supported\n", impl_name[impl]);
+            continue;
+        }
+        t0 = bench_now_ns();
+        for (size_t r = 0; r < BENCH_CRC_ROUNDS; r++) {
+            crc = 0;
+            xf_fal_crc32_ex((xf_fal_crc32_impl_t)impl, &crc, bench_crc_data, BENCH_CRC_LEN);
+        }
+        t = (bench_now_ns() - t0) / BENCH_CRC_ROUNDS;
+        printf("%-8s %9.1f MB/s crc=0x%08X %s\n", impl_name[impl],
+               (double)BENCH_CRC_LEN / 1e6 / ((double)t / 1e9),
+               (unsigned)crc, (crc == ref) ? "ok" : "MISMATCH");
+    }
+}
+
+/**
+ * @brief 校验整个分区：用户 "小缓冲区 + 逐位计算" 循环 vs. xf_fal_partition_crc32().
+ */
+static void bench_crc_partition(void)
+{
+    const xf_fal_partition_t *part = xf_fal_partition_find("image");
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    uint8_t buf[BENCH_CRC_USER_BUF_SIZE];
+    uint32_t user_crc = 0;
+    uint32_t crc = 0;
+    uint64_t t_user;
+    uint64_t t;
+    uint64_t t0;
+    size_t user_read_cnt;
+    uint64_t user_read_ns;
+
+    xf_fal_partition_erase_all(part);
+    xf_fal_partition_write(part, 0, bench_crc_data, BENCH_CRC_LEN);
+
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    for (size_t off = 0; off < BENCH_CRC_LEN; off += sizeof(buf)) {
+        xf_fal_partition_read(part, off, buf, sizeof(buf));
+        user_crc = bench_crc_bitwise(user_crc, buf, sizeof(buf));
+    }
+    t_user          = bench_now_ns() - t0;
+    user_read_cnt   = stat->read_cnt;
+    user_read_ns    = stat->read_model_ns;
+
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    xf_fal_partition_crc32(part, 0, BENCH_CRC_LEN, &crc);
+    t = bench_now_ns() - t0;
+
+    printf("partition 1 MiB: user loop (%uB buf, bitwise) cpu %7.2f ms + model read %7.2f ms "
+           "(%u reads) | xf_fal_partition_crc32 (%uB buf) cpu %7.2f ms + model read %7.2f ms "
+           "(%u reads) | %s\n",
+           BENCH_CRC_USER_BUF_SIZE, (double)t_user / 1e6,
+           (double)user_read_ns / 1e6, (unsigned)user_read_cnt,
+           XF_FAL_HASH_BUF_SIZE, (double)t / 1e6,
+           (double)stat->read_model_ns / 1e6, (unsigned)stat->read_cnt,
+           (crc == user_crc) ? "ok" : "MISMATCH");
+}
@@ -0,0 +1,134 @@
+/**
+ * @file bench_devlock.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 设备锁基准：两个线程在同一设备 / 不同设备上并发读写擦。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_DEVLOCK_DURATION_MS       (500)
+#define BENCH_DEVLOCK_IO_SIZE           (256)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    const char *part_name;
+    size_t ops;
+    size_t bytes;
+    size_t err;
+} bench_devlock_worker_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void *bench_devlock_worker(void *arg);
+static void bench_devlock_run(const char *title, const char *part_a, const char *part_b);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_devlock_table[] = {
+    {"dev1_a",  BENCH_FLASH1_NAME,  0,          256 * 1024},
+    {"dev1_b",  BENCH_FLASH1_NAME,  256 * 1024, 256 * 1024},
+    {"dev2_a",  BENCH_FLASH2_NAME,  0,          256 * 1024},
+};
+
+static volatile int bench_devlock_stop;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_devlock(void)
+{
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_devlock_table, ARRAY_SIZE(bench_devlock_table));
+    xf_fal_init();
+
+    /* 擦除 2ms, 页编程 200us, 读 20us */
+    bench_flash_set_delay(20, 200, 2000);
+    bench_devlock_run("same_device", "dev1_a", "dev1_b");
+    bench_devlock_run("two_devices", "dev1_a", "dev2_a");
+    bench_flash_set_delay(0, 0, 0);
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_devlock_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 循环执行 擦除扇区 -> 编程一页 -> 读回一页。
+ */
+static void *bench_devlock_worker(void *arg)
+{
+    bench_devlock_worker_t *worker = arg;
+    const xf_fal_partition_t *part = xf_fal_partition_find(worker->part_name);
+    xf_fal_handle_t handle;
+    uint8_t buf[BENCH_DEVLOCK_IO_SIZE];
+    size_t offset = 0;
+
+    memset(buf, 0x5A, sizeof(buf));
+    if ((!part) || (XF_OK != xf_fal_partition_get_handle(part, &handle))) {
+        worker->err++;
+        return NULL;
+    }
+
+    while (!bench_devlock_stop) {
+        if (XF_OK != xf_fal_handle_erase(&handle, offset, BENCH_FLASH_SECTOR_SIZE)) {
+            worker->err++;
+        }
+        if (XF_OK != xf_fal_handle_write(&handle, offset, buf, sizeof(buf))) {
+            worker->err++;
+        }
+        if (XF_OK != xf_fal_handle_read(&handle, offset, buf, sizeof(buf))) {
+            worker->err++;
+        }
+        worker->ops++;
+        worker->bytes += sizeof(buf);
+        offset = (offset + BENCH_FLASH_SECTOR_SIZE) % handle.len;
+    }
+
+    return NULL;
+}
+
+static void bench_devlock_run(const char *title, const char *part_a, const char *part_b)
+{
+    bench_devlock_worker_t worker[2] = {
+        {.part_name = part_a},
+        {.part_name = part_b},
+    };
+    pthread_t thread[2];
+    struct timespec ts = {
+        .tv_sec     = BENCH_DEVLOCK_DURATION_MS / 1000,
+        .tv_nsec    = (BENCH_DEVLOCK_DURATION_MS % 1000) * 1000000L,
+    };
+    size_t ops = 0;
+    size_t err = 0;
+
+    bench_devlock_stop = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(thread); i++) {
+        pthread_create(&thread[i], NULL, bench_devlock_worker, &worker[i]);
+    }
+    nanosleep(&ts, NULL);
+    bench_devlock_stop = 1;
+    for (size_t i = 0; i < ARRAY_SIZE(thread); i++) {
+        pthread_join(thread[i], NULL);
+        ops += worker[i].ops;
+        err += worker[i].err;
+    }
+
+    printf("%-12s threads=2 cycles=%6.1f /s (erase+program+read) err=%u\n",
+           title, (double)ops * 1000.0 / BENCH_DEVLOCK_DURATION_MS, (unsigned)err);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file bench_erase.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 擦除基准：逐扇区擦除 vs. 按擦除粒度表拆分的块擦除。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_erase_run(const char *name, size_t dev_idx);
+static void bench_erase_misaligned(void);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_erase_table[] = {
+    {"aligned",     BENCH_FLASH1_NAME,  0,                  1024 * 1024},
+    {"unaligned",   BENCH_FLASH1_NAME,  1024 * 1024 + 60 * 1024, 1000 * 1024},
+    {"chip",        BENCH_FLASH2_NAME,  0,                  BENCH_FLASH_LEN},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_erase(void)
+{
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_erase_table, ARRAY_SIZE(bench_erase_table));
+    xf_fal_init();
+
+    printf("model: 4K=%ums 32K=%ums 64K=%ums chip=%ums\n",
+           BENCH_FLASH_ERASE_4K_US / 1000, BENCH_FLASH_ERASE_32K_US / 1000,
+           BENCH_FLASH_ERASE_64K_US / 1000, BENCH_FLASH_ERASE_CHIP_US / 1000);
+    bench_erase_run("aligned", 0);
+    bench_erase_run("unaligned", 0);
+    bench_erase_run("chip", 1);
+    bench_erase_misaligned();
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_erase_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_erase_run(const char *name, size_t dev_idx)
+{
+    const xf_fal_partition_t *part = xf_fal_partition_find(name);
+    bench_flash_stat_t *stat = bench_flash_get_stat(dev_idx);
+    uint64_t sector_us;
+    size_t sector_cnt;
+    size_t err = 0;
+
+    /* 调用者逐扇区擦除 */
+    bench_flash_reset_stat();
+    for (size_t offset = 0; offset < part->len; offset += BENCH_FLASH_SECTOR_SIZE) {
+        if (XF_OK != xf_fal_partition_erase(part, offset, BENCH_FLASH_SECTOR_SIZE)) {
+            err++;
+        }
+    }
+    sector_us   = stat->erase_model_us;
+    sector_cnt  = stat->erase_cnt;
+
+    /* 整个分区交给 xf_fal 拆分 */
+    bench_flash_reset_stat();
+    if (XF_OK != xf_fal_partition_erase_all(part)) {
+        err++;
+    }
+
+    printf("%-10s len=%5uK sector: %4u calls %8.1f ms | block: %4u calls %8.1f ms"
+           " | speedup=%5.2fx err=%u\n",
+           name, (unsigned)(part->len / 1024),
+           (unsigned)sector_cnt, (double)sector_us / 1000.0,
+           (unsigned)stat->erase_cnt, (double)stat->erase_model_us / 1000.0,
+           (double)sector_us / (double)stat->erase_model_us, (unsigned)err);
+}
+
+static void bench_erase_misaligned(void)
+{
+    const xf_fal_partition_t *part = xf_fal_partition_find("aligned");
+    xf_err_t xf_ret;
+
+    xf_ret = xf_fal_partition_erase(part, 100, BENCH_FLASH_SECTOR_SIZE);
+    printf("misaligned erase(100, 4K): %s\n",
+           (XF_ERR_INVALID_ARG == xf_ret) ? "rejected" :
+           (XF_OK == xf_ret) ? "widened" : "error");
+}
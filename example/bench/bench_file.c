@@ -0,0 +1,160 @@
+/**
+ * @file bench_file.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 文件映射 flash 设备基准：与内存数组 + 逐字节写入的模拟 flash 对比吞吐，并在大容量镜像上检查持久化。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "xf_fal_file.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_FILE_DEV_NAME             "file_img"
+#define BENCH_FILE_PATH                 "/tmp/xf_fal_bench_flash.img"
+#define BENCH_FILE_LEN                  (256 * 1024 * 1024)
+#define BENCH_FILE_CHUNK                (64 * 1024)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+#if XF_FAL_FILE_ENABLE
+static xf_err_t bench_file_open(size_t len);
+static void bench_file_run(const char *name, const xf_fal_partition_t *part, size_t len);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+#if XF_FAL_FILE_ENABLE
+static const xf_fal_partition_t bench_file_table[] = {
+    {"ram",     BENCH_FLASH2_NAME,      0,  BENCH_FLASH_LEN},
+    {"img",     BENCH_FILE_DEV_NAME,    0,  BENCH_FLASH_LEN},
+    {"soak",    BENCH_FILE_DEV_NAME,    0,  BENCH_FILE_LEN},
+};
+static uint8_t s_bench_file_buf[BENCH_FILE_CHUNK];
+#endif
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+#if XF_FAL_FILE_ENABLE
+
+void bench_file(void)
+{
+    uint32_t crc = 0;
+    uint32_t crc_reload = 0;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_file_table, ARRAY_SIZE(bench_file_table));
+    xf_fal_init();
+    unlink(BENCH_FILE_PATH);
+
+    /* 同样 8 MiB 的设备：内存数组 + 逐字节与运算 vs 文件映射 + SIMD 与运算 */
+    if (XF_OK != bench_file_open(BENCH_FLASH_LEN)) {
+        goto l_end;
+    }
+    printf("%u MiB, erase + %u KiB writes + %u KiB reads:\n",
+           (unsigned)(BENCH_FLASH_LEN >> 20), (unsigned)(BENCH_FILE_CHUNK >> 10),
+           (unsigned)(BENCH_FILE_CHUNK >> 10));
+    bench_file_run("ram array:  ", xf_fal_partition_find("ram"), BENCH_FLASH_LEN);
+    bench_file_run("mmap file:  ", xf_fal_partition_find("img"), BENCH_FLASH_LEN);
+    xf_fal_file_deinit(BENCH_FILE_DEV_NAME);
+
+    /* 大容量镜像，重新映射后内容不变 */
+    if (XF_OK != bench_file_open(BENCH_FILE_LEN)) {
+        goto l_end;
+    }
+    printf("%u MiB image:\n", (unsigned)(BENCH_FILE_LEN >> 20));
+    bench_file_run("mmap file:  ", xf_fal_partition_find("soak"), BENCH_FILE_LEN);
+    xf_fal_partition_crc32(xf_fal_partition_find("soak"), 0, BENCH_FILE_LEN, &crc);
+    xf_fal_file_deinit(BENCH_FILE_DEV_NAME);
+    if (XF_OK != bench_file_open(BENCH_FILE_LEN)) {
+        goto l_end;
+    }
+    xf_fal_partition_crc32(xf_fal_partition_find("soak"), 0, BENCH_FILE_LEN, &crc_reload);
+    printf("  after remap: crc32 0x%08x / 0x%08x, %s\n", (unsigned)crc, (unsigned)crc_reload,
+           (crc == crc_reload) ? "persisted" : "MISMATCH");
+    xf_fal_file_deinit(BENCH_FILE_DEV_NAME);
+
+l_end:
+    unlink(BENCH_FILE_PATH);
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_file_table);
+}
+
+#else
+
+void bench_file(void)
+{
+    printf("XF_FAL_FILE_ENABLE is 0, skipped.\n");
+}
+
+#endif // XF_FAL_FILE_ENABLE
+
+/* ==================== [Static Functions] ================================== */
+
+#if XF_FAL_FILE_ENABLE
+
+static xf_err_t bench_file_open(size_t len)
+{
+    const xf_fal_file_cfg_t cfg = {
+        .path           = BENCH_FILE_PATH,
+        .len            = len,
+        .sector_size    = BENCH_FLASH_SECTOR_SIZE,
+        .page_size      = BENCH_FLASH_PAGE_SIZE,
+        .io_size        = BENCH_FLASH_IO_SIZE,
+    };
+    xf_err_t xf_ret;
+
+    xf_ret = xf_fal_file_init(BENCH_FILE_DEV_NAME, &cfg);
+    if (xf_ret != XF_OK) {
+        printf("xf_fal_file_init failed: %d\n", (int)xf_ret);
+    }
+    return xf_ret;
+}
+
+/**
+ * @brief 擦除整个分区，按块写满后再按块读出，打印各阶段吞吐。
+ */
+static void bench_file_run(const char *name, const xf_fal_partition_t *part, size_t len)
+{
+    size_t err = 0;
+    uint64_t t0;
+    uint64_t t1;
+    uint64_t t2;
+    uint64_t t3;
+
+    t0 = bench_now_ns();
+    err += (XF_OK != xf_fal_partition_erase(part, 0, len));
+    t1 = bench_now_ns();
+    for (size_t off = 0; off < len; off += sizeof(s_bench_file_buf)) {
+        memset(s_bench_file_buf, (uint8_t)(off >> 16), sizeof(s_bench_file_buf));
+        err += (XF_OK != xf_fal_partition_write(part, off, s_bench_file_buf,
+                                                sizeof(s_bench_file_buf)));
+    }
+    t2 = bench_now_ns();
+    for (size_t off = 0; off < len; off += sizeof(s_bench_file_buf)) {
+        err += (XF_OK != xf_fal_partition_read(part, off, s_bench_file_buf,
+                                               sizeof(s_bench_file_buf)));
+        err += (s_bench_file_buf[0] != (uint8_t)(off >> 16));
+    }
+    t3 = bench_now_ns();
+
+    printf("  %s erase %8.1f MB/s  write %8.1f MB/s  read %8.1f MB/s  err=%u\n", name,
+           len / 1e6 / ((t1 - t0) / 1e9), len / 1e6 / ((t2 - t1) / 1e9),
+           len / 1e6 / ((t3 - t2) / 1e9), (unsigned)err);
+}
+
+#endif // XF_FAL_FILE_ENABLE
@@ -0,0 +1,119 @@
+/**
+ * @file bench_find.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 分区名查找基准：哈希索引 vs. 遍历分区表。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_FIND_PART_MAX             (256)
+#define BENCH_FIND_LOOKUPS              (1000000)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static const xf_fal_partition_t *bench_linear_find(const char *name);
+static void bench_find_run(size_t part_num);
+
+/* ==================== [Static Variables] ================================== */
+
+static char bench_part_name[BENCH_FIND_PART_MAX][XF_FAL_DEV_NAME_MAX];
+static xf_fal_partition_t bench_part_table[BENCH_FIND_PART_MAX];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_find(void)
+{
+    static const size_t part_num_arr[] = {4, 8, 16, 64, 256};
+
+    bench_flash_register_devices();
+    for (size_t i = 0; i < ARRAY_SIZE(part_num_arr); i++) {
+        bench_find_run(part_num_arr[i]);
+    }
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 原 xf_fal_partition_find() 的遍历实现，作为对照组。
+ */
+static const xf_fal_partition_t *bench_linear_find(const char *name)
+{
+    const xf_fal_snapshot_t *snap = xf_fal_get_ctx()->p_snapshot;
+    const xf_fal_partition_t *p_table;
+    size_t table_len;
+
+    for (size_t i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
+        p_table     = snap->partition_table[i];
+        table_len   = snap->partition_table_len[i];
+        if ((NULL == p_table) || (0 == table_len)) {
+            continue;
+        }
+        for (size_t j = 0; j < table_len; j++) {
+            if (0 == xf_strncmp(name, p_table[j].name, XF_FAL_DEV_NAME_MAX)) {
+                return &p_table[j];
+            }
+        }
+    }
+    return NULL;
+}
+
+static void bench_find_run(size_t part_num)
+{
+    uint64_t t0;
+    uint64_t t_hash;
+    uint64_t t_linear;
+    size_t miss = 0;
+
+    for (size_t i = 0; i < part_num; i++) {
+        snprintf(bench_part_name[i], XF_FAL_DEV_NAME_MAX, "bench_part_%03u", (unsigned)i);
+        bench_part_table[i].name        = bench_part_name[i];
+        bench_part_table[i].flash_name  = BENCH_FLASH1_NAME;
+        bench_part_table[i].offset      = i * BENCH_FLASH_SECTOR_SIZE;
+        bench_part_table[i].len         = BENCH_FLASH_SECTOR_SIZE;
+    }
+    xf_fal_register_partition_table(bench_part_table, part_num);
+    xf_fal_init();
+
+    /* 按固定步长遍历所有分区名，避免总是命中表头 */
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_FIND_LOOKUPS; i++) {
+        if (!xf_fal_partition_find(bench_part_name[(i * 7) % part_num])) {
+            miss++;
+        }
+    }
+    t_hash = bench_now_ns() - t0;
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_FIND_LOOKUPS; i++) {
+        if (!bench_linear_find(bench_part_name[(i * 7) % part_num])) {
+            miss++;
+        }
+    }
+    t_linear = bench_now_ns() - t0;
+
+    printf("partitions=%-4u find=%7.1f ns/op linear=%7.1f ns/op speedup=%5.1fx miss=%u\n",
+           (unsigned)part_num,
+           (double)t_hash / BENCH_FIND_LOOKUPS,
+           (double)t_linear / BENCH_FIND_LOOKUPS,
+           (double)t_linear / (double)t_hash,
+           (unsigned)miss);
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_part_table);
+}
@@ -0,0 +1,206 @@
+/**
+ * @file bench_flash.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 基准测试用的模拟 flash 设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "xf_fal.h"
+#include "bench_flash.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_err_t bench_flash_init(size_t idx);
+static xf_err_t bench_flash_read(size_t idx, size_t src_offset, void *dst, size_t size);
+static xf_err_t bench_flash_write(size_t idx, size_t dst_offset, const void *src, size_t size);
+static xf_err_t bench_flash_erase(size_t idx, size_t offset, size_t size);
+static void bench_flash_delay(uint32_t us);
+static uint32_t bench_flash_erase_cost_us(size_t size);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief xf_fal_flash_ops_t 不带上下文参数，此处为每个设备生成一组转发函数。
+ */
+#define BENCH_FLASH_OPS_DEFINE(_idx) \
+    static xf_err_t bench_flash##_idx##_init(void) \
+    { return bench_flash_init(_idx); } \
+    static xf_err_t bench_flash##_idx##_read(size_t src_offset, void *dst, size_t size) \
+    { return bench_flash_read(_idx, src_offset, dst, size); } \
+    static xf_err_t bench_flash##_idx##_write(size_t dst_offset, const void *src, size_t size) \
+    { return bench_flash_write(_idx, dst_offset, src, size); } \
+    static xf_err_t bench_flash##_idx##_erase(size_t offset, size_t size) \
+    { return bench_flash_erase(_idx, offset, size); }
+
+#define BENCH_FLASH_DEV_INIT(_idx, _name) \
+    { \
+        .name           = _name, \
+        .addr           = 0, \
+        .len            = BENCH_FLASH_LEN, \
+        .sector_size    = BENCH_FLASH_SECTOR_SIZE, \
+        .page_size      = BENCH_FLASH_PAGE_SIZE, \
+        .io_size        = BENCH_FLASH_IO_SIZE, \
+        .ops.init       = bench_flash##_idx##_init, \
+        .ops.read       = bench_flash##_idx##_read, \
+        .ops.write      = bench_flash##_idx##_write, \
+        .ops.erase      = bench_flash##_idx##_erase, \
+        .erase_size_table   = bench_flash_erase_size_table, \
+        .erase_size_num     = ARRAY_SIZE(bench_flash_erase_size_table), \
+    }
+
+BENCH_FLASH_OPS_DEFINE(0)
+BENCH_FLASH_OPS_DEFINE(1)
+
+/* ==================== [Static Variables] ================================== */
+
+static uint8_t bench_flash_memory[BENCH_FLASH_NUM][BENCH_FLASH_LEN];
+static bench_flash_stat_t bench_flash_stat[BENCH_FLASH_NUM];
+static uint32_t bench_flash_read_us;
+static uint32_t bench_flash_write_us;
+static uint32_t bench_flash_erase_us;
+
+/* 4K 扇区、32K/64K 块、整片 */
+static const size_t bench_flash_erase_size_table[] = {
+    BENCH_FLASH_SECTOR_SIZE, 32 * 1024, 64 * 1024, BENCH_FLASH_LEN,
+};
+
+/* 设备对象不加 static, 供编译期分区表（bench_static.c）引用 */
+const xf_fal_flash_dev_t bench_flash1_dev = BENCH_FLASH_DEV_INIT(0, BENCH_FLASH1_NAME);
+const xf_fal_flash_dev_t bench_flash2_dev = BENCH_FLASH_DEV_INIT(1, BENCH_FLASH2_NAME);
+
+static const xf_fal_flash_dev_t *const bench_flash_dev[BENCH_FLASH_NUM] = {
+    &bench_flash1_dev,
+    &bench_flash2_dev,
+};
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_flash_register_devices(void)
+{
+    for (size_t i = 0; i < BENCH_FLASH_NUM; i++) {
+        xf_fal_register_flash_device(bench_flash_dev[i]);
+    }
+}
+
+const xf_fal_flash_dev_t *bench_flash_get_dev(size_t idx)
+{
+    return bench_flash_dev[idx];
+}
+
+bench_flash_stat_t *bench_flash_get_stat(size_t idx)
+{
+    return &bench_flash_stat[idx];
+}
+
+void bench_flash_reset_stat(void)
+{
+    memset(bench_flash_stat, 0, sizeof(bench_flash_stat));
+}
+
+void bench_flash_set_delay(uint32_t read_us, uint32_t write_us, uint32_t erase_us)
+{
+    bench_flash_read_us     = read_us;
+    bench_flash_write_us    = write_us;
+    bench_flash_erase_us    = erase_us;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_flash_delay(uint32_t us)
+{
+    struct timespec ts;
+
+    if (0 == us) {
+        return;
+    }
+    ts.tv_sec   = us / 1000000;
+    ts.tv_nsec  = (long)(us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+static xf_err_t bench_flash_init(size_t idx)
+{
+    memset(bench_flash_memory[idx], 0xFF, BENCH_FLASH_LEN);
+    return XF_OK;
+}
+
+static xf_err_t bench_flash_read(size_t idx, size_t src_offset, void *dst, size_t size)
+{
+    if (src_offset + size > BENCH_FLASH_LEN) {
+        return XF_FAIL;
+    }
+    bench_flash_delay(bench_flash_read_us);
+    memcpy(dst, &bench_flash_memory[idx][src_offset], size);
+    bench_flash_stat[idx].read_model_ns +=
+        BENCH_FLASH_READ_CMD_NS + (uint64_t)size * BENCH_FLASH_READ_BYTE_NS;
+    bench_flash_stat[idx].read_cnt++;
+    bench_flash_stat[idx].read_bytes += size;
+    return XF_OK;
+}
+
+static xf_err_t bench_flash_write(size_t idx, size_t dst_offset, const void *src, size_t size)
+{
+    uint8_t *dst_u8;
+    const uint8_t *src_u8;
+    size_t i;
+
+    if (dst_offset + size > BENCH_FLASH_LEN) {
+        return XF_FAIL;
+    }
+    if ((dst_offset % BENCH_FLASH_IO_SIZE) || (size % BENCH_FLASH_IO_SIZE)
+            || (dst_offset / BENCH_FLASH_PAGE_SIZE
+                != (dst_offset + size - 1) / BENCH_FLASH_PAGE_SIZE)) {
+        bench_flash_stat[idx].write_violation_cnt++;
+    }
+    bench_flash_delay(bench_flash_write_us);
+    /* 模拟 nor flash 的行为 */
+    dst_u8 = &bench_flash_memory[idx][dst_offset];
+    src_u8 = src;
+    for (i = 0; i < size; i++) {
+        dst_u8[i] &= src_u8[i];
+    }
+    bench_flash_stat[idx].write_cnt++;
+    bench_flash_stat[idx].write_bytes += size;
+    return XF_OK;
+}
+
+static xf_err_t bench_flash_erase(size_t idx, size_t offset, size_t size)
+{
+    if (offset + size > BENCH_FLASH_LEN) {
+        return XF_FAIL;
+    }
+    bench_flash_delay(bench_flash_erase_us);
+    memset(&bench_flash_memory[idx][offset], 0xFF, size);
+    bench_flash_stat[idx].erase_model_us += bench_flash_erase_cost_us(size);
+    bench_flash_stat[idx].erase_cnt++;
+    bench_flash_stat[idx].erase_bytes += size;
+    return XF_OK;
+}
+
+/**
+ * @brief 单次擦除的模型耗时。表外的大小按逐扇区擦除计算。
+ */
+static uint32_t bench_flash_erase_cost_us(size_t size)
+{
+    switch (size) {
+    case 32 * 1024:         return BENCH_FLASH_ERASE_32K_US;
+    case 64 * 1024:         return BENCH_FLASH_ERASE_64K_US;
+    case BENCH_FLASH_LEN:   return BENCH_FLASH_ERASE_CHIP_US;
+    default:                break;
+    }
+    return (uint32_t)(size / BENCH_FLASH_SECTOR_SIZE) * BENCH_FLASH_ERASE_4K_US;
+}
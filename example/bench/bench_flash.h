@@ -0,0 +1,117 @@
+/**
+ * @file bench_flash.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 基准测试用的模拟 flash 设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __BENCH_FLASH_H__
+#define __BENCH_FLASH_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_FLASH1_NAME               "bench_flash1"
+#define BENCH_FLASH2_NAME               "bench_flash2"
+#define BENCH_FLASH_NUM                 (2)
+#define BENCH_FLASH_LEN                 (8 * 1024 * 1024)
+#define BENCH_FLASH_SECTOR_SIZE         (4 * 1024)
+#define BENCH_FLASH_PAGE_SIZE           (256)
+#define BENCH_FLASH_IO_SIZE             (4)
+
+/**
+ * @name bench_flash_read_model
+ * @brief 读耗时模型（参考 SPI NOR 单线读），单位: ns.
+ *        仅累计到 bench_flash_stat_t.read_model_ns, 不实际等待。
+ * @{
+ */
+#define BENCH_FLASH_READ_CMD_NS         (2000)  /*!< 每次读的命令、地址和片选开销 */
+#define BENCH_FLASH_READ_BYTE_NS        (80)    /*!< 每字节传输耗时 */
+/**
+ * End of bench_flash_read_model
+ * @}
+ */
+
+/**
+ * @name bench_flash_erase_model
+ * @brief 擦除耗时模型（参考常见 SPI NOR 的典型值），单位: us.
+ *        仅累计到 bench_flash_stat_t.erase_model_us, 不实际等待。
+ * @{
+ */
+#define BENCH_FLASH_ERASE_4K_US         (45000)
+#define BENCH_FLASH_ERASE_32K_US        (120000)
+#define BENCH_FLASH_ERASE_64K_US        (150000)
+#define BENCH_FLASH_ERASE_CHIP_US       (10000000)
+/**
+ * End of bench_flash_erase_model
+ * @}
+ */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 模拟 flash 的驱动调用统计。
+ */
+typedef struct _bench_flash_stat_t {
+    size_t read_cnt;
+    size_t write_cnt;
+    size_t erase_cnt;
+    size_t read_bytes;
+    size_t write_bytes;
+    size_t erase_bytes;
+    size_t write_violation_cnt;     /*!< 跨页或未按 io_size 对齐的写入次数 */
+    uint64_t erase_model_us;        /*!< 按擦除耗时模型累计的擦除耗时 */
+    uint64_t read_model_ns;         /*!< 按读耗时模型累计的读耗时 */
+} bench_flash_stat_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 模拟 flash 设备对象，与 bench_flash_get_dev(0) / bench_flash_get_dev(1) 相同。
+ */
+extern const xf_fal_flash_dev_t bench_flash1_dev;
+extern const xf_fal_flash_dev_t bench_flash2_dev;
+
+/**
+ * @brief 注册 BENCH_FLASH_NUM 个模拟 flash 设备（不含分区表）。
+ */
+void bench_flash_register_devices(void);
+
+/**
+ * @brief 获取指定模拟 flash 的设备描述。
+ *
+ * @param idx 0 ~ BENCH_FLASH_NUM - 1.
+ */
+const xf_fal_flash_dev_t *bench_flash_get_dev(size_t idx);
+
+/**
+ * @brief 获取 / 清零指定模拟 flash 的驱动调用统计。
+ */
+bench_flash_stat_t *bench_flash_get_stat(size_t idx);
+void bench_flash_reset_stat(void);
+
+/**
+ * @brief 设置每次驱动调用的模拟耗时（线程睡眠），单位: us. 0 表示不等待。
+ *
+ * 睡眠期间不占用 CPU, 用于模拟等待 flash 忙的过程。
+ */
+void bench_flash_set_delay(uint32_t read_us, uint32_t write_us, uint32_t erase_us);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __BENCH_FLASH_H__
@@ -0,0 +1,94 @@
+/**
+ * @file bench_handle.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 小块读写基准：xf_fal_partition_read() vs. 分区句柄。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_HANDLE_OPS                (1000000)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_handle_run(size_t io_size);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_handle_table[] = {
+    {"kv",      BENCH_FLASH1_NAME,  0,          64 * 1024},
+    {"log",     BENCH_FLASH1_NAME,  64 * 1024,  64 * 1024},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_handle(void)
+{
+    static const size_t io_size_arr[] = {4, 16, 64};
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_handle_table, ARRAY_SIZE(bench_handle_table));
+    xf_fal_init();
+
+    for (size_t i = 0; i < ARRAY_SIZE(io_size_arr); i++) {
+        bench_handle_run(io_size_arr[i]);
+    }
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_handle_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_handle_run(size_t io_size)
+{
+    const xf_fal_partition_t *part = xf_fal_partition_find("kv");
+    xf_fal_handle_t handle;
+    uint8_t buf[64];
+    uint64_t t0;
+    uint64_t t_part;
+    uint64_t t_handle;
+    size_t err = 0;
+    size_t offset;
+
+    xf_fal_partition_get_handle(part, &handle);
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_HANDLE_OPS; i++) {
+        offset = (i * io_size) % part->len;
+        if (XF_OK != xf_fal_partition_read(part, offset, buf, io_size)) {
+            err++;
+        }
+    }
+    t_part = bench_now_ns() - t0;
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_HANDLE_OPS; i++) {
+        offset = (i * io_size) % part->len;
+        if (XF_OK != xf_fal_handle_read(&handle, offset, buf, io_size)) {
+            err++;
+        }
+    }
+    t_handle = bench_now_ns() - t0;
+
+    printf("read io_size=%-3u partition=%6.1f ns/op handle=%6.1f ns/op err=%u\n",
+           (unsigned)io_size,
+           (double)t_part / BENCH_HANDLE_OPS,
+           (double)t_handle / BENCH_HANDLE_OPS,
+           (unsigned)err);
+}
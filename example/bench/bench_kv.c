@@ -0,0 +1,263 @@
+/**
+ * @file bench_kv.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 键值存储基准：随机更新下日志结构存储与整扇区重写的写放大、擦除次数和吞吐对比。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "xf_fal_kv.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_KV_KEY_NUM                (48)
+#define BENCH_KV_VALUE_MIN              (8)
+#define BENCH_KV_VALUE_MAX              (40)
+#define BENCH_KV_SLOT_SIZE              (64)    /*!< 整扇区重写时每个键的固定槽位 */
+#define BENCH_KV_SETS                   (20000)
+#define BENCH_KV_GETS                   (100000)
+#define BENCH_KV_SECTOR_NUM             (8)
+#define BENCH_KV_DEL_STEP               (8)     /*!< 最后每 8 个键删除 1 个 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static uint32_t bench_kv_rand(void);
+static void bench_kv_key(char *key, size_t idx);
+static size_t bench_kv_value(uint8_t *value, size_t idx);
+static void bench_kv_run_log(void);
+static void bench_kv_run_sector(void);
+static size_t bench_kv_verify(xf_fal_kv_t *kv);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_kv_table[] = {
+    {"kv",      BENCH_FLASH1_NAME,  0,  BENCH_KV_SECTOR_NUM * BENCH_FLASH_SECTOR_SIZE},
+    {"table",   BENCH_FLASH2_NAME,  0,  BENCH_FLASH_SECTOR_SIZE},
+};
+
+static uint32_t s_bench_kv_seed;
+static uint32_t s_bench_kv_gen[BENCH_KV_KEY_NUM];
+static xf_fal_kv_t s_bench_kv;
+static uint8_t s_bench_kv_sector[BENCH_FLASH_SECTOR_SIZE];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_kv(void)
+{
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_kv_table, ARRAY_SIZE(bench_kv_table));
+    xf_fal_init();
+
+    printf("%u keys, %u random sets (%u~%u-byte values), %u random gets:\n",
+           (unsigned)BENCH_KV_KEY_NUM, (unsigned)BENCH_KV_SETS,
+           (unsigned)BENCH_KV_VALUE_MIN, (unsigned)BENCH_KV_VALUE_MAX, (unsigned)BENCH_KV_GETS);
+    bench_kv_run_sector();
+    bench_kv_run_log();
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_kv_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static uint32_t bench_kv_rand(void)
+{
+    /* xorshift32, 每次运行结果相同 */
+    s_bench_kv_seed ^= s_bench_kv_seed << 13;
+    s_bench_kv_seed ^= s_bench_kv_seed >> 17;
+    s_bench_kv_seed ^= s_bench_kv_seed << 5;
+    return s_bench_kv_seed;
+}
+
+static void bench_kv_key(char *key, size_t idx)
+{
+    memcpy(key, "cfg.", 4);
+    key[4] = (char)('0' + idx / 10);
+    key[5] = (char)('0' + idx % 10);
+    key[6] = '\0';
+}
+
+/**
+ * @brief 生成键 idx 当前版本的值，长度和内容由版本号决定。
+ */
+static size_t bench_kv_value(uint8_t *value, size_t idx)
+{
+    uint32_t gen = s_bench_kv_gen[idx];
+    size_t len = BENCH_KV_VALUE_MIN
+                 + (idx * 7 + gen) % (BENCH_KV_VALUE_MAX - BENCH_KV_VALUE_MIN + 1);
+
+    for (size_t i = 0; i < len; i++) {
+        value[i] = (uint8_t)(idx + gen * 31 + i);
+    }
+    return len;
+}
+
+static void bench_kv_run_log(void)
+{
+    const xf_fal_partition_t *part = xf_fal_partition_find("kv");
+    char key[8];
+    uint8_t value[BENCH_KV_VALUE_MAX];
+    size_t len;
+    size_t idx;
+    size_t err = 0;
+    size_t mismatch;
+    uint64_t t0;
+    uint64_t set_ns;
+    uint64_t get_ns;
+    xf_fal_kv_stat_t stat;
+    bench_flash_stat_t flash;
+
+    xf_fal_partition_erase(part, 0, BENCH_KV_SECTOR_NUM * BENCH_FLASH_SECTOR_SIZE);
+    if (XF_OK != xf_fal_kv_open(&s_bench_kv, part)) {
+        printf("xf_fal_kv_open failed\n");
+        return;
+    }
+    s_bench_kv_seed = 0x2545F491;
+    memset(s_bench_kv_gen, 0, sizeof(s_bench_kv_gen));
+    bench_flash_reset_stat();
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_KV_SETS; i++) {
+        idx = (i < BENCH_KV_KEY_NUM) ? i : (bench_kv_rand() % BENCH_KV_KEY_NUM);
+        s_bench_kv_gen[idx]++;
+        bench_kv_key(key, idx);
+        len = bench_kv_value(value, idx);
+        if (XF_OK != xf_fal_kv_set(&s_bench_kv, key, value, len)) {
+            err++;
+        }
+    }
+    set_ns  = bench_now_ns() - t0;
+    flash   = *bench_flash_get_stat(0);
+    xf_fal_kv_get_stat(&s_bench_kv, &stat);
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_KV_GETS; i++) {
+        bench_kv_key(key, bench_kv_rand() % BENCH_KV_KEY_NUM);
+        if (XF_OK != xf_fal_kv_get(&s_bench_kv, key, value, sizeof(value), &len)) {
+            err++;
+        }
+    }
+    get_ns = bench_now_ns() - t0;
+
+    /* 删除部分键，版本号 0 表示已删除 */
+    for (size_t i = BENCH_KV_DEL_STEP - 1; i < BENCH_KV_KEY_NUM; i += BENCH_KV_DEL_STEP) {
+        bench_kv_key(key, i);
+        s_bench_kv_gen[i] = 0;
+        if (XF_OK != xf_fal_kv_delete(&s_bench_kv, key)) {
+            err++;
+        }
+    }
+
+    printf("  log kv:        set %8.0f ops/s  get %8.0f ops/s  "
+           "write amp %5.2fx  erases %5u  gc %u\n",
+           BENCH_KV_SETS * 1e9 / set_ns, BENCH_KV_GETS * 1e9 / get_ns,
+           (double)flash.write_bytes / stat.user_bytes, (unsigned)flash.erase_cnt,
+           (unsigned)stat.gc_num);
+
+    /* 模拟重启：重新打开后所有键的值与最后一次写入一致 */
+    mismatch = bench_kv_verify(&s_bench_kv);
+    printf("  reopen: %u keys, %s, err=%u\n", (unsigned)s_bench_kv.stat.key_num,
+           (0 == mismatch) ? "values match" : "MISMATCH", (unsigned)err);
+}
+
+/**
+ * @brief 对比：所有键放在一个扇区的固定槽位中，每次更新读出整个扇区、擦除后重写。
+ */
+static void bench_kv_run_sector(void)
+{
+    const xf_fal_partition_t *part = xf_fal_partition_find("table");
+    uint8_t value[BENCH_KV_VALUE_MAX];
+    size_t user_bytes = 0;
+    size_t len;
+    size_t idx;
+    size_t err = 0;
+    uint64_t t0;
+    uint64_t set_ns;
+    uint64_t get_ns;
+    bench_flash_stat_t flash;
+
+    s_bench_kv_seed = 0x2545F491;
+    memset(s_bench_kv_gen, 0, sizeof(s_bench_kv_gen));
+    bench_flash_reset_stat();
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_KV_SETS; i++) {
+        idx = (i < BENCH_KV_KEY_NUM) ? i : (bench_kv_rand() % BENCH_KV_KEY_NUM);
+        s_bench_kv_gen[idx]++;
+        len = bench_kv_value(value, idx);
+        if (XF_OK != xf_fal_partition_read(part, 0, s_bench_kv_sector, BENCH_FLASH_SECTOR_SIZE)) {
+            err++;
+            continue;
+        }
+        s_bench_kv_sector[idx * BENCH_KV_SLOT_SIZE] = (uint8_t)len;
+        memcpy(&s_bench_kv_sector[idx * BENCH_KV_SLOT_SIZE + 1], value, len);
+        if ((XF_OK != xf_fal_partition_erase(part, 0, BENCH_FLASH_SECTOR_SIZE))
+                || (XF_OK != xf_fal_partition_write(part, 0, s_bench_kv_sector,
+                                                    BENCH_FLASH_SECTOR_SIZE))) {
+            err++;
+        }
+        user_bytes += 6 + len;
+    }
+    set_ns  = bench_now_ns() - t0;
+    flash   = *bench_flash_get_stat(1);
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_KV_GETS; i++) {
+        idx = bench_kv_rand() % BENCH_KV_KEY_NUM;
+        if (XF_OK != xf_fal_partition_read(part, idx * BENCH_KV_SLOT_SIZE, value, sizeof(value))) {
+            err++;
+        }
+    }
+    get_ns = bench_now_ns() - t0;
+
+    printf("  sector rewrite: set %8.0f ops/s  get %8.0f ops/s  "
+           "write amp %5.2fx  erases %5u  err=%u\n",
+           BENCH_KV_SETS * 1e9 / set_ns, BENCH_KV_GETS * 1e9 / get_ns,
+           (double)flash.write_bytes / user_bytes, (unsigned)flash.erase_cnt, (unsigned)err);
+}
+
+/**
+ * @brief 重新打开键值存储并与每个键最后一次写入的值比较，已删除的键应不存在。
+ *
+ * @return size_t 不一致的键个数。
+ */
+static size_t bench_kv_verify(xf_fal_kv_t *kv)
+{
+    char key[8];
+    uint8_t expect[BENCH_KV_VALUE_MAX];
+    uint8_t value[BENCH_KV_VALUE_MAX];
+    size_t expect_len;
+    size_t len;
+    size_t mismatch = 0;
+
+    if (XF_OK != xf_fal_kv_open(kv, xf_fal_partition_find("kv"))) {
+        return BENCH_KV_KEY_NUM;
+    }
+    for (size_t i = 0; i < BENCH_KV_KEY_NUM; i++) {
+        bench_kv_key(key, i);
+        if (0 == s_bench_kv_gen[i]) {
+            mismatch += (XF_ERR_NOT_FOUND != xf_fal_kv_get(kv, key, value, sizeof(value), &len));
+            continue;
+        }
+        expect_len = bench_kv_value(expect, i);
+        if ((XF_OK != xf_fal_kv_get(kv, key, value, sizeof(value), &len))
+                || (len != expect_len) || (0 != memcmp(value, expect, len))) {
+            mismatch++;
+        }
+    }
+
+    return mismatch;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file bench_rcache.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 读缓存基准：元数据密集型小块读取，直接读 flash vs. 经过读缓存。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+#if XF_FAL_READ_CACHE_NUM > 0
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_RCACHE_OPS                (200000)
+#define BENCH_RCACHE_PART_LEN           (1024 * 1024)
+#define BENCH_RCACHE_META_NUM           (8)     /*!< 热点元数据扇区数 */
+#define BENCH_RCACHE_META_SPAN          (256)   /*!< 每个元数据扇区中被频繁读取的范围 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_rcache_run(const xf_fal_partition_t *part, size_t hot_percent);
+static bool bench_rcache_coherency(const xf_fal_partition_t *part);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_rcache_table[] = {
+    {"fs",      BENCH_FLASH1_NAME,  0,          BENCH_RCACHE_PART_LEN},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_rcache(void)
+{
+    static const size_t hot_percent_arr[] = {50, 90, 99};
+    const xf_fal_partition_t *part;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_rcache_table, ARRAY_SIZE(bench_rcache_table));
+    xf_fal_init();
+
+    part = xf_fal_partition_find("fs");
+    printf("cache: %u lines x %u bytes, read model: %u ns/cmd + %u ns/byte\n",
+           (unsigned)XF_FAL_READ_CACHE_NUM, (unsigned)XF_FAL_READ_CACHE_LINE_SIZE,
+           (unsigned)BENCH_FLASH_READ_CMD_NS, (unsigned)BENCH_FLASH_READ_BYTE_NS);
+    for (size_t i = 0; i < ARRAY_SIZE(hot_percent_arr); i++) {
+        bench_rcache_run(part, hot_percent_arr[i]);
+    }
+    printf("write/erase invalidation: %s\n", bench_rcache_coherency(part) ? "ok" : "FAILED");
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_rcache_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static uint32_t bench_rcache_rand(uint32_t *p_state)
+{
+    *p_state = *p_state * 1103515245u + 12345u;
+    return *p_state >> 8;
+}
+
+/**
+ * @brief 生成一次读取：hot_percent% 落在元数据扇区的头部，其余随机分布在整个分区。
+ */
+static void bench_rcache_next(uint32_t *p_state, size_t hot_percent,
+                              size_t *p_offset, size_t *p_size)
+{
+    if ((bench_rcache_rand(p_state) % 100) < hot_percent) {
+        *p_size     = 16 + (bench_rcache_rand(p_state) % 3) * 16;
+        *p_offset   = (bench_rcache_rand(p_state) % BENCH_RCACHE_META_NUM) * BENCH_FLASH_SECTOR_SIZE
+                      + (bench_rcache_rand(p_state) % (BENCH_RCACHE_META_SPAN - *p_size));
+    } else {
+        *p_size     = 64;
+        *p_offset   = bench_rcache_rand(p_state) % (BENCH_RCACHE_PART_LEN - *p_size);
+    }
+}
+
+static void bench_rcache_run(const xf_fal_partition_t *part, size_t hot_percent)
+{
+    const xf_fal_flash_dev_t *dev = bench_flash_get_dev(0);
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    xf_fal_read_cache_stat_t rc_stat;
+    uint8_t buf[64];
+    uint32_t state;
+    size_t offset;
+    size_t size;
+    uint64_t direct_model_ns;
+    size_t direct_cnt;
+    size_t err = 0;
+
+    /* 直接调用驱动，相当于没有读缓存 */
+    bench_flash_reset_stat();
+    state = 1;
+    for (size_t i = 0; i < BENCH_RCACHE_OPS; i++) {
+        bench_rcache_next(&state, hot_percent, &offset, &size);
+        if (XF_OK != dev->ops.read(part->offset + offset, buf, size)) {
+            err++;
+        }
+    }
+    direct_model_ns = stat->read_model_ns;
+    direct_cnt      = stat->read_cnt;
+
+    xf_fal_read_cache_invalidate(NULL, 0, 0);
+    xf_fal_read_cache_reset_stat();
+    bench_flash_reset_stat();
+    state = 1;
+    for (size_t i = 0; i < BENCH_RCACHE_OPS; i++) {
+        bench_rcache_next(&state, hot_percent, &offset, &size);
+        if (XF_OK != xf_fal_partition_read(part, offset, buf, size)) {
+            err++;
+        }
+    }
+    xf_fal_read_cache_get_stat(&rc_stat);
+
+    printf("hot=%2u%% direct: %6u reads %7.1f ms | cached: %6u reads %7.1f ms "
+           "hit=%5.1f%% (hit %u miss %u bypass %u) speedup=%5.2fx err=%u\n",
+           (unsigned)hot_percent,
+           (unsigned)direct_cnt, (double)direct_model_ns / 1e6,
+           (unsigned)stat->read_cnt, (double)stat->read_model_ns / 1e6,
+           100.0 * rc_stat.hit_cnt
+           / (double)(rc_stat.hit_cnt + rc_stat.miss_cnt + rc_stat.bypass_cnt),
+           (unsigned)rc_stat.hit_cnt, (unsigned)rc_stat.miss_cnt, (unsigned)rc_stat.bypass_cnt,
+           (double)direct_model_ns / (double)stat->read_model_ns, (unsigned)err);
+}
+
+static bool bench_rcache_coherency(const xf_fal_partition_t *part)
+{
+    const uint8_t data[4] = {0x12, 0x34, 0x56, 0x78};
+    uint8_t buf[4];
+
+    xf_fal_partition_erase(part, 0, BENCH_FLASH_SECTOR_SIZE);
+    xf_fal_partition_read(part, 0, buf, sizeof(buf));   /* 缓存擦除后的内容 */
+    xf_fal_partition_write(part, 0, data, sizeof(data));
+    xf_fal_partition_read(part, 0, buf, sizeof(buf));
+    if (0 != memcmp(buf, data, sizeof(data))) {
+        return false;
+    }
+    xf_fal_partition_erase(part, 0, BENCH_FLASH_SECTOR_SIZE);
+    xf_fal_partition_read(part, 0, buf, sizeof(buf));
+    return (0xFF == buf[0]) && (0xFF == buf[3]);
+}
+
+#else
+
+void bench_rcache(void)
+{
+    printf("XF_FAL_READ_CACHE_NUM is 0, skipped.\n");
+}
+
+#endif // XF_FAL_READ_CACHE_NUM
@@ -0,0 +1,169 @@
+/**
+ * @file bench_ring.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 环形日志基准：写满 8 MiB 分区后，线性扫描与二分查找扇区头恢复写入位置的读次数和耗时对比。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "xf_fal_ring.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_RING_EVENT_SIZE           (60)
+#define BENCH_RING_APPENDS              (180000)    /*!< 约 1.5 圈 */
+#define BENCH_RING_SCAN_CHUNK           BENCH_FLASH_PAGE_SIZE
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static size_t bench_ring_linear_scan(const xf_fal_partition_t *part);
+static void bench_ring_print_read(const char *name, const bench_flash_stat_t *stat, uint64_t ns);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_ring_table[] = {
+    {"events",  BENCH_FLASH2_NAME,  0,  BENCH_FLASH_LEN},
+};
+
+static xf_fal_ring_t s_bench_ring;
+static uint8_t s_bench_ring_chunk[BENCH_RING_SCAN_CHUNK];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_ring(void)
+{
+    const xf_fal_partition_t *part;
+    xf_fal_ring_iter_t it;
+    uint8_t event[BENCH_RING_EVENT_SIZE];
+    uint32_t id;
+    uint32_t first = 0;
+    uint32_t expect = 0;
+    size_t head;
+    size_t tail;
+    size_t write_off;
+    size_t scan_head;
+    size_t num = 0;
+    size_t err = 0;
+    uint64_t t0;
+    uint64_t ns;
+    bench_flash_stat_t flash;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_ring_table, ARRAY_SIZE(bench_ring_table));
+    xf_fal_init();
+    part = xf_fal_partition_find("events");
+
+    /* 写入约 1.5 圈，使日志回绕 */
+    xf_fal_partition_erase(part, 0, BENCH_FLASH_LEN);
+    if (XF_OK != xf_fal_ring_open(&s_bench_ring, part)) {
+        printf("xf_fal_ring_open failed\n");
+        goto l_end;
+    }
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    for (id = 0; id < BENCH_RING_APPENDS; id++) {
+        memset(event, (uint8_t)id, sizeof(event));
+        memcpy(event, &id, sizeof(id));
+        err += (XF_OK != xf_fal_ring_append(&s_bench_ring, event, sizeof(event)));
+    }
+    err += (XF_OK != xf_fal_ring_flush(&s_bench_ring));
+    ns      = bench_now_ns() - t0;
+    flash   = *bench_flash_get_stat(1);
+    head        = s_bench_ring.head;
+    tail        = s_bench_ring.tail;
+    write_off   = s_bench_ring.write_off;
+
+    printf("%u MiB ring (%u sectors), %u appends of %u-byte events:\n",
+           (unsigned)(BENCH_FLASH_LEN >> 20), (unsigned)s_bench_ring.sector_num,
+           (unsigned)BENCH_RING_APPENDS, (unsigned)BENCH_RING_EVENT_SIZE);
+    printf("  append %6.1f ns/entry  writes %u (%.1f bytes avg, violations %u)  erases %u\n",
+           (double)ns / BENCH_RING_APPENDS, (unsigned)flash.write_cnt,
+           (double)flash.write_bytes / flash.write_cnt, (unsigned)flash.write_violation_cnt,
+           (unsigned)flash.erase_cnt);
+
+    /* 模拟重启：两种方式恢复写入位置 */
+    printf("boot recovery:\n");
+    bench_flash_reset_stat();
+    t0          = bench_now_ns();
+    scan_head   = bench_ring_linear_scan(part);
+    ns          = bench_now_ns() - t0;
+    bench_ring_print_read("linear scan:  ", bench_flash_get_stat(1), ns);
+
+    memset(&s_bench_ring, 0, sizeof(s_bench_ring));
+    bench_flash_reset_stat();
+    t0  = bench_now_ns();
+    err += (XF_OK != xf_fal_ring_open(&s_bench_ring, part));
+    ns  = bench_now_ns() - t0;
+    bench_ring_print_read("binary search:", bench_flash_get_stat(1), ns);
+    printf("  head sector %u (scan: %u), tail sector %u, %s\n",
+           (unsigned)s_bench_ring.head, (unsigned)scan_head, (unsigned)s_bench_ring.tail,
+           ((head == s_bench_ring.head) && (tail == s_bench_ring.tail)
+            && (write_off == s_bench_ring.write_off)) ? "matches writer" : "MISMATCH");
+
+    /* 遍历恢复后的日志，条目编号应连续且以最后一次追加结尾 */
+    xf_fal_ring_iter_begin(&s_bench_ring, &it);
+    while (XF_OK == xf_fal_ring_iter_next(&s_bench_ring, &it, event, sizeof(event), NULL)) {
+        memcpy(&id, event, sizeof(id));
+        if (0 == num) {
+            first = id;
+        } else if (id != expect) {
+            err++;
+        }
+        expect = id + 1;
+        num++;
+    }
+    printf("iterate: %u entries, id %u ~ %u, %s, err=%u\n",
+           (unsigned)num, (unsigned)first, (unsigned)(expect - 1),
+           (BENCH_RING_APPENDS == expect) ? "contiguous" : "MISMATCH", (unsigned)err);
+
+l_end:
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_ring_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 对比：按页读出整个分区，从每个扇区头中找出序号最大的扇区。
+ *
+ * @return size_t 最新扇区。
+ */
+static size_t bench_ring_linear_scan(const xf_fal_partition_t *part)
+{
+    uint32_t seq;
+    uint32_t seq_max = 0;
+    size_t head = 0;
+
+    for (size_t off = 0; off < BENCH_FLASH_LEN; off += sizeof(s_bench_ring_chunk)) {
+        xf_fal_partition_read(part, off, s_bench_ring_chunk, sizeof(s_bench_ring_chunk));
+        if (0 == off % BENCH_FLASH_SECTOR_SIZE) {
+            memcpy(&seq, &s_bench_ring_chunk[4], sizeof(seq));
+            if ((seq != UINT32_MAX) && (seq > seq_max)) {
+                seq_max = seq;
+                head    = off / BENCH_FLASH_SECTOR_SIZE;
+            }
+        }
+    }
+
+    return head;
+}
+
+static void bench_ring_print_read(const char *name, const bench_flash_stat_t *stat, uint64_t ns)
+{
+    printf("  %s reads %6u  bytes %8u  model %9.3f ms  cpu %9.3f ms\n",
+           name, (unsigned)stat->read_cnt, (unsigned)stat->read_bytes,
+           stat->read_model_ns / 1e6, ns / 1e6);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file bench_sim.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 时序模拟基准：用虚拟时钟比较不同操作序列在 SPI NOR 上的设备耗时，并检查等待模式的实际耗时。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "xf_fal_sim.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_SIM_LEN                   (1024 * 1024)
+#define BENCH_SIM_WAIT_SECTORS          (4)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+#if XF_FAL_SIM_ENABLE
+static void bench_sim_case(const char *name, const xf_fal_partition_t *part,
+                           void (*fn)(const xf_fal_partition_t *part));
+static void bench_sim_erase_sector(const xf_fal_partition_t *part);
+static void bench_sim_erase_range(const xf_fal_partition_t *part);
+static void bench_sim_write_page(const xf_fal_partition_t *part);
+static void bench_sim_write_4k(const xf_fal_partition_t *part);
+static void bench_sim_read_16(const xf_fal_partition_t *part);
+static void bench_sim_read_4k(const xf_fal_partition_t *part);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+#if XF_FAL_SIM_ENABLE
+static const xf_fal_partition_t bench_sim_table[] = {
+    {"sim",     BENCH_FLASH2_NAME,  0,  BENCH_SIM_LEN},
+};
+static uint8_t s_bench_sim_buf[BENCH_FLASH_SECTOR_SIZE];
+#endif
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+#if XF_FAL_SIM_ENABLE
+
+void bench_sim(void)
+{
+    const xf_fal_sim_model_t model = XF_FAL_SIM_MODEL_SPI_NOR_DEFAULT;
+    const xf_fal_partition_t *part;
+    xf_fal_sim_stat_t stat;
+    uint64_t t0;
+    uint64_t wall_ns;
+
+    /* bench_flash2 换成同名的模拟设备 */
+    bench_flash_register_devices();
+    xf_fal_unregister_flash_device(bench_flash_get_dev(1));
+    xf_fal_register_flash_device(xf_fal_sim_wrap(bench_flash_get_dev(1), &model));
+    xf_fal_register_partition_table(bench_sim_table, ARRAY_SIZE(bench_sim_table));
+    xf_fal_init();
+    part = xf_fal_partition_find("sim");
+
+    printf("%u KiB, simulated SPI NOR device time:\n", (unsigned)(BENCH_SIM_LEN >> 10));
+    bench_sim_case("erase, sector by sector", part, bench_sim_erase_sector);
+    bench_sim_case("erase, whole range",      part, bench_sim_erase_range);
+    bench_sim_case("write, 256 B calls",      part, bench_sim_write_page);
+    bench_sim_case("write, 4 KiB calls",      part, bench_sim_write_4k);
+    bench_sim_case("read, 16 B calls",        part, bench_sim_read_16);
+    bench_sim_case("read, 4 KiB calls",       part, bench_sim_read_4k);
+
+    /* 等待模式：实际耗时应接近虚拟时钟 */
+    printf("wait modes (%u sector erases):\n", (unsigned)BENCH_SIM_WAIT_SECTORS);
+    for (int wait = XF_FAL_SIM_WAIT_SLEEP; wait <= XF_FAL_SIM_WAIT_BUSY; wait++) {
+        xf_fal_sim_set_wait(BENCH_FLASH2_NAME, (xf_fal_sim_wait_t)wait);
+        xf_fal_sim_reset_stat(NULL);
+        t0 = bench_now_ns();
+        xf_fal_partition_erase(part, 0, BENCH_SIM_WAIT_SECTORS * BENCH_FLASH_SECTOR_SIZE);
+        wall_ns = bench_now_ns() - t0;
+        xf_fal_sim_get_stat(BENCH_FLASH2_NAME, &stat);
+        printf("  %-5s  virtual %8.3f ms  wall %8.3f ms\n",
+               (XF_FAL_SIM_WAIT_SLEEP == wait) ? "sleep" : "busy",
+               stat.time_ns / 1e6, wall_ns / 1e6);
+    }
+    xf_fal_sim_set_wait(BENCH_FLASH2_NAME, XF_FAL_SIM_WAIT_NONE);
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_sim_table);
+    xf_fal_unregister_flash_device(xf_fal_sim_wrap(bench_flash_get_dev(1), NULL));
+    xf_fal_register_flash_device(bench_flash_get_dev(1));
+}
+
+#else
+
+void bench_sim(void)
+{
+    printf("XF_FAL_SIM_ENABLE is 0, skipped.\n");
+}
+
+#endif // XF_FAL_SIM_ENABLE
+
+/* ==================== [Static Functions] ================================== */
+
+#if XF_FAL_SIM_ENABLE
+
+static void bench_sim_case(const char *name, const xf_fal_partition_t *part,
+                           void (*fn)(const xf_fal_partition_t *part))
+{
+    xf_fal_sim_stat_t stat;
+    uint64_t t0;
+    uint64_t wall_ns;
+
+    xf_fal_sim_reset_stat(NULL);
+    t0 = bench_now_ns();
+    fn(part);
+    wall_ns = bench_now_ns() - t0;
+    xf_fal_sim_get_stat(BENCH_FLASH2_NAME, &stat);
+    printf("  %-24s device %10.3f ms  (read %u, program %u, erase %u cmds)  host %7.3f ms\n",
+           name, stat.time_ns / 1e6, (unsigned)stat.read_cnt, (unsigned)stat.program_cnt,
+           (unsigned)stat.erase_cnt, wall_ns / 1e6);
+}
+
+static void bench_sim_erase_sector(const xf_fal_partition_t *part)
+{
+    for (size_t off = 0; off < BENCH_SIM_LEN; off += BENCH_FLASH_SECTOR_SIZE) {
+        xf_fal_partition_erase(part, off, BENCH_FLASH_SECTOR_SIZE);
+    }
+}
+
+/**
+ * @brief 一次擦除整个范围，xf_fal 按擦除粒度表拆分为 64 KiB 块擦除。
+ */
+static void bench_sim_erase_range(const xf_fal_partition_t *part)
+{
+    xf_fal_partition_erase(part, 0, BENCH_SIM_LEN);
+}
+
+static void bench_sim_write_page(const xf_fal_partition_t *part)
+{
+    memset(s_bench_sim_buf, 0x5A, sizeof(s_bench_sim_buf));
+    for (size_t off = 0; off < BENCH_SIM_LEN; off += BENCH_FLASH_PAGE_SIZE) {
+        xf_fal_partition_write(part, off, s_bench_sim_buf, BENCH_FLASH_PAGE_SIZE);
+    }
+}
+
+static void bench_sim_write_4k(const xf_fal_partition_t *part)
+{
+    /* 再次写入相同数据，对 NOR flash 无副作用 */
+    memset(s_bench_sim_buf, 0x5A, sizeof(s_bench_sim_buf));
+    for (size_t off = 0; off < BENCH_SIM_LEN; off += sizeof(s_bench_sim_buf)) {
+        xf_fal_partition_write(part, off, s_bench_sim_buf, sizeof(s_bench_sim_buf));
+    }
+}
+
+static void bench_sim_read_16(const xf_fal_partition_t *part)
+{
+    for (size_t off = 0; off < BENCH_SIM_LEN; off += 16) {
+        xf_fal_partition_read(part, off, s_bench_sim_buf, 16);
+    }
+}
+
+static void bench_sim_read_4k(const xf_fal_partition_t *part)
+{
+    for (size_t off = 0; off < BENCH_SIM_LEN; off += sizeof(s_bench_sim_buf)) {
+        xf_fal_partition_read(part, off, s_bench_sim_buf, sizeof(s_bench_sim_buf));
+    }
+}
+
+#endif // XF_FAL_SIM_ENABLE
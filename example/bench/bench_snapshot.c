@@ -0,0 +1,158 @@
+/**
+ * @file bench_snapshot.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 注册表快照压力测试：N 个查找线程 + 1 个注册线程。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_SNAPSHOT_READER_MAX       (8)
+#define BENCH_SNAPSHOT_DURATION_MS      (300)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 每个线程独立的计数，按缓存行对齐避免伪共享。
+ */
+typedef struct {
+    size_t ops;
+    size_t fail;
+} __attribute__((aligned(64))) bench_snapshot_cnt_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void *bench_snapshot_reader(void *arg);
+static void *bench_snapshot_writer(void *arg);
+static void bench_snapshot_run(size_t reader_num);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_snapshot_table[] = {
+    {"snap_a",  BENCH_FLASH1_NAME,  0,              64 * 1024},
+    {"snap_b",  BENCH_FLASH1_NAME,  64 * 1024,      64 * 1024},
+    {"snap_c",  BENCH_FLASH1_NAME,  128 * 1024,     64 * 1024},
+    {"snap_d",  BENCH_FLASH1_NAME,  192 * 1024,     64 * 1024},
+};
+
+/* 写线程反复注册、注销的分区表 */
+static const xf_fal_partition_t bench_snapshot_extra_table[] = {
+    {"snap_x",  BENCH_FLASH2_NAME,  0,              64 * 1024},
+    {"snap_y",  BENCH_FLASH2_NAME,  64 * 1024,      64 * 1024},
+};
+
+static volatile int bench_snapshot_stop;
+static bench_snapshot_cnt_t bench_snapshot_cnt[BENCH_SNAPSHOT_READER_MAX + 1];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_snapshot(void)
+{
+    static const size_t reader_num_arr[] = {1, 2, 4, 8};
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_snapshot_table, ARRAY_SIZE(bench_snapshot_table));
+    xf_fal_init();
+
+    for (size_t i = 0; i < ARRAY_SIZE(reader_num_arr); i++) {
+        bench_snapshot_run(reader_num_arr[i]);
+    }
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_snapshot_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void *bench_snapshot_reader(void *arg)
+{
+    bench_snapshot_cnt_t *cnt = arg;
+    const xf_fal_partition_t *part;
+    size_t i = 0;
+
+    while (!bench_snapshot_stop) {
+        /* 这些分区始终处于注册状态，查找失败即为误报 */
+        part = xf_fal_partition_find(bench_snapshot_table[i % ARRAY_SIZE(bench_snapshot_table)].name);
+        if ((!part) || (!xf_fal_flash_device_find_by_part(part))) {
+            cnt->fail++;
+        }
+        cnt->ops++;
+        i++;
+    }
+
+    return NULL;
+}
+
+static void *bench_snapshot_writer(void *arg)
+{
+    bench_snapshot_cnt_t *cnt = arg;
+
+    while (!bench_snapshot_stop) {
+        if (XF_OK != xf_fal_register_partition_table(
+                    bench_snapshot_extra_table, ARRAY_SIZE(bench_snapshot_extra_table))) {
+            cnt->fail++;
+        }
+        if (XF_OK != xf_fal_check_and_update_cache()) {
+            cnt->fail++;
+        }
+        if (XF_OK != xf_fal_unregister_partition_table(bench_snapshot_extra_table)) {
+            cnt->fail++;
+        }
+        if (XF_OK != xf_fal_check_and_update_cache()) {
+            cnt->fail++;
+        }
+        cnt->ops++;
+    }
+
+    return NULL;
+}
+
+static void bench_snapshot_run(size_t reader_num)
+{
+    pthread_t reader[BENCH_SNAPSHOT_READER_MAX];
+    pthread_t writer;
+    bench_snapshot_cnt_t *writer_cnt = &bench_snapshot_cnt[BENCH_SNAPSHOT_READER_MAX];
+    struct timespec ts = {
+        .tv_sec     = BENCH_SNAPSHOT_DURATION_MS / 1000,
+        .tv_nsec    = (BENCH_SNAPSHOT_DURATION_MS % 1000) * 1000000L,
+    };
+    size_t ops = 0;
+    size_t fail = 0;
+
+    memset(bench_snapshot_cnt, 0, sizeof(bench_snapshot_cnt));
+    bench_snapshot_stop = 0;
+
+    pthread_create(&writer, NULL, bench_snapshot_writer, writer_cnt);
+    for (size_t i = 0; i < reader_num; i++) {
+        pthread_create(&reader[i], NULL, bench_snapshot_reader, &bench_snapshot_cnt[i]);
+    }
+    nanosleep(&ts, NULL);
+    bench_snapshot_stop = 1;
+    for (size_t i = 0; i < reader_num; i++) {
+        pthread_join(reader[i], NULL);
+        ops     += bench_snapshot_cnt[i].ops;
+        fail    += bench_snapshot_cnt[i].fail;
+    }
+    pthread_join(writer, NULL);
+
+    printf("readers=%u lookups=%9.0f /s spurious_fail=%u writer_updates=%u writer_fail=%u\n",
+           (unsigned)reader_num,
+           (double)ops * 1000.0 / BENCH_SNAPSHOT_DURATION_MS,
+           (unsigned)fail,
+           (unsigned)writer_cnt->ops,
+           (unsigned)writer_cnt->fail);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file bench_split.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 写入拆分基准：不同对齐方式下的驱动调用次数与编程吞吐。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_SPLIT_OPS                 (64)
+#define BENCH_SPLIT_WRITE_US            (50)    /*!< 模拟每次页编程耗时 */
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _bench_split_case_t {
+    size_t offset;                              /*!< 每次写入相对扇区起始的偏移 */
+    size_t size;
+} bench_split_case_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_split_run(const xf_fal_partition_t *part, const bench_split_case_t *c);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_split_table[] = {
+    {"data",    BENCH_FLASH1_NAME,  0,          1024 * 1024},
+};
+
+static const bench_split_case_t bench_split_case_arr[] = {
+    {0,     4096},
+    {3,     4090},
+    {1,     1000},
+    {2,     5},
+};
+
+static uint8_t s_src[BENCH_FLASH_SECTOR_SIZE];
+static uint8_t s_dst[BENCH_FLASH_SECTOR_SIZE];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_split(void)
+{
+    const xf_fal_partition_t *part;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_split_table, ARRAY_SIZE(bench_split_table));
+    xf_fal_init();
+
+    part = xf_fal_partition_find("data");
+    for (size_t i = 0; i < sizeof(s_src); i++) {
+        s_src[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    printf("page_size=%u io_size=%u write=%u us/call\n",
+           (unsigned)BENCH_FLASH_PAGE_SIZE, (unsigned)BENCH_FLASH_IO_SIZE,
+           (unsigned)BENCH_SPLIT_WRITE_US);
+    for (size_t i = 0; i < ARRAY_SIZE(bench_split_case_arr); i++) {
+        bench_split_run(part, &bench_split_case_arr[i]);
+    }
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_split_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_split_run(const xf_fal_partition_t *part, const bench_split_case_t *c)
+{
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    uint64_t t0;
+    uint64_t t = 0;
+    size_t err = 0;
+    size_t mismatch = 0;
+    size_t offset;
+
+    bench_flash_reset_stat();
+    for (size_t i = 0; i < BENCH_SPLIT_OPS; i++) {
+        offset = i * BENCH_FLASH_SECTOR_SIZE;
+        xf_fal_partition_erase(part, offset, BENCH_FLASH_SECTOR_SIZE);
+
+        bench_flash_set_delay(0, BENCH_SPLIT_WRITE_US, 0);
+        t0 = bench_now_ns();
+        if (XF_OK != xf_fal_partition_write(part, offset + c->offset, s_src, c->size)) {
+            err++;
+        }
+        t += bench_now_ns() - t0;
+        bench_flash_set_delay(0, 0, 0);
+
+        xf_fal_partition_read(part, offset + c->offset, s_dst, c->size);
+        if (0 != memcmp(s_src, s_dst, c->size)) {
+            mismatch++;
+        }
+    }
+
+    printf("offset=%-2u size=%-5u %8.1f KiB/s driver_write=%5.1f/op rmw_read=%4.1f/op "
+           "violation=%u err=%u mismatch=%u\n",
+           (unsigned)c->offset, (unsigned)c->size,
+           (double)c->size * BENCH_SPLIT_OPS / 1024.0 / ((double)t / 1e9),
+           (double)stat->write_cnt / BENCH_SPLIT_OPS,
+           (double)stat->read_cnt / BENCH_SPLIT_OPS - 1.0,
+           (unsigned)stat->write_violation_cnt, (unsigned)err, (unsigned)mismatch);
+}
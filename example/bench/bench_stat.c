@@ -0,0 +1,147 @@
+/**
+ * @file bench_stat.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 读写擦统计基准：小块读取在不统计、只计数、计数 + 计时下的 CPU 开销。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_STAT_OPS                  (1000000)
+#define BENCH_STAT_READ_SIZE            (16)
+#define BENCH_STAT_PART_LEN             (64 * 1024)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static double bench_stat_run(const xf_fal_handle_t *handle);
+#if XF_FAL_STAT_ENABLE
+static uint32_t bench_stat_clock_us(void);
+static void bench_stat_show(const xf_fal_partition_t *part);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_stat_table[] = {
+    {"cfg",     BENCH_FLASH1_NAME,  0,                      BENCH_STAT_PART_LEN},
+    {"log",     BENCH_FLASH2_NAME,  0,                      BENCH_STAT_PART_LEN},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_stat(void)
+{
+    const xf_fal_partition_t *part;
+    xf_fal_handle_t handle;
+    uint8_t buf[BENCH_FLASH_SECTOR_SIZE];
+    double ns_op;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_stat_table, ARRAY_SIZE(bench_stat_table));
+    xf_fal_init();
+
+    part = xf_fal_partition_find("cfg");
+    xf_fal_partition_get_handle(part, &handle);
+
+    ns_op = bench_stat_run(&handle);
+#if XF_FAL_STAT_ENABLE
+    printf("%u x %u-byte reads, stat count only: %6.1f ns/op\n",
+           (unsigned)BENCH_STAT_OPS, (unsigned)BENCH_STAT_READ_SIZE, ns_op);
+    xf_fal_stat_set_clock(bench_stat_clock_us);
+    ns_op = bench_stat_run(&handle);
+    printf("%u x %u-byte reads, count + clock:  %6.1f ns/op\n",
+           (unsigned)BENCH_STAT_OPS, (unsigned)BENCH_STAT_READ_SIZE, ns_op);
+#else
+    printf("%u x %u-byte reads, stat disabled:  %6.1f ns/op\n",
+           (unsigned)BENCH_STAT_OPS, (unsigned)BENCH_STAT_READ_SIZE, ns_op);
+#endif
+
+    /* 混合负载，用于查看统计输出 */
+    memset(buf, 0x5A, sizeof(buf));
+    for (size_t i = 0; i < 4; i++) {
+        xf_fal_partition_erase(xf_fal_partition_find("log"), i * sizeof(buf), sizeof(buf));
+        xf_fal_partition_write(xf_fal_partition_find("log"), i * sizeof(buf), buf, sizeof(buf));
+    }
+    xf_fal_write_buffer_flush(NULL);
+    for (size_t i = 0; i < 64; i++) {
+        xf_fal_partition_read(xf_fal_partition_find("log"), i * 256, buf, 256);
+    }
+#if XF_FAL_STAT_ENABLE
+    bench_stat_show(part);
+    xf_fal_stat_set_clock(NULL);
+#endif
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_stat_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static double bench_stat_run(const xf_fal_handle_t *handle)
+{
+    uint8_t buf[BENCH_STAT_READ_SIZE];
+    uint64_t t0;
+    uint64_t t1;
+    size_t err = 0;
+
+#if XF_FAL_STAT_ENABLE
+    xf_fal_stat_reset();
+#endif
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_STAT_OPS; i++) {
+        if (XF_OK != xf_fal_handle_read(handle, (i * 64) % 4096, buf, sizeof(buf))) {
+            err++;
+        }
+    }
+    t1 = bench_now_ns();
+    if (err) {
+        printf("err=%u\n", (unsigned)err);
+    }
+
+    return (double)(t1 - t0) / BENCH_STAT_OPS;
+}
+
+#if XF_FAL_STAT_ENABLE
+
+static uint32_t bench_stat_clock_us(void)
+{
+    return (uint32_t)(bench_now_ns() / 1000);
+}
+
+static void bench_stat_show(const xf_fal_partition_t *part)
+{
+    const xf_fal_stat_op_t *op_stat;
+    xf_fal_stat_t stat;
+
+    if (XF_OK != xf_fal_partition_get_stat(part, &stat)) {
+        printf("partition(%s) has no stat slot\n", part->name);
+        return;
+    }
+    op_stat = &stat.op[XF_FAL_OP_READ];
+    printf("%s read: cnt=%u (expect %u) bytes=%u err=%u, latency histogram (us):",
+           part->name, (unsigned)op_stat->cnt, (unsigned)BENCH_STAT_OPS,
+           (unsigned)op_stat->bytes, (unsigned)op_stat->err_cnt);
+    for (size_t i = 0; i < XF_FAL_STAT_HIST_NUM; i++) {
+        if (op_stat->hist[i]) {
+            printf(" [<%u]=%u", 1u << i, (unsigned)op_stat->hist[i]);
+        }
+    }
+    printf("\n");
+    xf_fal_show_stat();
+}
+
+#endif // XF_FAL_STAT_ENABLE
@@ -0,0 +1,149 @@
+/**
+ * @file bench_static.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 编译期分区表基准：与运行时注册的同一张分区表对比初始化校验耗时和按 ID 访问的耗时。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "xf_fal_static.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_STATIC_CHECKS             (10000)
+#define BENCH_STATIC_READS              (1000000)
+#define BENCH_STATIC_READ_SIZE          (16)
+
+#define BENCH_STATIC_DEV_LIST(X)                                                    \
+    X(bench_flash1_dev, BENCH_FLASH1_NAME,  BENCH_FLASH_LEN)                        \
+    X(bench_flash2_dev, BENCH_FLASH2_NAME,  BENCH_FLASH_LEN)
+
+#define BENCH_STATIC_PART_LIST(X)                                                   \
+    X(BENCH_PART_BOOT,      "s_boot",       bench_flash1_dev,   0x000000,   0x010000)   \
+    X(BENCH_PART_APP_A,     "s_app_a",      bench_flash1_dev,   0x010000,   0x100000)   \
+    X(BENCH_PART_APP_B,     "s_app_b",      bench_flash1_dev,   0x110000,   0x100000)   \
+    X(BENCH_PART_NVS,       "s_nvs",        bench_flash1_dev,   0x210000,   0x008000)   \
+    X(BENCH_PART_PHY,       "s_phy",        bench_flash1_dev,   0x218000,   0x001000)   \
+    X(BENCH_PART_OTADATA,   "s_otadata",    bench_flash1_dev,   0x219000,   0x002000)   \
+    X(BENCH_PART_COREDUMP,  "s_coredump",   bench_flash1_dev,   0x21B000,   0x010000)   \
+    X(BENCH_PART_FACTORY,   "s_factory",    bench_flash1_dev,   0x22B000,   0x100000)   \
+    X(BENCH_PART_LOG,       "s_log",        bench_flash2_dev,   0x000000,   0x200000)   \
+    X(BENCH_PART_KV,        "s_kv",         bench_flash2_dev,   0x200000,   0x010000)   \
+    X(BENCH_PART_ASSET,     "s_asset",      bench_flash2_dev,   0x210000,   0x400000)   \
+    X(BENCH_PART_SPARE,     "s_spare",      bench_flash2_dev,   0x610000,   0x1F0000)
+
+/* ==================== [Typedefs] ========================================== */
+
+XF_FAL_STATIC_TABLE_DECLARE(bench_static, BENCH_STATIC_DEV_LIST, BENCH_STATIC_PART_LIST);
+
+/* ==================== [Static Prototypes] ================================= */
+
+static double bench_static_check_us(void);
+
+/* ==================== [Static Variables] ================================== */
+
+/* 与编译期分区表内容相同的运行时分区表，作为对照组 */
+static xf_fal_partition_t bench_static_rt_table[XF_FAL_STATIC_PART_NUM(bench_static)];
+static uint8_t s_bench_static_buf[BENCH_STATIC_READ_SIZE];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+XF_FAL_STATIC_TABLE_DEFINE(bench_static, BENCH_STATIC_DEV_LIST, BENCH_STATIC_PART_LIST);
+
+void bench_static(void)
+{
+    const size_t part_num = XF_FAL_STATIC_PART_NUM(bench_static);
+    const xf_fal_partition_t *part;
+    xf_err_t xf_ret;
+    size_t err = 0;
+    double check_rt;
+    double check_static;
+    uint64_t t0;
+    uint64_t t_find;
+    uint64_t t_part;
+    uint64_t t_static;
+
+    xf_ret = bench_static_register();
+    if (xf_ret != XF_OK) {
+        printf("bench_static_register failed: %d\n", (int)xf_ret);
+        return;
+    }
+    for (size_t i = 0; i < part_num; i++) {
+        bench_static_rt_table[i] = *XF_FAL_STATIC_HANDLE(bench_static, i)->partition;
+    }
+
+    /* 初始化时的分区校验和缓存构建：运行时分区表 vs 不注册分区表 */
+    xf_fal_register_partition_table(bench_static_rt_table, part_num);
+    xf_fal_init();
+    check_rt = bench_static_check_us();
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_static_rt_table);
+    xf_fal_init();
+    check_static = bench_static_check_us();
+    xf_fal_deinit();
+    printf("%u partitions, init-time check: runtime table %7.3f us, static table %7.3f us\n",
+           (unsigned)part_num, check_rt, check_static);
+    printf("  runtime cache entries %u, static handle table %u bytes (const)\n",
+           (unsigned)part_num, (unsigned)sizeof(bench_static_handle));
+
+    /* 16 字节读取：按名查找 + 读 / 预先查找的分区 + 读 / 按 ID 取句柄 + 读 */
+    xf_fal_register_partition_table(bench_static_rt_table, part_num);
+    xf_fal_init();
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_STATIC_READS; i++) {
+        part = xf_fal_partition_find(bench_static_rt_table[i % part_num].name);
+        err += (XF_OK != xf_fal_partition_read(part, 0, s_bench_static_buf,
+                                               BENCH_STATIC_READ_SIZE));
+    }
+    t_find = bench_now_ns() - t0;
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_STATIC_READS; i++) {
+        part = &bench_static_rt_table[i % part_num];
+        err += (XF_OK != xf_fal_partition_read(part, 0, s_bench_static_buf,
+                                               BENCH_STATIC_READ_SIZE));
+    }
+    t_part = bench_now_ns() - t0;
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_STATIC_READS; i++) {
+        err += (XF_OK != xf_fal_handle_read(XF_FAL_STATIC_HANDLE(bench_static, i % part_num),
+                                            0, s_bench_static_buf, BENCH_STATIC_READ_SIZE));
+    }
+    t_static = bench_now_ns() - t0;
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_static_rt_table);
+
+    printf("%u B reads, ns/op:\n", (unsigned)BENCH_STATIC_READ_SIZE);
+    printf("  find by name + partition_read  %7.1f\n", (double)t_find / BENCH_STATIC_READS);
+    printf("  partition pointer + read       %7.1f\n", (double)t_part / BENCH_STATIC_READS);
+    printf("  static handle by id + read     %7.1f\n", (double)t_static / BENCH_STATIC_READS);
+    printf("  err=%u\n", (unsigned)err);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief xf_fal_check_and_update_cache() 的平均耗时，单位: us.
+ */
+static double bench_static_check_us(void)
+{
+    uint64_t t0;
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_STATIC_CHECKS; i++) {
+        xf_fal_check_and_update_cache();
+    }
+    return (double)(bench_now_ns() - t0) / BENCH_STATIC_CHECKS / 1e3;
+}
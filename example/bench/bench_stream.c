@@ -0,0 +1,120 @@
+/**
+ * @file bench_stream.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 流式写入基准：整区擦除 + 逐块写入 vs. xf_fal_stream_t.
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "xf_fal_stream.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_STREAM_PART_LEN           (1024 * 1024)
+#define BENCH_STREAM_IMAGE_LEN          (BENCH_STREAM_PART_LEN - 1000)
+#define BENCH_STREAM_CHUNK_SIZE         (1460)      /*!< 模拟 TCP 报文段 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_stream_report(const char *name, uint64_t first_us, uint64_t t);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_stream_table[] = {
+    {"download", BENCH_FLASH1_NAME,  0,          BENCH_STREAM_PART_LEN},
+};
+
+static uint8_t bench_stream_image[BENCH_STREAM_IMAGE_LEN];
+static uint8_t bench_stream_chk[BENCH_STREAM_IMAGE_LEN];
+static const xf_fal_partition_t *bench_stream_part;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_stream(void)
+{
+    static const size_t erase_step_arr[] = {BENCH_FLASH_SECTOR_SIZE, 64 * 1024};
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    xf_fal_stream_t stream;
+    uint64_t first_us;
+    uint64_t t0;
+    size_t len;
+    char name[48];
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_stream_table, ARRAY_SIZE(bench_stream_table));
+    xf_fal_init();
+
+    bench_stream_part = xf_fal_partition_find("download");
+    for (size_t i = 0; i < sizeof(bench_stream_image); i++) {
+        bench_stream_image[i] = (uint8_t)(i * 13 + (i >> 11));
+    }
+
+    /* 先擦除整个分区再逐块写入 */
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    xf_fal_partition_erase_all(bench_stream_part);
+    first_us = stat->erase_model_us;
+    for (size_t off = 0; off < BENCH_STREAM_IMAGE_LEN; off += len) {
+        len = BENCH_STREAM_IMAGE_LEN - off;
+        len = (len < BENCH_STREAM_CHUNK_SIZE) ? len : BENCH_STREAM_CHUNK_SIZE;
+        xf_fal_partition_write(bench_stream_part, off, &bench_stream_image[off], len);
+    }
+    bench_stream_report("erase_all + write", first_us, bench_now_ns() - t0);
+
+    /* 流式写入，分别按扇区和 64 KiB 擦除 */
+    for (size_t i = 0; i < ARRAY_SIZE(erase_step_arr); i++) {
+        bench_flash_reset_stat();
+        first_us = 0;
+        t0 = bench_now_ns();
+        xf_fal_stream_open(&stream, bench_stream_part, 0);
+        stream.erase_step = erase_step_arr[i];
+        for (size_t off = 0; off < BENCH_STREAM_IMAGE_LEN; off += len) {
+            len = BENCH_STREAM_IMAGE_LEN - off;
+            len = (len < BENCH_STREAM_CHUNK_SIZE) ? len : BENCH_STREAM_CHUNK_SIZE;
+            xf_fal_stream_write(&stream, &bench_stream_image[off], len);
+            if (0 == off) {
+                first_us = stat->erase_model_us;
+            }
+        }
+        xf_fal_stream_finish(&stream, NULL);
+        snprintf(name, sizeof(name), "stream erase_step=%uK",
+                 (unsigned)(erase_step_arr[i] / 1024));
+        bench_stream_report(name, first_us, bench_now_ns() - t0);
+    }
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_stream_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_stream_report(const char *name, uint64_t first_us, uint64_t t)
+{
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    bench_flash_stat_t s = *stat;
+
+    memset(bench_stream_chk, 0, sizeof(bench_stream_chk));
+    xf_fal_partition_read(bench_stream_part, 0, bench_stream_chk, BENCH_STREAM_IMAGE_LEN);
+
+    printf("%-22s first chunk after %7.1f ms erase | total erase %7.1f ms (%3u calls) "
+           "| %4u write %3u read | cpu %7.2f MiB/s | %s\n",
+           name, (double)first_us / 1000.0,
+           (double)s.erase_model_us / 1000.0, (unsigned)s.erase_cnt,
+           (unsigned)s.write_cnt, (unsigned)s.read_cnt,
+           (double)BENCH_STREAM_IMAGE_LEN / (1024.0 * 1024.0) / ((double)t / 1e9),
+           memcmp(bench_stream_chk, bench_stream_image, BENCH_STREAM_IMAGE_LEN)
+           ? "MISMATCH" : "ok");
+}
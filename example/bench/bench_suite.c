@@ -0,0 +1,244 @@
+/**
+ * @file bench_suite.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 标准基准套件：固定的工作负载，以 CSV 输出吞吐和 p50/p99 延迟，便于跨版本对比。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_SUITE_FIND_PART_NUM       (64)
+#define BENCH_SUITE_DATA_LEN            (1024 * 1024)
+#define BENCH_SUITE_COPY_SIZE           (64 * 1024)
+#define BENCH_SUITE_SAMPLE_MAX          (20000)
+#define BENCH_SUITE_SEED                (0x2545F491u)
+
+#ifdef __OPTIMIZE__
+#define BENCH_SUITE_BUILD               "optimized"
+#else
+#define BENCH_SUITE_BUILD               "unoptimized"
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 一项工作负载。
+ *
+ * 每个样本连续执行 batch 次 run() 并计时，延迟取样本耗时 / batch.
+ * 单次操作很短时（查找、小块读）用 batch 摊薄计时本身的开销。
+ */
+typedef struct _bench_suite_workload_t {
+    const char *name;
+    size_t samples;
+    size_t batch;
+    size_t bytes_per_op;                /*!< 每次操作读写的字节数，0 表示不计 MB/s */
+    void (*setup)(void);                /*!< 计时前的准备，可为 NULL */
+    void (*run)(size_t i);
+} bench_suite_workload_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_suite_run(const bench_suite_workload_t *p_wl);
+static int bench_suite_cmp_u64(const void *a, const void *b);
+static uint32_t bench_suite_rand(void);
+static void bench_suite_erase_dst(void);
+static void bench_suite_find(size_t i);
+static void bench_suite_read_small(size_t i);
+static void bench_suite_write_seq(size_t i);
+static void bench_suite_erase_program(size_t i);
+static void bench_suite_copy(size_t i);
+
+/* ==================== [Static Variables] ================================== */
+
+static char s_bench_suite_name[BENCH_SUITE_FIND_PART_NUM][XF_FAL_DEV_NAME_MAX];
+static xf_fal_partition_t s_bench_suite_table[BENCH_SUITE_FIND_PART_NUM + 2];
+static const xf_fal_partition_t *s_bench_suite_src;
+static const xf_fal_partition_t *s_bench_suite_dst;
+static uint64_t s_bench_suite_sample[BENCH_SUITE_SAMPLE_MAX];
+static uint8_t s_bench_suite_buf[BENCH_FLASH_SECTOR_SIZE];
+static uint32_t s_bench_suite_rand_state;
+static size_t s_bench_suite_miss;
+
+static const bench_suite_workload_t s_bench_suite_workload[] = {
+    {"find",            20000,  64, 0,                          NULL,                   bench_suite_find},
+    {"read_16B_rand",   20000,  16, 16,                         NULL,                   bench_suite_read_small},
+    {"write_256B_seq",  BENCH_SUITE_DATA_LEN / BENCH_FLASH_PAGE_SIZE,
+                                1,  BENCH_FLASH_PAGE_SIZE,      bench_suite_erase_dst,  bench_suite_write_seq},
+    {"erase_program_4K",BENCH_SUITE_DATA_LEN / BENCH_FLASH_SECTOR_SIZE,
+                                1,  BENCH_FLASH_SECTOR_SIZE,    NULL,                   bench_suite_erase_program},
+    {"copy_64K_xdev",   256,    1,  BENCH_SUITE_COPY_SIZE,      bench_suite_erase_dst,  bench_suite_copy},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_suite(void)
+{
+    size_t idx = 0;
+
+    bench_flash_register_devices();
+    bench_flash_set_delay(0, 0, 0);
+
+    /* flash1: 64 个 4 KiB 查找用分区 + 1 MiB 源数据分区; flash2: 1 MiB 目标分区 */
+    for (; idx < BENCH_SUITE_FIND_PART_NUM; idx++) {
+        snprintf(s_bench_suite_name[idx], XF_FAL_DEV_NAME_MAX, "suite_%02u", (unsigned)idx);
+        s_bench_suite_table[idx] = (xf_fal_partition_t) {
+            s_bench_suite_name[idx], BENCH_FLASH1_NAME,
+            idx * BENCH_FLASH_SECTOR_SIZE, BENCH_FLASH_SECTOR_SIZE
+        };
+    }
+    s_bench_suite_table[idx++] = (xf_fal_partition_t) {
+        "suite_src", BENCH_FLASH1_NAME, BENCH_SUITE_DATA_LEN, BENCH_SUITE_DATA_LEN
+    };
+    s_bench_suite_table[idx++] = (xf_fal_partition_t) {
+        "suite_dst", BENCH_FLASH2_NAME, 0, BENCH_SUITE_DATA_LEN
+    };
+    xf_fal_register_partition_table(s_bench_suite_table, idx);
+    xf_fal_init();
+    s_bench_suite_src = xf_fal_partition_find("suite_src");
+    s_bench_suite_dst = xf_fal_partition_find("suite_dst");
+
+    /* 源数据固定，保证各版本读写的内容相同 */
+    s_bench_suite_rand_state = BENCH_SUITE_SEED;
+    xf_fal_partition_erase(s_bench_suite_src, 0, BENCH_SUITE_DATA_LEN);
+    for (size_t off = 0; off < BENCH_SUITE_DATA_LEN; off += sizeof(s_bench_suite_buf)) {
+        for (size_t i = 0; i < sizeof(s_bench_suite_buf); i += 4) {
+            uint32_t v = bench_suite_rand();
+            memcpy(&s_bench_suite_buf[i], &v, 4);
+        }
+        xf_fal_partition_write(s_bench_suite_src, off, s_bench_suite_buf,
+                               sizeof(s_bench_suite_buf));
+    }
+
+    printf("# xf_fal %s, %s build\n", XF_FAL_SW_VERSION, BENCH_SUITE_BUILD);
+    printf("workload,ops,bytes_per_op,ops_per_s,mb_per_s,p50_ns,p99_ns\n");
+    s_bench_suite_miss = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(s_bench_suite_workload); i++) {
+        s_bench_suite_rand_state = BENCH_SUITE_SEED;
+        bench_suite_run(&s_bench_suite_workload[i]);
+    }
+    if (0 != s_bench_suite_miss) {
+        printf("# errors=%u\n", (unsigned)s_bench_suite_miss);
+    }
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(s_bench_suite_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_suite_run(const bench_suite_workload_t *p_wl)
+{
+    uint64_t total_ns = 0;
+    uint64_t t0;
+    size_t ops;
+    size_t p50;
+    size_t p99;
+
+    if (p_wl->setup) {
+        p_wl->setup();
+    }
+    for (size_t s = 0; s < p_wl->samples; s++) {
+        t0 = bench_now_ns();
+        for (size_t b = 0; b < p_wl->batch; b++) {
+            p_wl->run(s * p_wl->batch + b);
+        }
+        s_bench_suite_sample[s] = bench_now_ns() - t0;
+        total_ns += s_bench_suite_sample[s];
+    }
+    qsort(s_bench_suite_sample, p_wl->samples, sizeof(s_bench_suite_sample[0]),
+          bench_suite_cmp_u64);
+
+    ops = p_wl->samples * p_wl->batch;
+    p50 = p_wl->samples / 2;
+    p99 = p_wl->samples * 99 / 100;
+    printf("%s,%u,%u,%.0f,%.2f,%.1f,%.1f\n", p_wl->name, (unsigned)ops,
+           (unsigned)p_wl->bytes_per_op,
+           ops / (total_ns / 1e9),
+           (double)ops * p_wl->bytes_per_op / 1e6 / (total_ns / 1e9),
+           (double)s_bench_suite_sample[p50] / p_wl->batch,
+           (double)s_bench_suite_sample[p99] / p_wl->batch);
+}
+
+static int bench_suite_cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t bench_suite_rand(void)
+{
+    uint32_t x = s_bench_suite_rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_bench_suite_rand_state = x;
+    return x;
+}
+
+static void bench_suite_erase_dst(void)
+{
+    xf_fal_partition_erase(s_bench_suite_dst, 0, BENCH_SUITE_DATA_LEN);
+}
+
+static void bench_suite_find(size_t i)
+{
+    /* 按固定步长遍历所有分区名，避免总是命中表头 */
+    if (NULL == xf_fal_partition_find(s_bench_suite_name[(i * 7) % BENCH_SUITE_FIND_PART_NUM])) {
+        s_bench_suite_miss++;
+    }
+}
+
+static void bench_suite_read_small(size_t i)
+{
+    size_t off = bench_suite_rand() % (BENCH_SUITE_DATA_LEN - 16);
+    (void)i;
+    s_bench_suite_miss += (XF_OK != xf_fal_partition_read(s_bench_suite_src, off,
+                                                          s_bench_suite_buf, 16));
+}
+
+static void bench_suite_write_seq(size_t i)
+{
+    s_bench_suite_miss += (XF_OK != xf_fal_partition_write(s_bench_suite_dst,
+                                                           i * BENCH_FLASH_PAGE_SIZE,
+                                                           s_bench_suite_buf,
+                                                           BENCH_FLASH_PAGE_SIZE));
+}
+
+static void bench_suite_erase_program(size_t i)
+{
+    size_t off = i * BENCH_FLASH_SECTOR_SIZE;
+
+    s_bench_suite_miss += (XF_OK != xf_fal_partition_erase(s_bench_suite_dst, off,
+                                                           BENCH_FLASH_SECTOR_SIZE));
+    s_bench_suite_miss += (XF_OK != xf_fal_partition_write(s_bench_suite_dst, off,
+                                                           s_bench_suite_buf,
+                                                           BENCH_FLASH_SECTOR_SIZE));
+}
+
+/**
+ * @brief flash1 -> flash2 复制 64 KiB, 在 1 MiB 范围内循环；
+ *        重复写入相同数据对 NOR flash 无副作用，因此只在开始前擦除一次。
+ */
+static void bench_suite_copy(size_t i)
+{
+    size_t off = (i * BENCH_SUITE_COPY_SIZE) % BENCH_SUITE_DATA_LEN;
+
+    s_bench_suite_miss += (XF_OK != xf_fal_partition_copy(s_bench_suite_src, off,
+                                                          s_bench_suite_dst, off,
+                                                          BENCH_SUITE_COPY_SIZE));
+}
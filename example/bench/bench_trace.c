@@ -0,0 +1,160 @@
+/**
+ * @file bench_trace.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 操作跟踪基准：小块读取的跟踪开销，以及卡住时导出正在进行的操作。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_TRACE_OPS                 (1000000)
+#define BENCH_TRACE_READ_SIZE           (16)
+#define BENCH_TRACE_PART_LEN            (256 * 1024)
+#define BENCH_TRACE_STALL_US            (200 * 1000)    /*!< 模拟卡住的擦除耗时 */
+#define BENCH_TRACE_DUMP_PATH           "xf_fal_trace.bin"
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static double bench_trace_run(const xf_fal_handle_t *handle);
+#if XF_FAL_TRACE_ENABLE
+static uint32_t bench_trace_clock_us(void);
+static void *bench_trace_stall_worker(void *arg);
+static xf_err_t bench_trace_write_file(void *user_data, const void *data, size_t size);
+static void bench_trace_stall(void);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_trace_table[] = {
+    {"cfg",     BENCH_FLASH1_NAME,  0,                      BENCH_TRACE_PART_LEN},
+    {"data",    BENCH_FLASH2_NAME,  0,                      BENCH_TRACE_PART_LEN},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_trace(void)
+{
+    xf_fal_handle_t handle;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_trace_table, ARRAY_SIZE(bench_trace_table));
+    xf_fal_init();
+
+    xf_fal_partition_get_handle(xf_fal_partition_find("cfg"), &handle);
+#if XF_FAL_TRACE_ENABLE
+    printf("%u x %u-byte reads, trace without clock: %6.1f ns/op\n",
+           (unsigned)BENCH_TRACE_OPS, (unsigned)BENCH_TRACE_READ_SIZE, bench_trace_run(&handle));
+    xf_fal_trace_set_clock(bench_trace_clock_us);
+    printf("%u x %u-byte reads, trace with clock:    %6.1f ns/op\n",
+           (unsigned)BENCH_TRACE_OPS, (unsigned)BENCH_TRACE_READ_SIZE, bench_trace_run(&handle));
+    bench_trace_stall();
+    xf_fal_trace_set_clock(NULL);
+#else
+    printf("%u x %u-byte reads, trace disabled:      %6.1f ns/op\n",
+           (unsigned)BENCH_TRACE_OPS, (unsigned)BENCH_TRACE_READ_SIZE, bench_trace_run(&handle));
+#endif
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_trace_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static double bench_trace_run(const xf_fal_handle_t *handle)
+{
+    uint8_t buf[BENCH_TRACE_READ_SIZE];
+    uint64_t t0;
+    uint64_t t1;
+    size_t err = 0;
+
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_TRACE_OPS; i++) {
+        if (XF_OK != xf_fal_handle_read(handle, (i * 64) % 4096, buf, sizeof(buf))) {
+            err++;
+        }
+    }
+    t1 = bench_now_ns();
+    if (err) {
+        printf("err=%u\n", (unsigned)err);
+    }
+
+    return (double)(t1 - t0) / BENCH_TRACE_OPS;
+}
+
+#if XF_FAL_TRACE_ENABLE
+
+static uint32_t bench_trace_clock_us(void)
+{
+    return (uint32_t)(bench_now_ns() / 1000);
+}
+
+static void *bench_trace_stall_worker(void *arg)
+{
+    (void)arg;
+    xf_fal_partition_erase(xf_fal_partition_find("data"), 0, BENCH_FLASH_SECTOR_SIZE);
+    return NULL;
+}
+
+static xf_err_t bench_trace_write_file(void *user_data, const void *data, size_t size)
+{
+    return (1 == fwrite(data, size, 1, (FILE *)user_data)) ? XF_OK : XF_FAIL;
+}
+
+/**
+ * @brief 写入一段有规律的访问，再让另一个线程的擦除卡住，期间导出跟踪记录。
+ */
+static void bench_trace_stall(void)
+{
+    const xf_fal_partition_t *data = xf_fal_partition_find("data");
+    uint8_t buf[256];
+    pthread_t thread;
+    FILE *fp;
+    xf_err_t xf_ret;
+
+    xf_fal_trace_reset();
+    memset(buf, 0xA5, sizeof(buf));
+    xf_fal_partition_erase(data, BENCH_FLASH_SECTOR_SIZE, 4 * BENCH_FLASH_SECTOR_SIZE);
+    for (size_t i = 0; i < 16; i++) {
+        xf_fal_partition_write(data, BENCH_FLASH_SECTOR_SIZE + i * sizeof(buf), buf, sizeof(buf));
+    }
+    xf_fal_write_buffer_flush(NULL);
+    for (size_t i = 0; i < 32; i++) {
+        xf_fal_partition_read(data, BENCH_TRACE_PART_LEN - 2048 + (i % 8) * 256, buf, sizeof(buf));
+    }
+
+    bench_flash_set_delay(0, 0, BENCH_TRACE_STALL_US);
+    pthread_create(&thread, NULL, bench_trace_stall_worker, NULL);
+    usleep(BENCH_TRACE_STALL_US / 4);
+
+    fp = fopen(BENCH_TRACE_DUMP_PATH, "wb");
+    xf_ret = (fp) ? xf_fal_trace_dump(bench_trace_write_file, fp) : XF_FAIL;
+    if (fp) {
+        fclose(fp);
+    }
+
+    pthread_join(thread, NULL);
+    bench_flash_set_delay(0, 0, 0);
+    printf("dumped %u records during a stalled erase to %s (%s), decode with:\n"
+           "  trace_decode %s\n",
+           (unsigned)XF_FAL_TRACE_NUM, BENCH_TRACE_DUMP_PATH,
+           (XF_OK == xf_ret) ? "ok" : "FAILED", BENCH_TRACE_DUMP_PATH);
+}
+
+#endif // XF_FAL_TRACE_ENABLE
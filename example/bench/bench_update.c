@@ -0,0 +1,152 @@
+/**
+ * @file bench_update.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 按需更新基准：擦除 + 写入 vs. xf_fal_partition_update().
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_UPDATE_PART_LEN           (16 * 1024)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 新内容相对旧内容的变化方式。
+ */
+typedef enum _bench_update_case_t {
+    BENCH_UPDATE_SAME = 0,              /*!< 内容不变 */
+    BENCH_UPDATE_CLEAR_BITS,            /*!< 少量字节只有 1 变 0 (如清除标志位) */
+    BENCH_UPDATE_ONE_SECTOR,            /*!< 一个扇区内有 0 变 1 */
+    BENCH_UPDATE_ALL,                   /*!< 全部内容更换 */
+    BENCH_UPDATE_MAX,
+} bench_update_case_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_update_make(uint8_t *buf, bench_update_case_t c);
+static void bench_update_run(const xf_fal_partition_t *part, bench_update_case_t c);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_update_table[] = {
+    {"config",  BENCH_FLASH1_NAME,  0,          BENCH_UPDATE_PART_LEN},
+};
+
+static const char *const bench_update_case_name[BENCH_UPDATE_MAX] = {
+    "same", "clear_bits", "one_sector", "all",
+};
+
+static uint8_t bench_update_old[BENCH_UPDATE_PART_LEN];
+static uint8_t bench_update_new[BENCH_UPDATE_PART_LEN];
+static uint8_t bench_update_chk[BENCH_UPDATE_PART_LEN];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_update(void)
+{
+    const xf_fal_partition_t *part;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_update_table, ARRAY_SIZE(bench_update_table));
+    xf_fal_init();
+
+    part = xf_fal_partition_find("config");
+    for (size_t i = 0; i < sizeof(bench_update_old); i++) {
+        bench_update_old[i] = (uint8_t)(i * 131 + 7);
+    }
+    for (size_t c = 0; c < BENCH_UPDATE_MAX; c++) {
+        bench_update_run(part, (bench_update_case_t)c);
+    }
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_update_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void bench_update_make(uint8_t *buf, bench_update_case_t c)
+{
+    memcpy(buf, bench_update_old, BENCH_UPDATE_PART_LEN);
+    switch (c) {
+    case BENCH_UPDATE_CLEAR_BITS:
+        /* 分散在两个扇区的 3 个字节清零（旧值均非 0） */
+        buf[100]    = 0;
+        buf[101]    = 0;
+        buf[9000]   = 0;
+        break;
+    case BENCH_UPDATE_ONE_SECTOR:
+        buf[5000]   = (uint8_t)~bench_update_old[5000];
+        break;
+    case BENCH_UPDATE_ALL:
+        for (size_t i = 0; i < BENCH_UPDATE_PART_LEN; i++) {
+            buf[i] = (uint8_t)~bench_update_old[i];
+        }
+        break;
+    case BENCH_UPDATE_SAME:
+    default:
+        break;
+    }
+}
+
+static void bench_update_run(const xf_fal_partition_t *part, bench_update_case_t c)
+{
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    xf_fal_update_result_t result;
+    bench_flash_stat_t plain;
+    bench_flash_stat_t smart;
+    uint64_t t0;
+    uint64_t t;
+    size_t err = 0;
+
+    bench_update_make(bench_update_new, c);
+
+    /* 擦除 + 写入 */
+    xf_fal_partition_erase_all(part);
+    xf_fal_partition_write(part, 0, bench_update_old, BENCH_UPDATE_PART_LEN);
+    bench_flash_reset_stat();
+    xf_fal_partition_erase_all(part);
+    xf_fal_partition_write(part, 0, bench_update_new, BENCH_UPDATE_PART_LEN);
+    plain = *stat;
+
+    /* 按需更新 */
+    xf_fal_partition_erase_all(part);
+    xf_fal_partition_write(part, 0, bench_update_old, BENCH_UPDATE_PART_LEN);
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    if (XF_OK != xf_fal_partition_update(part, 0, bench_update_new,
+                                         BENCH_UPDATE_PART_LEN, &result)) {
+        err++;
+    }
+    t = bench_now_ns() - t0;
+    smart = *stat;
+
+    xf_fal_partition_read(part, 0, bench_update_chk, BENCH_UPDATE_PART_LEN);
+    if (0 != memcmp(bench_update_chk, bench_update_new, BENCH_UPDATE_PART_LEN)) {
+        err++;
+    }
+
+    printf("%-10s plain: %2u erase %3u write %7.1f ms | update: skipped=%2u programmed=%2u "
+           "erased=%u, %u erase %2u write %7.1f ms (+%6.1f us, %u KiB read) err=%u\n",
+           bench_update_case_name[c],
+           (unsigned)plain.erase_cnt, (unsigned)plain.write_cnt,
+           (double)plain.erase_model_us / 1000.0,
+           (unsigned)result.skipped_page_num, (unsigned)result.programmed_page_num,
+           (unsigned)result.erased_sector_num,
+           (unsigned)smart.erase_cnt, (unsigned)smart.write_cnt,
+           (double)smart.erase_model_us / 1000.0,
+           (double)t / 1000.0, (unsigned)(smart.read_bytes / 1024), (unsigned)err);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file bench_vec.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 记录写入基准：多次写 vs. 拼接后写 vs. xf_fal_partition_writev().
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_VEC_OPS                   (200000)
+
+#define BENCH_VEC_HDR_SIZE              (8)
+#define BENCH_VEC_PAYLOAD_SIZE          (48)
+#define BENCH_VEC_CRC_SIZE              (4)
+#define BENCH_VEC_REC_SIZE              (BENCH_VEC_HDR_SIZE \
+                                            + BENCH_VEC_PAYLOAD_SIZE \
+                                            + BENCH_VEC_CRC_SIZE)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef enum _bench_vec_mode_t {
+    BENCH_VEC_MODE_MULTI = 0,   /*!< 每个字段调用一次 xf_fal_partition_write */
+    BENCH_VEC_MODE_STAGE,       /*!< memcpy 到临时缓冲区后写一次 */
+    BENCH_VEC_MODE_WRITEV,      /*!< xf_fal_partition_writev */
+    BENCH_VEC_MODE_MAX,
+} bench_vec_mode_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void bench_vec_run(const xf_fal_partition_t *part, bench_vec_mode_t mode);
+static bool bench_vec_verify(const xf_fal_partition_t *part);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_vec_table[] = {
+    {"log",     BENCH_FLASH1_NAME,  0,          1024 * 1024},
+};
+
+static const char *const bench_vec_mode_name[BENCH_VEC_MODE_MAX] = {
+    "multi write", "stage+write", "writev",
+};
+
+static uint8_t s_hdr[BENCH_VEC_HDR_SIZE];
+static uint8_t s_payload[BENCH_VEC_PAYLOAD_SIZE];
+static uint8_t s_crc[BENCH_VEC_CRC_SIZE];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_vec(void)
+{
+    const xf_fal_partition_t *part;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_vec_table, ARRAY_SIZE(bench_vec_table));
+    xf_fal_init();
+
+    part = xf_fal_partition_find("log");
+    for (size_t i = 0; i < sizeof(s_hdr); i++) {
+        s_hdr[i] = (uint8_t)(0xA0 + i);
+    }
+    for (size_t i = 0; i < sizeof(s_payload); i++) {
+        s_payload[i] = (uint8_t)i;
+    }
+    for (size_t i = 0; i < sizeof(s_crc); i++) {
+        s_crc[i] = (uint8_t)(0xC0 + i);
+    }
+
+    printf("record=%u bytes (hdr %u + payload %u + crc %u)\n",
+           (unsigned)BENCH_VEC_REC_SIZE, (unsigned)BENCH_VEC_HDR_SIZE,
+           (unsigned)BENCH_VEC_PAYLOAD_SIZE, (unsigned)BENCH_VEC_CRC_SIZE);
+    for (size_t i = 0; i < BENCH_VEC_MODE_MAX; i++) {
+        bench_vec_run(part, (bench_vec_mode_t)i);
+    }
+    printf("writev verify: %s\n", bench_vec_verify(part) ? "ok" : "FAILED");
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_vec_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_err_t bench_vec_write_record(
+    const xf_fal_partition_t *part, size_t offset, bench_vec_mode_t mode)
+{
+    xf_err_t xf_ret = XF_OK;
+    uint8_t stage[BENCH_VEC_REC_SIZE];
+    const xf_fal_iovec_t iov[] = {
+        {s_hdr,     sizeof(s_hdr)},
+        {s_payload, sizeof(s_payload)},
+        {s_crc,     sizeof(s_crc)},
+    };
+
+    switch (mode) {
+    case BENCH_VEC_MODE_MULTI:
+        xf_ret |= xf_fal_partition_write(part, offset, s_hdr, sizeof(s_hdr));
+        offset += sizeof(s_hdr);
+        xf_ret |= xf_fal_partition_write(part, offset, s_payload, sizeof(s_payload));
+        offset += sizeof(s_payload);
+        xf_ret |= xf_fal_partition_write(part, offset, s_crc, sizeof(s_crc));
+        break;
+    case BENCH_VEC_MODE_STAGE:
+        memcpy(&stage[0], s_hdr, sizeof(s_hdr));
+        memcpy(&stage[sizeof(s_hdr)], s_payload, sizeof(s_payload));
+        memcpy(&stage[sizeof(s_hdr) + sizeof(s_payload)], s_crc, sizeof(s_crc));
+        xf_ret = xf_fal_partition_write(part, offset, stage, sizeof(stage));
+        break;
+    case BENCH_VEC_MODE_WRITEV:
+    default:
+        xf_ret = xf_fal_partition_writev(part, offset, iov, ARRAY_SIZE(iov));
+        break;
+    }
+
+    return xf_ret;
+}
+
+static void bench_vec_run(const xf_fal_partition_t *part, bench_vec_mode_t mode)
+{
+    const size_t rec_num = part->len / BENCH_VEC_REC_SIZE;
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    uint64_t t0;
+    uint64_t t;
+    size_t err = 0;
+
+    bench_flash_reset_stat();
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_VEC_OPS; i++) {
+        if (XF_OK != bench_vec_write_record(
+                    part, (i % rec_num) * BENCH_VEC_REC_SIZE, mode)) {
+            err++;
+        }
+    }
+    t = bench_now_ns() - t0;
+
+    printf("%-12s %6.1f ns/record driver_write=%.2f/record err=%u\n",
+           bench_vec_mode_name[mode],
+           (double)t / BENCH_VEC_OPS,
+           (double)stat->write_cnt / BENCH_VEC_OPS,
+           (unsigned)err);
+}
+
+static bool bench_vec_verify(const xf_fal_partition_t *part)
+{
+    uint8_t hdr[BENCH_VEC_HDR_SIZE];
+    uint8_t payload[BENCH_VEC_PAYLOAD_SIZE];
+    uint8_t crc[BENCH_VEC_CRC_SIZE];
+    const xf_fal_iovec_t iov[] = {
+        {hdr,       sizeof(hdr)},
+        {payload,   sizeof(payload)},
+        {crc,       sizeof(crc)},
+    };
+    /* 跨页边界的记录 */
+    const size_t offset = BENCH_FLASH_PAGE_SIZE - BENCH_VEC_HDR_SIZE / 2;
+
+    xf_fal_partition_erase(part, 0, BENCH_FLASH_SECTOR_SIZE);
+    if (XF_OK != bench_vec_write_record(part, offset, BENCH_VEC_MODE_WRITEV)) {
+        return false;
+    }
+    if (XF_OK != xf_fal_partition_readv(part, offset, iov, ARRAY_SIZE(iov))) {
+        return false;
+    }
+
+    return (0 == memcmp(hdr, s_hdr, sizeof(hdr)))
+           && (0 == memcmp(payload, s_payload, sizeof(payload)))
+           && (0 == memcmp(crc, s_crc, sizeof(crc)));
+}
@@ -0,0 +1,144 @@
+/**
+ * @file bench_wbuf.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 写缓冲基准：小记录顺序追加，直接写入 vs. 分区写缓冲。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+#if XF_FAL_WRITE_BUFFER_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_WBUF_LOG_LEN              (64 * 1024)
+#define BENCH_WBUF_REC_MIN              (8)
+#define BENCH_WBUF_REC_MAX              (32)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static size_t bench_wbuf_run(const xf_fal_partition_t *part,
+                             size_t *p_len, size_t *p_err, size_t *p_ryw_err);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_fal_partition_t bench_wbuf_table[] = {
+    {"log",     BENCH_FLASH1_NAME,  0,          BENCH_WBUF_LOG_LEN},
+};
+
+static xf_fal_write_buffer_t s_wbuf;
+static uint8_t s_shadow[BENCH_WBUF_LOG_LEN];
+static uint8_t s_readback[BENCH_WBUF_LOG_LEN];
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_wbuf(void)
+{
+    const xf_fal_partition_t *part;
+    bench_flash_stat_t *stat = bench_flash_get_stat(0);
+    size_t rec_num;
+    size_t len;
+    size_t direct_cnt;
+    size_t err = 0;
+    size_t ryw_err = 0;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_wbuf_table, ARRAY_SIZE(bench_wbuf_table));
+    xf_fal_init();
+    part = xf_fal_partition_find("log");
+
+    rec_num     = bench_wbuf_run(part, &len, &err, &ryw_err);
+    direct_cnt  = stat->write_cnt;
+
+    xf_fal_write_buffer_attach(part, &s_wbuf);
+    bench_wbuf_run(part, &len, &err, &ryw_err);
+    xf_fal_write_buffer_detach(part);
+
+    /* 刷新后 flash 上的内容应与追加的数据一致 */
+    xf_fal_partition_read(part, 0, s_readback, len);
+
+    printf("records=%u (%u~%u bytes) page=%u: direct %u programs (%.2f/record) | "
+           "buffered %u programs (%.2f/record) reduction=%.1fx\n",
+           (unsigned)rec_num, BENCH_WBUF_REC_MIN, BENCH_WBUF_REC_MAX,
+           (unsigned)BENCH_FLASH_PAGE_SIZE,
+           (unsigned)direct_cnt, (double)direct_cnt / rec_num,
+           (unsigned)stat->write_cnt, (double)stat->write_cnt / rec_num,
+           (double)direct_cnt / stat->write_cnt);
+    printf("read-your-writes errors=%u, flash content after flush: %s, err=%u\n",
+           (unsigned)ryw_err,
+           (0 == memcmp(s_shadow, s_readback, len)) ? "ok" : "MISMATCH",
+           (unsigned)err);
+
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_wbuf_table);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 擦除分区后顺序追加随机长度的记录，直到写满。
+ *
+ * 每次追加后读回刚写入的记录，检查能否读到尚在写缓冲中的数据。
+ *
+ * @param[out] p_len 追加的总长度。
+ * @return size_t 追加的记录数。
+ */
+static size_t bench_wbuf_run(const xf_fal_partition_t *part,
+                             size_t *p_len, size_t *p_err, size_t *p_ryw_err)
+{
+    uint8_t rec[BENCH_WBUF_REC_MAX];
+    uint8_t buf[BENCH_WBUF_REC_MAX];
+    uint32_t state = 1;
+    size_t offset = 0;
+    size_t rec_num = 0;
+    size_t len;
+
+    xf_fal_partition_erase_all(part);
+    bench_flash_reset_stat();
+    while (1) {
+        state   = state * 1103515245u + 12345u;
+        len     = BENCH_WBUF_REC_MIN + (state >> 8) % (BENCH_WBUF_REC_MAX - BENCH_WBUF_REC_MIN + 1);
+        if (offset + len > part->len) {
+            break;
+        }
+        for (size_t i = 0; i < len; i++) {
+            rec[i] = (uint8_t)(state >> (i % 24));
+        }
+        if (XF_OK != xf_fal_partition_write(part, offset, rec, len)) {
+            (*p_err)++;
+        }
+        memcpy(&s_shadow[offset], rec, len);
+
+        xf_fal_partition_read(part, offset, buf, len);
+        if (0 != memcmp(buf, rec, len)) {
+            (*p_ryw_err)++;
+        }
+        offset += len;
+        rec_num++;
+    }
+    *p_len = offset;
+
+    return rec_num;
+}
+
+#else
+
+void bench_wbuf(void)
+{
+    printf("XF_FAL_WRITE_BUFFER_ENABLE is 0, skipped.\n");
+}
+
+#endif // XF_FAL_WRITE_BUFFER_ENABLE
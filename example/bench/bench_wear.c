@@ -0,0 +1,188 @@
+/**
+ * @file bench_wear.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 擦除次数统计基准：偏斜的擦除负载下，增量日志与整表重写的持久化开销对比。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "xf_fal_wear.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_WEAR_ERASES               (20000)
+#define BENCH_WEAR_SYNC_EVERY           (256)       /*!< 每多少次擦除持久化一次 */
+#define BENCH_WEAR_HOT_SECTORS          (4)         /*!< 配置区：频繁擦除的少数扇区 */
+#define BENCH_WEAR_HOT_PERCENT          (70)
+#define BENCH_WEAR_LOG_FIRST            (16)        /*!< 日志区：循环擦除 */
+#define BENCH_WEAR_LOG_SECTORS          (240)
+#define BENCH_WEAR_DATA_LEN             (1024 * 1024)
+#define BENCH_WEAR_META_OFFSET          (3 * 1024 * 1024)
+#define BENCH_WEAR_META_LEN             (4 * BENCH_FLASH_SECTOR_SIZE)
+#define BENCH_WEAR_TOP_NUM              (5)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+#if XF_FAL_WEAR_ENABLE
+static uint32_t bench_wear_rand(void);
+static size_t bench_wear_verify(void);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+#if XF_FAL_WEAR_ENABLE
+static const xf_fal_partition_t bench_wear_table[] = {
+    {"data",    BENCH_FLASH1_NAME,  0,                      BENCH_WEAR_DATA_LEN},
+    {"wear",    BENCH_FLASH2_NAME,  BENCH_WEAR_META_OFFSET, BENCH_WEAR_META_LEN},
+};
+static uint32_t s_bench_wear_seed = 0x12345678;
+static uint32_t s_bench_wear_cnt[BENCH_FLASH_NUM][BENCH_FLASH_LEN / BENCH_FLASH_SECTOR_SIZE];
+#endif
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+#if XF_FAL_WEAR_ENABLE
+
+void bench_wear(void)
+{
+    const xf_fal_partition_t *data;
+    const xf_fal_partition_t *meta;
+    xf_fal_wear_hot_t hot[BENCH_WEAR_TOP_NUM];
+    bench_flash_stat_t stat;
+    size_t sync_num = 0;
+    size_t sector;
+    size_t hot_num;
+    size_t naive_bytes;
+    size_t naive_erases;
+    uint64_t sync_ns = 0;
+    uint64_t t0;
+    xf_err_t xf_ret;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_wear_table, ARRAY_SIZE(bench_wear_table));
+    xf_fal_init();
+
+    data = xf_fal_partition_find("data");
+    meta = xf_fal_partition_find("wear");
+    xf_fal_partition_erase(meta, 0, BENCH_WEAR_META_LEN);
+    xf_ret = xf_fal_wear_init(meta);
+    if (xf_ret != XF_OK) {
+        printf("xf_fal_wear_init failed: %d\n", (int)xf_ret);
+        goto l_end;
+    }
+
+    bench_flash_reset_stat();
+    for (size_t i = 0; i < BENCH_WEAR_ERASES; i++) {
+        if (bench_wear_rand() % 100 < BENCH_WEAR_HOT_PERCENT) {
+            sector = bench_wear_rand() % BENCH_WEAR_HOT_SECTORS;
+        } else {
+            sector = BENCH_WEAR_LOG_FIRST + i % BENCH_WEAR_LOG_SECTORS;
+        }
+        xf_fal_partition_erase(data, sector * BENCH_FLASH_SECTOR_SIZE, BENCH_FLASH_SECTOR_SIZE);
+        if (0 == (i + 1) % BENCH_WEAR_SYNC_EVERY) {
+            t0 = bench_now_ns();
+            xf_fal_wear_sync();
+            sync_ns += bench_now_ns() - t0;
+            sync_num++;
+        }
+    }
+    t0 = bench_now_ns();
+    xf_fal_wear_sync();
+    sync_ns += bench_now_ns() - t0;
+    sync_num++;
+    stat = *bench_flash_get_stat(1);
+
+    /* 对比：每次持久化把整张计数表（每扇区 4 字节）重写到一个扇区里 */
+    naive_bytes     = 2 * (BENCH_FLASH_LEN / BENCH_FLASH_SECTOR_SIZE) * sizeof(uint32_t);
+    naive_erases    = (naive_bytes + BENCH_FLASH_SECTOR_SIZE - 1) / BENCH_FLASH_SECTOR_SIZE;
+    printf("%u erases, %u syncs (%.1f us/sync):\n",
+           (unsigned)BENCH_WEAR_ERASES, (unsigned)sync_num, (double)sync_ns / sync_num / 1000.0);
+    printf("  delta log:          %6u meta erases, %9u bytes written\n",
+           (unsigned)stat.erase_cnt, (unsigned)stat.write_bytes);
+    printf("  full-table rewrite: %6u meta erases, %9u bytes written\n",
+           (unsigned)(naive_erases * sync_num), (unsigned)(naive_bytes * sync_num));
+
+    hot_num = xf_fal_wear_get_hot(hot, ARRAY_SIZE(hot));
+    printf("hottest sectors:\n");
+    for (size_t i = 0; i < hot_num; i++) {
+        printf("  %s sector %4u: %u\n", hot[i].flash_dev->name,
+               (unsigned)hot[i].sector, (unsigned)hot[i].erase_cnt);
+    }
+    printf("counts after reload: %s\n", (0 == bench_wear_verify()) ? "match" : "MISMATCH");
+    xf_fal_show_wear(64);
+
+    xf_fal_wear_deinit();
+l_end:
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_wear_table);
+}
+
+#else
+
+void bench_wear(void)
+{
+    printf("XF_FAL_WEAR_ENABLE is 0, skipped.\n");
+}
+
+#endif // XF_FAL_WEAR_ENABLE
+
+/* ==================== [Static Functions] ================================== */
+
+#if XF_FAL_WEAR_ENABLE
+
+static uint32_t bench_wear_rand(void)
+{
+    /* xorshift32, 每次运行结果相同 */
+    s_bench_wear_seed ^= s_bench_wear_seed << 13;
+    s_bench_wear_seed ^= s_bench_wear_seed >> 17;
+    s_bench_wear_seed ^= s_bench_wear_seed << 5;
+    return s_bench_wear_seed;
+}
+
+/**
+ * @brief 模拟重启：记下内存中的计数，重新初始化后从元数据分区加载并比较。
+ *
+ * @return size_t 不一致的扇区数。
+ */
+static size_t bench_wear_verify(void)
+{
+    const size_t sector_num = BENCH_FLASH_LEN / BENCH_FLASH_SECTOR_SIZE;
+    size_t mismatch = 0;
+    uint32_t cnt;
+
+    for (size_t d = 0; d < BENCH_FLASH_NUM; d++) {
+        for (size_t i = 0; i < sector_num; i++) {
+            xf_fal_wear_get_count(bench_flash_get_dev(d), i, &s_bench_wear_cnt[d][i]);
+        }
+    }
+    xf_fal_wear_deinit();
+    if (XF_OK != xf_fal_wear_init(xf_fal_partition_find("wear"))) {
+        return sector_num * BENCH_FLASH_NUM;
+    }
+    for (size_t d = 0; d < BENCH_FLASH_NUM; d++) {
+        for (size_t i = 0; i < sector_num; i++) {
+            cnt = 0;
+            xf_fal_wear_get_count(bench_flash_get_dev(d), i, &cnt);
+            if (cnt != s_bench_wear_cnt[d][i]) {
+                mismatch++;
+            }
+        }
+    }
+
+    return mismatch;
+}
+
+#endif // XF_FAL_WEAR_ENABLE
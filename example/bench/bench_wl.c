@@ -0,0 +1,199 @@
+/**
+ * @file bench_wl.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 磨损均衡基准：少数扇区反复擦写时，直接使用分区与经磨损均衡设备的最大擦除次数对比。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "xf_fal_wl.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_WL_DEV_NAME               "bench_wl"
+#define BENCH_WL_REWRITES               (20000)
+#define BENCH_WL_LOGICAL_NUM            (16)    /*!< 逻辑扇区数，同 easyflash 环境变量区 */
+#define BENCH_WL_HOT_NUM                (2)     /*!< 反复擦写的扇区数 */
+#define BENCH_WL_PHYS_NUM               (2 + 64)    /*!< 物理分区扇区数（含 2 个日志扇区） */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+#if XF_FAL_WL_ENABLE
+static double bench_wl_run(const xf_fal_partition_t *part, uint32_t *p_cnt);
+static size_t bench_wl_verify(const xf_fal_partition_t *part);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+#if XF_FAL_WL_ENABLE
+static const xf_fal_partition_t bench_wl_table[] = {
+    {"wl_phys", BENCH_FLASH1_NAME,  0,  BENCH_WL_PHYS_NUM * BENCH_FLASH_SECTOR_SIZE},
+    {"env_raw", BENCH_FLASH2_NAME,  0,  BENCH_WL_LOGICAL_NUM * BENCH_FLASH_SECTOR_SIZE},
+    {"env",     BENCH_WL_DEV_NAME,  0,  BENCH_WL_LOGICAL_NUM * BENCH_FLASH_SECTOR_SIZE},
+};
+static uint8_t s_bench_wl_gen[BENCH_WL_LOGICAL_NUM];
+static uint8_t s_bench_wl_buf[BENCH_FLASH_SECTOR_SIZE];
+#endif
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+#if XF_FAL_WL_ENABLE
+
+void bench_wl(void)
+{
+    const xf_fal_partition_t *raw;
+    const xf_fal_partition_t *env;
+    uint32_t raw_cnt[BENCH_WL_LOGICAL_NUM];
+    uint32_t raw_max = 0;
+    xf_fal_wl_stat_t stat;
+    double raw_us;
+    double wl_us;
+    xf_err_t xf_ret;
+
+    bench_flash_register_devices();
+    xf_fal_register_partition_table(bench_wl_table, ARRAY_SIZE(bench_wl_table));
+    xf_fal_init();
+
+    /* 从空白的物理分区开始 */
+    xf_fal_partition_erase(xf_fal_partition_find("wl_phys"), 0,
+                           BENCH_WL_PHYS_NUM * BENCH_FLASH_SECTOR_SIZE);
+    xf_ret = xf_fal_wl_init(BENCH_WL_DEV_NAME, xf_fal_partition_find("wl_phys"),
+                            BENCH_WL_LOGICAL_NUM * BENCH_FLASH_SECTOR_SIZE);
+    if (xf_ret != XF_OK) {
+        printf("xf_fal_wl_init failed: %d\n", (int)xf_ret);
+        goto l_end;
+    }
+    raw = xf_fal_partition_find("env_raw");
+    env = xf_fal_partition_find("env");
+
+    raw_us = bench_wl_run(raw, raw_cnt);
+    for (size_t i = 0; i < BENCH_WL_LOGICAL_NUM; i++) {
+        raw_max = (raw_cnt[i] > raw_max) ? raw_cnt[i] : raw_max;
+    }
+    wl_us = bench_wl_run(env, NULL);
+    xf_fal_wl_get_stat(BENCH_WL_DEV_NAME, &stat);
+
+    printf("%u rewrites of %u hot sectors in %u (+%u cold):\n",
+           (unsigned)BENCH_WL_REWRITES, (unsigned)BENCH_WL_HOT_NUM,
+           (unsigned)BENCH_WL_LOGICAL_NUM, (unsigned)(BENCH_WL_LOGICAL_NUM - BENCH_WL_HOT_NUM));
+    printf("  direct:        max erase %6u                        %6.2f us/rewrite\n",
+           (unsigned)raw_max, raw_us);
+    printf("  wear-leveled:  max erase %6u  min %4u  (%u data sectors) %6.2f us/rewrite"
+           "  journal erases=%u\n",
+           (unsigned)stat.erase_max, (unsigned)stat.erase_min, (unsigned)stat.sector_num, wl_us,
+           (unsigned)stat.journal_erase);
+    printf("  max erase reduced %.1fx\n",
+           (stat.erase_max) ? (double)raw_max / stat.erase_max : 0.0);
+
+    /* 模拟重启：重新加载映射后内容不变 */
+    printf("data check: %s", (0 == bench_wl_verify(env)) ? "ok" : "MISMATCH");
+    xf_fal_wl_deinit(BENCH_WL_DEV_NAME);
+    xf_fal_wl_init(BENCH_WL_DEV_NAME, xf_fal_partition_find("wl_phys"),
+                   BENCH_WL_LOGICAL_NUM * BENCH_FLASH_SECTOR_SIZE);
+    printf(", after reload: %s\n",
+           (0 == bench_wl_verify(xf_fal_partition_find("env"))) ? "ok" : "MISMATCH");
+
+    xf_fal_wl_deinit(BENCH_WL_DEV_NAME);
+l_end:
+    xf_fal_deinit();
+    xf_fal_unregister_partition_table(bench_wl_table);
+}
+
+#else
+
+void bench_wl(void)
+{
+    printf("XF_FAL_WL_ENABLE is 0, skipped.\n");
+}
+
+#endif // XF_FAL_WL_ENABLE
+
+/* ==================== [Static Functions] ================================== */
+
+#if XF_FAL_WL_ENABLE
+
+/**
+ * @brief 先写满所有扇区，再反复擦写热扇区（擦除 + 写满整个扇区）。
+ *
+ * @param[out] p_cnt 各扇区的擦除次数，NULL 时不统计。
+ * @return double 每次擦写的平均耗时，单位: us.
+ */
+static double bench_wl_run(const xf_fal_partition_t *part, uint32_t *p_cnt)
+{
+    const size_t sector_size = BENCH_FLASH_SECTOR_SIZE;
+    size_t err = 0;
+    size_t sector;
+    uint64_t t0;
+    uint64_t t1 = 0;
+
+    if (p_cnt) {
+        memset(p_cnt, 0, BENCH_WL_LOGICAL_NUM * sizeof(uint32_t));
+    }
+    memset(s_bench_wl_gen, 0, sizeof(s_bench_wl_gen));
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < BENCH_WL_LOGICAL_NUM + BENCH_WL_REWRITES; i++) {
+        if (BENCH_WL_LOGICAL_NUM == i) {
+            t0 = bench_now_ns();
+        }
+        sector = (i < BENCH_WL_LOGICAL_NUM) ? i : (i % BENCH_WL_HOT_NUM);
+        s_bench_wl_gen[sector]++;
+        memset(s_bench_wl_buf, (uint8_t)(sector * 31 + s_bench_wl_gen[sector]), sector_size);
+        if ((XF_OK != xf_fal_partition_erase(part, sector * sector_size, sector_size))
+                || (XF_OK != xf_fal_partition_write(part, sector * sector_size,
+                                                    s_bench_wl_buf, sector_size))) {
+            err++;
+        }
+        if (p_cnt) {
+            p_cnt[sector]++;
+        }
+    }
+    t1 = bench_now_ns();
+    if (err) {
+        printf("err=%u\n", (unsigned)err);
+    }
+
+    return (double)(t1 - t0) / BENCH_WL_REWRITES / 1000.0;
+}
+
+/**
+ * @brief 检查各逻辑扇区的内容是否为最后一次写入的数据。
+ *
+ * @return size_t 内容不符的扇区数。
+ */
+static size_t bench_wl_verify(const xf_fal_partition_t *part)
+{
+    const size_t sector_size = BENCH_FLASH_SECTOR_SIZE;
+    size_t mismatch = 0;
+    uint8_t expect;
+
+    for (size_t i = 0; i < BENCH_WL_LOGICAL_NUM; i++) {
+        expect = (uint8_t)(i * 31 + s_bench_wl_gen[i]);
+        if (XF_OK != xf_fal_partition_read(part, i * sector_size, s_bench_wl_buf, sector_size)) {
+            mismatch++;
+            continue;
+        }
+        for (size_t k = 0; k < sector_size; k++) {
+            if (s_bench_wl_buf[k] != expect) {
+                mismatch++;
+                break;
+            }
+        }
+    }
+
+    return mismatch;
+}
+
+#endif // XF_FAL_WL_ENABLE
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} bench_case_t;
+
+static const bench_case_t bench_case_table[] = {
+    {"find",        bench_find},
+    {"handle",      bench_handle},
+    {"snapshot",    bench_snapshot},
+    {"devlock",     bench_devlock},
+    {"async",       bench_async},
+    {"vec",         bench_vec},
+    {"split",       bench_split},
+    {"erase",       bench_erase},
+    {"blank",       bench_blank},
+    {"rcache",      bench_rcache},
+    {"wbuf",        bench_wbuf},
+    {"update",      bench_update},
+    {"copy",        bench_copy},
+    {"stream",      bench_stream},
+    {"crc",         bench_crc},
+    {"stat",        bench_stat},
+    {"trace",       bench_trace},
+    {"wear",        bench_wear},
+    {"wl",          bench_wl},
+    {"kv",          bench_kv},
+    {"ring",        bench_ring},
+    {"file",        bench_file},
+    {"sim",         bench_sim},
+    {"suite",       bench_suite},
+    {"static",      bench_static},
+};
+
+int main(int argc, char *argv[])
+{
+    /* 不带参数时运行全部用例，否则只运行指定名称的用例 */
+    for (size_t i = 0; i < ARRAY_SIZE(bench_case_table); i++) {
+        if ((argc > 1) && (0 != strcmp(argv[1], bench_case_table[i].name))) {
+            continue;
+        }
+        printf("==== bench: %s ====\n", bench_case_table[i].name);
+        bench_case_table[i].run();
+    }
+
+    return 0;
+}
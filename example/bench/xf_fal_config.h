@@ -0,0 +1,70 @@
+/**
+ * @file xf_fal_config.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_CONFIG_H__
+#define __XF_FAL_CONFIG_H__
+
+/* ==================== [Includes] ========================================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_FAL_LOCK_DISABLE 0
+#define XF_FAL_FLASH_DEVICE_NUM 4
+#define XF_FAL_PARTITION_TABLE_NUM 8
+#define XF_FAL_DEV_NAME_MAX 24
+#define XF_FAL_CACHE_NUM 320
+#define XF_FAL_HASH_INDEX_NUM 1024
+#define XF_FAL_ASYNC_ENABLE 1
+#define XF_FAL_READ_CACHE_NUM 16
+#define XF_FAL_READ_CACHE_LINE_SIZE 256
+#define XF_FAL_WRITE_BUFFER_ENABLE 1
+#define XF_FAL_COPY_BUF_SIZE 4096
+#define XF_FAL_HASH_BUF_SIZE 4096
+#define XF_FAL_UPDATE_SECTOR_BUF_SIZE 4096
+#ifndef XF_FAL_STAT_ENABLE
+#define XF_FAL_STAT_ENABLE 1
+#endif
+#ifndef XF_FAL_TRACE_ENABLE
+#define XF_FAL_TRACE_ENABLE 1
+#endif
+#ifndef XF_FAL_WEAR_ENABLE
+#define XF_FAL_WEAR_ENABLE 1
+#endif
+#define XF_FAL_WEAR_SECTOR_NUM 4096
+#ifndef XF_FAL_WL_ENABLE
+#define XF_FAL_WL_ENABLE 1
+#endif
+#ifndef XF_FAL_FILE_ENABLE
+#define XF_FAL_FILE_ENABLE 1
+#endif
+#ifndef XF_FAL_SIM_ENABLE
+#define XF_FAL_SIM_ENABLE 1
+#endif
+#define XF_FAL_DEFAULT_FLASH_DEVICE_NAME    "chip_flash"
+#define XF_FAL_DEFAULT_PARTITION_NAME       "storage"
+#define XF_FAL_DEFAULT_PARTITION_OFFSET     0
+#define XF_FAL_DEFAULT_PARTITION_LENGTH     4096
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __XF_FAL_CONFIG_H__
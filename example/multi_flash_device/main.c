@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include "xf_fal.h"
+#include "xf_fal_sim.h"
 #include "mock_flash.h"
 
 const char *partition_name_arr[] = {
@@ -73,5 +74,10 @@ int main(void)
         }
     }
 
+#if XF_FAL_SIM_ENABLE
+    /* 以上操作在真实 SPI NOR 上所需的时间 */
+    xf_fal_show_sim();
+#endif
+
     return 0;
 }
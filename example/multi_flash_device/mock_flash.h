@@ -38,23 +38,23 @@ extern "C" {
 
 #define MOCK_FLASH1_PART_TABLE1                                         \
     {                                                                   \
-        {"bl1",         MOCK_FLASH1_NAME,   0,          64        },    \
-        {"app1",        MOCK_FLASH1_NAME,   64,         1024 * 10 },    \
-        {"easyflash1",  MOCK_FLASH1_NAME,   1024 * 10,  1024 * 20 },    \
-        {"download1",   MOCK_FLASH1_NAME,   1024 * 20,  1024 * 40 },    \
+        {"bl1",         MOCK_FLASH1_NAME,   0,          1024 * 4  },    \
+        {"app1",        MOCK_FLASH1_NAME,   1024 * 4,   1024 * 12 },    \
+        {"easyflash1",  MOCK_FLASH1_NAME,   1024 * 16,  1024 * 20 },    \
+        {"download1",   MOCK_FLASH1_NAME,   1024 * 36,  1024 * 40 },    \
     }
 
 #define MOCK_FLASH1_PART_TABLE2                                         \
     {                                                                   \
-        {"storage1",    MOCK_FLASH1_NAME,   1024 * 40,  1024 * 40 },    \
+        {"storage1",    MOCK_FLASH1_NAME,   1024 * 76,  1024 * 40 },    \
     }
 
 #define MOCK_FLASH2_PART_TABLE                                          \
     {                                                                   \
-        {"bl2",         MOCK_FLASH2_NAME,   0,          64        },   \
-        {"app2",        MOCK_FLASH2_NAME,   64,         1024 * 10 },   \
-        {"easyflash2",  MOCK_FLASH2_NAME,   1024 * 10,  1024 * 20 },   \
-        {"download2",   MOCK_FLASH2_NAME,   1024 * 20,  1024 * 40 },   \
+        {"bl2",         MOCK_FLASH2_NAME,   0,          1024 * 4  },   \
+        {"app2",        MOCK_FLASH2_NAME,   1024 * 4,   1024 * 12 },   \
+        {"easyflash2",  MOCK_FLASH2_NAME,   1024 * 16,  1024 * 20 },   \
+        {"download2",   MOCK_FLASH2_NAME,   1024 * 36,  1024 * 40 },   \
     }
 
 /* ==================== [Typedefs] ========================================== */
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xf_fal.h"
+#include "xf_fal_stream.h"
+#include "xf_fal_sim.h"
+#include "mock_flash.h"
+
+#define IMAGE_SIZE      (200 * 1024 + 123)
+#define CHUNK_SIZE_MAX  (1460)  /* 模拟 TCP 报文段 */
+
+static uint8_t image[IMAGE_SIZE];
+static uint8_t read_buf[IMAGE_SIZE];
+
+int main(void)
+{
+    /* 注册 xf_fal */
+    mock_flash_register_to_xf_fal();
+
+    xf_fal_stream_t stream;
+    uint32_t crc32;
+    size_t chunk;
+    size_t received = 0;
+    xf_err_t xf_ret;
+
+    /* 初始化 FAL */
+    xf_ret = xf_fal_init();
+    if (xf_ret != XF_OK) {
+        printf("FAL init failed: %d\n", xf_ret);
+        return -1;
+    }
+
+    /* 打印分区表 */
+    xf_fal_show_part_table();
+
+    /* 获取下载分区 */
+    const xf_fal_partition_t *part = xf_fal_partition_find("download");
+    if (!part) {
+        printf("Partition not found!\n");
+        return -1;
+    }
+
+    /* 模拟待下载的镜像 */
+    for (size_t i = 0; i < sizeof(image); i++) {
+        image[i] = (uint8_t)rand();
+    }
+
+    /*
+        开始流式写入
+        不需要事先擦除整个分区，每个扇区在第一次写入前才擦除
+     */
+    xf_ret = xf_fal_stream_open(&stream, part, 0);
+    if (xf_ret != XF_OK) {
+        printf("Stream open failed: %d\n", xf_ret);
+        return -1;
+    }
+
+    /* 按网络收到的任意大小数据块写入 */
+    while (received < sizeof(image)) {
+        chunk = 1 + (size_t)rand() % CHUNK_SIZE_MAX;
+        if (chunk > sizeof(image) - received) {
+            chunk = sizeof(image) - received;
+        }
+        xf_ret = xf_fal_stream_write(&stream, &image[received], chunk);
+        if (xf_ret != XF_OK) {
+            printf("Stream write failed: %d\n", xf_ret);
+            return -1;
+        }
+        if (0 == received) {
+            printf("First chunk written, %u sector(s) erased.\n",
+                   (unsigned)mock_flash_get_erase_cnt());
+        }
+        received += chunk;
+    }
+
+    /* 写入剩余数据并得到镜像的 CRC-32 */
+    xf_ret = xf_fal_stream_finish(&stream, &crc32);
+    if (xf_ret != XF_OK) {
+        printf("Stream finish failed: %d\n", xf_ret);
+        return -1;
+    }
+    printf("Received %u bytes, CRC-32: 0x%08X, %u sector(s) erased.\n",
+           (unsigned)xf_fal_stream_get_size(&stream), (unsigned)crc32,
+           (unsigned)mock_flash_get_erase_cnt());
+
+    /* 读回校验 */
+    xf_ret = xf_fal_partition_read(part, 0, read_buf, sizeof(read_buf));
+    if ((xf_ret != XF_OK) || (0 != memcmp(read_buf, image, sizeof(image)))) {
+        printf("Verify failed!\n");
+        return -1;
+    }
+    printf("Verify successful!\n");
+
+#if XF_FAL_SIM_ENABLE
+    /* 以上操作在真实 SPI NOR 上所需的时间 */
+    xf_fal_show_sim();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file mock_flash.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-12-10
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __MOCK_FLASH_H__
+#define __MOCK_FLASH_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define MOCK_FLASH_NAME                 "mock_flash"
+#define MOCK_FLASH_START_ADDR           (0)
+#define MOCK_FLASH_LEN                  (8 * 1024 * 1024)
+#define MOCK_FLASH_SECTOR_SIZE          (4 * 1024)
+#define MOCK_FLASH_PAGE_SIZE            (256)
+#define MOCK_FLASH_IO_SIZE              (1)
+
+#define MOCK_FLASH_PART_TABLE                                           \
+    {                                                                   \
+        {"bl",          MOCK_FLASH_NAME,   0,          1024 * 16 },     \
+        {"app",         MOCK_FLASH_NAME,   1024 * 16,  1024 * 496},     \
+        {"download",    MOCK_FLASH_NAME,   1024 * 512, 1024 * 512},     \
+    }
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+void mock_flash_register_to_xf_fal(void);
+
+/**
+ * @brief 获取驱动擦除调用次数。
+ */
+size_t mock_flash_get_erase_cnt(void);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __MOCK_FLASH_H__
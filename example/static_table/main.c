@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include "xf_fal.h"
+#include "mock_flash.h"
+
+int main(void)
+{
+    uint8_t read_buf[16] = {0};
+    uint8_t write_buf[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const xf_fal_handle_t *handle;
+    xf_err_t xf_ret;
+
+    /* 只注册 flash 设备，分区表在编译期生成，无需注册 */
+    xf_ret = part_register();
+    if (xf_ret != XF_OK) {
+        printf("Flash device register failed: %d\n", xf_ret);
+        return -1;
+    }
+
+    xf_ret = xf_fal_init();
+    if (xf_ret != XF_OK) {
+        printf("FAL init failed: %d\n", xf_ret);
+        return -1;
+    }
+
+    /* 打印编译期分区表 */
+    for (size_t i = 0; i < XF_FAL_STATIC_PART_NUM(part); i++) {
+        handle = XF_FAL_STATIC_HANDLE(part, i);
+        printf("[%u] %-10s %s 0x%08x 0x%08x\n", (unsigned)i,
+               handle->partition->name, handle->flash_dev->name,
+               (unsigned)handle->base, (unsigned)handle->len);
+    }
+
+    /* 通过分区 ID 直接取得句柄，无需按名查找 */
+    handle = XF_FAL_STATIC_HANDLE(part, PART_EASYFLASH);
+
+    xf_ret = xf_fal_handle_erase(handle, 0, handle->flash_dev->sector_size);
+    if (xf_ret != XF_OK) {
+        printf("Partition erase failed: %d\n", xf_ret);
+        return -1;
+    }
+
+    xf_ret = xf_fal_handle_write(handle, 0, write_buf, sizeof(write_buf));
+    if (xf_ret != XF_OK) {
+        printf("Partition write failed: %d\n", xf_ret);
+        return -1;
+    }
+
+    xf_ret = xf_fal_handle_read(handle, 0, read_buf, sizeof(read_buf));
+    if (xf_ret == XF_OK) {
+        printf("Partition read successful! Data: ");
+        for (size_t i = 0; i < sizeof(read_buf); i++) {
+            printf("%02X ", read_buf[i]);
+        }
+        printf("\n");
+    } else {
+        printf("Partition read failed: %d\n", xf_ret);
+    }
+
+    /* 越界访问仍在运行时检查 */
+    xf_ret = xf_fal_handle_read(handle, handle->len, read_buf, 1);
+    printf("Out of bound read: %d\n", xf_ret);
+
+    xf_fal_deinit();
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file mock_flash.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "xf_fal.h"
+#include "mock_flash.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/**
+ * @name mock_flash_ops
+ * @brief mock_flash 的操作。
+ * @{
+ */
+static xf_err_t mock_flash_init(void);
+static xf_err_t mock_flash_deinit(void);
+static xf_err_t mock_flash_read(size_t src_offset, void *dst, size_t size);
+static xf_err_t mock_flash_write(size_t dst_offset, const void *src, size_t size);
+static xf_err_t mock_flash_erase(size_t offset, size_t size);
+/**
+ * End of mock_flash_ops
+ * @}
+ */
+
+/* ==================== [Static Variables] ================================== */
+
+/**
+ * @brief 用于模拟 flash 的内存。
+ */
+static uint8_t mock_flash_memory[MOCK_FLASH_LEN] = {0};
+
+/**
+ * @brief mock flash 设备描述。
+ */
+static const xf_fal_flash_dev_t mock_flash_dev = {
+    .name           = MOCK_FLASH_NAME,
+    .addr           = MOCK_FLASH_START_ADDR,
+    .len            = MOCK_FLASH_LEN,
+    .sector_size    = MOCK_FLASH_SECTOR_SIZE,
+    .page_size      = MOCK_FLASH_PAGE_SIZE,
+    .io_size        = MOCK_FLASH_IO_SIZE,
+    .ops.init       = mock_flash_init,
+    .ops.deinit     = mock_flash_deinit,
+    .ops.read       = mock_flash_read,
+    .ops.write      = mock_flash_write,
+    .ops.erase      = mock_flash_erase,
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+/**
+ * @brief 编译期分区表：句柄表直接引用 mock_flash_dev, 因此定义在本文件中。
+ */
+XF_FAL_STATIC_TABLE_DEFINE(part, MOCK_FLASH_DEV_LIST, MOCK_FLASH_PART_LIST);
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_err_t mock_flash_init(void)
+{
+    printf("Mock flash initialized.\n");
+    memset(mock_flash_memory, 0xFF, sizeof(mock_flash_memory));
+    return XF_OK;
+}
+
+static xf_err_t mock_flash_deinit(void)
+{
+    printf("Mock flash deinitialized.\n");
+    return XF_OK;
+}
+
+static xf_err_t mock_flash_read(size_t src_offset, void *dst, size_t size)
+{
+    if (src_offset + size > sizeof(mock_flash_memory)) {
+        return XF_FAIL;
+    }
+    memcpy(dst, &mock_flash_memory[src_offset], size);
+    return XF_OK;
+}
+
+static xf_err_t mock_flash_write(size_t dst_offset, const void *src, size_t size)
+{
+    const uint8_t *src_u8 = src;
+
+    if (dst_offset + size > sizeof(mock_flash_memory)) {
+        return XF_FAIL;
+    }
+    /* 模拟 nor flash 的行为 */
+    for (size_t i = 0; i < size; i++) {
+        mock_flash_memory[dst_offset + i] &= src_u8[i];
+    }
+    return XF_OK;
+}
+
+static xf_err_t mock_flash_erase(size_t offset, size_t size)
+{
+    if (offset + size > sizeof(mock_flash_memory)) {
+        return XF_FAIL;
+    }
+    memset(&mock_flash_memory[offset], 0xFF, size);
+    return XF_OK;
+}
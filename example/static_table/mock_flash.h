@@ -0,0 +1,63 @@
+/**
+ * @file mock_flash.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __MOCK_FLASH_H__
+#define __MOCK_FLASH_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+#include "xf_fal_static.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define MOCK_FLASH_NAME                 "mock_flash"
+#define MOCK_FLASH_START_ADDR           (0)
+#define MOCK_FLASH_LEN                  (8 * 1024 * 1024)
+#define MOCK_FLASH_SECTOR_SIZE          (4 * 1024)
+#define MOCK_FLASH_PAGE_SIZE            (256)
+#define MOCK_FLASH_IO_SIZE              (1)
+
+/**
+ * @brief 编译期分区表的设备列表，见 xf_fal_static.h.
+ */
+#define MOCK_FLASH_DEV_LIST(X)                                          \
+    X(mock_flash_dev,   MOCK_FLASH_NAME,    MOCK_FLASH_LEN)
+
+/**
+ * @brief 编译期分区表的分区列表。
+ *
+ * 分区越界或重叠时编译报错，例如把 PART_APP 的长度改为 1024 * 16.
+ */
+#define MOCK_FLASH_PART_LIST(X)                                         \
+    X(PART_BL,          "bl",           mock_flash_dev, 0,          1024 * 4  ) \
+    X(PART_APP,         "app",          mock_flash_dev, 1024 * 4,   1024 * 12 ) \
+    X(PART_EASYFLASH,   "easyflash",    mock_flash_dev, 1024 * 16,  1024 * 20 ) \
+    X(PART_DOWNLOAD,    "download",     mock_flash_dev, 1024 * 36,  1024 * 40 )
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* 生成 part_id_t 枚举、part_handle[] 和 part_register() */
+XF_FAL_STATIC_TABLE_DECLARE(part, MOCK_FLASH_DEV_LIST, MOCK_FLASH_PART_LIST);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __MOCK_FLASH_H__
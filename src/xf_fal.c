@@ -13,20 +13,157 @@
 
 #include "xf_utils.h"
 #include "xf_fal.h"
+#if XF_FAL_ASYNC_ENABLE
+#include "xf_fal_async.h"
+#endif
+#if XF_FAL_WEAR_ENABLE
+#include "xf_fal_wear.h"
+#endif
 
 /* ==================== [Defines] =========================================== */
 
 #define TAG "xf_fal"
 
+/**
+ * @brief 分区间复制的缓冲区数，有异步队列时双缓冲。
+ */
+#if XF_FAL_ASYNC_ENABLE
+#   define XF_FAL_COPY_BUF_NUM          2
+#else
+#   define XF_FAL_COPY_BUF_NUM          1
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Static Prototypes] ================================= */
 
+#if XF_FAL_ASYNC_ENABLE
+static void xf_fal_dev_lock_wait_async(size_t dev_idx);
+#endif
+static xf_fal_snapshot_t *xf_fal_snapshot_begin(void);
+static void xf_fal_snapshot_publish(xf_fal_snapshot_t *next);
+static void xf_fal_snapshot_abort(void);
+static const xf_fal_flash_dev_t *xf_fal_snapshot_device_find(
+    const xf_fal_snapshot_t *snap, const char *name, size_t *p_dev_idx);
+static const xf_fal_flash_dev_t *xf_fal_part_resolve(
+    const xf_fal_partition_t *part, size_t *p_dev_idx);
+static xf_err_t xf_fal_dev_write(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const uint8_t *src, size_t size);
+static xf_err_t xf_fal_erase_align(
+    const xf_fal_handle_t *handle, size_t *p_offset, size_t *p_size);
+static size_t xf_fal_erase_step(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size);
+static xf_err_t xf_fal_dev_erase(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size);
+static xf_err_t xf_fal_dev_erase_skip_blank(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size,
+    xf_fal_erase_result_t *p_result);
+static xf_err_t xf_fal_dev_blank_check(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size, bool *p_is_blank);
+static size_t xf_fal_update_piece(const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t end);
+static xf_err_t xf_fal_update_cmp(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    bool *p_is_equal, bool *p_need_erase);
+static xf_err_t xf_fal_update_scan(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    bool *p_need_erase, size_t *p_diff_num);
+static xf_err_t xf_fal_update_sector(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    xf_fal_update_result_t *p_result);
+static xf_err_t xf_fal_update_program(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    xf_fal_update_result_t *p_result);
+#if XF_FAL_UPDATE_SECTOR_BUF_SIZE > 0
+static xf_err_t xf_fal_update_sector_rmw(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    xf_fal_update_result_t *p_result);
+#endif
+static xf_err_t xf_fal_dev_read(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx,
+    size_t addr, void *dst, size_t size);
+#if XF_FAL_READ_CACHE_NUM > 0
+static xf_err_t xf_fal_rcache_read(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx,
+    size_t addr, uint8_t *dst, size_t size);
+static void xf_fal_rcache_invalidate(size_t dev_idx, size_t addr, size_t size);
+static xf_fal_read_cache_line_t *xf_fal_rcache_lookup(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx,
+    size_t line_addr, size_t len, bool *p_is_hit);
+static uint32_t xf_fal_rcache_tick(void);
+#endif
+#if XF_FAL_WRITE_BUFFER_ENABLE
+static xf_fal_write_buffer_t *xf_fal_wbuf_find(
+    size_t dev_idx, const xf_fal_partition_t *part, xf_fal_write_buffer_t ***ppp_link);
+static xf_err_t xf_fal_wbuf_flush(xf_fal_write_buffer_t *wbuf);
+static xf_err_t xf_fal_wbuf_flush_range(
+    size_t dev_idx, size_t addr, size_t size, bool is_erase,
+    const xf_fal_write_buffer_t *skip);
+static xf_err_t xf_fal_wbuf_write(
+    const xf_fal_handle_t *handle, size_t addr, const uint8_t *src, size_t size);
+static void xf_fal_wbuf_overlay(size_t dev_idx, size_t addr, uint8_t *dst, size_t size);
+#endif
+static size_t xf_fal_iov_total(const xf_fal_iovec_t *iov, size_t iovcnt);
+static xf_err_t xf_fal_dev_readv(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt);
+static xf_err_t xf_fal_dev_writev(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt, size_t total);
+static xf_err_t xf_fal_crc32_update_cb(void *user_data, const void *data, size_t size);
+static uint32_t xf_fal_name_hash(const char *name);
+static void xf_fal_hash_index_insert(xf_fal_snapshot_t *snap, size_t cache_idx);
+static const xf_fal_cache_t *xf_fal_hash_index_find(
+    const xf_fal_snapshot_t *snap,
+    const char *name, const xf_fal_partition_t *part);
+#if XF_FAL_STAT_ENABLE
+static uint32_t xf_fal_stat_now(void);
+static size_t xf_fal_stat_bucket(uint32_t dt);
+static void xf_fal_stat_record(
+    xf_fal_stat_t *stat, xf_fal_op_t op, size_t size, xf_err_t result, uint32_t t0);
+static size_t xf_fal_stat_part_slot(const xf_fal_partition_t *part, bool is_insert);
+static xf_fal_stat_t *xf_fal_stat_part_find(const xf_fal_partition_t *part);
+static xf_fal_stat_t *xf_fal_stat_dev_find(const xf_fal_flash_dev_t *flash_dev);
+static xf_err_t xf_fal_drv_read(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, void *dst, size_t size);
+static xf_err_t xf_fal_drv_write(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const void *src, size_t size);
+static xf_err_t xf_fal_drv_erase(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size);
+static xf_err_t xf_fal_drv_readv(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt);
+static xf_err_t xf_fal_drv_writev(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt);
+#endif
+#if XF_FAL_TRACE_ENABLE
+static uint16_t xf_fal_trace_part_id(uint32_t name_hash);
+static uint32_t xf_fal_trace_begin(
+    const xf_fal_handle_t *handle, xf_fal_op_t op, size_t offset, size_t size);
+static void xf_fal_trace_end(uint32_t seq, xf_err_t result);
+#endif
+
 /* ==================== [Static Variables] ================================== */
 
-static xf_fal_ctx_t     s_fal_ctx = {0};
+static xf_fal_ctx_t     s_fal_ctx = {
+    .p_snapshot = &s_fal_ctx.snapshot[0],
+};
 static xf_fal_ctx_t    *sp_fal_ctx = &s_fal_ctx;
 #define sp_fal()        (sp_fal_ctx)
+#define sp_snap()       (sp_fal_ctx->p_snapshot)
+
+/**
+ * @brief 分区间复制的缓冲区，由 xf_fal_ctx_t.copy_mutex 保护。
+ */
+static uint8_t s_copy_buf[XF_FAL_COPY_BUF_NUM][XF_FAL_COPY_BUF_SIZE];
+
+#if XF_FAL_UPDATE_SECTOR_BUF_SIZE > 0
+/**
+ * @brief 按需更新时读-改-写扇区的缓冲区，由 xf_fal_ctx_t.update_mutex 保护。
+ */
+static uint8_t s_update_sector_buf[XF_FAL_UPDATE_SECTOR_BUF_SIZE];
+#endif
 
 /* ==================== [Macros] ============================================ */
 
@@ -68,6 +205,24 @@ static xf_fal_ctx_t    *sp_fal_ctx = &s_fal_ctx;
         sp_fal()->is_lock = true; \
     } while (0)
 
+/**
+ * @brief 阻塞地取得写者锁；只有标志位可用且已被占用时，输出提示后返回。
+ *
+ * 用于打印类接口，避免锁忙时静默地没有任何输出。
+ */
+#define XF_FAL_CTX_LOCK__LOG_ON_FAILURE(_what) \
+    do { \
+        if (sp_fal()->mutex) { \
+            xf_lock_lock(sp_fal()->mutex); \
+            break; \
+        } \
+        if (true == sp_fal()->is_lock) { \
+            XF_LOGW(TAG, "%s skipped: xf_fal is being updated.", (_what)); \
+            return; \
+        } \
+        sp_fal()->is_lock = true; \
+    } while (0)
+
 #define XF_FAL_CTX_UNLOCK() \
     do { \
         if (sp_fal()->mutex) { \
@@ -77,24 +232,256 @@ static xf_fal_ctx_t    *sp_fal_ctx = &s_fal_ctx;
         sp_fal()->is_lock = false; \
     } while (0);
 
+#define XF_FAL_DEV_MUTEX_TRY_INIT(_idx) \
+    do { \
+        if (NULL == sp_fal()->dev_mutex[_idx]) { \
+            xf_lock_init(&sp_fal()->dev_mutex[_idx]); \
+        } \
+    } while (0)
+
+#define XF_FAL_DEV_LOCK(_idx) \
+    do { \
+        if (sp_fal()->dev_mutex[_idx]) { \
+            xf_lock_lock(sp_fal()->dev_mutex[_idx]); \
+        } \
+    } while (0)
+
+#define XF_FAL_DEV_UNLOCK(_idx) \
+    do { \
+        if (sp_fal()->dev_mutex[_idx]) { \
+            xf_lock_unlock(sp_fal()->dev_mutex[_idx]); \
+        } \
+    } while (0)
+
+#define XF_FAL_RCACHE_MUTEX_TRY_INIT() \
+    do { \
+        if (NULL == sp_fal()->rcache_mutex) { \
+            xf_lock_init(&sp_fal()->rcache_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_RCACHE_LOCK() \
+    do { \
+        if (sp_fal()->rcache_mutex) { \
+            xf_lock_lock(sp_fal()->rcache_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_RCACHE_UNLOCK() \
+    do { \
+        if (sp_fal()->rcache_mutex) { \
+            xf_lock_unlock(sp_fal()->rcache_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_UPDATE_MUTEX_TRY_INIT() \
+    do { \
+        if (NULL == sp_fal()->update_mutex) { \
+            xf_lock_init(&sp_fal()->update_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_UPDATE_LOCK() \
+    do { \
+        if (sp_fal()->update_mutex) { \
+            xf_lock_lock(sp_fal()->update_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_UPDATE_UNLOCK() \
+    do { \
+        if (sp_fal()->update_mutex) { \
+            xf_lock_unlock(sp_fal()->update_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_COPY_MUTEX_TRY_INIT() \
+    do { \
+        if (NULL == sp_fal()->copy_mutex) { \
+            xf_lock_init(&sp_fal()->copy_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_COPY_LOCK() \
+    do { \
+        if (sp_fal()->copy_mutex) { \
+            xf_lock_lock(sp_fal()->copy_mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_COPY_UNLOCK() \
+    do { \
+        if (sp_fal()->copy_mutex) { \
+            xf_lock_unlock(sp_fal()->copy_mutex); \
+        } \
+    } while (0)
+
+#if XF_FAL_LOCK_IS_ENABLE == 0
+#undef XF_FAL_COPY_MUTEX_TRY_INIT
+#undef XF_FAL_COPY_LOCK
+#undef XF_FAL_COPY_UNLOCK
+#define XF_FAL_COPY_MUTEX_TRY_INIT()
+#define XF_FAL_COPY_LOCK()
+#define XF_FAL_COPY_UNLOCK()
+#endif
+
+#if (XF_FAL_LOCK_IS_ENABLE == 0) || (XF_FAL_UPDATE_SECTOR_BUF_SIZE == 0)
+#undef XF_FAL_UPDATE_MUTEX_TRY_INIT
+#undef XF_FAL_UPDATE_LOCK
+#undef XF_FAL_UPDATE_UNLOCK
+#define XF_FAL_UPDATE_MUTEX_TRY_INIT()
+#define XF_FAL_UPDATE_LOCK()
+#define XF_FAL_UPDATE_UNLOCK()
+#endif
+
+#if (XF_FAL_LOCK_IS_ENABLE == 0) || (XF_FAL_READ_CACHE_NUM == 0)
+#undef XF_FAL_RCACHE_MUTEX_TRY_INIT
+#undef XF_FAL_RCACHE_LOCK
+#undef XF_FAL_RCACHE_UNLOCK
+#define XF_FAL_RCACHE_MUTEX_TRY_INIT()
+#define XF_FAL_RCACHE_LOCK()
+#define XF_FAL_RCACHE_UNLOCK()
+#endif
+
+/**
+ * @brief 读缓存近期命中率：定点数满值，及每次访问后按 1/32 的权重更新。
+ */
+#define XF_FAL_RCACHE_HIT_ONE           (1024)
+#define XF_FAL_RCACHE_HIT_UPDATE(_rcache, _is_hit) \
+    ((_rcache)->hit_avg = (_rcache)->hit_avg - ((_rcache)->hit_avg >> 5) \
+                          + ((_is_hit) ? (XF_FAL_RCACHE_HIT_ONE >> 5) : 0))
+
+/**
+ * @brief 判断 [_a, _a + _alen) 与 [_b, _b + _blen) 是否重叠。
+ */
+#define XF_FAL_RANGE_OVERLAP(_a, _alen, _b, _blen) \
+    (((_a) < (_b) + (_blen)) && ((_b) < (_a) + (_alen)))
+
+/**
+ * @brief 使 flash 设备上指定范围的读缓存失效。size 为 0 表示整个设备。
+ */
+#if XF_FAL_READ_CACHE_NUM > 0
+#define XF_FAL_RCACHE_INVALIDATE(_dev_idx, _addr, _size) \
+    xf_fal_rcache_invalidate((_dev_idx), (_addr), (_size))
+#else
+#define XF_FAL_RCACHE_INVALIDATE(_dev_idx, _addr, _size)
+#endif
+
+/**
+ * @brief 读写擦统计。
+ *
+ * 分区统计在 handle 接口中记录，flash 设备统计在每次驱动调用处记录。
+ * XF_FAL_STAT_ENABLE 为 0 时不生成任何代码，驱动直接调用。
+ */
+#if XF_FAL_STAT_ENABLE
+#define XF_FAL_STAT_TIMESTAMP(_t0) \
+    uint32_t _t0 = xf_fal_stat_now()
+#define XF_FAL_STAT_PART(_handle, _op, _size, _ret, _t0) \
+    xf_fal_stat_record(xf_fal_stat_part_find((_handle)->partition), \
+                       (_op), (_size), (_ret), (_t0))
+#define XF_FAL_DRV_READ(_dev, _addr, _dst, _size) \
+    xf_fal_drv_read((_dev), (_addr), (_dst), (_size))
+#define XF_FAL_DRV_WRITE(_dev, _addr, _src, _size) \
+    xf_fal_drv_write((_dev), (_addr), (_src), (_size))
+#define XF_FAL_DRV_ERASE(_dev, _addr, _size) \
+    xf_fal_drv_erase((_dev), (_addr), (_size))
+#define XF_FAL_DRV_READV(_dev, _addr, _iov, _iovcnt) \
+    xf_fal_drv_readv((_dev), (_addr), (_iov), (_iovcnt))
+#define XF_FAL_DRV_WRITEV(_dev, _addr, _iov, _iovcnt) \
+    xf_fal_drv_writev((_dev), (_addr), (_iov), (_iovcnt))
+#else
+#define XF_FAL_STAT_TIMESTAMP(_t0)
+#define XF_FAL_STAT_PART(_handle, _op, _size, _ret, _t0)
+#define XF_FAL_DRV_READ(_dev, _addr, _dst, _size) \
+    (_dev)->ops.read((_addr), (_dst), (_size))
+#define XF_FAL_DRV_WRITE(_dev, _addr, _src, _size) \
+    (_dev)->ops.write((_addr), (_src), (_size))
+#define XF_FAL_DRV_ERASE(_dev, _addr, _size) \
+    (_dev)->ops.erase((_addr), (_size))
+#define XF_FAL_DRV_READV(_dev, _addr, _iov, _iovcnt) \
+    (_dev)->ops.readv((_addr), (_iov), (_iovcnt))
+#define XF_FAL_DRV_WRITEV(_dev, _addr, _iov, _iovcnt) \
+    (_dev)->ops.writev((_addr), (_iov), (_iovcnt))
+#endif
+
+/**
+ * @brief 操作跟踪。开始时占用一条记录（标记为未完成），结束时补充耗时和结果。
+ */
+#if XF_FAL_TRACE_ENABLE
+#define XF_FAL_TRACE_BEGIN(_seq, _handle, _op, _offset, _size) \
+    uint32_t _seq = xf_fal_trace_begin((_handle), (_op), (_offset), (_size))
+#define XF_FAL_TRACE_END(_seq, _ret) \
+    xf_fal_trace_end((_seq), (_ret))
+#else
+#define XF_FAL_TRACE_BEGIN(_seq, _handle, _op, _offset, _size)
+#define XF_FAL_TRACE_END(_seq, _ret)
+#endif
+
+/**
+ * @brief 擦除次数统计。每次擦除驱动调用成功后按扇区计数。
+ */
+#if XF_FAL_WEAR_ENABLE
+#define XF_FAL_WEAR_RECORD(_dev, _addr, _size) \
+    xf_fal_wear_record((_dev), (_addr), (_size))
+#define XF_FAL_WEAR_SYNC_IF_NEEDED() \
+    xf_fal_wear_sync_if_needed()
+#else
+#define XF_FAL_WEAR_RECORD(_dev, _addr, _size)
+#define XF_FAL_WEAR_SYNC_IF_NEEDED()
+#endif
+
 #if XF_FAL_LOCK_IS_ENABLE == 0
 #undef XF_FAL_CTX_MUTEX_TRY_INIT
 #undef XF_FAL_CTX_MUTEX_TRY_DEINIT
 #undef XF_FAL_CTX_TRYLOCK__RETURN_ON_FAILURE
 #undef XF_FAL_CTX_TRYLOCK__ANYWAY
+#undef XF_FAL_CTX_LOCK__LOG_ON_FAILURE
 #undef XF_FAL_CTX_UNLOCK
+#undef XF_FAL_DEV_MUTEX_TRY_INIT
+#undef XF_FAL_DEV_LOCK
+#undef XF_FAL_DEV_UNLOCK
 #define XF_FAL_CTX_MUTEX_TRY_INIT()
 #define XF_FAL_CTX_MUTEX_TRY_DEINIT()
 #define XF_FAL_CTX_TRYLOCK__RETURN_ON_FAILURE(_ret)
 #define XF_FAL_CTX_TRYLOCK__ANYWAY()
+#define XF_FAL_CTX_LOCK__LOG_ON_FAILURE(_what)
 #define XF_FAL_CTX_UNLOCK()
+#define XF_FAL_DEV_MUTEX_TRY_INIT(_idx)
+#define XF_FAL_DEV_LOCK(_idx)
+#define XF_FAL_DEV_UNLOCK(_idx)
+#endif
+
+/**
+ * @brief 有异步队列时，取得设备锁后还需等待设备上 async_start 启动的操作完成。
+ */
+#if XF_FAL_ASYNC_ENABLE
+#undef XF_FAL_DEV_LOCK
+#define XF_FAL_DEV_LOCK(_idx) \
+    xf_fal_dev_lock_wait_async(_idx)
 #endif
 
+/**
+ * @brief 无锁读取当前发布的快照。
+ *
+ * 读取前后快照序号不变时读取结果有效，否则重试。
+ * 两宏之间的代码可能被执行多次，不能有副作用，也不能跳出。
+ */
+#define XF_FAL_SNAPSHOT_READ_BEGIN(_snap, _seq) \
+    do { \
+        (_seq) = sp_fal()->seq; \
+        XF_FAL_READ_BARRIER(); \
+        (_snap) = sp_snap();
+
+#define XF_FAL_SNAPSHOT_READ_END(_seq) \
+        XF_FAL_READ_BARRIER(); \
+    } while ((_seq) != sp_fal()->seq)
+
 /* ==================== [Global Functions] ================================== */
 
 xf_err_t xf_fal_register_flash_device(const xf_fal_flash_dev_t *p_dev)
 {
     xf_err_t xf_ret = XF_OK;
+    xf_fal_snapshot_t *next;
     int idle_idx;
 
     if (NULL == p_dev) {
@@ -106,6 +493,31 @@ xf_err_t xf_fal_register_flash_device(const xf_fal_flash_dev_t *p_dev)
        ) {
         return XF_ERR_INVALID_PORT;
     }
+    for (size_t i = 0; i < p_dev->erase_size_num; i++) {
+        if ((NULL == p_dev->erase_size_table)
+                || (0 == p_dev->sector_size)
+                || (0 == p_dev->erase_size_table[i])
+                || (0 != p_dev->erase_size_table[i] % p_dev->sector_size)) {
+            return XF_ERR_INVALID_PORT;
+        }
+    }
+#if XF_FAL_WRITE_SPLIT_ENABLE
+    /*
+     * 拆分写入的读-改-写以 io_size 为单位，单元须放得进缓冲区且不超出设备末尾；
+     * 按页拆分后的对齐部分须至少为一个 io_size, 否则写入无法前进。
+     */
+    if ((p_dev->io_size > XF_FAL_IO_SIZE_MAX)
+            || ((p_dev->io_size) && (0 != p_dev->len % p_dev->io_size))
+            || ((p_dev->io_size) && (p_dev->page_size)
+                && ((p_dev->page_size < p_dev->io_size)
+                    || (0 != p_dev->page_size % p_dev->io_size)))) {
+        XF_LOGE(TAG, "Flash device(%s) io_size(%lu) exceeds XF_FAL_IO_SIZE_MAX, "
+                "or does not divide len(%lu) or page_size(%lu).",
+                p_dev->name, (unsigned long)p_dev->io_size,
+                (unsigned long)p_dev->len, (unsigned long)p_dev->page_size);
+        return XF_ERR_INVALID_PORT;
+    }
+#endif
 
     XF_FAL_CTX_MUTEX_TRY_INIT();
 
@@ -114,11 +526,11 @@ xf_err_t xf_fal_register_flash_device(const xf_fal_flash_dev_t *p_dev)
     /* TODO 未检查 flash 设备名是否重复 */
     idle_idx = -1;
     for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
-        if (p_dev == sp_fal()->flash_device_table[i]) {
+        if (p_dev == sp_snap()->flash_device_table[i]) {
             xf_ret = XF_ERR_INITED;
             goto l_unlock_ret;
         }
-        if ((NULL == sp_fal()->flash_device_table[i])
+        if ((NULL == sp_snap()->flash_device_table[i])
                 && (-1 == idle_idx)) {
             idle_idx = i;
         }
@@ -128,7 +540,19 @@ xf_err_t xf_fal_register_flash_device(const xf_fal_flash_dev_t *p_dev)
         goto l_unlock_ret;
     }
 
-    sp_fal()->flash_device_table[idle_idx] = p_dev;
+    XF_FAL_DEV_MUTEX_TRY_INIT(idle_idx);
+    XF_FAL_RCACHE_MUTEX_TRY_INIT();
+    XF_FAL_UPDATE_MUTEX_TRY_INIT();
+    XF_FAL_COPY_MUTEX_TRY_INIT();
+
+#if XF_FAL_STAT_ENABLE
+    memset(&sp_fal()->stat_dev[idle_idx], 0, sizeof(sp_fal()->stat_dev[idle_idx]));
+#endif
+
+    next = xf_fal_snapshot_begin();
+    next->flash_device_table[idle_idx]  = p_dev;
+    next->is_stale                      = true;
+    xf_fal_snapshot_publish(next);
 
 l_unlock_ret:;
     XF_FAL_CTX_UNLOCK();
@@ -140,6 +564,7 @@ xf_err_t xf_fal_register_partition_table(
     const xf_fal_partition_t *p_table, size_t table_len)
 {
     xf_err_t xf_ret = XF_OK;
+    xf_fal_snapshot_t *next;
     int idle_idx;
 
     if ((NULL == p_table)
@@ -154,11 +579,11 @@ xf_err_t xf_fal_register_partition_table(
     /* TODO 未检查分区名是否重复 */
     idle_idx = -1;
     for (size_t i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
-        if (p_table == sp_fal()->partition_table[i]) {
+        if (p_table == sp_snap()->partition_table[i]) {
             xf_ret = XF_ERR_INITED;
             goto l_unlock_ret;
         }
-        if ((NULL == sp_fal()->partition_table[i])
+        if ((NULL == sp_snap()->partition_table[i])
                 && (-1 == idle_idx)) {
             idle_idx = i;
         }
@@ -168,8 +593,11 @@ xf_err_t xf_fal_register_partition_table(
         goto l_unlock_ret;
     }
 
-    sp_fal()->partition_table[idle_idx]     = p_table;
-    sp_fal()->partition_table_len[idle_idx] = table_len;
+    next = xf_fal_snapshot_begin();
+    next->partition_table[idle_idx]     = p_table;
+    next->partition_table_len[idle_idx] = table_len;
+    next->is_stale                      = true;
+    xf_fal_snapshot_publish(next);
 
 l_unlock_ret:;
     XF_FAL_CTX_UNLOCK();
@@ -180,6 +608,7 @@ l_unlock_ret:;
 xf_err_t xf_fal_unregister_flash_device(const xf_fal_flash_dev_t *p_dev)
 {
     xf_err_t xf_ret = XF_OK;
+    xf_fal_snapshot_t *next;
     int dev_idx;
 
     if (NULL == p_dev) {
@@ -192,7 +621,7 @@ xf_err_t xf_fal_unregister_flash_device(const xf_fal_flash_dev_t *p_dev)
 
     dev_idx = -1;
     for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
-        if ((p_dev == sp_fal()->flash_device_table[i])) {
+        if ((p_dev == sp_snap()->flash_device_table[i])) {
             dev_idx = i;
             break;
         }
@@ -202,7 +631,21 @@ xf_err_t xf_fal_unregister_flash_device(const xf_fal_flash_dev_t *p_dev)
         goto l_unlock_ret;
     }
 
-    sp_fal()->flash_device_table[dev_idx] = NULL;
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    /* 写入并取下该设备上的所有写缓冲 */
+    XF_FAL_DEV_LOCK(dev_idx);
+    for (xf_fal_write_buffer_t *wbuf = sp_fal()->wbuf_list[dev_idx]; wbuf; wbuf = wbuf->next) {
+        xf_fal_wbuf_flush(wbuf);
+    }
+    sp_fal()->wbuf_list[dev_idx] = NULL;
+    XF_FAL_DEV_UNLOCK(dev_idx);
+#endif
+
+    next = xf_fal_snapshot_begin();
+    next->flash_device_table[dev_idx]   = NULL;
+    next->is_stale                      = true;
+    xf_fal_snapshot_publish(next);
+    XF_FAL_RCACHE_INVALIDATE(dev_idx, 0, 0);
 
 l_unlock_ret:;
     XF_FAL_CTX_UNLOCK();
@@ -210,9 +653,28 @@ l_unlock_ret:;
     return xf_ret;
 }
 
+xf_err_t xf_fal_register_flash_device_apply(const xf_fal_flash_dev_t *p_dev)
+{
+    xf_err_t xf_ret;
+
+    xf_ret = xf_fal_register_flash_device(p_dev);
+    if ((xf_ret != XF_OK) || (!sp_fal()->is_init)) {
+        return xf_ret;
+    }
+
+    /* 使已注册的、位于此设备上的分区生效；校验失败时撤销注册，不留下半初始化的设备 */
+    xf_ret = xf_fal_check_and_update_cache();
+    if (xf_ret != XF_OK) {
+        (void)xf_fal_unregister_flash_device(p_dev);
+    }
+
+    return xf_ret;
+}
+
 xf_err_t xf_fal_unregister_partition_table(const xf_fal_partition_t *p_table)
 {
     xf_err_t xf_ret = XF_OK;
+    xf_fal_snapshot_t *next;
     int table_idx;
 
     if (NULL == p_table) {
@@ -225,7 +687,7 @@ xf_err_t xf_fal_unregister_partition_table(const xf_fal_partition_t *p_table)
 
     table_idx = -1;
     for (size_t i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
-        if ((p_table == sp_fal()->partition_table[i])) {
+        if ((p_table == sp_snap()->partition_table[i])) {
             table_idx = i;
         }
     }
@@ -234,8 +696,11 @@ xf_err_t xf_fal_unregister_partition_table(const xf_fal_partition_t *p_table)
         goto l_unlock_ret;
     }
 
-    sp_fal()->partition_table[table_idx]        = NULL;
-    sp_fal()->partition_table_len[table_idx]    = 0;
+    next = xf_fal_snapshot_begin();
+    next->partition_table[table_idx]        = NULL;
+    next->partition_table_len[table_idx]    = 0;
+    next->is_stale                          = true;
+    xf_fal_snapshot_publish(next);
 
 l_unlock_ret:;
     XF_FAL_CTX_UNLOCK();
@@ -245,7 +710,15 @@ l_unlock_ret:;
 
 bool xf_fal_check_register_state(void)
 {
-    if (0 == sp_fal()->cached_num) {
+    const xf_fal_snapshot_t *snap;
+    uint32_t seq;
+    size_t cached_num;
+
+    XF_FAL_SNAPSHOT_READ_BEGIN(snap, seq);
+    cached_num = snap->cached_num;
+    XF_FAL_SNAPSHOT_READ_END(seq);
+
+    if (0 == cached_num) {
         return false;
     }
     return true;
@@ -267,7 +740,7 @@ xf_err_t xf_fal_init(void)
 
     /* 逐个初始化 */
     for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
-        device_table = sp_fal()->flash_device_table[i];
+        device_table = sp_snap()->flash_device_table[i];
         if ((!device_table) || (!device_table->ops.init)) {
             continue;
         }
@@ -293,120 +766,131 @@ xf_err_t xf_fal_init(void)
 xf_err_t xf_fal_deinit(void)
 {
     const xf_fal_flash_dev_t *device_table;
+    xf_fal_snapshot_t *next;
 
-    if (!xf_fal_check_register_state()) {
-        return XF_ERR_INVALID_PORT;
-    }
+    /* 不检查注册状态：只使用编译期分区表（xf_fal_static.h）时没有缓存的分区 */
     if (!sp_fal()->is_init) {
         return XF_ERR_UNINIT;
     }
 
+    XF_FAL_CTX_TRYLOCK__RETURN_ON_FAILURE(XF_ERR_BUSY);
+
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    xf_fal_write_buffer_flush(NULL);
+#endif
+
     for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
-        device_table = sp_fal()->flash_device_table[i];
+        device_table = sp_snap()->flash_device_table[i];
         if ((!device_table) || (!device_table->ops.deinit)) {
             continue;
         }
         device_table->ops.deinit();
     }
 
-    sp_fal()->cached_num    = 0;
-    sp_fal()->is_init       = false;
+    next = xf_fal_snapshot_begin();
+    next->cached_num    = 0;
+    next->part_num      = 0;
+    xf_fal_snapshot_publish(next);
+    sp_fal()->is_init   = false;
+    for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        XF_FAL_RCACHE_INVALIDATE(i, 0, 0);
+    }
+
+    XF_FAL_CTX_UNLOCK();
 
     return XF_OK;
 }
 
 const xf_fal_flash_dev_t *xf_fal_flash_device_find(const char *name)
 {
+    const xf_fal_snapshot_t *snap;
     const xf_fal_flash_dev_t *flash_device;
-    size_t i;
+    uint32_t seq;
 
     if (!name) {
         return NULL;
     }
 
-    /* 暂无递归互斥锁，此处不加锁没太大问题 */
-
-    for (i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
-        flash_device = sp_fal()->flash_device_table[i];
-        if (!flash_device) {
-            continue;
-        }
-        if (0 == xf_strncmp(name, flash_device->name, XF_FAL_DEV_NAME_MAX)) {
-            return flash_device;
-        }
-    }
+    XF_FAL_SNAPSHOT_READ_BEGIN(snap, seq);
+    flash_device = xf_fal_snapshot_device_find(snap, name, NULL);
+    XF_FAL_SNAPSHOT_READ_END(seq);
 
-    return NULL;
+    return flash_device;
 }
 
 const xf_fal_flash_dev_t *xf_fal_flash_device_find_by_part(
     const xf_fal_partition_t *part)
 {
-    const xf_fal_flash_dev_t *flash_dev = NULL;
-    size_t i;
-
     if (!part) {
         return NULL;
     }
 
-    XF_FAL_CTX_TRYLOCK__RETURN_ON_FAILURE(NULL);
-    if (xf_fal_check_register_state()) {
-        for (i = 0; i < sp_fal()->cached_num; i++) {
-            if (sp_fal()->cache[i].partition == part) {
-                flash_dev = sp_fal()->cache[i].flash_dev;
-                break;
-            }
-        }
-    }
-    /* 未注册或未找到时遍历 */
-    if (!flash_dev) {
-        flash_dev = xf_fal_flash_device_find(part->flash_name);
-    }
-    XF_FAL_CTX_UNLOCK();
-
-    return flash_dev;
+    return xf_fal_part_resolve(part, NULL);
 }
 
 const xf_fal_partition_t *xf_fal_partition_find(const char *name)
 {
+    const xf_fal_snapshot_t *snap;
+    const xf_fal_cache_t *cache;
     const xf_fal_partition_t *p_table;
-    const xf_fal_partition_t *part = NULL;
+    const xf_fal_partition_t *part;
     size_t table_len;
     size_t i;
     size_t j;
+    uint32_t seq;
 
     if (!name) {
         return NULL;
     }
 
-    XF_FAL_CTX_TRYLOCK__RETURN_ON_FAILURE(NULL);
-
-    for (i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
-        p_table     = sp_fal()->partition_table[i];
-        table_len   = sp_fal()->partition_table_len[i];
-        if ((NULL == p_table) || (0 == table_len)) {
-            continue;
+    XF_FAL_SNAPSHOT_READ_BEGIN(snap, seq);
+    part = NULL;
+
+    /*
+     * 所有分区均已缓存且分区数不少于 XF_FAL_HASH_FIND_MIN_NUM 时查哈希索引，
+     * 否则遍历分区表。
+     * 缓存项按分区表顺序插入索引，同名分区在探测序列中先遇到表中靠前的一个，
+     * 与遍历结果一致；有分区未进入缓存时索引不能保证这一点，因此也遍历。
+     */
+    if ((snap->cached_num >= XF_FAL_HASH_FIND_MIN_NUM)
+            && (snap->cached_num == snap->part_num) && (!snap->is_stale)) {
+        cache = xf_fal_hash_index_find(snap, name, NULL);
+        if (cache) {
+            part = cache->partition;
         }
-        for (j = 0; j < table_len; j++) {
-            if (0 == xf_strncmp(name, p_table[j].name, XF_FAL_DEV_NAME_MAX)) {
-                part = &p_table[j];
-                goto l_unlock_ret;
+    } else {
+        for (i = 0; (i < XF_FAL_PARTITION_TABLE_NUM) && (!part); i++) {
+            p_table     = snap->partition_table[i];
+            table_len   = snap->partition_table_len[i];
+            if ((NULL == p_table) || (0 == table_len)) {
+                continue;
+            }
+            /*
+             * 快照可能正被改写，表指针和表长可能不匹配，
+             * 确认序号未变后再访问分区表，否则退出并重试。
+             */
+            XF_FAL_READ_BARRIER();
+            if (seq != sp_fal()->seq) {
+                break;
+            }
+            for (j = 0; j < table_len; j++) {
+                if (0 == xf_strncmp(name, p_table[j].name, XF_FAL_DEV_NAME_MAX)) {
+                    part = &p_table[j];
+                    break;
+                }
             }
         }
     }
-
-l_unlock_ret:;
-    XF_FAL_CTX_UNLOCK();
+    XF_FAL_SNAPSHOT_READ_END(seq);
 
     return part;
 }
 
-xf_err_t xf_fal_partition_read(
-    const xf_fal_partition_t *part,
-    size_t src_offset, void *dst, size_t size)
+xf_err_t xf_fal_partition_get_handle(
+    const xf_fal_partition_t *part, xf_fal_handle_t *handle)
 {
-    xf_err_t xf_ret = XF_OK;
     const xf_fal_flash_dev_t *flash_dev = NULL;
+    size_t dev_idx;
 
     if (!xf_fal_check_register_state()) {
         return XF_ERR_INVALID_PORT;
@@ -414,218 +898,2639 @@ xf_err_t xf_fal_partition_read(
     if (!sp_fal()->is_init) {
         return XF_ERR_UNINIT;
     }
-    if (!part || !dst || !size) {
-        return XF_ERR_INVALID_ARG;
-    }
-    if (src_offset + size > part->len) {
-        XF_LOGE(TAG, "Partition read error! "
-                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
-                part->name, (int)(src_offset + size), (int)part->len);
+    if (!part || !handle) {
         return XF_ERR_INVALID_ARG;
     }
 
-    flash_dev = xf_fal_flash_device_find_by_part(part);
+    flash_dev = xf_fal_part_resolve(part, &dev_idx);
     if (flash_dev == NULL) {
-        XF_LOGE(TAG, "Partition read error! "
-                "Do NOT found the flash device(%s).", part->flash_name);
+        XF_LOGE(TAG, "Partition(%s) error! "
+                "Do NOT found the flash device(%s).", part->name, part->flash_name);
         return XF_ERR_INVALID_ARG;
     }
 
-    xf_ret = flash_dev->ops.read(part->offset + src_offset, dst, size);
+    handle->partition   = part;
+    handle->flash_dev   = flash_dev;
+    handle->dev_idx     = dev_idx;
+    handle->base        = part->offset;
+    handle->len         = part->len;
+#if XF_FAL_TRACE_ENABLE
+    handle->part_id     = xf_fal_trace_part_id(xf_fal_name_hash(part->name));
+#endif
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_partition_read(
+    const xf_fal_partition_t *part,
+    size_t src_offset, void *dst, size_t size)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
     if (xf_ret != XF_OK) {
-        XF_LOGE(TAG, "Partition read error! "
-                "Flash device(%s) read failed.", part->flash_name);
+        return xf_ret;
     }
 
-    return xf_ret;
+    return xf_fal_handle_read(&handle, src_offset, dst, size);
 }
 
 xf_err_t xf_fal_partition_write(
     const xf_fal_partition_t *part,
     size_t dst_offset, const void *src, size_t size)
 {
-    xf_err_t xf_ret = XF_OK;
-    const xf_fal_flash_dev_t *flash_dev = NULL;
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
 
-    if (!xf_fal_check_register_state()) {
-        return XF_ERR_INVALID_PORT;
-    }
-    if (!sp_fal()->is_init) {
-        return XF_ERR_UNINIT;
-    }
-    if (!part || !src || !size) {
-        return XF_ERR_INVALID_ARG;
-    }
-    if (dst_offset + size > part->len) {
-        XF_LOGE(TAG, "Partition write error! "
-                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
-                part->name, (int)(dst_offset + size), (int)part->len);
-        return XF_ERR_INVALID_ARG;
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
     }
 
-    flash_dev = xf_fal_flash_device_find_by_part(part);
-    if (flash_dev == NULL) {
-        XF_LOGE(TAG, "Partition write error! "
-                "Do NOT found the flash device(%s).", part->flash_name);
-        return XF_ERR_INVALID_ARG;
-    }
+    return xf_fal_handle_write(&handle, dst_offset, src, size);
+}
+
+xf_err_t xf_fal_partition_erase(
+    const xf_fal_partition_t *part, size_t offset, size_t size)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
 
-    xf_ret = flash_dev->ops.write(part->offset + dst_offset, src, size);
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
     if (xf_ret != XF_OK) {
-        XF_LOGE(TAG, "Partition write error! "
-                "Flash device(%s) write failed.", part->flash_name);
+        return xf_ret;
     }
 
-    return xf_ret;
+    return xf_fal_handle_erase(&handle, offset, size);
 }
 
-xf_err_t xf_fal_partition_erase(
-    const xf_fal_partition_t *part, size_t offset, size_t size)
+xf_err_t xf_fal_partition_erase_ex(
+    const xf_fal_partition_t *part, size_t offset, size_t size,
+    uint32_t flags, xf_fal_erase_result_t *p_result)
 {
-    xf_err_t xf_ret = XF_OK;
-    const xf_fal_flash_dev_t *flash_dev = NULL;
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
 
-    if (!xf_fal_check_register_state()) {
-        return XF_ERR_INVALID_PORT;
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
     }
+
+    return xf_fal_handle_erase_ex(&handle, offset, size, flags, p_result);
+}
+
+xf_err_t xf_fal_handle_read(
+    const xf_fal_handle_t *handle,
+    size_t src_offset, void *dst, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+
     if (!sp_fal()->is_init) {
         return XF_ERR_UNINIT;
     }
-    if (!part || !size) {
+    if (!handle || !dst || !size) {
         return XF_ERR_INVALID_ARG;
     }
-    if (offset + size > part->len) {
-        XF_LOGE(TAG, "Partition write error! "
+    if ((src_offset > handle->len) || (size > handle->len - src_offset)) {
+        XF_LOGE(TAG, "Partition read error! "
                 "Partition(%s) address(0x%08x) out of bound(0x%08x).",
-                part->name, (int)(offset + size), (int)part->len);
+                handle->partition->name, (int)(src_offset + size), (int)handle->len);
         return XF_ERR_INVALID_ARG;
     }
 
-    flash_dev = xf_fal_flash_device_find_by_part(part);
-    if (flash_dev == NULL) {
+    XF_FAL_STAT_TIMESTAMP(t0);
+    XF_FAL_TRACE_BEGIN(trace_seq, handle, XF_FAL_OP_READ, src_offset, size);
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+    xf_ret = xf_fal_dev_read(handle->flash_dev, handle->dev_idx,
+                             handle->base + src_offset, dst, size);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    if (XF_OK == xf_ret) {
+        xf_fal_wbuf_overlay(handle->dev_idx, handle->base + src_offset, dst, size);
+    }
+#endif
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+    XF_FAL_STAT_PART(handle, XF_FAL_OP_READ, size, xf_ret, t0);
+    XF_FAL_TRACE_END(trace_seq, xf_ret);
+    if (xf_ret != XF_OK) {
+        XF_LOGE(TAG, "Partition read error! "
+                "Flash device(%s) read failed.", handle->flash_dev->name);
+    }
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_handle_write(
+    const xf_fal_handle_t *handle,
+    size_t dst_offset, const void *src, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!handle || !src || !size) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((dst_offset > handle->len) || (size > handle->len - dst_offset)) {
         XF_LOGE(TAG, "Partition write error! "
-                "Do NOT found the flash device(%s).", part->flash_name);
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                handle->partition->name, (int)(dst_offset + size), (int)handle->len);
         return XF_ERR_INVALID_ARG;
     }
 
-    xf_ret = flash_dev->ops.erase(part->offset + offset, size);
+    XF_FAL_STAT_TIMESTAMP(t0);
+    XF_FAL_TRACE_BEGIN(trace_seq, handle, XF_FAL_OP_WRITE, dst_offset, size);
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    xf_ret = xf_fal_wbuf_write(handle, handle->base + dst_offset, src, size);
+#else
+    xf_ret = xf_fal_dev_write(handle->flash_dev, handle->base + dst_offset, src, size);
+    XF_FAL_RCACHE_INVALIDATE(handle->dev_idx, handle->base + dst_offset, size);
+#endif
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+    XF_FAL_STAT_PART(handle, XF_FAL_OP_WRITE, size, xf_ret, t0);
+    XF_FAL_TRACE_END(trace_seq, xf_ret);
     if (xf_ret != XF_OK) {
         XF_LOGE(TAG, "Partition write error! "
-                "Flash device(%s) write failed.", part->flash_name);
+                "Flash device(%s) write failed.", handle->flash_dev->name);
     }
 
     return xf_ret;
 }
 
-xf_err_t xf_fal_partition_erase_all(const xf_fal_partition_t *part)
+xf_err_t xf_fal_handle_erase(
+    const xf_fal_handle_t *handle, size_t offset, size_t size)
 {
-    return xf_fal_partition_erase(part, 0, part->len);
+    return xf_fal_handle_erase_ex(handle, offset, size, XF_FAL_ERASE_FLAG_NONE, NULL);
 }
 
-void xf_fal_show_part_table(void)
+xf_err_t xf_fal_handle_erase_ex(
+    const xf_fal_handle_t *handle, size_t offset, size_t size,
+    uint32_t flags, xf_fal_erase_result_t *p_result)
 {
-    const xf_fal_partition_t *p_table;
-    size_t table_len;
-    const xf_fal_partition_t *part;
-    size_t i;
-    size_t j;
-    char *item1                 = "name";
-    char *item2                 = "flash_dev";
-    size_t part_name_max        = strlen(item1);
-    size_t flash_dev_name_max   = strlen(item2);
-    size_t len_max;
+    xf_err_t xf_ret = XF_OK;
+    xf_fal_erase_result_t result = {0};
 
-    for (i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
-        p_table     = sp_fal()->partition_table[i];
-        table_len   = sp_fal()->partition_table_len[i];
-        if ((NULL == p_table) || (0 == table_len)) {
-            continue;
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!handle || !size) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((offset > handle->len) || (size > handle->len - offset)) {
+        XF_LOGE(TAG, "Partition erase error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                handle->partition->name, (int)(offset + size), (int)handle->len);
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_ret = xf_fal_erase_align(handle, &offset, &size);
+    if (xf_ret != XF_OK) {
+        XF_LOGE(TAG, "Partition erase error! "
+                "Partition(%s) range(0x%08x, 0x%08x) not aligned to sector(0x%08x).",
+                handle->partition->name, (int)offset, (int)size,
+                (int)handle->flash_dev->sector_size);
+        return xf_ret;
+    }
+
+    XF_FAL_STAT_TIMESTAMP(t0);
+    XF_FAL_TRACE_BEGIN(trace_seq, handle, XF_FAL_OP_ERASE, offset, size);
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    /* 完全被擦除的缓冲数据直接丢弃，部分重叠的先写入 */
+    xf_ret = xf_fal_wbuf_flush_range(
+                 handle->dev_idx, handle->base + offset, size, true, NULL);
+#endif
+    if (XF_OK != xf_ret) {
+        /* 擦除前的写入失败，不再擦除 */
+    } else if (flags & XF_FAL_ERASE_FLAG_SKIP_BLANK) {
+        xf_ret = xf_fal_dev_erase_skip_blank(
+                     handle->flash_dev, handle->base + offset, size, &result);
+    } else {
+        xf_ret = xf_fal_dev_erase(handle->flash_dev, handle->base + offset, size);
+        if (XF_OK == xf_ret) {
+            result.erased_num = (handle->flash_dev->sector_size)
+                                ? (size / handle->flash_dev->sector_size) : 1;
         }
-        for (j = 0; j < table_len; j++) {
-            part = &p_table[j];
-            len_max = xf_strlen(part->name);
-            if (part_name_max < len_max) {
-                part_name_max = len_max;
+    }
+    XF_FAL_RCACHE_INVALIDATE(handle->dev_idx, handle->base + offset, size);
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+    XF_FAL_STAT_PART(handle, XF_FAL_OP_ERASE, size, xf_ret, t0);
+    XF_FAL_TRACE_END(trace_seq, xf_ret);
+    if (xf_ret != XF_OK) {
+        XF_LOGE(TAG, "Partition erase error! "
+                "Flash device(%s) erase failed.", handle->flash_dev->name);
+    }
+    if (p_result) {
+        *p_result = result;
+    }
+    XF_FAL_WEAR_SYNC_IF_NEEDED();
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_partition_update(
+    const xf_fal_partition_t *part, size_t offset,
+    const void *src, size_t size, xf_fal_update_result_t *p_result)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    return xf_fal_handle_update(&handle, offset, src, size, p_result);
+}
+
+xf_err_t xf_fal_handle_update(
+    const xf_fal_handle_t *handle, size_t offset,
+    const void *src, size_t size, xf_fal_update_result_t *p_result)
+{
+    xf_err_t xf_ret = XF_OK;
+    xf_fal_update_result_t result = {0};
+    const xf_fal_flash_dev_t *flash_dev;
+    size_t sector_size;
+    size_t addr;
+    size_t end;
+    size_t head_len;
+    size_t len;
+    bool need_erase;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!handle || !src || !size) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((offset > handle->len) || (size > handle->len - offset)) {
+        XF_LOGE(TAG, "Partition update error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                handle->partition->name, (int)(offset + size), (int)handle->len);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    flash_dev   = handle->flash_dev;
+    sector_size = flash_dev->sector_size;
+    addr        = handle->base + offset;
+    end         = addr + size;
+
+    XF_FAL_STAT_TIMESTAMP(t0);
+    XF_FAL_TRACE_BEGIN(trace_seq, handle, XF_FAL_OP_WRITE, offset, size);
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    /* 首尾扇区可能被整扇区读-改-写，写缓冲按扇区范围写入 */
+    head_len = (sector_size) ? (addr % sector_size) : 0;
+    len      = (sector_size) ? ((sector_size - end % sector_size) % sector_size) : 0;
+    xf_ret = xf_fal_wbuf_flush_range(handle->dev_idx, addr - head_len,
+                                     head_len + size + len, false, NULL);
+    if (xf_ret != XF_OK) {
+        goto l_unlock_ret;
+    }
+#endif
+
+    /* 扇区大于读-改-写缓冲区时无法保留范围外的数据，修改前先确认首尾扇区不需要擦除 */
+    if (sector_size > XF_FAL_UPDATE_SECTOR_BUF_SIZE) {
+        head_len = 0;
+        if (addr % sector_size) {
+            head_len = sector_size - addr % sector_size;
+            head_len = (head_len < size) ? head_len : size;
+            xf_ret = xf_fal_update_scan(flash_dev, addr, src, head_len, &need_erase, NULL);
+            if ((XF_OK == xf_ret) && (need_erase)) {
+                xf_ret = XF_ERR_NOT_SUPPORTED;
             }
-            len_max = xf_strlen(part->flash_name);
-            if (flash_dev_name_max < len_max) {
-                flash_dev_name_max = len_max;
+            if (xf_ret != XF_OK) {
+                goto l_unlock_ret;
+            }
+        }
+        len = end % sector_size;
+        if ((len) && (end - len >= addr + head_len)) {
+            xf_ret = xf_fal_update_scan(flash_dev, end - len,
+                                        (const uint8_t *)src + size - len,
+                                        len, &need_erase, NULL);
+            if ((XF_OK == xf_ret) && (need_erase)) {
+                xf_ret = XF_ERR_NOT_SUPPORTED;
+            }
+            if (xf_ret != XF_OK) {
+                goto l_unlock_ret;
             }
         }
     }
 
-    XF_LOGI(TAG, "==================== FAL partition table ===================");
-    XF_LOGI(TAG, "| %-*.*s | %-*.*s |   offset   |    length  |",
-            (int)part_name_max, XF_FAL_DEV_NAME_MAX, item1,
-            (int)flash_dev_name_max, XF_FAL_DEV_NAME_MAX, item2);
-    XF_LOGI(TAG, "-------------------------------------------------------------");
-    for (i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
-        p_table     = sp_fal()->partition_table[i];
-        table_len   = sp_fal()->partition_table_len[i];
-        if ((NULL == p_table) || (0 == table_len)) {
+    /* 逐扇区更新 */
+    while (addr < end) {
+        len = (sector_size) ? (sector_size - addr % sector_size) : size;
+        len = (len < end - addr) ? len : (end - addr);
+        xf_ret = xf_fal_update_sector(flash_dev, addr, src, len, &result);
+        if (xf_ret != XF_OK) {
+            break;
+        }
+        addr += len;
+        src   = (const uint8_t *)src + len;
+    }
+    XF_FAL_RCACHE_INVALIDATE(handle->dev_idx, handle->base + offset, size);
+
+l_unlock_ret:;
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+    XF_FAL_STAT_PART(handle, XF_FAL_OP_WRITE, size, xf_ret, t0);
+    XF_FAL_TRACE_END(trace_seq, xf_ret);
+    if ((xf_ret != XF_OK) && (xf_ret != XF_ERR_NOT_SUPPORTED)) {
+        XF_LOGE(TAG, "Partition update error! "
+                "Flash device(%s) operation failed.", flash_dev->name);
+    }
+    if (p_result) {
+        *p_result = result;
+    }
+    XF_FAL_WEAR_SYNC_IF_NEEDED();
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_partition_copy(
+    const xf_fal_partition_t *src, size_t src_offset,
+    const xf_fal_partition_t *dst, size_t dst_offset, size_t size)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t src_handle;
+    xf_fal_handle_t dst_handle;
+
+    xf_ret = xf_fal_partition_get_handle(src, &src_handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    xf_ret = xf_fal_partition_get_handle(dst, &dst_handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    return xf_fal_handle_copy(&src_handle, src_offset, &dst_handle, dst_offset, size);
+}
+
+xf_err_t xf_fal_handle_copy(
+    const xf_fal_handle_t *src, size_t src_offset,
+    const xf_fal_handle_t *dst, size_t dst_offset, size_t size)
+{
+    xf_err_t xf_ret;
+    size_t sector_size;
+    size_t erase_end;
+    size_t erase_limit;
+    size_t done = 0;
+    size_t cur_len;
+    size_t next_len;
+    size_t len;
+    size_t idx = 0;
+#if XF_FAL_ASYNC_ENABLE
+    xf_fal_async_req_t req = {0};
+    bool is_prefetch;
+#endif
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!src || !dst || !size) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((src_offset > src->len) || (size > src->len - src_offset)
+            || (dst_offset > dst->len) || (size > dst->len - dst_offset)) {
+        XF_LOGE(TAG, "Partition copy error! "
+                "Partition(%s -> %s) address out of bound.",
+                src->partition->name, dst->partition->name);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    /* 目标擦除范围：从 dst_offset 起按扇区向上取整 */
+    sector_size = dst->flash_dev->sector_size;
+    erase_limit = dst_offset + size;
+    if (sector_size) {
+        if ((dst->base + dst_offset) % sector_size) {
+            XF_LOGE(TAG, "Partition copy error! "
+                    "Partition(%s) destination not aligned to sector.", dst->partition->name);
+            return XF_ERR_INVALID_ARG;
+        }
+        erase_limit = dst_offset + (size + sector_size - 1) / sector_size * sector_size;
+        if (erase_limit > dst->len) {
+            return XF_ERR_INVALID_ARG;
+        }
+    }
+    if ((src->dev_idx == dst->dev_idx)
+            && XF_FAL_RANGE_OVERLAP(src->base + src_offset, size,
+                                    dst->base + dst_offset, erase_limit - dst_offset)) {
+        XF_LOGE(TAG, "Partition copy error! "
+                "Partition(%s -> %s) ranges overlap.",
+                src->partition->name, dst->partition->name);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    XF_FAL_COPY_LOCK();
+    erase_end   = dst_offset;
+    cur_len     = (size < XF_FAL_COPY_BUF_SIZE) ? size : XF_FAL_COPY_BUF_SIZE;
+    xf_ret      = xf_fal_handle_read(src, src_offset, s_copy_buf[idx], cur_len);
+    while (XF_OK == xf_ret) {
+        next_len = size - done - cur_len;
+        next_len = (next_len < XF_FAL_COPY_BUF_SIZE) ? next_len : XF_FAL_COPY_BUF_SIZE;
+
+#if XF_FAL_ASYNC_ENABLE
+        /* 跨设备时在编程当前块的同时读取下一块 */
+        is_prefetch = false;
+        if ((next_len) && (src->dev_idx != dst->dev_idx)) {
+            req.op      = XF_FAL_OP_READ;
+            req.part    = src->partition;
+            req.offset  = src_offset + done + cur_len;
+            req.buf     = s_copy_buf[(idx + 1) % XF_FAL_COPY_BUF_NUM];
+            req.size    = next_len;
+            is_prefetch = (XF_OK == xf_fal_async_start(&req));
+        }
+#endif
+
+        /* 按需擦除，尽量使用大块擦除 */
+        while ((XF_OK == xf_ret) && (erase_end < dst_offset + done + cur_len)) {
+            len = xf_fal_erase_step(dst->flash_dev, dst->base + erase_end,
+                                    erase_limit - erase_end);
+            xf_ret = xf_fal_handle_erase(dst, erase_end, len);
+            erase_end += len;
+        }
+        if (XF_OK == xf_ret) {
+            xf_ret = xf_fal_handle_write(dst, dst_offset + done, s_copy_buf[idx], cur_len);
+        }
+        done += cur_len;
+        idx   = (idx + 1) % XF_FAL_COPY_BUF_NUM;
+
+#if XF_FAL_ASYNC_ENABLE
+        if (is_prefetch) {
+            /* 请求在栈上且使用复制缓冲区，出错时也要等待完成 */
+            while (!xf_fal_async_is_done(&req)) {
+                XF_FAL_ASYNC_BUSY_WAIT();
+            }
+            if (XF_OK == xf_ret) {
+                xf_ret = req.result;
+            }
+            cur_len = next_len;
             continue;
         }
-        for (j = 0; j < table_len; j++) {
-            part = &p_table[j];
-            XF_LOGI(TAG, "| %-*.*s | %-*.*s | 0x%08lx | 0x%08lx |",
-                    (int)part_name_max, XF_FAL_DEV_NAME_MAX, part->name,
-                    (int)flash_dev_name_max, XF_FAL_DEV_NAME_MAX, part->flash_name,
-                    part->offset, part->len);
+#endif
+        if ((XF_OK != xf_ret) || (0 == next_len)) {
+            break;
         }
+        xf_ret  = xf_fal_handle_read(src, src_offset + done, s_copy_buf[idx], next_len);
+        cur_len = next_len;
     }
-    XF_LOGI(TAG, "=============================================================");
+    XF_FAL_COPY_UNLOCK();
+
+    return xf_ret;
 }
 
-xf_err_t xf_fal_check_and_update_cache(void)
+xf_err_t xf_fal_partition_crc32(
+    const xf_fal_partition_t *part, size_t offset, size_t size, uint32_t *p_crc)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    return xf_fal_handle_crc32(&handle, offset, size, p_crc);
+}
+
+xf_err_t xf_fal_handle_crc32(
+    const xf_fal_handle_t *handle, size_t offset, size_t size, uint32_t *p_crc)
 {
     xf_err_t xf_ret = XF_OK;
-    const xf_fal_flash_dev_t *flash_dev;
-    const xf_fal_partition_t *p_table;
-    const xf_fal_partition_t *part;
-    size_t table_len;
-    size_t i;
-    size_t j;
 
-    XF_FAL_CTX_TRYLOCK__RETURN_ON_FAILURE(XF_ERR_BUSY);
-    sp_fal()->cached_num = 0;
-    for (i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
-        p_table     = sp_fal()->partition_table[i];
-        table_len   = sp_fal()->partition_table_len[i];
-        if ((NULL == p_table) || (0 == table_len)) {
-            continue;
-        }
-        for (j = 0; j < table_len; j++) {
-            part = &p_table[j];
-            flash_dev = xf_fal_flash_device_find(part->flash_name);
-            if (flash_dev == NULL) {
-                XF_LOGD(TAG, "Warning: Do NOT found the flash device(%s).",
-                        part->flash_name);
-                continue;
-            }
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!handle || !p_crc) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((offset > handle->len) || (size > handle->len - offset)) {
+        XF_LOGE(TAG, "Partition crc32 error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                handle->partition->name, (int)(offset + size), (int)handle->len);
+        return XF_ERR_INVALID_ARG;
+    }
 
-            if (part->offset >= (size_t)flash_dev->len) {
-                XF_LOGE(TAG, "Initialize failed! "
-                        "Partition(%s) offset address(%ld) out of flash bound(<%d).",
-                        part->name, part->offset, (int)flash_dev->len);;
-                xf_ret = XF_FAIL;
-                goto l_unlock_ret;
-            }
+    if (NULL == handle->flash_dev->ops.crc32) {
+        return xf_fal_handle_hash(handle, offset, size, xf_fal_crc32_update_cb, p_crc);
+    }
 
-            if (sp_fal()->cached_num >= XF_FAL_CACHE_NUM) {
-                XF_LOGW(TAG, "The cache is too small.");
-                continue;
-            }
+    /* 硬件直接读 flash, 先刷新范围内尚未写入的缓冲数据 */
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    xf_ret = xf_fal_wbuf_flush_range(handle->dev_idx, handle->base + offset, size, false, NULL);
+#endif
+    if ((XF_OK == xf_ret) && (size)) {
+        xf_ret = handle->flash_dev->ops.crc32(handle->base + offset, size, *p_crc, p_crc);
+    }
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+    if (xf_ret != XF_OK) {
+        XF_LOGE(TAG, "Partition crc32 error! "
+                "Flash device(%s) operation failed.", handle->flash_dev->name);
+    }
 
-            sp_fal()->cache[sp_fal()->cached_num].flash_dev = flash_dev;
-            sp_fal()->cache[sp_fal()->cached_num].partition = part;
-            ++sp_fal()->cached_num;
-        }
+    return xf_ret;
+}
+
+xf_err_t xf_fal_partition_hash(
+    const xf_fal_partition_t *part, size_t offset, size_t size,
+    xf_fal_hash_update_cb_t update, void *user_data)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
     }
 
-l_unlock_ret:;
-    XF_FAL_CTX_UNLOCK();
+    return xf_fal_handle_hash(&handle, offset, size, update, user_data);
+}
+
+xf_err_t xf_fal_handle_hash(
+    const xf_fal_handle_t *handle, size_t offset, size_t size,
+    xf_fal_hash_update_cb_t update, void *user_data)
+{
+    xf_err_t xf_ret = XF_OK;
+    uint8_t buf[XF_FAL_HASH_BUF_SIZE];
+    size_t len;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!handle || !update) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((offset > handle->len) || (size > handle->len - offset)) {
+        XF_LOGE(TAG, "Partition hash error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                handle->partition->name, (int)(offset + size), (int)handle->len);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    while ((size > 0) && (XF_OK == xf_ret)) {
+        len = (size < sizeof(buf)) ? size : sizeof(buf);
+        xf_ret = xf_fal_handle_read(handle, offset, buf, len);
+        if (XF_OK == xf_ret) {
+            xf_ret = update(user_data, buf, len);
+        }
+        offset += len;
+        size   -= len;
+    }
 
     return xf_ret;
 }
 
-/* ==================== [Static Functions] ================================== */
+xf_err_t xf_fal_partition_readv(
+    const xf_fal_partition_t *part, size_t src_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    return xf_fal_handle_readv(&handle, src_offset, iov, iovcnt);
+}
+
+xf_err_t xf_fal_partition_writev(
+    const xf_fal_partition_t *part, size_t dst_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    return xf_fal_handle_writev(&handle, dst_offset, iov, iovcnt);
+}
+
+xf_err_t xf_fal_handle_readv(
+    const xf_fal_handle_t *handle, size_t src_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    xf_err_t xf_ret = XF_OK;
+    size_t total;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!handle || !iov || !iovcnt) {
+        return XF_ERR_INVALID_ARG;
+    }
+    total = xf_fal_iov_total(iov, iovcnt);
+    if (0 == total) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((src_offset > handle->len) || (total > handle->len - src_offset)) {
+        XF_LOGE(TAG, "Partition readv error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                handle->partition->name, (int)(src_offset + total), (int)handle->len);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    XF_FAL_STAT_TIMESTAMP(t0);
+    XF_FAL_TRACE_BEGIN(trace_seq, handle, XF_FAL_OP_READ, src_offset, total);
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    /* 分散读不合并写缓冲中的数据，先写入重叠部分 */
+    xf_ret = xf_fal_wbuf_flush_range(
+                 handle->dev_idx, handle->base + src_offset, total, false, NULL);
+#endif
+    if (XF_OK == xf_ret) {
+        xf_ret = xf_fal_dev_readv(handle->flash_dev, handle->dev_idx,
+                                  handle->base + src_offset, iov, iovcnt);
+    }
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+    XF_FAL_STAT_PART(handle, XF_FAL_OP_READ, total, xf_ret, t0);
+    XF_FAL_TRACE_END(trace_seq, xf_ret);
+    if (xf_ret != XF_OK) {
+        XF_LOGE(TAG, "Partition readv error! "
+                "Flash device(%s) read failed.", handle->flash_dev->name);
+    }
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_handle_writev(
+    const xf_fal_handle_t *handle, size_t dst_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    xf_err_t xf_ret = XF_OK;
+    size_t total;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (!handle || !iov || !iovcnt) {
+        return XF_ERR_INVALID_ARG;
+    }
+    total = xf_fal_iov_total(iov, iovcnt);
+    if (0 == total) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((dst_offset > handle->len) || (total > handle->len - dst_offset)) {
+        XF_LOGE(TAG, "Partition writev error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                handle->partition->name, (int)(dst_offset + total), (int)handle->len);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    XF_FAL_STAT_TIMESTAMP(t0);
+    XF_FAL_TRACE_BEGIN(trace_seq, handle, XF_FAL_OP_WRITE, dst_offset, total);
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    xf_ret = xf_fal_wbuf_flush_range(
+                 handle->dev_idx, handle->base + dst_offset, total, false, NULL);
+#endif
+    if (XF_OK == xf_ret) {
+        xf_ret = xf_fal_dev_writev(handle->flash_dev, handle->base + dst_offset,
+                                   iov, iovcnt, total);
+    }
+    XF_FAL_RCACHE_INVALIDATE(handle->dev_idx, handle->base + dst_offset, total);
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+    XF_FAL_STAT_PART(handle, XF_FAL_OP_WRITE, total, xf_ret, t0);
+    XF_FAL_TRACE_END(trace_seq, xf_ret);
+    if (xf_ret != XF_OK) {
+        XF_LOGE(TAG, "Partition writev error! "
+                "Flash device(%s) write failed.", handle->flash_dev->name);
+    }
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_partition_erase_all(const xf_fal_partition_t *part)
+{
+    return xf_fal_partition_erase(part, 0, part->len);
+}
+
+#if XF_FAL_WRITE_BUFFER_ENABLE
+
+xf_err_t xf_fal_write_buffer_attach(
+    const xf_fal_partition_t *part, xf_fal_write_buffer_t *wbuf)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+    xf_fal_write_buffer_t *p;
+
+    if (NULL == wbuf) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    XF_FAL_DEV_LOCK(handle.dev_idx);
+    for (p = sp_fal()->wbuf_list[handle.dev_idx]; p; p = p->next) {
+        if ((p == wbuf) || (p->handle.partition == part)) {
+            xf_ret = XF_ERR_INITED;
+            goto l_unlock_ret;
+        }
+    }
+    wbuf->handle    = handle;
+    wbuf->page_size = handle.flash_dev->page_size;
+    if ((0 == wbuf->page_size) || (wbuf->page_size > sizeof(wbuf->data))) {
+        wbuf->page_size = sizeof(wbuf->data);
+    }
+    wbuf->addr      = 0;
+    wbuf->len       = 0;
+    wbuf->next      = sp_fal()->wbuf_list[handle.dev_idx];
+    sp_fal()->wbuf_list[handle.dev_idx] = wbuf;
+
+l_unlock_ret:;
+    XF_FAL_DEV_UNLOCK(handle.dev_idx);
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_write_buffer_detach(const xf_fal_partition_t *part)
+{
+    xf_err_t xf_ret;
+    xf_fal_handle_t handle;
+    xf_fal_write_buffer_t *wbuf;
+    xf_fal_write_buffer_t **p_link;
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    XF_FAL_DEV_LOCK(handle.dev_idx);
+    wbuf = xf_fal_wbuf_find(handle.dev_idx, part, &p_link);
+    if (wbuf) {
+        xf_ret  = xf_fal_wbuf_flush(wbuf);
+        *p_link = wbuf->next;
+        wbuf->next = NULL;
+    } else {
+        xf_ret = XF_ERR_NOT_FOUND;
+    }
+    XF_FAL_DEV_UNLOCK(handle.dev_idx);
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_write_buffer_flush(const xf_fal_partition_t *part)
+{
+    xf_err_t xf_ret = XF_OK;
+    xf_err_t xf_ret_tmp;
+    xf_fal_handle_t handle;
+    xf_fal_write_buffer_t *wbuf;
+
+    if (NULL == part) {
+        for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+            XF_FAL_DEV_LOCK(i);
+            for (wbuf = sp_fal()->wbuf_list[i]; wbuf; wbuf = wbuf->next) {
+                xf_ret_tmp = xf_fal_wbuf_flush(wbuf);
+                if (xf_ret_tmp != XF_OK) {
+                    xf_ret = xf_ret_tmp;
+                }
+            }
+            XF_FAL_DEV_UNLOCK(i);
+        }
+        return xf_ret;
+    }
+
+    xf_ret = xf_fal_partition_get_handle(part, &handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    XF_FAL_DEV_LOCK(handle.dev_idx);
+    wbuf = xf_fal_wbuf_find(handle.dev_idx, part, NULL);
+    xf_ret = (wbuf) ? xf_fal_wbuf_flush(wbuf) : XF_ERR_NOT_FOUND;
+    XF_FAL_DEV_UNLOCK(handle.dev_idx);
+
+    return xf_ret;
+}
+
+#endif // XF_FAL_WRITE_BUFFER_ENABLE
+
+#if XF_FAL_READ_CACHE_NUM > 0
+
+xf_err_t xf_fal_read_cache_get_stat(xf_fal_read_cache_stat_t *p_stat)
+{
+    if (NULL == p_stat) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_FAL_RCACHE_LOCK();
+    *p_stat = sp_fal()->rcache.stat;
+    XF_FAL_RCACHE_UNLOCK();
+    return XF_OK;
+}
+
+void xf_fal_read_cache_reset_stat(void)
+{
+    XF_FAL_RCACHE_LOCK();
+    memset(&sp_fal()->rcache.stat, 0, sizeof(sp_fal()->rcache.stat));
+    XF_FAL_RCACHE_UNLOCK();
+}
+
+void xf_fal_read_cache_invalidate(
+    const xf_fal_handle_t *handle, size_t offset, size_t size)
+{
+    if (NULL == handle) {
+        for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+            xf_fal_rcache_invalidate(i, 0, 0);
+        }
+        return;
+    }
+    if ((offset > handle->len) || (0 == size)) {
+        return;
+    }
+    if (size > handle->len - offset) {
+        size = handle->len - offset;
+    }
+    xf_fal_rcache_invalidate(handle->dev_idx, handle->base + offset, size);
+}
+
+#endif // XF_FAL_READ_CACHE_NUM
+
+#if XF_FAL_STAT_ENABLE
+
+void xf_fal_stat_set_clock(xf_fal_stat_clock_t clock)
+{
+    sp_fal()->stat_clock = clock;
+}
+
+xf_err_t xf_fal_partition_get_stat(
+    const xf_fal_partition_t *part, xf_fal_stat_t *p_stat)
+{
+    const xf_fal_stat_t *stat;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if ((NULL == part) || (NULL == p_stat)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    stat = xf_fal_stat_part_find(part);
+    if (NULL == stat) {
+        return XF_ERR_NOT_FOUND;
+    }
+    /* 计数逐个原子更新，快照内各计数之间不保证一致 */
+    *p_stat = *stat;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_flash_device_get_stat(
+    const xf_fal_flash_dev_t *flash_dev, xf_fal_stat_t *p_stat)
+{
+    const xf_fal_stat_t *stat;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if ((NULL == flash_dev) || (NULL == p_stat)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    stat = xf_fal_stat_dev_find(flash_dev);
+    if (NULL == stat) {
+        return XF_ERR_NOT_FOUND;
+    }
+    *p_stat = *stat;
+
+    return XF_OK;
+}
+
+void xf_fal_stat_reset(void)
+{
+    memset(sp_fal()->stat_dev, 0, sizeof(sp_fal()->stat_dev));
+    memset(sp_fal()->stat_part, 0, sizeof(sp_fal()->stat_part));
+}
+
+void xf_fal_show_stat(void)
+{
+    static const char *const op_name[XF_FAL_OP_MAX] = {"read", "write", "erase"};
+    const xf_fal_snapshot_t *snap;
+    const xf_fal_stat_t *stat;
+    const xf_fal_stat_op_t *op_stat;
+    const char *name;
+    size_t i;
+    size_t op;
+
+    XF_FAL_CTX_LOCK__LOG_ON_FAILURE("FAL statistics");
+    snap = sp_snap();
+
+    XF_LOGI(TAG, "======================= FAL statistics ========================");
+    XF_LOGI(TAG, "| %-*s | op    |      count |  err |       bytes |   time_sum |",
+            XF_FAL_DEV_NAME_MAX, "name");
+    XF_LOGI(TAG, "---------------------------------------------------------------");
+    for (i = 0; i < XF_FAL_FLASH_DEVICE_NUM + snap->cached_num; i++) {
+        if (i < XF_FAL_FLASH_DEVICE_NUM) {
+            if (NULL == snap->flash_device_table[i]) {
+                continue;
+            }
+            name = snap->flash_device_table[i]->name;
+            stat = &sp_fal()->stat_dev[i];
+        } else {
+            if (i == XF_FAL_FLASH_DEVICE_NUM) {
+                XF_LOGI(TAG, "---------------------------------------------------------------");
+            }
+            name = snap->cache[i - XF_FAL_FLASH_DEVICE_NUM].partition->name;
+            stat = xf_fal_stat_part_find(snap->cache[i - XF_FAL_FLASH_DEVICE_NUM].partition);
+            if (NULL == stat) {
+                continue;
+            }
+        }
+        for (op = 0; op < XF_FAL_OP_MAX; op++) {
+            op_stat = &stat->op[op];
+            if (0 == op_stat->cnt) {
+                continue;
+            }
+            XF_LOGI(TAG, "| %-*.*s | %-5s | %10lu | %4lu | %11lu | %10lu |",
+                    XF_FAL_DEV_NAME_MAX, XF_FAL_DEV_NAME_MAX, name, op_name[op],
+                    (unsigned long)op_stat->cnt, (unsigned long)op_stat->err_cnt,
+                    (unsigned long)op_stat->bytes, (unsigned long)op_stat->time_sum);
+        }
+    }
+    XF_LOGI(TAG, "===============================================================");
+
+    XF_FAL_CTX_UNLOCK();
+}
+
+#endif // XF_FAL_STAT_ENABLE
+
+#if XF_FAL_TRACE_ENABLE
+
+void xf_fal_trace_set_clock(xf_fal_stat_clock_t clock)
+{
+    sp_fal()->trace_clock = clock;
+}
+
+void xf_fal_trace_reset(void)
+{
+    memset(sp_fal()->trace_ring, 0, sizeof(sp_fal()->trace_ring));
+    sp_fal()->trace_head = 0;
+}
+
+xf_err_t xf_fal_trace_dump(xf_fal_trace_write_cb_t write, void *user_data)
+{
+    xf_err_t xf_ret;
+    const xf_fal_snapshot_t *snap;
+    xf_fal_trace_hdr_t hdr = {0};
+    xf_fal_trace_part_t part;
+    xf_fal_trace_rec_t rec;
+    uint32_t seq;
+    size_t len;
+    size_t i;
+
+    if (!sp_fal()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (NULL == write) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    XF_FAL_SNAPSHOT_READ_BEGIN(snap, seq);
+    hdr.part_num    = snap->cached_num;
+    XF_FAL_SNAPSHOT_READ_END(seq);
+    hdr.magic       = XF_FAL_TRACE_MAGIC;
+    hdr.version     = XF_FAL_TRACE_VERSION;
+    hdr.rec_size    = sizeof(xf_fal_trace_rec_t);
+    hdr.rec_num     = XF_FAL_TRACE_NUM;
+    hdr.head        = sp_fal()->trace_head;
+    xf_ret = write(user_data, &hdr, sizeof(hdr));
+
+    /* 回调在快照读取之外调用；期间分区缓存变小时，多出的项写为空 */
+    for (i = 0; (XF_OK == xf_ret) && (i < hdr.part_num); i++) {
+        XF_FAL_SNAPSHOT_READ_BEGIN(snap, seq);
+        memset(&part, 0, sizeof(part));
+        if (i < snap->cached_num) {
+            len = xf_strlen(snap->cache[i].partition->name);
+            if (len > sizeof(part.name)) {
+                len = sizeof(part.name);
+            }
+            memcpy(part.name, snap->cache[i].partition->name, len);
+            part.part_id    = xf_fal_trace_part_id(snap->cache[i].name_hash);
+            part.len        = snap->cache[i].partition->len;
+        }
+        XF_FAL_SNAPSHOT_READ_END(seq);
+        xf_ret = write(user_data, &part, sizeof(part));
+    }
+
+    /* 从最旧的记录开始 */
+    for (i = 0; (XF_OK == xf_ret) && (i < XF_FAL_TRACE_NUM); i++) {
+        rec = sp_fal()->trace_ring[(hdr.head + i) & (XF_FAL_TRACE_NUM - 1)];
+        xf_ret = write(user_data, &rec, sizeof(rec));
+    }
+
+    return xf_ret;
+}
+
+#endif // XF_FAL_TRACE_ENABLE
+
+void xf_fal_show_part_table(void)
+{
+    const xf_fal_snapshot_t *snap;
+    const xf_fal_partition_t *p_table;
+    size_t table_len;
+    const xf_fal_partition_t *part;
+    size_t i;
+    size_t j;
+    char *item1                 = "name";
+    char *item2                 = "flash_dev";
+    size_t part_name_max        = strlen(item1);
+    size_t flash_dev_name_max   = strlen(item2);
+    size_t len_max;
+
+    /* 持有写者锁，打印期间快照不会被改写 */
+    XF_FAL_CTX_LOCK__LOG_ON_FAILURE("FAL partition table");
+    snap = sp_snap();
+
+    for (i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
+        p_table     = snap->partition_table[i];
+        table_len   = snap->partition_table_len[i];
+        if ((NULL == p_table) || (0 == table_len)) {
+            continue;
+        }
+        for (j = 0; j < table_len; j++) {
+            part = &p_table[j];
+            len_max = xf_strlen(part->name);
+            if (part_name_max < len_max) {
+                part_name_max = len_max;
+            }
+            len_max = xf_strlen(part->flash_name);
+            if (flash_dev_name_max < len_max) {
+                flash_dev_name_max = len_max;
+            }
+        }
+    }
+
+    XF_LOGI(TAG, "==================== FAL partition table ===================");
+    XF_LOGI(TAG, "| %-*.*s | %-*.*s |   offset   |    length  |",
+            (int)part_name_max, XF_FAL_DEV_NAME_MAX, item1,
+            (int)flash_dev_name_max, XF_FAL_DEV_NAME_MAX, item2);
+    XF_LOGI(TAG, "-------------------------------------------------------------");
+    for (i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
+        p_table     = snap->partition_table[i];
+        table_len   = snap->partition_table_len[i];
+        if ((NULL == p_table) || (0 == table_len)) {
+            continue;
+        }
+        for (j = 0; j < table_len; j++) {
+            part = &p_table[j];
+            XF_LOGI(TAG, "| %-*.*s | %-*.*s | 0x%08lx | 0x%08lx |",
+                    (int)part_name_max, XF_FAL_DEV_NAME_MAX, part->name,
+                    (int)flash_dev_name_max, XF_FAL_DEV_NAME_MAX, part->flash_name,
+                    part->offset, part->len);
+        }
+    }
+    XF_LOGI(TAG, "=============================================================");
+
+    XF_FAL_CTX_UNLOCK();
+}
+
+xf_err_t xf_fal_check_and_update_cache(void)
+{
+    xf_err_t xf_ret = XF_OK;
+    xf_fal_snapshot_t *next;
+    const xf_fal_flash_dev_t *flash_dev;
+    const xf_fal_partition_t *p_table;
+    const xf_fal_partition_t *part;
+    size_t table_len;
+    size_t dev_idx;
+    size_t i;
+    size_t j;
+
+    XF_FAL_CTX_TRYLOCK__RETURN_ON_FAILURE(XF_ERR_BUSY);
+    next = xf_fal_snapshot_begin();
+    next->cached_num    = 0;
+    next->part_num      = 0;
+    next->is_stale      = false;
+    memset(next->hash_index, 0, sizeof(next->hash_index));
+    for (i = 0; i < XF_FAL_PARTITION_TABLE_NUM; i++) {
+        p_table     = next->partition_table[i];
+        table_len   = next->partition_table_len[i];
+        if ((NULL == p_table) || (0 == table_len)) {
+            continue;
+        }
+        for (j = 0; j < table_len; j++) {
+            part = &p_table[j];
+            ++next->part_num;
+            flash_dev = xf_fal_snapshot_device_find(next, part->flash_name, &dev_idx);
+            if (flash_dev == NULL) {
+                XF_LOGD(TAG, "Warning: Do NOT found the flash device(%s).",
+                        part->flash_name);
+                continue;
+            }
+
+            if (part->offset >= (size_t)flash_dev->len) {
+                XF_LOGE(TAG, "Initialize failed! "
+                        "Partition(%s) offset address(%ld) out of flash bound(<%d).",
+                        part->name, part->offset, (int)flash_dev->len);;
+                xf_ret = XF_FAIL;
+                /* 校验失败，放弃本次修改，保留原快照 */
+                xf_fal_snapshot_abort();
+                goto l_unlock_ret;
+            }
+
+            if (next->cached_num >= XF_FAL_CACHE_NUM) {
+                XF_LOGW(TAG, "The cache is too small.");
+                continue;
+            }
+
+            next->cache[next->cached_num].flash_dev = flash_dev;
+            next->cache[next->cached_num].dev_idx   = dev_idx;
+            next->cache[next->cached_num].partition = part;
+            next->cache[next->cached_num].name_hash = xf_fal_name_hash(part->name);
+            xf_fal_hash_index_insert(next, next->cached_num);
+#if XF_FAL_STAT_ENABLE
+            (void)xf_fal_stat_part_slot(part, true);
+#endif
+            ++next->cached_num;
+        }
+    }
+    xf_fal_snapshot_publish(next);
+
+l_unlock_ret:;
+    XF_FAL_CTX_UNLOCK();
+
+    return xf_ret;
+}
+
+#if XF_FAL_ASYNC_ENABLE
+
+xf_err_t xf_fal_async_op_begin(
+    const xf_fal_handle_t *handle, xf_fal_op_t op, size_t offset, size_t size,
+    uint32_t *p_t0, uint32_t *p_trace_seq)
+{
+    xf_err_t xf_ret = XF_OK;
+
+#if XF_FAL_STAT_ENABLE
+    *p_t0 = xf_fal_stat_now();
+#endif
+#if XF_FAL_TRACE_ENABLE
+    *p_trace_seq = xf_fal_trace_begin(handle, op, offset, size);
+#endif
+    XF_FAL_DEV_LOCK(handle->dev_idx);
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    /* 驱动直接访问 flash, 先写入重叠的缓冲数据，擦除时丢弃被完全擦除的 */
+    xf_ret = xf_fal_wbuf_flush_range(handle->dev_idx, handle->base + offset, size,
+                                     (XF_FAL_OP_ERASE == op), NULL);
+#endif
+    if (XF_OK == xf_ret) {
+        sp_fal()->dev_async_busy[handle->dev_idx] = true;
+    }
+    XF_FAL_DEV_UNLOCK(handle->dev_idx);
+
+    return xf_ret;
+}
+
+void xf_fal_async_op_end(
+    const xf_fal_handle_t *handle, xf_fal_op_t op, size_t offset, size_t size,
+    xf_err_t result, uint32_t t0, uint32_t trace_seq)
+{
+    if (XF_FAL_OP_READ != op) {
+        XF_FAL_RCACHE_INVALIDATE(handle->dev_idx, handle->base + offset, size);
+    }
+    if ((XF_FAL_OP_ERASE == op) && (XF_OK == result)) {
+        XF_FAL_WEAR_RECORD(handle->flash_dev, handle->base + offset, size);
+    }
+    XF_FAL_MEMORY_BARRIER();
+    sp_fal()->dev_async_busy[handle->dev_idx] = false;
+#if XF_FAL_STAT_ENABLE
+    xf_fal_stat_record(xf_fal_stat_dev_find(handle->flash_dev), op, size, result, t0);
+#endif
+    XF_FAL_STAT_PART(handle, op, size, result, t0);
+    XF_FAL_TRACE_END(trace_seq, result);
+    if (XF_FAL_OP_ERASE == op) {
+        XF_FAL_WEAR_SYNC_IF_NEEDED();
+    }
+}
+
+#endif // XF_FAL_ASYNC_ENABLE
+
+/* ==================== [Static Functions] ================================== */
+
+#if XF_FAL_ASYNC_ENABLE
+/**
+ * @brief 取得设备锁，并等待设备上 async_start 启动的操作完成。
+ *
+ * 完成时 xf_fal_async_op_end() 不需要设备锁，因此持锁等待。
+ */
+static void xf_fal_dev_lock_wait_async(size_t dev_idx)
+{
+#if XF_FAL_LOCK_IS_ENABLE
+    if (sp_fal()->dev_mutex[dev_idx]) {
+        xf_lock_lock(sp_fal()->dev_mutex[dev_idx]);
+    }
+#endif
+    while (sp_fal()->dev_async_busy[dev_idx]) {
+        XF_FAL_ASYNC_BUSY_WAIT();
+    }
+    XF_FAL_READ_BARRIER();
+}
+#endif
+
+/**
+ * @brief 开始修改注册表：将当前快照复制到未发布的快照上。
+ *
+ * @attention 调用者需持有 xf_fal_ctx_t.mutex, 且之后必须调用
+ *            xf_fal_snapshot_publish() 或 xf_fal_snapshot_abort().
+ *
+ * @return xf_fal_snapshot_t* 未发布的快照，可以修改。
+ */
+static xf_fal_snapshot_t *xf_fal_snapshot_begin(void)
+{
+    xf_fal_snapshot_t *next;
+
+    next = (sp_snap() == &sp_fal()->snapshot[0])
+           ? &sp_fal()->snapshot[1] : &sp_fal()->snapshot[0];
+    /* 序号变为奇数，仍持有 next 旧指针的读者会重试 */
+    ++sp_fal()->seq;
+    XF_FAL_MEMORY_BARRIER();
+    *next = *sp_snap();
+
+    return next;
+}
+
+static void xf_fal_snapshot_publish(xf_fal_snapshot_t *next)
+{
+    XF_FAL_MEMORY_BARRIER();
+    sp_fal()->p_snapshot = next;
+    XF_FAL_MEMORY_BARRIER();
+    ++sp_fal()->seq;
+}
+
+static void xf_fal_snapshot_abort(void)
+{
+    XF_FAL_MEMORY_BARRIER();
+    ++sp_fal()->seq;
+}
+
+/**
+ * @brief 在快照中按名称查找 flash 设备。
+ *
+ * @param snap          快照。
+ * @param name          flash 设备名。
+ * @param[out] p_dev_idx 设备在 flash_device_table 中的下标，可以为 NULL.
+ */
+static const xf_fal_flash_dev_t *xf_fal_snapshot_device_find(
+    const xf_fal_snapshot_t *snap, const char *name, size_t *p_dev_idx)
+{
+    const xf_fal_flash_dev_t *flash_device;
+    size_t i;
+
+    for (i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        flash_device = snap->flash_device_table[i];
+        if (!flash_device) {
+            continue;
+        }
+        if (0 == xf_strncmp(name, flash_device->name, XF_FAL_DEV_NAME_MAX)) {
+            if (p_dev_idx) {
+                *p_dev_idx = i;
+            }
+            return flash_device;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 查找分区关联的 flash 设备。
+ *
+ * 缓存有效时通过哈希索引查找，否则按 flash 设备名遍历。
+ *
+ * @param part          分区。
+ * @param[out] p_dev_idx 设备在 flash_device_table 中的下标，可以为 NULL.
+ */
+static const xf_fal_flash_dev_t *xf_fal_part_resolve(
+    const xf_fal_partition_t *part, size_t *p_dev_idx)
+{
+    const xf_fal_snapshot_t *snap;
+    const xf_fal_flash_dev_t *flash_dev;
+    const xf_fal_cache_t *cache;
+    size_t dev_idx;
+    uint32_t seq;
+
+    XF_FAL_SNAPSHOT_READ_BEGIN(snap, seq);
+    flash_dev   = NULL;
+    dev_idx     = 0;
+    if ((0 != snap->cached_num) && (!snap->is_stale)) {
+        cache = xf_fal_hash_index_find(snap, part->name, part);
+        if (cache) {
+            flash_dev   = cache->flash_dev;
+            dev_idx     = cache->dev_idx;
+        }
+    }
+    /* 未注册或未找到时遍历 */
+    if (!flash_dev) {
+        flash_dev = xf_fal_snapshot_device_find(snap, part->flash_name, &dev_idx);
+    }
+    XF_FAL_SNAPSHOT_READ_END(seq);
+
+    if (p_dev_idx) {
+        *p_dev_idx = dev_idx;
+    }
+
+    return flash_dev;
+}
+
+/**
+ * @brief xf_fal_handle_hash() 的 CRC32 回调，user_data 为 uint32_t 型 CRC 累计值。
+ */
+static xf_err_t xf_fal_crc32_update_cb(void *user_data, const void *data, size_t size)
+{
+    uint32_t *p_crc = user_data;
+
+    *p_crc = xf_fal_crc32(*p_crc, data, size);
+
+    return XF_OK;
+}
+
+/**
+ * @brief 计算分区名的哈希值 (FNV-1a)。
+ *
+ * 与 xf_strncmp 的比较范围一致，最多计算 XF_FAL_DEV_NAME_MAX 个字符。
+ */
+static uint32_t xf_fal_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; (i < XF_FAL_DEV_NAME_MAX) && (name[i] != '\0'); i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static void xf_fal_hash_index_insert(xf_fal_snapshot_t *snap, size_t cache_idx)
+{
+    size_t slot;
+    size_t i;
+
+    slot = snap->cache[cache_idx].name_hash % XF_FAL_HASH_INDEX_NUM;
+    for (i = 0; i < XF_FAL_HASH_INDEX_NUM; i++) {
+        if (0 == snap->hash_index[slot]) {
+            snap->hash_index[slot] = (uint16_t)(cache_idx + 1);
+            return;
+        }
+        slot = (slot + 1) % XF_FAL_HASH_INDEX_NUM;
+    }
+}
+
+/**
+ * @brief 在哈希索引中查找分区。
+ *
+ * @param snap  快照。
+ * @param name  分区名。
+ * @param part  不为 NULL 时按分区指针匹配（用于同名分区），否则按分区名匹配。
+ * @return const xf_fal_cache_t* 命中的缓存项，未命中返回 NULL.
+ */
+static const xf_fal_cache_t *xf_fal_hash_index_find(
+    const xf_fal_snapshot_t *snap,
+    const char *name, const xf_fal_partition_t *part)
+{
+    const xf_fal_cache_t *cache;
+    uint32_t name_hash;
+    size_t slot;
+    size_t i;
+
+    name_hash = xf_fal_name_hash(name);
+    slot = name_hash % XF_FAL_HASH_INDEX_NUM;
+    for (i = 0; i < XF_FAL_HASH_INDEX_NUM; i++) {
+        if (0 == snap->hash_index[slot]) {
+            break;
+        }
+        cache = &snap->cache[snap->hash_index[slot] - 1];
+        /* 快照正被改写时可能读到空缓存项，由调用者重试 */
+        if (NULL == cache->partition) {
+            break;
+        }
+        if (part) {
+            if (cache->partition == part) {
+                return cache;
+            }
+        } else if ((cache->name_hash == name_hash)
+                   && (0 == xf_strncmp(name, cache->partition->name,
+                                       XF_FAL_DEV_NAME_MAX))) {
+            return cache;
+        }
+        slot = (slot + 1) % XF_FAL_HASH_INDEX_NUM;
+    }
+
+    return NULL;
+}
+
+#if XF_FAL_STAT_ENABLE
+
+static uint32_t xf_fal_stat_now(void)
+{
+    xf_fal_stat_clock_t clock = sp_fal()->stat_clock;
+
+    return (clock) ? clock() : 0;
+}
+
+/**
+ * @brief 耗时所在的直方图桶：0 为耗时 0, 否则为耗时的有效位数，超出的归入最后一桶。
+ */
+static size_t xf_fal_stat_bucket(uint32_t dt)
+{
+    size_t bucket;
+
+#if defined(__GNUC__)
+    bucket = (dt) ? (sizeof(unsigned long) * 8 - __builtin_clzl(dt)) : 0;
+#else
+    for (bucket = 0; dt; bucket++) {
+        dt >>= 1;
+    }
+#endif
+
+    return (bucket < XF_FAL_STAT_HIST_NUM) ? bucket : (XF_FAL_STAT_HIST_NUM - 1);
+}
+
+/**
+ * @brief 记录一次操作。
+ *
+ * @param stat   统计，为 NULL 时忽略。
+ * @param op     操作类型。
+ * @param size   操作大小，仅在成功时计入字节数。
+ * @param result 操作结果。
+ * @param t0     xf_fal_stat_now() 取得的开始时间。
+ */
+static void xf_fal_stat_record(
+    xf_fal_stat_t *stat, xf_fal_op_t op, size_t size, xf_err_t result, uint32_t t0)
+{
+    xf_fal_stat_op_t *op_stat;
+    xf_fal_stat_clock_t clock;
+    uint32_t dt;
+
+    if (NULL == stat) {
+        return;
+    }
+    op_stat = &stat->op[op];
+    XF_FAL_STAT_ADD(&op_stat->cnt, 1);
+    if (XF_OK == result) {
+        XF_FAL_STAT_ADD(&op_stat->bytes, size);
+    } else {
+        XF_FAL_STAT_ADD(&op_stat->err_cnt, 1);
+    }
+
+    clock = sp_fal()->stat_clock;
+    if (NULL == clock) {
+        return;
+    }
+    dt = clock() - t0;
+    XF_FAL_STAT_ADD(&op_stat->time_sum, dt);
+    XF_FAL_STAT_ADD(&op_stat->hist[xf_fal_stat_bucket(dt)], 1);
+}
+
+/**
+ * @brief 在分区统计槽中查找（或插入）分区。
+ *
+ * @param part      分区。
+ * @param is_insert 未找到时是否占用空槽。插入只在更新缓存时（持有写者锁）进行。
+ * @return size_t 槽下标，未找到或已满时返回 XF_FAL_STAT_PART_NUM.
+ */
+static size_t xf_fal_stat_part_slot(const xf_fal_partition_t *part, bool is_insert)
+{
+    const xf_fal_partition_t *key;
+    size_t slot;
+    size_t i;
+
+    slot = ((uintptr_t)part / sizeof(xf_fal_partition_t)) % XF_FAL_STAT_PART_NUM;
+    for (i = 0; i < XF_FAL_STAT_PART_NUM; i++) {
+        key = sp_fal()->stat_part_key[slot];
+        if (key == part) {
+            return slot;
+        }
+        if (NULL == key) {
+            if (!is_insert) {
+                break;
+            }
+            memset(&sp_fal()->stat_part[slot], 0, sizeof(sp_fal()->stat_part[slot]));
+            XF_FAL_MEMORY_BARRIER();
+            sp_fal()->stat_part_key[slot] = part;
+            return slot;
+        }
+        slot = (slot + 1) % XF_FAL_STAT_PART_NUM;
+    }
+
+    return XF_FAL_STAT_PART_NUM;
+}
+
+static xf_fal_stat_t *xf_fal_stat_part_find(const xf_fal_partition_t *part)
+{
+    size_t slot = xf_fal_stat_part_slot(part, false);
+
+    return (slot < XF_FAL_STAT_PART_NUM) ? &sp_fal()->stat_part[slot] : NULL;
+}
+
+static xf_fal_stat_t *xf_fal_stat_dev_find(const xf_fal_flash_dev_t *flash_dev)
+{
+    const xf_fal_snapshot_t *snap;
+    uint32_t seq;
+    size_t i;
+
+    XF_FAL_SNAPSHOT_READ_BEGIN(snap, seq);
+    for (i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        if (snap->flash_device_table[i] == flash_dev) {
+            break;
+        }
+    }
+    XF_FAL_SNAPSHOT_READ_END(seq);
+
+    return (i < XF_FAL_FLASH_DEVICE_NUM) ? &sp_fal()->stat_dev[i] : NULL;
+}
+
+static xf_err_t xf_fal_drv_read(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, void *dst, size_t size)
+{
+    xf_err_t xf_ret;
+    uint32_t t0 = xf_fal_stat_now();
+
+    xf_ret = flash_dev->ops.read(addr, dst, size);
+    xf_fal_stat_record(xf_fal_stat_dev_find(flash_dev), XF_FAL_OP_READ, size, xf_ret, t0);
+
+    return xf_ret;
+}
+
+static xf_err_t xf_fal_drv_write(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const void *src, size_t size)
+{
+    xf_err_t xf_ret;
+    uint32_t t0 = xf_fal_stat_now();
+
+    xf_ret = flash_dev->ops.write(addr, src, size);
+    xf_fal_stat_record(xf_fal_stat_dev_find(flash_dev), XF_FAL_OP_WRITE, size, xf_ret, t0);
+
+    return xf_ret;
+}
+
+static xf_err_t xf_fal_drv_erase(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size)
+{
+    xf_err_t xf_ret;
+    uint32_t t0 = xf_fal_stat_now();
+
+    xf_ret = flash_dev->ops.erase(addr, size);
+    xf_fal_stat_record(xf_fal_stat_dev_find(flash_dev), XF_FAL_OP_ERASE, size, xf_ret, t0);
+
+    return xf_ret;
+}
+
+static xf_err_t xf_fal_drv_readv(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    xf_err_t xf_ret;
+    uint32_t t0 = xf_fal_stat_now();
+
+    xf_ret = flash_dev->ops.readv(addr, iov, iovcnt);
+    xf_fal_stat_record(xf_fal_stat_dev_find(flash_dev), XF_FAL_OP_READ,
+                       xf_fal_iov_total(iov, iovcnt), xf_ret, t0);
+
+    return xf_ret;
+}
+
+static xf_err_t xf_fal_drv_writev(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    xf_err_t xf_ret;
+    uint32_t t0 = xf_fal_stat_now();
+
+    xf_ret = flash_dev->ops.writev(addr, iov, iovcnt);
+    xf_fal_stat_record(xf_fal_stat_dev_find(flash_dev), XF_FAL_OP_WRITE,
+                       xf_fal_iov_total(iov, iovcnt), xf_ret, t0);
+
+    return xf_ret;
+}
+
+#endif // XF_FAL_STAT_ENABLE
+
+#if XF_FAL_TRACE_ENABLE
+
+static uint16_t xf_fal_trace_part_id(uint32_t name_hash)
+{
+    return (uint16_t)(name_hash ^ (name_hash >> 16));
+}
+
+/**
+ * @brief 占用一条跟踪记录并写入操作信息。
+ *
+ * @return uint32_t 记录序号，传给 xf_fal_trace_end().
+ */
+static uint32_t xf_fal_trace_begin(
+    const xf_fal_handle_t *handle, xf_fal_op_t op, size_t offset, size_t size)
+{
+    xf_fal_stat_clock_t clock = sp_fal()->trace_clock;
+    xf_fal_trace_rec_t *rec;
+    uint32_t seq;
+
+    do {
+        seq = XF_FAL_FETCH_ADD(&sp_fal()->trace_head, 1) + 1;
+    } while (0 == seq);
+    rec = &sp_fal()->trace_ring[(seq - 1) & (XF_FAL_TRACE_NUM - 1)];
+
+    rec->seq        = 0;
+    rec->timestamp  = (clock) ? clock() : 0;
+    rec->duration   = XF_FAL_TRACE_IN_FLIGHT;
+    rec->offset     = (uint32_t)offset;
+    rec->size       = (uint32_t)size;
+    rec->part_id    = handle->part_id;
+    rec->op         = (uint8_t)op;
+    rec->result     = 0;
+    rec->seq        = seq;
+
+    return seq;
+}
+
+static void xf_fal_trace_end(uint32_t seq, xf_err_t result)
+{
+    xf_fal_stat_clock_t clock = sp_fal()->trace_clock;
+    xf_fal_trace_rec_t *rec;
+    uint32_t duration;
+
+    rec = &sp_fal()->trace_ring[(seq - 1) & (XF_FAL_TRACE_NUM - 1)];
+    /* 操作期间环形记录已转过一圈，本条已被覆盖 */
+    if (rec->seq != seq) {
+        return;
+    }
+    duration = (clock) ? (clock() - rec->timestamp) : 0;
+    if (XF_FAL_TRACE_IN_FLIGHT == duration) {
+        --duration;
+    }
+    rec->result     = (uint8_t)result;
+    rec->duration   = duration;
+}
+
+#endif // XF_FAL_TRACE_ENABLE
+
+/**
+ * @brief 按页和最小读写单元拆分写入。
+ *
+ * 每次驱动调用都不跨页，且地址和大小按 io_size 对齐，
+ * 中间整页部分直接从 src 写入；首尾不足一个 io_size 的部分
+ * 先读出所在的读写单元，合并后整单元写回（读-改-写）。
+ *
+ * XF_FAL_WRITE_SPLIT_ENABLE 为 0 时直接调用驱动。
+ */
+static xf_err_t xf_fal_dev_write(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const uint8_t *src, size_t size)
+{
+#if XF_FAL_WRITE_SPLIT_ENABLE
+    xf_err_t xf_ret = XF_OK;
+    uint8_t unit_buf[XF_FAL_IO_SIZE_MAX];
+    const size_t page_size = flash_dev->page_size;
+    const size_t io_size = (flash_dev->io_size) ? flash_dev->io_size : 1;
+    size_t unit_off;
+    size_t len;
+
+    if ((0 == page_size) && (1 == io_size)) {
+        return XF_FAL_DRV_WRITE(flash_dev, addr, src, size);
+    }
+
+    while (size > 0) {
+        unit_off = addr % io_size;
+        if ((unit_off) || (size < io_size)) {
+            /* 首尾不对齐的读写单元：读-改-写 */
+            len = io_size - unit_off;
+            if (len > size) {
+                len = size;
+            }
+            if (addr - unit_off + io_size > flash_dev->len) {
+                /* 读写单元超出设备末尾 */
+                return XF_ERR_INVALID_ARG;
+            }
+            xf_ret = XF_FAL_DRV_READ(flash_dev, addr - unit_off, unit_buf, io_size);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+            memcpy(&unit_buf[unit_off], src, len);
+            xf_ret = XF_FAL_DRV_WRITE(flash_dev, addr - unit_off, unit_buf, io_size);
+        } else {
+            /* 到页边界为止的对齐部分 */
+            len = size;
+            if ((page_size) && (len > page_size - (addr % page_size))) {
+                len = page_size - (addr % page_size);
+            }
+            len -= len % io_size;
+            if (0 == len) {
+                /* 页大小不是 io_size 的整数倍，注册时已拒绝，此处防止死循环 */
+                return XF_ERR_INVALID_PORT;
+            }
+            xf_ret = XF_FAL_DRV_WRITE(flash_dev, addr, src, len);
+        }
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        addr += len;
+        src  += len;
+        size -= len;
+    }
+
+    return xf_ret;
+#else
+    return XF_FAL_DRV_WRITE(flash_dev, addr, src, size);
+#endif
+}
+
+/**
+ * @brief 检查擦除范围是否对齐到扇区，按 XF_FAL_ERASE_WIDEN_ENABLE 扩展。
+ *
+ * 对齐以 flash 设备上的地址为准（分区偏移 + offset）。
+ */
+static xf_err_t xf_fal_erase_align(
+    const xf_fal_handle_t *handle, size_t *p_offset, size_t *p_size)
+{
+    const size_t sector_size = handle->flash_dev->sector_size;
+    size_t head;
+    size_t tail;
+
+    if (0 == sector_size) {
+        return XF_OK;
+    }
+    head = (handle->base + *p_offset) % sector_size;
+    tail = (handle->base + *p_offset + *p_size) % sector_size;
+    if ((0 == head) && (0 == tail)) {
+        return XF_OK;
+    }
+#if XF_FAL_ERASE_WIDEN_ENABLE
+    tail = (tail) ? (sector_size - tail) : 0;
+    if ((head <= *p_offset) && (tail <= handle->len - *p_offset - *p_size)) {
+        *p_offset -= head;
+        *p_size   += head + tail;
+        return XF_OK;
+    }
+#endif
+
+    return XF_ERR_INVALID_ARG;
+}
+
+/**
+ * @brief 从 addr 开始的下一次擦除大小。
+ *
+ * 选择地址对齐且不超过剩余长度的最大粒度，没有合适的粒度时按扇区擦除；
+ * 未提供擦除粒度表时为整个剩余长度。
+ */
+static size_t xf_fal_erase_step(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size)
+{
+    size_t gran;
+    size_t len;
+
+    if ((NULL == flash_dev->erase_size_table) || (0 == flash_dev->erase_size_num)) {
+        return size;
+    }
+
+    len = flash_dev->sector_size;
+    for (size_t i = 0; i < flash_dev->erase_size_num; i++) {
+        gran = flash_dev->erase_size_table[i];
+        if ((gran > len) && (gran <= size) && (0 == addr % gran)) {
+            len = gran;
+        }
+    }
+
+    return len;
+}
+
+/**
+ * @brief 按擦除粒度表拆分擦除。
+ *
+ * 每次按 xf_fal_erase_step() 选择粒度。
+ * 嵌套粒度（如 4K/32K/64K）下贪心选择即为调用次数最少的组合。
+ */
+static xf_err_t xf_fal_dev_erase(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+    size_t len;
+
+    if ((NULL == flash_dev->erase_size_table) || (0 == flash_dev->erase_size_num)) {
+        xf_ret = XF_FAL_DRV_ERASE(flash_dev, addr, size);
+        if (XF_OK == xf_ret) {
+            XF_FAL_WEAR_RECORD(flash_dev, addr, size);
+        }
+        return xf_ret;
+    }
+
+    while (size > 0) {
+        len = xf_fal_erase_step(flash_dev, addr, size);
+        xf_ret = XF_FAL_DRV_ERASE(flash_dev, addr, len);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        XF_FAL_WEAR_RECORD(flash_dev, addr, len);
+        addr += len;
+        size -= len;
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 跳过空白扇区的擦除。
+ *
+ * 逐扇区检查，连续的非空白扇区合并为一段交给 xf_fal_dev_erase(),
+ * 以便仍能使用块擦除。
+ */
+static xf_err_t xf_fal_dev_erase_skip_blank(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size,
+    xf_fal_erase_result_t *p_result)
+{
+    xf_err_t xf_ret = XF_OK;
+    const size_t unit = (flash_dev->sector_size) ? flash_dev->sector_size : size;
+    size_t run_addr = addr;
+    size_t run_len = 0;
+    bool is_blank;
+
+    while (size > 0) {
+        xf_ret = xf_fal_dev_blank_check(flash_dev, addr, unit, &is_blank);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if (is_blank) {
+            /* 遇到空白扇区，先擦除之前累积的非空白段 */
+            if (run_len) {
+                xf_ret = xf_fal_dev_erase(flash_dev, run_addr, run_len);
+                if (xf_ret != XF_OK) {
+                    return xf_ret;
+                }
+                p_result->erased_num += run_len / unit;
+                run_len = 0;
+            }
+            p_result->skipped_num++;
+        } else {
+            if (0 == run_len) {
+                run_addr = addr;
+            }
+            run_len += unit;
+        }
+        addr += unit;
+        size -= unit;
+    }
+    if (run_len) {
+        xf_ret = xf_fal_dev_erase(flash_dev, run_addr, run_len);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        p_result->erased_num += run_len / unit;
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 检查是否为擦除状态（全 0xFF）。
+ *
+ * 未实现 blank_check 时分块读入栈上缓冲区，
+ * 按机器字做与运算归约（编译器可向量化），每块结束时判断一次。
+ */
+static xf_err_t xf_fal_dev_blank_check(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size, bool *p_is_blank)
+{
+    xf_err_t xf_ret = XF_OK;
+    size_t word_buf[XF_FAL_PAGE_BUF_SIZE / sizeof(size_t)];
+    const uint8_t *p_u8 = (const uint8_t *)word_buf;
+    size_t acc;
+    size_t len;
+    size_t i;
+
+    if (flash_dev->ops.blank_check) {
+        return flash_dev->ops.blank_check(addr, size, p_is_blank);
+    }
+
+    *p_is_blank = false;
+    while (size > 0) {
+        len = (size < sizeof(word_buf)) ? size : sizeof(word_buf);
+        xf_ret = XF_FAL_DRV_READ(flash_dev, addr, word_buf, len);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        acc = (size_t)-1;
+        for (i = 0; i < len / sizeof(size_t); i++) {
+            acc &= word_buf[i];
+        }
+        for (i = i * sizeof(size_t); i < len; i++) {
+            acc &= ((size_t)p_u8[i] | ~(size_t)0xFF);
+        }
+        if (acc != (size_t)-1) {
+            return XF_OK;
+        }
+        addr += len;
+        size -= len;
+    }
+    *p_is_blank = true;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 按需更新的比较单位：到下一个 min(页大小, XF_FAL_PAGE_BUF_SIZE) 边界的长度。
+ */
+static size_t xf_fal_update_piece(const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t end)
+{
+    size_t unit = XF_FAL_PAGE_BUF_SIZE;
+    size_t len;
+
+    if ((flash_dev->page_size) && (flash_dev->page_size < unit)) {
+        unit = flash_dev->page_size;
+    }
+    len = unit - addr % unit;
+
+    return (len < end - addr) ? len : (end - addr);
+}
+
+/**
+ * @brief 读回一页并与新数据比较。
+ *
+ * 用 diff 和 need_erase 两个累加器逐字节归约，循环内无提前退出，
+ * 编译器可向量化。
+ */
+static xf_err_t xf_fal_update_cmp(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    bool *p_is_equal, bool *p_need_erase)
+{
+    xf_err_t xf_ret;
+    uint8_t old[XF_FAL_PAGE_BUF_SIZE];
+    uint8_t diff = 0;
+    uint8_t need_erase = 0;
+    size_t i;
+
+    /* 直接读驱动，不经过读缓存，避免整段比较冲刷缓存 */
+    xf_ret = XF_FAL_DRV_READ(flash_dev, addr, old, size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    for (i = 0; i < size; i++) {
+        diff       |= old[i] ^ src[i];
+        need_erase |= src[i] & (uint8_t)~old[i];
+    }
+    *p_is_equal     = (0 == diff);
+    *p_need_erase   = (0 != need_erase);
+
+    return XF_OK;
+}
+
+/**
+ * @brief 扫描一段范围，得到是否需要擦除和有变化的页数。
+ *
+ * @note 发现需要擦除时立即返回，此时 p_diff_num 不完整。
+ */
+static xf_err_t xf_fal_update_scan(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    bool *p_need_erase, size_t *p_diff_num)
+{
+    xf_err_t xf_ret;
+    size_t end = addr + size;
+    size_t diff_num = 0;
+    size_t len;
+    bool is_equal;
+
+    *p_need_erase = false;
+    while (addr < end) {
+        len = xf_fal_update_piece(flash_dev, addr, end);
+        xf_ret = xf_fal_update_cmp(flash_dev, addr, src, len, &is_equal, p_need_erase);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if (*p_need_erase) {
+            break;
+        }
+        diff_num += (is_equal) ? 0 : 1;
+        addr += len;
+        src  += len;
+    }
+    if (p_diff_num) {
+        *p_diff_num = diff_num;
+    }
+
+    return XF_OK;
+}
+
+/**
+ * @brief 按需更新一个扇区内的数据。
+ *
+ * 逐页读回比较，只需 1 变 0 时直接编程有变化的页，每页只读一次；
+ * 发现需要 0 变 1 时擦除扇区，重新编程新数据不全为 0xFF 的页。
+ * [addr, addr + size) 未覆盖整个扇区时整扇区读-改-写。
+ *
+ * @note [addr, addr + size) 不跨扇区，由调用者保证。
+ */
+static xf_err_t xf_fal_update_sector(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    xf_fal_update_result_t *p_result)
+{
+    xf_err_t xf_ret;
+    size_t end = addr + size;
+    size_t cur = addr;
+    size_t skipped_num = 0;
+    size_t len;
+    bool need_erase = false;
+    bool is_equal;
+
+    while (cur < end) {
+        len = xf_fal_update_piece(flash_dev, cur, end);
+        xf_ret = xf_fal_update_cmp(flash_dev, cur, src + (cur - addr), len,
+                                   &is_equal, &need_erase);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if (need_erase) {
+            break;
+        }
+        if (is_equal) {
+            skipped_num++;
+        } else {
+            xf_ret = xf_fal_dev_write(flash_dev, cur, src + (cur - addr), len);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+            p_result->programmed_page_num++;
+        }
+        cur += len;
+    }
+    if (!need_erase) {
+        p_result->skipped_page_num += skipped_num;
+        return XF_OK;
+    }
+
+    /* 已跳过的页在擦除后重新计数 */
+    if ((0 == flash_dev->sector_size) || (size == flash_dev->sector_size)) {
+        xf_ret = xf_fal_dev_erase(flash_dev, addr, size);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        p_result->erased_sector_num++;
+        return xf_fal_update_program(flash_dev, addr, src, size, p_result);
+    }
+#if XF_FAL_UPDATE_SECTOR_BUF_SIZE > 0
+    return xf_fal_update_sector_rmw(flash_dev, addr, src, size, p_result);
+#else
+    return XF_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief 擦除后编程新数据，全 0xFF 的页无需编程。
+ */
+static xf_err_t xf_fal_update_program(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    xf_fal_update_result_t *p_result)
+{
+    xf_err_t xf_ret;
+    size_t end = addr + size;
+    size_t len;
+    size_t i;
+    uint8_t acc;
+
+    while (addr < end) {
+        len = xf_fal_update_piece(flash_dev, addr, end);
+        acc = 0xFF;
+        for (i = 0; i < len; i++) {
+            acc &= src[i];
+        }
+        if (0xFF == acc) {
+            p_result->skipped_page_num++;
+        } else {
+            xf_ret = xf_fal_dev_write(flash_dev, addr, src, len);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+            p_result->programmed_page_num++;
+        }
+        addr += len;
+        src  += len;
+    }
+
+    return XF_OK;
+}
+
+#if XF_FAL_UPDATE_SECTOR_BUF_SIZE > 0
+/**
+ * @brief 读-改-写 [addr, addr + size) 所在的扇区：读出整个扇区，合并新数据后擦除并重新编程。
+ */
+static xf_err_t xf_fal_update_sector_rmw(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr, const uint8_t *src, size_t size,
+    xf_fal_update_result_t *p_result)
+{
+    xf_err_t xf_ret;
+    size_t sector_size = flash_dev->sector_size;
+    size_t sector_addr = addr - addr % sector_size;
+
+    if (sector_size > XF_FAL_UPDATE_SECTOR_BUF_SIZE) {
+        return XF_ERR_NOT_SUPPORTED;
+    }
+
+    XF_FAL_UPDATE_LOCK();
+    xf_ret = XF_FAL_DRV_READ(flash_dev, sector_addr, s_update_sector_buf, sector_size);
+    if (XF_OK == xf_ret) {
+        memcpy(&s_update_sector_buf[addr - sector_addr], src, size);
+        xf_ret = xf_fal_dev_erase(flash_dev, sector_addr, sector_size);
+    }
+    if (XF_OK == xf_ret) {
+        p_result->erased_sector_num++;
+        xf_ret = xf_fal_update_program(flash_dev, sector_addr, s_update_sector_buf,
+                                       sector_size, p_result);
+    }
+    XF_FAL_UPDATE_UNLOCK();
+
+    return xf_ret;
+}
+#endif
+
+#if XF_FAL_WRITE_BUFFER_ENABLE
+
+/**
+ * @brief 查找分区挂接的写缓冲。调用者需持有设备锁。
+ *
+ * @param ppp_link 不为 NULL 时返回指向该写缓冲的链表指针，用于摘除。
+ */
+static xf_fal_write_buffer_t *xf_fal_wbuf_find(
+    size_t dev_idx, const xf_fal_partition_t *part, xf_fal_write_buffer_t ***ppp_link)
+{
+    xf_fal_write_buffer_t **p_link = &sp_fal()->wbuf_list[dev_idx];
+
+    for (; *p_link; p_link = &(*p_link)->next) {
+        if ((*p_link)->handle.partition == part) {
+            if (ppp_link) {
+                *ppp_link = p_link;
+            }
+            return *p_link;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 将写缓冲中的数据写入 flash. 失败时数据被丢弃。
+ */
+static xf_err_t xf_fal_wbuf_flush(xf_fal_write_buffer_t *wbuf)
+{
+    xf_err_t xf_ret;
+
+    if (0 == wbuf->len) {
+        return XF_OK;
+    }
+    xf_ret = xf_fal_dev_write(wbuf->handle.flash_dev, wbuf->addr, wbuf->data, wbuf->len);
+    XF_FAL_RCACHE_INVALIDATE(wbuf->handle.dev_idx, wbuf->addr, wbuf->len);
+    wbuf->len = 0;
+
+    return xf_ret;
+}
+
+/**
+ * @brief 写入设备上与指定范围重叠的写缓冲。
+ *
+ * @param is_erase 为 true 时完全落在范围内的缓冲数据直接丢弃。
+ * @param skip     跳过的写缓冲，可以为 NULL.
+ */
+static xf_err_t xf_fal_wbuf_flush_range(
+    size_t dev_idx, size_t addr, size_t size, bool is_erase,
+    const xf_fal_write_buffer_t *skip)
+{
+    xf_err_t xf_ret;
+    xf_fal_write_buffer_t *wbuf;
+
+    for (wbuf = sp_fal()->wbuf_list[dev_idx]; wbuf; wbuf = wbuf->next) {
+        if ((wbuf == skip) || (0 == wbuf->len)
+                || !XF_FAL_RANGE_OVERLAP(wbuf->addr, wbuf->len, addr, size)) {
+            continue;
+        }
+        if ((is_erase) && (addr <= wbuf->addr)
+                && (wbuf->addr + wbuf->len <= addr + size)) {
+            wbuf->len = 0;
+            continue;
+        }
+        xf_ret = xf_fal_wbuf_flush(wbuf);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+    }
+
+    return XF_OK;
+}
+
+/**
+ * @brief 经过写缓冲写入。调用者需持有设备锁。
+ *
+ * 缓冲中的数据始终在同一页内。顺序写入追加到缓冲，到达页边界时写入 flash;
+ * 缓冲为空且写入从页边界开始时，整页部分直接写入 flash.
+ */
+static xf_err_t xf_fal_wbuf_write(
+    const xf_fal_handle_t *handle, size_t addr, const uint8_t *src, size_t size)
+{
+    xf_err_t xf_ret;
+    xf_fal_write_buffer_t *wbuf;
+    size_t page_size;
+    size_t len;
+
+    wbuf = xf_fal_wbuf_find(handle->dev_idx, handle->partition, NULL);
+    /* 先写入其他分区与此范围重叠的缓冲数据，保证写入顺序 */
+    xf_ret = xf_fal_wbuf_flush_range(handle->dev_idx, addr, size, false, wbuf);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    if (NULL == wbuf) {
+        xf_ret = xf_fal_dev_write(handle->flash_dev, addr, src, size);
+        XF_FAL_RCACHE_INVALIDATE(handle->dev_idx, addr, size);
+        return xf_ret;
+    }
+
+    page_size = wbuf->page_size;
+    while (size > 0) {
+        if ((wbuf->len) && (addr != wbuf->addr + wbuf->len)) {
+            /* 非顺序写入 */
+            xf_ret = xf_fal_wbuf_flush(wbuf);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+        }
+        if ((0 == wbuf->len) && (0 == addr % page_size) && (size >= page_size)) {
+            len = size - size % page_size;
+            xf_ret = xf_fal_dev_write(handle->flash_dev, addr, src, len);
+            XF_FAL_RCACHE_INVALIDATE(handle->dev_idx, addr, len);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+        } else {
+            if (0 == wbuf->len) {
+                wbuf->addr = addr;
+            }
+            len = page_size - addr % page_size;
+            if (len > size) {
+                len = size;
+            }
+            memcpy(&wbuf->data[wbuf->len], src, len);
+            wbuf->len += len;
+            if (0 == (addr + len) % page_size) {
+                xf_ret = xf_fal_wbuf_flush(wbuf);
+                if (xf_ret != XF_OK) {
+                    return xf_ret;
+                }
+            }
+        }
+        addr += len;
+        src  += len;
+        size -= len;
+    }
+
+    return XF_OK;
+}
+
+/**
+ * @brief 将设备上尚未写入的缓冲数据合并到读取结果中。
+ */
+static void xf_fal_wbuf_overlay(size_t dev_idx, size_t addr, uint8_t *dst, size_t size)
+{
+    const xf_fal_write_buffer_t *wbuf;
+    size_t start;
+    size_t end;
+
+    for (wbuf = sp_fal()->wbuf_list[dev_idx]; wbuf; wbuf = wbuf->next) {
+        if ((0 == wbuf->len)
+                || !XF_FAL_RANGE_OVERLAP(wbuf->addr, wbuf->len, addr, size)) {
+            continue;
+        }
+        start   = (wbuf->addr > addr) ? wbuf->addr : addr;
+        end     = (wbuf->addr + wbuf->len < addr + size) ? (wbuf->addr + wbuf->len) : (addr + size);
+        memcpy(&dst[start - addr], &wbuf->data[start - wbuf->addr], end - start);
+    }
+}
+
+#endif // XF_FAL_WRITE_BUFFER_ENABLE
+
+/**
+ * @brief 从 flash 设备读取，启用读缓存时经过读缓存。
+ */
+static xf_err_t xf_fal_dev_read(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx,
+    size_t addr, void *dst, size_t size)
+{
+#if XF_FAL_READ_CACHE_NUM > 0
+    if (size <= XF_FAL_READ_CACHE_BYPASS_SIZE) {
+        return xf_fal_rcache_read(flash_dev, dev_idx, addr, dst, size);
+    }
+    XF_FAL_RCACHE_LOCK();
+    sp_fal()->rcache.stat.bypass_cnt++;
+    XF_FAL_RCACHE_UNLOCK();
+#else
+    (void)dev_idx;
+#endif
+    return XF_FAL_DRV_READ(flash_dev, addr, dst, size);
+}
+
+#if XF_FAL_READ_CACHE_NUM > 0
+
+/**
+ * @brief 经过读缓存读取。
+ *
+ * 调用者需持有设备锁。逐行查找，命中时从缓存复制；
+ * 需要读入整行时不持读缓存锁读 flash, 读入后若期间被失效则改为直接读取；
+ * 不读入的未命中及超出设备范围的行直接读 flash.
+ */
+static xf_err_t xf_fal_rcache_read(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx,
+    size_t addr, uint8_t *dst, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+    xf_fal_read_cache_line_t *line;
+    size_t line_addr;
+    size_t line_off;
+    size_t len;
+    bool is_hit;
+
+    while ((XF_OK == xf_ret) && (size > 0)) {
+        line_off    = addr & (XF_FAL_READ_CACHE_LINE_SIZE - 1);
+        line_addr   = addr - line_off;
+        len         = XF_FAL_READ_CACHE_LINE_SIZE - line_off;
+        if (len > size) {
+            len = size;
+        }
+
+        XF_FAL_RCACHE_LOCK();
+        line = xf_fal_rcache_lookup(flash_dev, dev_idx, line_addr, len, &is_hit);
+        if (is_hit) {
+            memcpy(dst, &line->data[line_off], len);
+            XF_FAL_RCACHE_UNLOCK();
+        } else if (line) {
+            XF_FAL_RCACHE_UNLOCK();
+            xf_ret = XF_FAL_DRV_READ(flash_dev, line_addr, line->data, XF_FAL_READ_CACHE_LINE_SIZE);
+            XF_FAL_RCACHE_LOCK();
+            line->is_filling = false;
+            is_hit = ((XF_OK == xf_ret) && (!line->is_stale));
+            if (is_hit) {
+                line->stamp = xf_fal_rcache_tick();
+                memcpy(dst, &line->data[line_off], len);
+            }
+            XF_FAL_RCACHE_UNLOCK();
+            if ((XF_OK == xf_ret) && (!is_hit)) {
+                xf_ret = XF_FAL_DRV_READ(flash_dev, addr, dst, len);
+            }
+        } else {
+            XF_FAL_RCACHE_UNLOCK();
+            xf_ret = XF_FAL_DRV_READ(flash_dev, addr, dst, len);
+        }
+
+        dst     += len;
+        addr    += len;
+        size    -= len;
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 查找缓存行。调用者需持有读缓存锁。
+ *
+ * 命中时 *p_is_hit 为 true 并返回该行。未命中时按准入规则决定是否读入：
+ * 读入时返回已标记为读入中的替换行，由调用者在锁外读入；不读入时返回 NULL.
+ *
+ * 准入规则：近期命中率低于读入整行的收益点（1 - len / 行大小，忽略命令开销）时，
+ * 行在近期第二次未命中才读入，避免随机小块读取冲刷热点行。
+ */
+static xf_fal_read_cache_line_t *xf_fal_rcache_lookup(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx,
+    size_t line_addr, size_t len, bool *p_is_hit)
+{
+    xf_fal_read_cache_t *rcache = &sp_fal()->rcache;
+    xf_fal_read_cache_line_t *victim = NULL;
+    xf_fal_read_cache_ghost_t *ghost;
+    bool is_ghost = false;
+    size_t i;
+
+    *p_is_hit = false;
+    if (line_addr + XF_FAL_READ_CACHE_LINE_SIZE > flash_dev->len) {
+        rcache->stat.bypass_cnt++;
+        return NULL;
+    }
+
+    for (i = 0; i < XF_FAL_READ_CACHE_NUM; i++) {
+        if ((rcache->line[i].stamp)
+                && (rcache->line[i].dev_idx == dev_idx)
+                && (rcache->line[i].addr == line_addr)) {
+            rcache->stat.hit_cnt++;
+            XF_FAL_RCACHE_HIT_UPDATE(rcache, true);
+            rcache->line[i].stamp = xf_fal_rcache_tick();
+            *p_is_hit = true;
+            return &rcache->line[i];
+        }
+        if ((!rcache->line[i].is_filling)
+                && ((NULL == victim) || (rcache->line[i].stamp < victim->stamp))) {
+            victim = &rcache->line[i];
+        }
+    }
+    XF_FAL_RCACHE_HIT_UPDATE(rcache, false);
+
+    if ((len < XF_FAL_READ_CACHE_LINE_SIZE)
+            && ((size_t)rcache->hit_avg * XF_FAL_READ_CACHE_LINE_SIZE
+                < (size_t)(XF_FAL_READ_CACHE_LINE_SIZE - len) * XF_FAL_RCACHE_HIT_ONE)) {
+        for (i = 0; i < XF_FAL_READ_CACHE_NUM; i++) {
+            ghost = &rcache->ghost[i];
+            if ((ghost->dev_idx == dev_idx) && (ghost->addr == line_addr)) {
+                is_ghost = true;
+                break;
+            }
+        }
+        if (!is_ghost) {
+            ghost = &rcache->ghost[rcache->ghost_pos];
+            ghost->dev_idx  = (uint32_t)dev_idx;
+            ghost->addr     = line_addr;
+            rcache->ghost_pos = (rcache->ghost_pos + 1) % XF_FAL_READ_CACHE_NUM;
+            victim = NULL;
+        }
+    }
+    if (NULL == victim) {
+        /* 不读入，或所有行都在读入中 */
+        rcache->stat.bypass_cnt++;
+        return NULL;
+    }
+
+    rcache->stat.miss_cnt++;
+    victim->stamp       = 0;
+    victim->is_filling  = true;
+    victim->is_stale    = false;
+    victim->dev_idx     = (uint32_t)dev_idx;
+    victim->addr        = line_addr;
+
+    return victim;
+}
+
+/**
+ * @brief 取下一个 LRU 时间戳。调用者需持有读缓存锁。
+ */
+static uint32_t xf_fal_rcache_tick(void)
+{
+    /* 时间戳回绕到 0 时跳过 0, 仅会短暂影响 LRU 顺序 */
+    if (0 == ++sp_fal()->rcache.clock) {
+        sp_fal()->rcache.clock = 1;
+    }
+    return sp_fal()->rcache.clock;
+}
+
+static void xf_fal_rcache_invalidate(size_t dev_idx, size_t addr, size_t size)
+{
+    xf_fal_read_cache_line_t *line;
+
+    XF_FAL_RCACHE_LOCK();
+    for (size_t i = 0; i < XF_FAL_READ_CACHE_NUM; i++) {
+        line = &sp_fal()->rcache.line[i];
+        if (((0 == line->stamp) && (!line->is_filling)) || (line->dev_idx != dev_idx)) {
+            continue;
+        }
+        if ((0 == size)
+                || ((line->addr < addr + size)
+                    && (addr < line->addr + XF_FAL_READ_CACHE_LINE_SIZE))) {
+            line->stamp     = 0;
+            line->is_stale  = line->is_filling;
+        }
+    }
+    XF_FAL_RCACHE_UNLOCK();
+}
+
+#endif // XF_FAL_READ_CACHE_NUM
+
+/**
+ * @brief 计算数据段总长度。
+ *
+ * @return size_t 总长度。存在 base 为 NULL 的非空数据段或长度溢出时返回 0.
+ */
+static size_t xf_fal_iov_total(const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    size_t total = 0;
+    size_t i;
+
+    for (i = 0; i < iovcnt; i++) {
+        if (0 == iov[i].len) {
+            continue;
+        }
+        if ((NULL == iov[i].base) || (iov[i].len > (size_t)-1 - total)) {
+            return 0;
+        }
+        total += iov[i].len;
+    }
+
+    return total;
+}
+
+static xf_err_t xf_fal_dev_readv(
+    const xf_fal_flash_dev_t *flash_dev, size_t dev_idx, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt)
+{
+    xf_err_t xf_ret = XF_OK;
+    size_t i;
+
+    if (flash_dev->ops.readv) {
+        return XF_FAL_DRV_READV(flash_dev, addr, iov, iovcnt);
+    }
+
+    /* 读无需合并，直接读入各数据段 */
+    for (i = 0; i < iovcnt; i++) {
+        if (0 == iov[i].len) {
+            continue;
+        }
+        xf_ret = xf_fal_dev_read(flash_dev, dev_idx, addr, iov[i].base, iov[i].len);
+        if (xf_ret != XF_OK) {
+            break;
+        }
+        addr += iov[i].len;
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 聚集写。
+ *
+ * 驱动未实现 writev 时按页推进：
+ * - 当前数据段剩余部分覆盖整页（或到结尾）时，直接从数据段写入，
+ *   并尽量延伸到数据段内最后一个页边界，减少驱动调用次数；
+ * - 否则将跨数据段的这一页合并到栈上的页缓冲区后写入。
+ */
+static xf_err_t xf_fal_dev_writev(
+    const xf_fal_flash_dev_t *flash_dev, size_t addr,
+    const xf_fal_iovec_t *iov, size_t iovcnt, size_t total)
+{
+    xf_err_t xf_ret = XF_OK;
+    uint8_t page_buf[XF_FAL_PAGE_BUF_SIZE];
+    size_t page_size;
+    size_t seg_idx = 0;
+    size_t seg_off = 0;
+    size_t seg_left;
+    size_t span;
+    size_t len;
+    size_t copy;
+
+    if (flash_dev->ops.writev) {
+        return XF_FAL_DRV_WRITEV(flash_dev, addr, iov, iovcnt);
+    }
+
+    page_size = flash_dev->page_size;
+    if ((0 == page_size) || (page_size > sizeof(page_buf))) {
+        page_size = sizeof(page_buf);
+    }
+
+    while (total > 0) {
+        while (0 == iov[seg_idx].len - seg_off) {
+            seg_idx++;
+            seg_off = 0;
+        }
+        seg_left = iov[seg_idx].len - seg_off;
+        if (seg_left > total) {
+            seg_left = total;
+        }
+        /* 当前地址到下一个页边界的长度 */
+        span = page_size - (addr % page_size);
+        if (span > total) {
+            span = total;
+        }
+
+        if (seg_left >= span) {
+            len = seg_left;
+            if (len < total) {
+                /* 截止到数据段内最后一个页边界，剩余不足一页的部分与下一段合并 */
+                len = ((addr + len) / page_size) * page_size - addr;
+                if (len < span) {
+                    len = span;
+                }
+            }
+            xf_ret = xf_fal_dev_write(
+                         flash_dev, addr, (const uint8_t *)iov[seg_idx].base + seg_off, len);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+            seg_off += len;
+            addr    += len;
+            total   -= len;
+            continue;
+        }
+
+        /* 这一页跨数据段，合并后写入 */
+        len = 0;
+        while (len < span) {
+            seg_left = iov[seg_idx].len - seg_off;
+            if (0 == seg_left) {
+                seg_idx++;
+                seg_off = 0;
+                continue;
+            }
+            copy = (seg_left < span - len) ? seg_left : (span - len);
+            memcpy(&page_buf[len], (const uint8_t *)iov[seg_idx].base + seg_off, copy);
+            seg_off += copy;
+            len     += copy;
+        }
+        xf_ret = xf_fal_dev_write(flash_dev, addr, page_buf, span);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        addr    += span;
+        total   -= span;
+    }
+
+    return xf_ret;
+}
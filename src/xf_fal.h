@@ -62,6 +62,8 @@ xf_err_t xf_fal_check_and_update_cache(void);
  *
  * @note 通过此接口可获取当前 xf_fal 注册状态、注册的 flash 设备和注册的分区表。
  *       可用于动态扩展分区表。
+ * @note 注册信息位于 xf_fal_ctx_t.p_snapshot 指向的快照中，
+ *       注册、注销或更新缓存后快照指针会切换，需要重新读取。
  * @attention 禁止直接修改其中内容。
  *
  * @return xf_fal_ctx_t*        xf_fal 上下文
@@ -74,6 +76,9 @@ const xf_fal_ctx_t *xf_fal_get_ctx(void);
  * @attention xf_fal 内仅保存 flash 设备指针，
  *            用户必须保证在使用 xf_fal 的整个过程中 flash 设备可访问。
  * @attention 用户应保证 flash 设备名不重复。否则只会找到第一个。
+ * @note 启用锁时 xf_fal 为每个注册的 flash 设备创建一个互斥锁，
+ *       同一设备上的读写擦操作由 xf_fal 串行化，对接层无需自行加锁；
+ *       不同设备上的操作可以并行。
  * @attention 注册完毕后需要调用 xf_fal_init() 初始化 xf_fal .
  * @attention 已初始化后禁止注册或注销，需调用  xf_fal_deinit() 反初始化.
  *
@@ -83,7 +88,11 @@ const xf_fal_ctx_t *xf_fal_get_ctx(void);
  *      - XF_FAIL               xf_fal 已初始化，禁止注册注销
  *      - XF_ERR_BUSY           xf_fal 被别处占用
  *      - XF_ERR_INVALID_ARG    无效参数
- *      - XF_ERR_INVALID_PORT   无效对接, p_dev->ops 的 read, write, erase 存在 NULL
+ *      - XF_ERR_INVALID_PORT   无效对接, p_dev->ops 的 read, write, erase 存在 NULL,
+ *                              或 erase_size_table 中存在不是 sector_size 整数倍的项,
+ *                              或启用 XF_FAL_WRITE_SPLIT_ENABLE 时 io_size 超过
+ *                              XF_FAL_IO_SIZE_MAX, 或 len 或 page_size（非 0 时）
+ *                              不是 io_size 的整数倍
  *      - XF_ERR_INITED         p_dev 已注册
  *      - XF_ERR_RESOURCE       xf_fal 的设备表数组已满，需增大 XF_FAL_FLASH_DEVICE_NUM
  */
@@ -212,6 +221,8 @@ const xf_fal_flash_dev_t *xf_fal_flash_device_find_by_part(
 /**
  * @brief 根据分区名称查找分区句柄。
  *
+ * @note 存在同名分区时返回按注册顺序最先出现的一个。
+ *
  * @param name 分区表名称。
  * @return const xf_fal_partition_t*
  *      - NULL                  未找到或参数错误或未注册 xf_fal
@@ -243,8 +254,9 @@ xf_err_t xf_fal_partition_read(
 /**
  * @brief 将数据写入指定分区。
  *
- * @note 读写数据的大小以及偏移地址需要是 flash 最小读写颗粒大小的整数倍。
- *       见 @ref xf_fal_flash_dev_t.io_size .
+ * @note 启用 XF_FAL_WRITE_SPLIT_ENABLE 时（默认启用），写入的大小和偏移地址不限，
+ *       xf_fal 按页拆分并对首尾不对齐部分读-改-写；否则需要是 flash
+ *       最小读写颗粒大小的整数倍，见 @ref xf_fal_flash_dev_t.io_size .
  * @note 写入前一定要确认目标地址已经被擦除。
  *
  * @param part       分区表中的指定分区。
@@ -265,11 +277,13 @@ xf_err_t xf_fal_partition_write(
 /**
  * @brief 擦除指定分区数据。
  *
- * @note 擦除数据的大小推荐对齐到 flash 扇区大小的整数倍。
+ * @note 擦除数据的大小和地址需要对齐到 flash 扇区大小的整数倍。
  *       扇区大小见 @ref xf_fal_flash_dev_t.sector_size .
  *       可以通过 xf_fal_flash_device_find_by_part() 获取。
- * @attention 如果分区偏移地址和 offset 和 size 未对齐到扇区，
- *            则可能无法擦除。需要看对接的实现。
+ * @note 未对齐时返回 XF_ERR_INVALID_ARG; 启用 XF_FAL_ERASE_WIDEN_ENABLE 时
+ *       向外扩展到扇区边界（扩展后仍需在分区内）。
+ * @note 设备提供 xf_fal_flash_dev_t.erase_size_table 时，
+ *       xf_fal 会优先使用大粒度的块擦除。
  *
  * @param part       分区表中的指定分区。
  *                   可以通过 xf_fal_partition_find() 获取。
@@ -285,6 +299,29 @@ xf_err_t xf_fal_partition_write(
 xf_err_t xf_fal_partition_erase(
     const xf_fal_partition_t *part, size_t offset, size_t size);
 
+/**
+ * @brief 按选项擦除指定分区数据。
+ *
+ * @note 对齐要求等同 xf_fal_partition_erase().
+ * @note 使用 XF_FAL_ERASE_FLAG_SKIP_BLANK 时逐扇区检查，已是擦除状态的扇区跳过，
+ *       其余连续扇区合并后擦除。检查优先使用 xf_fal_flash_ops_t.blank_check.
+ *
+ * @param part       分区表中的指定分区。
+ * @param offset     待擦除的地址。相对当前分区起始地址的偏移地址。
+ * @param size       要擦除的数据大小，单位：字节。
+ * @param flags      擦除选项，见 @ref xf_fal_erase_flag_t .
+ * @param[out] p_result 擦除和跳过的扇区数，可以为 NULL.
+ *                   失败时为出错前的统计。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_partition_erase_ex(
+    const xf_fal_partition_t *part, size_t offset, size_t size,
+    uint32_t flags, xf_fal_erase_result_t *p_result);
+
 /**
  * @brief 擦除指定分区所有数据。
  *
@@ -298,11 +335,570 @@ xf_err_t xf_fal_partition_erase(
  */
 xf_err_t xf_fal_partition_erase_all(const xf_fal_partition_t *part);
 
+/**
+ * @brief 解析分区，获取分区句柄。
+ *
+ * @note 在初始化后获取一次句柄，之后通过 xf_fal_handle_read() 等接口读写，
+ *       每次读写只需边界检查和调用驱动，无需加锁和查找 flash 设备。
+ *
+ * @param part          分区表中的指定分区。
+ *                      可以通过 xf_fal_partition_find() 获取。
+ * @param[out] handle   分区句柄。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或未找到分区关联的 flash 设备
+ *      - XF_ERR_INVALID_PORT   未注册 xf_fal
+ */
+xf_err_t xf_fal_partition_get_handle(
+    const xf_fal_partition_t *part, xf_fal_handle_t *handle);
+
+/**
+ * @brief 通过分区句柄读取数据。
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_read() 相同。
+ *
+ * @param handle     分区句柄。见 xf_fal_partition_get_handle() .
+ * @param src_offset 要读取的数据的地址。相对当前分区起始地址的偏移地址。
+ * @param[out] dst   指向读取缓冲区。
+ * @param size       要读取的数据大小，单位：字节。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_handle_read(
+    const xf_fal_handle_t *handle,
+    size_t src_offset, void *dst, size_t size);
+
+/**
+ * @brief 通过分区句柄写入数据。
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_write() 相同。
+ *
+ * @param handle     分区句柄。见 xf_fal_partition_get_handle() .
+ * @param dst_offset 要写入的数据的地址。相对当前分区起始地址的偏移地址。
+ * @param src        指向数据来源缓冲区。
+ * @param size       要写入的数据大小，单位：字节。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_handle_write(
+    const xf_fal_handle_t *handle,
+    size_t dst_offset, const void *src, size_t size);
+
+/**
+ * @brief 通过分区句柄擦除数据。
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_erase() 相同。
+ *
+ * @param handle     分区句柄。见 xf_fal_partition_get_handle() .
+ * @param offset     待擦除的地址。相对当前分区起始地址的偏移地址。
+ * @param size       要擦除的数据大小，单位：字节。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_handle_erase(
+    const xf_fal_handle_t *handle, size_t offset, size_t size);
+
+/**
+ * @brief 通过分区句柄按选项擦除数据。
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_erase_ex() 相同。
+ *
+ * @param handle     分区句柄。见 xf_fal_partition_get_handle() .
+ * @param offset     待擦除的地址。相对当前分区起始地址的偏移地址。
+ * @param size       要擦除的数据大小，单位：字节。
+ * @param flags      擦除选项，见 @ref xf_fal_erase_flag_t .
+ * @param[out] p_result 擦除和跳过的扇区数，可以为 NULL.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_handle_erase_ex(
+    const xf_fal_handle_t *handle, size_t offset, size_t size,
+    uint32_t flags, xf_fal_erase_result_t *p_result);
+
+/**
+ * @brief 按需更新分区数据（只写有变化的部分）。
+ *
+ * 按扇区读回目标范围并与新数据比较：
+ * - 内容相同的页跳过；
+ * - 扇区内只需 1 变 0 (NOR flash 编程语义) 时，不擦除，只编程有变化的页；
+ * - 需要 0 变 1 时擦除该扇区，再编程新数据不全为 0xFF 的页。
+ *
+ * 适用于配置等经常以相同或相近内容重写的分区，
+ * 可以代替 "擦除 + 写入"，且无需事先擦除。
+ *
+ * @note 需要擦除但未被 [offset, offset + size) 完全覆盖的首尾扇区，
+ *       整扇区读出、合并新数据后擦除并重新编程（读-改-写），范围外的数据保留。
+ *       扇区大于 XF_FAL_UPDATE_SECTOR_BUF_SIZE（默认为 0）时无法读-改-写，
+ *       会在修改任何数据前检查首尾扇区，需要擦除时返回 XF_ERR_NOT_SUPPORTED.
+ *
+ * @param part       分区表中的指定分区。
+ * @param offset     相对当前分区起始地址的偏移地址。
+ * @param src        新数据。
+ * @param size       新数据大小，单位：字节。
+ * @param[out] p_result 跳过、编程的页数和擦除的扇区数，可以为 NULL.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_SUPPORTED  扇区大于 XF_FAL_UPDATE_SECTOR_BUF_SIZE 且
+ *                              未完全覆盖的首尾扇区需要擦除，未做任何修改
+ */
+xf_err_t xf_fal_partition_update(
+    const xf_fal_partition_t *part, size_t offset,
+    const void *src, size_t size, xf_fal_update_result_t *p_result);
+
+/**
+ * @brief 通过分区句柄按需更新数据。
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_update() 相同。
+ *
+ * @param handle     分区句柄。见 xf_fal_partition_get_handle() .
+ * @param offset     相对当前分区起始地址的偏移地址。
+ * @param src        新数据。
+ * @param size       新数据大小，单位：字节。
+ * @param[out] p_result 跳过、编程的页数和擦除的扇区数，可以为 NULL.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_SUPPORTED  扇区大于 XF_FAL_UPDATE_SECTOR_BUF_SIZE 且
+ *                              未完全覆盖的首尾扇区需要擦除，未做任何修改
+ */
+xf_err_t xf_fal_handle_update(
+    const xf_fal_handle_t *handle, size_t offset,
+    const void *src, size_t size, xf_fal_update_result_t *p_result);
+
+/**
+ * @brief 从一个分区复制数据到另一个分区，可以跨 flash 设备。
+ *
+ * 按 XF_FAL_COPY_BUF_SIZE 分块复制，写入前按需擦除目标扇区
+ * （按 xf_fal_flash_dev_t.erase_size_table 尽量使用大块擦除）。
+ *
+ * 启用 XF_FAL_ASYNC_ENABLE 且已调用 xf_fal_async_init() 时，
+ * 跨设备复制使用双缓冲：编程当前块的同时在其他上下文中读取下一块，
+ * 源设备实现 async_start 时直接启动异步读，否则交给源设备的工作线程。
+ * 两者都不可用时（无 async_start 且未设置通知回调）逐块同步复制。
+ *
+ * @note 目标起始地址必须对齐到扇区；目标末尾不足一个扇区的部分
+ *       所在扇区会被整个擦除。
+ * @note 同一设备上源范围与目标擦除范围不能重叠。
+ * @note 复制过程不是原子的，其他线程可以在块之间访问两个分区。
+ *
+ * @param src        源分区。
+ * @param src_offset 相对源分区起始地址的偏移地址。
+ * @param dst        目标分区。
+ * @param dst_offset 相对目标分区起始地址的偏移地址。
+ * @param size       复制大小，单位：字节。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数、越界、目标未对齐或范围重叠
+ */
+xf_err_t xf_fal_partition_copy(
+    const xf_fal_partition_t *src, size_t src_offset,
+    const xf_fal_partition_t *dst, size_t dst_offset, size_t size);
+
+/**
+ * @brief 通过分区句柄复制数据。
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_copy() 相同。
+ *
+ * @param src        源分区句柄。见 xf_fal_partition_get_handle() .
+ * @param src_offset 相对源分区起始地址的偏移地址。
+ * @param dst        目标分区句柄。
+ * @param dst_offset 相对目标分区起始地址的偏移地址。
+ * @param size       复制大小，单位：字节。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数、越界、目标未对齐或范围重叠
+ */
+xf_err_t xf_fal_handle_copy(
+    const xf_fal_handle_t *src, size_t src_offset,
+    const xf_fal_handle_t *dst, size_t dst_offset, size_t size);
+
+/**
+ * @brief 计算分区指定范围的 CRC-32 (IEEE 802.3).
+ *
+ * 设备实现了 xf_fal_flash_ops_t.crc32 时由硬件计算；
+ * 否则按 XF_FAL_HASH_BUF_SIZE 分块读出后由 xf_fal_crc32() 计算。
+ *
+ * @param part       分区表中的指定分区。
+ * @param offset     相对当前分区起始地址的偏移地址。
+ * @param size       计算的大小，单位：字节。
+ * @param[in,out] p_crc 输入之前数据的 CRC-32 (首次为 0)，输出包含本范围后的 CRC-32.
+ *                      可以分段计算。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或越界
+ */
+xf_err_t xf_fal_partition_crc32(
+    const xf_fal_partition_t *part, size_t offset, size_t size, uint32_t *p_crc);
+
+/**
+ * @brief 通过分区句柄计算 CRC-32.
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_crc32() 相同。
+ *
+ * @param handle     分区句柄。见 xf_fal_partition_get_handle() .
+ * @param offset     相对当前分区起始地址的偏移地址。
+ * @param size       计算的大小，单位：字节。
+ * @param[in,out] p_crc 输入之前数据的 CRC-32 (首次为 0)，输出包含本范围后的 CRC-32.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或越界
+ */
+xf_err_t xf_fal_handle_crc32(
+    const xf_fal_handle_t *handle, size_t offset, size_t size, uint32_t *p_crc);
+
+/**
+ * @brief 按 XF_FAL_HASH_BUF_SIZE 分块读出分区指定范围，依次交给哈希回调。
+ *
+ * 用于 SHA-256 等由用户提供实现的哈希。
+ *
+ * @param part       分区表中的指定分区。
+ * @param offset     相对当前分区起始地址的偏移地址。
+ * @param size       读取的大小，单位：字节。
+ * @param update     哈希更新回调。
+ * @param user_data  传给回调的用户数据，通常为哈希上下文。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或越界
+ *      - (OTHER)               回调返回的错误
+ */
+xf_err_t xf_fal_partition_hash(
+    const xf_fal_partition_t *part, size_t offset, size_t size,
+    xf_fal_hash_update_cb_t update, void *user_data);
+
+/**
+ * @brief 通过分区句柄分块读出并交给哈希回调。
+ *
+ * @note 除分区通过句柄给出外，与 xf_fal_partition_hash() 相同。
+ *
+ * @param handle     分区句柄。见 xf_fal_partition_get_handle() .
+ * @param offset     相对当前分区起始地址的偏移地址。
+ * @param size       读取的大小，单位：字节。
+ * @param update     哈希更新回调。
+ * @param user_data  传给回调的用户数据。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或越界
+ *      - (OTHER)               回调返回的错误
+ */
+xf_err_t xf_fal_handle_hash(
+    const xf_fal_handle_t *handle, size_t offset, size_t size,
+    xf_fal_hash_update_cb_t update, void *user_data);
+
+/**
+ * @brief 计算内存数据的 CRC-32 (IEEE 802.3, 同 zlib crc32()).
+ *
+ * 自动选择可用的最快实现，见 XF_FAL_CRC32_ACCEL_ENABLE 和 XF_FAL_CRC32_SLICE_BY_8.
+ *
+ * @param crc        之前数据的 CRC-32, 首次为 0.
+ * @param data       数据。
+ * @param size       数据大小，单位：字节。
+ * @return uint32_t  包含本段数据后的 CRC-32.
+ */
+uint32_t xf_fal_crc32(uint32_t crc, const void *data, size_t size);
+
+/**
+ * @brief 使用指定实现计算 CRC-32, 用于测试和基准。
+ *
+ * @param impl       实现，见 @ref xf_fal_crc32_impl_t .
+ * @param[in,out] p_crc 输入之前数据的 CRC-32 (首次为 0)，输出包含本段数据后的 CRC-32.
+ * @param data       数据。
+ * @param size       数据大小，单位：字节。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_SUPPORTED  该实现未编译或当前 CPU 不支持
+ */
+xf_err_t xf_fal_crc32_ex(
+    xf_fal_crc32_impl_t impl, uint32_t *p_crc, const void *data, size_t size);
+
+/**
+ * @brief 从指定分区连续读取数据到多个缓冲区（分散读）。
+ *
+ * @note 只查找一次分区，整个请求期间持有 flash 设备锁。
+ *
+ * @param part       分区表中的指定分区。
+ * @param src_offset 要读取的数据的地址。相对当前分区起始地址的偏移地址。
+ * @param iov        数据段数组，按顺序依次填充。
+ * @param iovcnt     数据段个数。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_partition_readv(
+    const xf_fal_partition_t *part, size_t src_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt);
+
+/**
+ * @brief 将多个缓冲区的数据连续写入指定分区（聚集写）。
+ *
+ * @note 只查找一次分区，整个请求期间持有 flash 设备锁。
+ * @note 驱动未实现 xf_fal_flash_ops_t.writev 时，
+ *       完整落在一个数据段内的页直接从该数据段写入，
+ *       跨数据段的页先合并到页缓冲区再写入，无需额外的整块拷贝。
+ *
+ * @param part       分区表中的指定分区。
+ * @param dst_offset 要写入的数据的地址。相对当前分区起始地址的偏移地址。
+ * @param iov        数据段数组，按顺序依次写入。
+ * @param iovcnt     数据段个数。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_partition_writev(
+    const xf_fal_partition_t *part, size_t dst_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt);
+
+/**
+ * @brief 通过分区句柄分散读，见 xf_fal_partition_readv().
+ */
+xf_err_t xf_fal_handle_readv(
+    const xf_fal_handle_t *handle, size_t src_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt);
+
+/**
+ * @brief 通过分区句柄聚集写，见 xf_fal_partition_writev().
+ */
+xf_err_t xf_fal_handle_writev(
+    const xf_fal_handle_t *handle, size_t dst_offset,
+    const xf_fal_iovec_t *iov, size_t iovcnt);
+
+#if XF_FAL_WRITE_BUFFER_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief 为分区挂接写缓冲。
+ *
+ * 挂接后该分区的 xf_fal_partition_write() / xf_fal_handle_write()
+ * 顺序写入先合并在写缓冲中，以下情况才编程到 flash:
+ * - 写满一页（到达页边界）；
+ * - 非顺序写入（新写入的地址不紧接缓冲中的数据）；
+ * - 调用 xf_fal_write_buffer_flush() 或 xf_fal_write_buffer_detach();
+ * - 其他写入、分散读、聚集写或擦除与缓冲中的数据重叠；
+ * - xf_fal_deinit().
+ *
+ * 读取时会合并缓冲中尚未写入的数据（读到自己的写入）。
+ *
+ * @attention 写入返回 XF_OK 不代表数据已在 flash 上，掉电前需要刷新。
+ *            编程失败在刷新时才会返回。
+ * @attention 注销分区表前需要先 xf_fal_write_buffer_detach().
+ *            xf_fal_async 的 async_start 路径不经过写缓冲，
+ *            对同一分区使用异步请求前需要先刷新。
+ *
+ * @param part 分区。
+ * @param wbuf 写缓冲，由用户分配，挂接期间必须保持有效。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_INITED         分区已挂接写缓冲或 wbuf 已被使用
+ */
+xf_err_t xf_fal_write_buffer_attach(
+    const xf_fal_partition_t *part, xf_fal_write_buffer_t *wbuf);
+
+/**
+ * @brief 刷新并取下分区的写缓冲。
+ *
+ * @param part 分区。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      分区未挂接写缓冲
+ *      - (OTHER)               刷新失败，写缓冲仍已取下
+ */
+xf_err_t xf_fal_write_buffer_detach(const xf_fal_partition_t *part);
+
+/**
+ * @brief 将分区写缓冲中的数据写入 flash.
+ *
+ * @param part 分区。为 NULL 时刷新所有写缓冲。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      分区未挂接写缓冲
+ *      - (OTHER)               写入失败，缓冲中的数据被丢弃
+ */
+xf_err_t xf_fal_write_buffer_flush(const xf_fal_partition_t *part);
+
+#endif // XF_FAL_WRITE_BUFFER_ENABLE
+
+#if (XF_FAL_READ_CACHE_NUM > 0) || defined(__DOXYGEN__)
+
+/**
+ * @brief 获取读缓存命中统计。
+ *
+ * @param[out] p_stat 统计结果。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_read_cache_get_stat(xf_fal_read_cache_stat_t *p_stat);
+
+/**
+ * @brief 清零读缓存命中统计。
+ */
+void xf_fal_read_cache_reset_stat(void);
+
+/**
+ * @brief 使读缓存失效。
+ *
+ * 通过 xf_fal 读写擦时缓存自动失效，无需调用。
+ * 用于 flash 内容被 xf_fal 以外的途径修改（如 DMA、另一个核）的情况。
+ *
+ * @param handle 分区句柄。为 NULL 时使全部缓存失效。
+ * @param offset 相对分区起始地址的偏移地址。
+ * @param size   大小，单位：字节。
+ */
+void xf_fal_read_cache_invalidate(
+    const xf_fal_handle_t *handle, size_t offset, size_t size);
+
+#endif // XF_FAL_READ_CACHE_NUM
+
+#if XF_FAL_STAT_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief 设置统计用时钟。
+ *
+ * @param clock 时钟。为 NULL 时只统计次数和字节数，不统计耗时。
+ */
+void xf_fal_stat_set_clock(xf_fal_stat_clock_t clock);
+
+/**
+ * @brief 获取分区的读写擦统计快照。
+ *
+ * @param part 分区。
+ * @param[out] p_stat 统计结果。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      分区未分配统计槽（未注册或超出 XF_FAL_STAT_PART_NUM）
+ */
+xf_err_t xf_fal_partition_get_stat(
+    const xf_fal_partition_t *part, xf_fal_stat_t *p_stat);
+
+/**
+ * @brief 获取 flash 设备的驱动调用统计快照。
+ *
+ * @param flash_dev flash 设备。
+ * @param[out] p_stat 统计结果。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      flash 设备未注册
+ */
+xf_err_t xf_fal_flash_device_get_stat(
+    const xf_fal_flash_dev_t *flash_dev, xf_fal_stat_t *p_stat);
+
+/**
+ * @brief 清零所有分区和 flash 设备的统计。
+ *
+ * @note 与读写擦并发调用时，清零期间的少量计数可能丢失。
+ */
+void xf_fal_stat_reset(void);
+
+/**
+ * @brief 打印各 flash 设备和分区的读写擦统计。
+ */
+void xf_fal_show_stat(void);
+
+#endif // XF_FAL_STAT_ENABLE
+
+#if XF_FAL_TRACE_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief 设置跟踪用时钟。
+ *
+ * @param clock 时钟。为 NULL 时记录的时间戳和耗时为 0, 仍可按 seq 排序。
+ */
+void xf_fal_trace_set_clock(xf_fal_stat_clock_t clock);
+
+/**
+ * @brief 清空跟踪记录。
+ */
+void xf_fal_trace_reset(void);
+
+/**
+ * @brief 导出跟踪记录。
+ *
+ * 格式见 xf_fal_trace_fmt.h, 可用主机端工具 trace_decode 解码为时间线和访问热力图。
+ * 不加锁，可以在其他操作卡住时（如看门狗、调试命令中）调用；
+ * 与读写擦并发时，正在写入的记录可能不完整。
+ *
+ * @param write     输出回调，通常写入串口或文件。
+ * @param user_data 传给 write 的用户数据。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               write 返回的错误
+ */
+xf_err_t xf_fal_trace_dump(xf_fal_trace_write_cb_t write, void *user_data);
+
+#endif // XF_FAL_TRACE_ENABLE
+
 /**
  * @brief 打印分区表信息。
  */
 void xf_fal_show_part_table(void);
 
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/**
+ * @cond (XFAPI_INTERNAL)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 注册运行时创建的 flash 设备，xf_fal 已初始化时立即刷新分区缓存。
+ *
+ * 供 xf_fal_wl_init(), xf_fal_file_init() 等创建设备的模块使用。
+ * 刷新分区缓存失败时注销该设备后返回错误。
+ *
+ * @param p_dev flash 设备。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - (OTHER)               xf_fal_register_flash_device() 或
+ *                              xf_fal_check_and_update_cache() 的错误，设备未注册
+ */
+xf_err_t xf_fal_register_flash_device_apply(const xf_fal_flash_dev_t *p_dev);
+
 /**
  * End of addtogroup group_xf_fal
  * @}
@@ -0,0 +1,346 @@
+/**
+ * @file xf_fal_async.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 异步读写请求队列。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_async.h"
+
+#if XF_FAL_ASYNC_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_async"
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 异步请求队列上下文。
+ */
+typedef struct _xf_fal_async_ctx_t {
+    volatile uint8_t            is_init;
+    xf_lock_t                   mutex;      /*!< 保护各设备队列 */
+    xf_fal_async_notify_cb_t    notify;
+    /**
+     * @brief 各 flash 设备的请求队列（单向链表），下标同 xf_fal_handle_t.dev_idx .
+     */
+    xf_fal_async_req_t         *head[XF_FAL_FLASH_DEVICE_NUM];
+    xf_fal_async_req_t         *tail[XF_FAL_FLASH_DEVICE_NUM];
+    /**
+     * @brief 各 flash 设备上正在执行的请求，出队时在 mutex 保护下占用，完成时清除。
+     */
+    xf_fal_async_req_t *volatile in_flight[XF_FAL_FLASH_DEVICE_NUM];
+} xf_fal_async_ctx_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_err_t xf_fal_async_prepare(xf_fal_async_req_t *req);
+static void xf_fal_async_enqueue(xf_fal_async_req_t *req);
+static void xf_fal_async_launch(xf_fal_async_req_t *req);
+static void xf_fal_async_complete(xf_fal_async_req_t *req, xf_err_t result);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_fal_async_ctx_t s_async_ctx = {0};
+#define sp_async()      (&s_async_ctx)
+
+/* ==================== [Macros] ============================================ */
+
+#define XF_FAL_ASYNC_LOCK() \
+    do { \
+        if (sp_async()->mutex) { \
+            xf_lock_lock(sp_async()->mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_ASYNC_UNLOCK() \
+    do { \
+        if (sp_async()->mutex) { \
+            xf_lock_unlock(sp_async()->mutex); \
+        } \
+    } while (0)
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_fal_async_init(xf_fal_async_notify_cb_t notify)
+{
+    if (sp_async()->is_init) {
+        return XF_ERR_INITED;
+    }
+
+    if (NULL == sp_async()->mutex) {
+        xf_lock_init(&sp_async()->mutex);
+    }
+    sp_async()->notify  = notify;
+    sp_async()->is_init = true;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_async_deinit(void)
+{
+    xf_err_t xf_ret = XF_OK;
+
+    if (!sp_async()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+
+    XF_FAL_ASYNC_LOCK();
+    for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        if ((sp_async()->head[i]) || (sp_async()->in_flight[i])) {
+            xf_ret = XF_ERR_BUSY;
+            break;
+        }
+    }
+    if (XF_OK == xf_ret) {
+        sp_async()->is_init = false;
+        sp_async()->notify  = NULL;
+    }
+    XF_FAL_ASYNC_UNLOCK();
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_async_submit(xf_fal_async_req_t *req)
+{
+    xf_err_t xf_ret;
+
+    xf_ret = xf_fal_async_prepare(req);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    xf_fal_async_enqueue(req);
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_async_process(size_t dev_idx)
+{
+    xf_err_t xf_ret;
+    xf_fal_async_req_t *req;
+    const xf_fal_handle_t *handle;
+
+    if (dev_idx >= XF_FAL_FLASH_DEVICE_NUM) {
+        return XF_ERR_INVALID_ARG;
+    }
+    /* 检查、出队和占用须是原子的，否则两个工作线程可能同时执行同一设备的请求 */
+    XF_FAL_ASYNC_LOCK();
+    if (sp_async()->in_flight[dev_idx]) {
+        XF_FAL_ASYNC_UNLOCK();
+        return XF_ERR_BUSY;
+    }
+    req = sp_async()->head[dev_idx];
+    if (req) {
+        sp_async()->head[dev_idx] = req->next;
+        if (NULL == req->next) {
+            sp_async()->tail[dev_idx] = NULL;
+        }
+        req->next = NULL;
+        sp_async()->in_flight[dev_idx] = req;
+    }
+    XF_FAL_ASYNC_UNLOCK();
+
+    if (!req) {
+        return XF_ERR_NOT_FOUND;
+    }
+
+    req->state  = XF_FAL_ASYNC_STATE_RUNNING;
+    handle      = &req->handle;
+
+    /* 驱动支持异步操作时只负责启动，由 xf_fal_async_done() 完成 */
+    if (handle->flash_dev->ops.async_start) {
+        xf_fal_async_launch(req);
+        return XF_OK;
+    }
+
+    switch (req->op) {
+    case XF_FAL_OP_READ:
+        xf_ret = xf_fal_handle_read(handle, req->offset, req->buf, req->size);
+        break;
+    case XF_FAL_OP_WRITE:
+        xf_ret = xf_fal_handle_write(handle, req->offset, req->buf, req->size);
+        break;
+    case XF_FAL_OP_ERASE:
+    default:
+        xf_ret = xf_fal_handle_erase(handle, req->offset, req->size);
+        break;
+    }
+    xf_fal_async_complete(req, xf_ret);
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_async_start(xf_fal_async_req_t *req)
+{
+    xf_err_t xf_ret;
+    size_t dev_idx;
+
+    xf_ret = xf_fal_async_prepare(req);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    if (NULL == req->handle.flash_dev->ops.async_start) {
+        /* 没有通知回调时不一定有工作线程，无法保证在其他线程中执行 */
+        if (NULL == sp_async()->notify) {
+            return XF_ERR_NOT_SUPPORTED;
+        }
+        xf_fal_async_enqueue(req);
+        return XF_OK;
+    }
+
+    dev_idx = req->handle.dev_idx;
+    XF_FAL_ASYNC_LOCK();
+    if (sp_async()->in_flight[dev_idx]) {
+        XF_FAL_ASYNC_UNLOCK();
+        return XF_ERR_BUSY;
+    }
+    sp_async()->in_flight[dev_idx] = req;
+    XF_FAL_ASYNC_UNLOCK();
+
+    req->result = XF_OK;
+    req->next   = NULL;
+    req->state  = XF_FAL_ASYNC_STATE_RUNNING;
+    xf_fal_async_launch(req);
+
+    return XF_OK;
+}
+
+void xf_fal_async_done(void *token, xf_err_t result)
+{
+    xf_fal_async_req_t *req = token;
+
+    if ((!req) || (XF_FAL_ASYNC_STATE_RUNNING != req->state)) {
+        return;
+    }
+
+    xf_fal_async_complete(req, result);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 检查请求并解析分区句柄。
+ */
+static xf_err_t xf_fal_async_prepare(xf_fal_async_req_t *req)
+{
+    xf_err_t xf_ret;
+
+    if (!sp_async()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if ((!req) || (!req->size) || (req->op >= XF_FAL_OP_MAX)
+            || ((XF_FAL_OP_ERASE != req->op) && (!req->buf))) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((XF_FAL_ASYNC_STATE_PENDING == req->state)
+            || (XF_FAL_ASYNC_STATE_RUNNING == req->state)) {
+        return XF_ERR_BUSY;
+    }
+
+    xf_ret = xf_fal_partition_get_handle(req->part, &req->handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    /* 提交时即检查边界，避免错误延迟到工作线程中才发现 */
+    if ((req->offset > req->handle.len)
+            || (req->size > req->handle.len - req->offset)) {
+        XF_LOGE(TAG, "Async request error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                req->part->name, (int)(req->offset + req->size), (int)req->handle.len);
+        return XF_ERR_INVALID_ARG;
+    }
+    /* 异步擦除不扩展范围，要求对齐到扇区 */
+    if ((XF_FAL_OP_ERASE == req->op) && (req->handle.flash_dev->sector_size)
+            && (((req->handle.base + req->offset) % req->handle.flash_dev->sector_size)
+                || (req->size % req->handle.flash_dev->sector_size))) {
+        XF_LOGE(TAG, "Async request error! "
+                "Partition(%s) erase range not aligned to sector.", req->part->name);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    return XF_OK;
+}
+
+/**
+ * @brief 请求加入设备队列并通知工作线程。
+ */
+static void xf_fal_async_enqueue(xf_fal_async_req_t *req)
+{
+    size_t dev_idx;
+
+    dev_idx         = req->handle.dev_idx;
+    req->result     = XF_OK;
+    req->next       = NULL;
+    req->state      = XF_FAL_ASYNC_STATE_PENDING;
+
+    XF_FAL_ASYNC_LOCK();
+    if (sp_async()->tail[dev_idx]) {
+        sp_async()->tail[dev_idx]->next = req;
+    } else {
+        sp_async()->head[dev_idx] = req;
+    }
+    sp_async()->tail[dev_idx] = req;
+    XF_FAL_ASYNC_UNLOCK();
+
+    if (sp_async()->notify) {
+        sp_async()->notify(dev_idx);
+    }
+}
+
+/**
+ * @brief 占用设备并通过 async_start 启动请求。调用者已占用 in_flight.
+ */
+static void xf_fal_async_launch(xf_fal_async_req_t *req)
+{
+    xf_err_t xf_ret;
+    const xf_fal_handle_t *handle = &req->handle;
+
+    xf_ret = xf_fal_async_op_begin(handle, req->op, req->offset, req->size,
+                                   &req->t0, &req->trace_seq);
+    if (XF_OK == xf_ret) {
+        xf_ret = handle->flash_dev->ops.async_start(
+                     req->op, handle->base + req->offset,
+                     (XF_FAL_OP_ERASE == req->op) ? NULL : req->buf,
+                     req->size, req);
+    }
+    if (xf_ret != XF_OK) {
+        XF_LOGE(TAG, "Flash device(%s) async start failed.", handle->flash_dev->name);
+        xf_fal_async_complete(req, xf_ret);
+    }
+}
+
+static void xf_fal_async_complete(xf_fal_async_req_t *req, xf_err_t result)
+{
+    size_t dev_idx = req->handle.dev_idx;
+    bool is_async = (NULL != req->handle.flash_dev->ops.async_start);
+
+    req->result = result;
+    /* async_start 绕过了 xf_fal 的读写擦路径，在此补做并释放设备 */
+    if (is_async) {
+        xf_fal_async_op_end(&req->handle, req->op, req->offset, req->size,
+                            result, req->t0, req->trace_seq);
+    }
+    sp_async()->in_flight[dev_idx] = NULL;
+    XF_FAL_MEMORY_BARRIER();
+    /* 先置为完成再回调，回调中可以重新提交 */
+    req->state = XF_FAL_ASYNC_STATE_DONE;
+    if (req->cb) {
+        req->cb(req);
+    }
+
+    /* 异步操作完成后唤醒工作线程继续处理队列 */
+    if ((is_async) && (sp_async()->notify)) {
+        sp_async()->notify(dev_idx);
+    }
+}
+
+#endif // XF_FAL_ASYNC_ENABLE
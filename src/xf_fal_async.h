@@ -0,0 +1,260 @@
+/**
+ * @file xf_fal_async.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 异步读写请求队列。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_ASYNC_H__
+#define __XF_FAL_ASYNC_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#if XF_FAL_ASYNC_ENABLE || defined(__DOXYGEN__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 异步请求状态。
+ */
+typedef enum _xf_fal_async_state_t {
+    XF_FAL_ASYNC_STATE_IDLE = 0,        /*!< 未提交 */
+    XF_FAL_ASYNC_STATE_PENDING,         /*!< 已提交，排队中 */
+    XF_FAL_ASYNC_STATE_RUNNING,         /*!< 正在执行 */
+    XF_FAL_ASYNC_STATE_DONE,            /*!< 已完成，结果见 xf_fal_async_req_t.result */
+} xf_fal_async_state_t;
+
+typedef struct _xf_fal_async_req_t xf_fal_async_req_t;
+
+/**
+ * @brief 请求完成回调。
+ *
+ * @note 在工作线程中调用；若设备实现了 xf_fal_flash_ops_t.async_start,
+ *       则在调用 xf_fal_async_done() 的上下文（可能是中断）中调用。
+ * @note 回调中可以重新提交同一个请求。
+ */
+typedef void (*xf_fal_async_cb_t)(xf_fal_async_req_t *req);
+
+/**
+ * @brief 有新请求需要处理时的通知回调。
+ *
+ * 由对接层实现，通常是释放对应设备工作线程等待的信号量。
+ *
+ * @param dev_idx flash 设备的注册下标，见 xf_fal_handle_t.dev_idx .
+ */
+typedef void (*xf_fal_async_notify_cb_t)(size_t dev_idx);
+
+/**
+ * @brief 异步读写擦请求描述。
+ *
+ * 请求对象由用户提供，在完成前必须保持有效，xf_fal 不做任何动态分配。
+ */
+struct _xf_fal_async_req_t {
+    /* 由用户填写 */
+    xf_fal_op_t                 op;         /*!< 操作类型 */
+    const xf_fal_partition_t   *part;       /*!< 目标分区 */
+    size_t                      offset;     /*!< 相对分区起始地址的偏移地址 */
+    void                       *buf;        /*!< 读的目标缓冲区或写的数据来源，擦除时忽略 */
+    size_t                      size;       /*!< 操作大小，单位：字节 */
+    xf_fal_async_cb_t           cb;         /*!< 完成回调，可以为 NULL */
+    void                       *user_data;  /*!< 用户数据 */
+
+    /* 由 xf_fal 填写，用户只读 */
+    volatile uint8_t            state;      /*!< 见 @ref xf_fal_async_state_t */
+    xf_err_t                    result;     /*!< 完成结果 */
+    xf_fal_handle_t             handle;     /*!< 提交时解析的分区句柄 */
+    xf_fal_async_req_t         *next;       /*!< 队列链表 */
+    uint32_t                    t0;         /*!< async_start 启动时的统计时间戳 */
+    uint32_t                    trace_seq;  /*!< async_start 启动时的跟踪记录序号 */
+};
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 初始化异步请求队列。
+ *
+ * @param notify 有新请求或异步操作完成时的通知回调，可以为 NULL (轮询处理)。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INITED         已初始化
+ */
+xf_err_t xf_fal_async_init(xf_fal_async_notify_cb_t notify);
+
+/**
+ * @brief 反初始化异步请求队列。
+ *
+ * @attention 调用前需确保所有请求均已完成。
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_BUSY           仍有未完成的请求
+ */
+xf_err_t xf_fal_async_deinit(void);
+
+/**
+ * @brief 提交一个异步请求。
+ *
+ * 请求加入分区所在 flash 设备的队列，由该设备的工作线程通过
+ * xf_fal_async_process() 依次执行。
+ *
+ * @param req 请求。需要填写 op, part, offset, buf, size, 可选 cb 和 user_data.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_BUSY           请求仍在队列中或正在执行
+ */
+xf_err_t xf_fal_async_submit(xf_fal_async_req_t *req);
+
+/**
+ * @brief 处理指定 flash 设备队列中的一个请求。
+ *
+ * 由对接层的工作线程调用，通常在收到通知后循环调用直到返回非 XF_OK.
+ * 设备未实现 xf_fal_flash_ops_t.async_start 时在当前线程同步执行，
+ * 否则只启动操作，完成时由驱动调用 xf_fal_async_done().
+ * 同一设备上的请求按提交顺序逐个执行，前一个完成前不会开始下一个。
+ *
+ * @note 通过 async_start 启动的操作在完成前占用设备，
+ *       此期间该设备上的同步读写擦等待其完成，见 XF_FAL_ASYNC_BUSY_WAIT.
+ *
+ * @param dev_idx flash 设备的注册下标。
+ * @return xf_err_t
+ *      - XF_OK                 处理了一个请求
+ *      - XF_ERR_NOT_FOUND      队列为空
+ *      - XF_ERR_BUSY           该设备上的异步操作尚未完成
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_async_process(size_t dev_idx);
+
+/**
+ * @brief 驱动通知异步操作完成。
+ *
+ * 在此释放设备占用，并完成读缓存失效、擦除计数、统计和跟踪记录。
+ *
+ * @attention 启用 XF_FAL_LOCK_IS_ENABLE 且启用读缓存、擦除计数或统计时，
+ *            其中会获取互斥锁，不能在中断中调用，应在中断中通知线程后由线程调用。
+ *
+ * @param token  xf_fal_flash_ops_t.async_start 收到的 token.
+ * @param result 操作结果。
+ */
+void xf_fal_async_done(void *token, xf_err_t result);
+
+/**
+ * @brief 查询请求是否已完成。
+ *
+ * @param req 请求。
+ * @return true                 已完成，结果见 xf_fal_async_req_t.result
+ * @return false                未完成
+ */
+static inline bool xf_fal_async_is_done(const xf_fal_async_req_t *req)
+{
+    return (XF_FAL_ASYNC_STATE_DONE == req->state);
+}
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+
+/**
+ * @cond (XFAPI_INTERNAL)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 在调用者以外的上下文中启动请求，供 xf_fal 内部使用（如分区复制的预读）。
+ *
+ * 设备实现 async_start 时不经过队列直接启动；否则有通知回调（即有工作线程）时加入队列。
+ * 调用者不会执行其他请求，可以轮询 xf_fal_async_is_done() 等待本请求完成。
+ *
+ * @param req 请求，填写要求同 xf_fal_async_submit().
+ * @return xf_err_t
+ *      - XF_OK                 已启动或已加入队列
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_BUSY           设备上的异步操作尚未完成
+ *      - XF_ERR_NOT_SUPPORTED  设备不支持 async_start 且没有工作线程
+ */
+xf_err_t xf_fal_async_start(xf_fal_async_req_t *req);
+
+/**
+ * @brief 调用 async_start 前占用设备。由 xf_fal_async 内部调用，实现在 xf_fal.c.
+ *
+ * 取得设备锁（等待前一个异步操作完成），写入与范围重叠的写缓冲，
+ * 然后标记设备被异步操作占用，在 xf_fal_async_op_end() 中释放。
+ *
+ * @param handle        分区句柄。
+ * @param op            操作类型。
+ * @param offset        相对分区起始地址的偏移地址。
+ * @param size          操作大小，单位：字节。
+ * @param[out] p_t0         统计用的开始时间戳。
+ * @param[out] p_trace_seq  跟踪记录序号。
+ * @return xf_err_t
+ *      - XF_OK                 成功，必须随后调用 xf_fal_async_op_end()
+ *      - (OTHER)               写入写缓冲失败，设备未被占用
+ */
+xf_err_t xf_fal_async_op_begin(
+    const xf_fal_handle_t *handle, xf_fal_op_t op, size_t offset, size_t size,
+    uint32_t *p_t0, uint32_t *p_trace_seq);
+
+/**
+ * @brief 异步操作结束后释放设备。由 xf_fal_async 内部调用，实现在 xf_fal.c.
+ *
+ * 使读缓存失效、记录擦除次数、统计和跟踪，参数同 xf_fal_async_op_begin().
+ * xf_fal_async_op_begin() 失败时也需调用以记录统计和跟踪。
+ *
+ * @param result        操作结果。
+ */
+void xf_fal_async_op_end(
+    const xf_fal_handle_t *handle, xf_fal_op_t op, size_t offset, size_t size,
+    xf_err_t result, uint32_t t0, uint32_t trace_seq);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // XF_FAL_ASYNC_ENABLE
+
+#endif // __XF_FAL_ASYNC_H__
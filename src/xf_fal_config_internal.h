@@ -46,6 +46,452 @@ extern "C" {
 #   define XF_FAL_CACHE_NUM             16
 #endif
 
+/**
+ * @brief 分区名哈希索引的槽位数。
+ *
+ * 用于 xf_fal_partition_find() 按名称 O(1) 查找已缓存的分区。
+ * 必须大于 XF_FAL_CACHE_NUM, 推荐为 2 的幂且不小于 XF_FAL_CACHE_NUM 的 2 倍。
+ */
+#ifndef XF_FAL_HASH_INDEX_NUM
+#   define XF_FAL_HASH_INDEX_NUM        (XF_FAL_CACHE_NUM * 2)
+#endif
+
+#if (XF_FAL_HASH_INDEX_NUM <= XF_FAL_CACHE_NUM)
+#   error "XF_FAL_HASH_INDEX_NUM must be greater than XF_FAL_CACHE_NUM."
+#endif
+
+/**
+ * @brief 使用哈希索引查找分区名的最少分区数。
+ *
+ * 分区较少时遍历分区表比计算哈希更快，少于此数时 xf_fal_partition_find() 遍历分区表。
+ */
+#ifndef XF_FAL_HASH_FIND_MIN_NUM
+#   define XF_FAL_HASH_FIND_MIN_NUM     12
+#endif
+
+#if (XF_FAL_CACHE_NUM >= 0xFFFF)
+#   error "XF_FAL_CACHE_NUM must be less than 65535."
+#endif
+
+/**
+ * @brief xf_fal 内部页缓冲区大小（栈上分配），单位：字节。
+ *
+ * 用于聚集写时合并跨数据段的页，推荐不小于 flash 的页大小；
+ * 也用作擦除前空白检查的读缓冲区。
+ */
+#ifndef XF_FAL_PAGE_BUF_SIZE
+#   define XF_FAL_PAGE_BUF_SIZE         256
+#endif
+
+/**
+ * @brief 是否由 xf_fal 拆分写入。
+ *
+ * 启用后 xf_fal 保证每次调用 xf_fal_flash_ops_t.write 都不跨页，
+ * 且地址和大小按 xf_fal_flash_dev_t.io_size 对齐，
+ * 首尾不对齐部分由 xf_fal 读-改-写，驱动无需再自行处理。
+ */
+#ifndef XF_FAL_WRITE_SPLIT_ENABLE
+#   define XF_FAL_WRITE_SPLIT_ENABLE    1
+#endif
+
+/**
+ * @brief 支持的最大 xf_fal_flash_dev_t.io_size, 单位：字节。
+ *
+ * 用于拆分写入时首尾读-改-写的栈上缓冲区。
+ */
+#ifndef XF_FAL_IO_SIZE_MAX
+#   define XF_FAL_IO_SIZE_MAX           16
+#endif
+
+/**
+ * @brief 按需更新 xf_fal_partition_update() 读-改-写扇区的缓冲区大小（静态分配），单位：字节。
+ *
+ * 需要擦除但未被更新范围完全覆盖的首尾扇区，先整扇区读出、合并后擦除重新编程。
+ * 扇区大于此值时不做读-改-写，返回 XF_ERR_NOT_SUPPORTED.
+ * 默认为 0, 不分配缓冲区；需要部分覆盖扇区的更新时设为扇区大小，如 4096.
+ */
+#ifndef XF_FAL_UPDATE_SECTOR_BUF_SIZE
+#   define XF_FAL_UPDATE_SECTOR_BUF_SIZE    0
+#endif
+
+/**
+ * @brief 擦除范围未对齐到扇区时是否扩展。
+ *
+ * - 0: 返回 XF_ERR_INVALID_ARG.
+ * - 1: 向外扩展到扇区边界后擦除，扩展后超出分区时仍返回 XF_ERR_INVALID_ARG.
+ *      @attention 扩展部分的数据也会被擦除。
+ */
+#ifndef XF_FAL_ERASE_WIDEN_ENABLE
+#   define XF_FAL_ERASE_WIDEN_ENABLE    0
+#endif
+
+/**
+ * @brief 扇区读缓存的行数，0 表示不启用。
+ *
+ * 启用后小块读取以缓存行为单位从 flash 读入 RAM, 按 LRU 淘汰，
+ * 写入和擦除时使对应的缓存行失效。
+ * 占用 RAM 约 XF_FAL_READ_CACHE_NUM * XF_FAL_READ_CACHE_LINE_SIZE 字节。
+ * 查找为线性遍历，行数推荐不超过 32.
+ */
+#ifndef XF_FAL_READ_CACHE_NUM
+#   define XF_FAL_READ_CACHE_NUM        0
+#endif
+
+/**
+ * @brief 读缓存行大小，单位：字节。
+ *
+ * 必须是 2 的幂。通常等于 flash 扇区大小，
+ * 较小的值可以降低未命中时的读取开销。
+ */
+#ifndef XF_FAL_READ_CACHE_LINE_SIZE
+#   define XF_FAL_READ_CACHE_LINE_SIZE  4096
+#endif
+
+/**
+ * @brief 超过此大小的读取不经过读缓存，直接读 flash, 避免大块顺序读冲刷缓存。
+ */
+#ifndef XF_FAL_READ_CACHE_BYPASS_SIZE
+#   define XF_FAL_READ_CACHE_BYPASS_SIZE    XF_FAL_READ_CACHE_LINE_SIZE
+#endif
+
+#if (XF_FAL_READ_CACHE_NUM > 0) \
+        && (XF_FAL_READ_CACHE_LINE_SIZE & (XF_FAL_READ_CACHE_LINE_SIZE - 1))
+#   error "XF_FAL_READ_CACHE_LINE_SIZE must be a power of 2."
+#endif
+
+/**
+ * @brief 是否支持分区写缓冲（写回）。
+ *
+ * 启用后可以通过 xf_fal_write_buffer_attach() 为分区挂接写缓冲，
+ * 连续的小块顺序写入先合并在 RAM 中，写满一页、非顺序写入或显式刷新时
+ * 才编程到 flash.
+ */
+#ifndef XF_FAL_WRITE_BUFFER_ENABLE
+#   define XF_FAL_WRITE_BUFFER_ENABLE   0
+#endif
+
+/**
+ * @brief 每个写缓冲的大小，单位：字节。推荐等于 flash 的页大小。
+ *
+ * flash 页大小大于此值时，以此大小作为合并的边界。
+ */
+#ifndef XF_FAL_WRITE_BUFFER_SIZE
+#   define XF_FAL_WRITE_BUFFER_SIZE     XF_FAL_PAGE_BUF_SIZE
+#endif
+
+/**
+ * @brief 是否启用异步读写请求队列 xf_fal_async.
+ */
+#ifndef XF_FAL_ASYNC_ENABLE
+#   define XF_FAL_ASYNC_ENABLE          0
+#endif
+
+/**
+ * @brief 同步读写擦等待设备上的异步操作（async_start）完成时，每轮等待执行的动作。
+ *
+ * 默认忙等，使用 RTOS 时可对接为让出 CPU, 如 `#define XF_FAL_ASYNC_BUSY_WAIT() osDelay(1)`.
+ */
+#ifndef XF_FAL_ASYNC_BUSY_WAIT
+#   define XF_FAL_ASYNC_BUSY_WAIT()     do {} while (0)
+#endif
+
+/**
+ * @brief 分区间复制 xf_fal_partition_copy() 每块的大小（静态缓冲区），单位：字节。
+ *
+ * 推荐设为扇区大小以减少驱动调用次数。
+ * 启用 XF_FAL_ASYNC_ENABLE 时使用两块缓冲区，跨设备复制时读写重叠。
+ * 缓冲区由所有复制共用，同时进行的复制依次执行。
+ */
+#ifndef XF_FAL_COPY_BUF_SIZE
+#   define XF_FAL_COPY_BUF_SIZE         XF_FAL_PAGE_BUF_SIZE
+#endif
+
+/**
+ * @brief 流式写入 xf_fal_stream_t 的页缓冲区大小，单位：字节。
+ *
+ * flash 页大小大于此值时，以此大小作为缓冲的边界。
+ */
+#ifndef XF_FAL_STREAM_BUF_SIZE
+#   define XF_FAL_STREAM_BUF_SIZE       XF_FAL_PAGE_BUF_SIZE
+#endif
+
+/**
+ * @brief 分区哈希 xf_fal_partition_crc32() / xf_fal_partition_hash()
+ *        每次读取的大小（栈上缓冲区），单位：字节。
+ *
+ * 越大驱动调用次数越少，推荐设为扇区大小。
+ */
+#ifndef XF_FAL_HASH_BUF_SIZE
+#   define XF_FAL_HASH_BUF_SIZE         XF_FAL_PAGE_BUF_SIZE
+#endif
+
+/**
+ * @brief 键值存储 xf_fal_kv_t 的索引项数，必须是 2 的幂。每项 8 字节，最多存放 (此值 - 1) 个键。
+ */
+#ifndef XF_FAL_KV_INDEX_NUM
+#   define XF_FAL_KV_INDEX_NUM          128
+#endif
+
+/**
+ * @brief 键值存储分区的最大扇区数。
+ */
+#ifndef XF_FAL_KV_SECTOR_NUM
+#   define XF_FAL_KV_SECTOR_NUM         16
+#endif
+
+/**
+ * @brief 键的最大长度（不含 '\0'），不超过 254.
+ */
+#ifndef XF_FAL_KV_KEY_MAX
+#   define XF_FAL_KV_KEY_MAX            32
+#endif
+
+/**
+ * @brief 键值存储比较键和回收时复制记录的缓冲区大小，单位：字节。不小于 XF_FAL_KV_KEY_MAX.
+ */
+#ifndef XF_FAL_KV_BUF_SIZE
+#   define XF_FAL_KV_BUF_SIZE           64
+#endif
+
+#if (XF_FAL_KV_INDEX_NUM & (XF_FAL_KV_INDEX_NUM - 1)) || (XF_FAL_KV_INDEX_NUM < 2)
+#   error "XF_FAL_KV_INDEX_NUM must be a power of 2."
+#endif
+
+#if (XF_FAL_KV_KEY_MAX > 254) || (XF_FAL_KV_BUF_SIZE < XF_FAL_KV_KEY_MAX)
+#   error "Invalid XF_FAL_KV_KEY_MAX or XF_FAL_KV_BUF_SIZE."
+#endif
+
+/**
+ * @brief 环形日志 xf_fal_ring_t 的页缓冲区大小，单位：字节。
+ *
+ * flash 页大小大于此值时，以此大小作为缓冲的边界。
+ */
+#ifndef XF_FAL_RING_BUF_SIZE
+#   define XF_FAL_RING_BUF_SIZE         XF_FAL_PAGE_BUF_SIZE
+#endif
+
+/**
+ * @brief CRC-32 是否使用 slice-by-8 查表（8 KiB 常量表）。
+ *
+ * 为 0 时使用 64 字节的半字节查表，速度约为 slice-by-8 的 1/8.
+ */
+#ifndef XF_FAL_CRC32_SLICE_BY_8
+#   define XF_FAL_CRC32_SLICE_BY_8      1
+#endif
+
+/**
+ * @brief CRC-32 是否使用 CPU 指令加速。
+ *
+ * - ARMv8 编译时启用了 CRC32 扩展 (__ARM_FEATURE_CRC32) 时使用 CRC32 指令；
+ * - x86 GCC/Clang 下运行时检测 PCLMULQDQ 和 SSE4.1, 支持时使用无进位乘法折叠。
+ *
+ * 不满足条件时自动退回查表实现。
+ */
+#ifndef XF_FAL_CRC32_ACCEL_ENABLE
+#   define XF_FAL_CRC32_ACCEL_ENABLE    1
+#endif
+
+/**
+ * @brief 是否启用读写擦统计。
+ *
+ * 启用后按分区统计接口调用、按 flash 设备统计驱动调用的
+ * 次数、字节数、失败次数和耗时直方图，见 xf_fal_partition_get_stat().
+ * 为 0 时不占用任何内存和时间。
+ */
+#ifndef XF_FAL_STAT_ENABLE
+#   define XF_FAL_STAT_ENABLE           0
+#endif
+
+/**
+ * @brief 分区统计槽个数，超出的分区不统计。
+ */
+#ifndef XF_FAL_STAT_PART_NUM
+#   define XF_FAL_STAT_PART_NUM         XF_FAL_CACHE_NUM
+#endif
+
+/**
+ * @brief 耗时直方图桶数。
+ *
+ * 第 0 桶为耗时 0, 第 i 桶为 [2^(i-1), 2^i) 个时钟单位，最后一桶包含更大的耗时。
+ */
+#ifndef XF_FAL_STAT_HIST_NUM
+#   define XF_FAL_STAT_HIST_NUM         16
+#endif
+
+/**
+ * @brief 是否启用操作跟踪。
+ *
+ * 启用后每次分区读写擦都会写入内存中的环形记录，
+ * 用于定位卡死时正在进行的操作，见 xf_fal_trace_dump().
+ */
+#ifndef XF_FAL_TRACE_ENABLE
+#   define XF_FAL_TRACE_ENABLE          0
+#endif
+
+/**
+ * @brief 跟踪记录条数，必须是 2 的幂。每条 24 字节。
+ */
+#ifndef XF_FAL_TRACE_NUM
+#   define XF_FAL_TRACE_NUM             64
+#endif
+
+#if XF_FAL_TRACE_ENABLE && (XF_FAL_TRACE_NUM & (XF_FAL_TRACE_NUM - 1))
+#   error "XF_FAL_TRACE_NUM must be a power of 2."
+#endif
+
+/**
+ * @brief 是否启用擦除次数（磨损）统计，见 xf_fal_wear.h.
+ */
+#ifndef XF_FAL_WEAR_ENABLE
+#   define XF_FAL_WEAR_ENABLE           0
+#endif
+
+/**
+ * @brief 统计擦除次数的扇区总数（所有 flash 设备之和），每个扇区占 6 字节内存。
+ */
+#ifndef XF_FAL_WEAR_SECTOR_NUM
+#   define XF_FAL_WEAR_SECTOR_NUM       1024
+#endif
+
+/**
+ * @brief 擦除次数持久化时单条记录的最大长度，单位：字节。
+ *
+ * 越大则记录条数越少（每条有 8 字节头尾开销），不影响可统计的扇区数。
+ */
+#ifndef XF_FAL_WEAR_BUF_SIZE
+#   define XF_FAL_WEAR_BUF_SIZE         128
+#endif
+
+/**
+ * @brief 累计多少次未持久化的扇区擦除后自动持久化，0 表示只在调用
+ *        xf_fal_wear_sync() 时持久化。
+ */
+#ifndef XF_FAL_WEAR_SYNC_THRESHOLD
+#   define XF_FAL_WEAR_SYNC_THRESHOLD   0
+#endif
+
+/**
+ * @brief 是否启用磨损均衡虚拟 flash 设备，见 xf_fal_wl.h.
+ */
+#ifndef XF_FAL_WL_ENABLE
+#   define XF_FAL_WL_ENABLE             0
+#endif
+
+/**
+ * @brief 最多可创建的磨损均衡虚拟 flash 设备数，最大为 4.
+ */
+#ifndef XF_FAL_WL_NUM
+#   define XF_FAL_WL_NUM                1
+#endif
+
+/**
+ * @brief 每个磨损均衡设备最多的物理数据扇区数，每个扇区占 8 字节内存。
+ */
+#ifndef XF_FAL_WL_SECTOR_NUM
+#   define XF_FAL_WL_SECTOR_NUM         128
+#endif
+
+#if XF_FAL_WL_ENABLE && ((XF_FAL_WL_NUM < 1) || (XF_FAL_WL_NUM > 4))
+#   error "XF_FAL_WL_NUM must be 1 ~ 4."
+#endif
+
+#if XF_FAL_WL_ENABLE && (XF_FAL_WL_SECTOR_NUM > 0xFFFE)
+#   error "XF_FAL_WL_SECTOR_NUM too large."
+#endif
+
+/**
+ * @brief 是否启用主机端文件映射 flash 设备，见 xf_fal_file.h. 需要 POSIX mmap.
+ */
+#ifndef XF_FAL_FILE_ENABLE
+#   define XF_FAL_FILE_ENABLE           0
+#endif
+
+/**
+ * @brief 最多可创建的文件映射 flash 设备数，最大为 4.
+ */
+#ifndef XF_FAL_FILE_NUM
+#   define XF_FAL_FILE_NUM              2
+#endif
+
+#if XF_FAL_FILE_ENABLE && ((XF_FAL_FILE_NUM < 1) || (XF_FAL_FILE_NUM > 4))
+#   error "XF_FAL_FILE_NUM must be 1 ~ 4."
+#endif
+
+/**
+ * @brief 是否启用 flash 时序模拟设备，见 xf_fal_sim.h.
+ *
+ * 示例工程以 `xmake f --flash_sim=y` 配置时启用，并经模拟设备注册 mock flash.
+ */
+#ifndef XF_FAL_SIM_ENABLE
+#   define XF_FAL_SIM_ENABLE            0
+#endif
+
+/**
+ * @brief 最多可创建的时序模拟设备数，最大为 4.
+ */
+#ifndef XF_FAL_SIM_NUM
+#   define XF_FAL_SIM_NUM               2
+#endif
+
+#if XF_FAL_SIM_ENABLE && ((XF_FAL_SIM_NUM < 1) || (XF_FAL_SIM_NUM > 4))
+#   error "XF_FAL_SIM_NUM must be 1 ~ 4."
+#endif
+
+/**
+ * @brief 内存屏障。
+ *
+ * 用于发布注册表快照，保证读者看到快照指针时快照内容已写入。
+ * 非 GCC/Clang 编译器或多核平台需要对接为对应的屏障指令。
+ */
+#ifndef XF_FAL_MEMORY_BARRIER
+#   if defined(__GNUC__) || defined(__clang__)
+#       define XF_FAL_MEMORY_BARRIER()  __sync_synchronize()
+#   else
+#       define XF_FAL_MEMORY_BARRIER()  do {} while (0)
+#   endif
+#endif
+
+/**
+ * @brief 读屏障（acquire）。
+ *
+ * 用于无锁查找时读取快照序号，只需保证读操作之间的顺序。
+ * 默认与 XF_FAL_MEMORY_BARRIER 相同，GCC/Clang 下使用更轻量的 acquire 屏障。
+ */
+#ifndef XF_FAL_READ_BARRIER
+#   if defined(__ATOMIC_ACQUIRE)
+#       define XF_FAL_READ_BARRIER()    __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#   else
+#       define XF_FAL_READ_BARRIER()    XF_FAL_MEMORY_BARRIER()
+#   endif
+#endif
+
+/**
+ * @brief 统计计数的原子加。
+ *
+ * 不同设备上的操作会并发更新同一统计（如分区表跨设备时的全局计数），
+ * GCC/Clang 下使用 relaxed 原子加，其他编译器需要对接，否则计数可能偶尔丢失。
+ */
+#ifndef XF_FAL_STAT_ADD
+#   if defined(__ATOMIC_RELAXED)
+#       define XF_FAL_STAT_ADD(_p, _v)  ((void)__atomic_fetch_add((_p), (_v), __ATOMIC_RELAXED))
+#   else
+#       define XF_FAL_STAT_ADD(_p, _v)  ((void)(*(_p) += (_v)))
+#   endif
+#endif
+
+/**
+ * @brief 原子加并返回旧值。
+ *
+ * 用于多个线程无锁占用跟踪记录，其他编译器需要对接，否则并发时记录可能互相覆盖。
+ */
+#ifndef XF_FAL_FETCH_ADD
+#   if defined(__ATOMIC_RELAXED)
+#       define XF_FAL_FETCH_ADD(_p, _v) __atomic_fetch_add((_p), (_v), __ATOMIC_RELAXED)
+#   else
+#       define XF_FAL_FETCH_ADD(_p, _v) ((*(_p) += (_v)) - (_v))
+#   endif
+#endif
+
 #ifndef XF_FAL_DEFAULT_FLASH_DEVICE_NAME
 #   define XF_FAL_DEFAULT_FLASH_DEVICE_NAME     "default_flash"
 #endif
@@ -0,0 +1,377 @@
+/**
+ * @file xf_fal_file.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 主机端文件映射 flash 设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_file.h"
+
+#if XF_FAL_FILE_ENABLE
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#   error "XF_FAL_FILE_ENABLE requires POSIX mmap."
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#   define XF_FAL_FILE_SIMD_SSE2    1
+#elif defined(__ARM_NEON)
+#   include <arm_neon.h>
+#   define XF_FAL_FILE_SIMD_NEON    1
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_file"
+
+#ifndef XF_FAL_FILE_SIMD_SSE2
+#   define XF_FAL_FILE_SIMD_SSE2    0
+#endif
+#ifndef XF_FAL_FILE_SIMD_NEON
+#   define XF_FAL_FILE_SIMD_NEON    0
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 文件映射 flash 设备上下文。
+ *
+ * 读写擦由 xf_fal 按设备串行化，因此除初始化外无需加锁。
+ */
+typedef struct _xf_fal_file_ctx_t {
+    bool                is_used;
+    char                name[XF_FAL_DEV_NAME_MAX + 1];
+    xf_fal_flash_dev_t  dev;            /*!< 注册到 xf_fal 的设备 */
+    int                 fd;
+    uint8_t            *map;            /*!< 镜像文件的映射区，长度为 dev.len */
+} xf_fal_file_ctx_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_fal_file_ctx_t *xf_fal_file_find(const char *dev_name);
+static xf_err_t xf_fal_file_read(xf_fal_file_ctx_t *file, size_t src_offset, void *dst, size_t size);
+static xf_err_t xf_fal_file_write(
+    xf_fal_file_ctx_t *file, size_t dst_offset, const void *src, size_t size);
+static xf_err_t xf_fal_file_erase(xf_fal_file_ctx_t *file, size_t offset, size_t size);
+static xf_err_t xf_fal_file_blank_check(
+    xf_fal_file_ctx_t *file, size_t offset, size_t size, bool *p_is_blank);
+static void xf_fal_file_program(uint8_t *dst, const uint8_t *src, size_t size);
+static xf_err_t xf_fal_file_map(xf_fal_file_ctx_t *file, const char *path, size_t len);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_fal_file_ctx_t s_file_ctx[XF_FAL_FILE_NUM] = {0};
+#define sp_file(_idx)   (&s_file_ctx[_idx])
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief xf_fal_flash_ops_t 不带上下文参数，此处为每个设备生成一组转发函数。
+ */
+#define XF_FAL_FILE_OPS_DEFINE(_idx) \
+    static xf_err_t xf_fal_file##_idx##_read(size_t src_offset, void *dst, size_t size) \
+    { return xf_fal_file_read(sp_file(_idx), src_offset, dst, size); } \
+    static xf_err_t xf_fal_file##_idx##_write(size_t dst_offset, const void *src, size_t size) \
+    { return xf_fal_file_write(sp_file(_idx), dst_offset, src, size); } \
+    static xf_err_t xf_fal_file##_idx##_erase(size_t offset, size_t size) \
+    { return xf_fal_file_erase(sp_file(_idx), offset, size); } \
+    static xf_err_t xf_fal_file##_idx##_blank_check(size_t offset, size_t size, bool *p_is_blank) \
+    { return xf_fal_file_blank_check(sp_file(_idx), offset, size, p_is_blank); }
+
+#define XF_FAL_FILE_OPS_INIT(_idx) \
+    { \
+        .read           = xf_fal_file##_idx##_read, \
+        .write          = xf_fal_file##_idx##_write, \
+        .erase          = xf_fal_file##_idx##_erase, \
+        .blank_check    = xf_fal_file##_idx##_blank_check, \
+    }
+
+XF_FAL_FILE_OPS_DEFINE(0)
+#if XF_FAL_FILE_NUM > 1
+XF_FAL_FILE_OPS_DEFINE(1)
+#endif
+#if XF_FAL_FILE_NUM > 2
+XF_FAL_FILE_OPS_DEFINE(2)
+#endif
+#if XF_FAL_FILE_NUM > 3
+XF_FAL_FILE_OPS_DEFINE(3)
+#endif
+
+static const xf_fal_flash_ops_t s_file_ops[XF_FAL_FILE_NUM] = {
+    XF_FAL_FILE_OPS_INIT(0),
+#if XF_FAL_FILE_NUM > 1
+    XF_FAL_FILE_OPS_INIT(1),
+#endif
+#if XF_FAL_FILE_NUM > 2
+    XF_FAL_FILE_OPS_INIT(2),
+#endif
+#if XF_FAL_FILE_NUM > 3
+    XF_FAL_FILE_OPS_INIT(3),
+#endif
+};
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_fal_file_init(const char *dev_name, const xf_fal_file_cfg_t *cfg)
+{
+    xf_err_t xf_ret;
+    xf_fal_file_ctx_t *file = NULL;
+    size_t name_len;
+    size_t idx = 0;
+
+    if ((NULL == dev_name) || (NULL == cfg) || (NULL == cfg->path)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((0 == cfg->len) || (0 == cfg->sector_size) || (cfg->len % cfg->sector_size)
+            || ((cfg->page_size) && (cfg->sector_size % cfg->page_size))
+            || ((cfg->io_size) && (cfg->page_size) && (cfg->page_size % cfg->io_size))) {
+        XF_LOGE(TAG, "Invalid geometry for %s.", dev_name);
+        return XF_ERR_INVALID_ARG;
+    }
+    if (xf_fal_file_find(dev_name)) {
+        return XF_ERR_INITED;
+    }
+    for (idx = 0; idx < XF_FAL_FILE_NUM; idx++) {
+        if (!sp_file(idx)->is_used) {
+            file = sp_file(idx);
+            break;
+        }
+    }
+    if (NULL == file) {
+        return XF_ERR_RESOURCE;
+    }
+
+    memset(file, 0, sizeof(*file));
+    xf_ret = xf_fal_file_map(file, cfg->path, cfg->len);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    name_len = xf_strlen(dev_name);
+    if (name_len > XF_FAL_DEV_NAME_MAX) {
+        name_len = XF_FAL_DEV_NAME_MAX;
+    }
+    memcpy(file->name, dev_name, name_len);
+    file->name[name_len]    = '\0';
+    file->dev.name          = file->name;
+    file->dev.addr          = 0;
+    file->dev.len           = cfg->len;
+    file->dev.sector_size   = cfg->sector_size;
+    file->dev.page_size     = cfg->page_size;
+    file->dev.io_size       = cfg->io_size;
+    file->dev.ops           = s_file_ops[idx];
+    file->is_used           = true;
+    xf_ret = xf_fal_register_flash_device_apply(&file->dev);
+    if (xf_ret != XF_OK) {
+        file->is_used = false;
+        munmap(file->map, cfg->len);
+        close(file->fd);
+        file->map   = NULL;
+        file->fd    = -1;
+        return xf_ret;
+    }
+    XF_LOGD(TAG, "%s: %lu bytes mapped from %s.",
+            file->name, (unsigned long)cfg->len, cfg->path);
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_file_deinit(const char *dev_name)
+{
+    xf_err_t xf_ret;
+    xf_fal_file_ctx_t *file;
+
+    if (NULL == dev_name) {
+        return XF_ERR_INVALID_ARG;
+    }
+    file = xf_fal_file_find(dev_name);
+    if (NULL == file) {
+        return XF_ERR_NOT_FOUND;
+    }
+
+    xf_ret = xf_fal_unregister_flash_device(&file->dev);
+    if ((xf_ret != XF_OK) && (xf_ret != XF_ERR_NOT_FOUND)) {
+        return xf_ret;
+    }
+    file->is_used = false;
+    if (xf_fal_get_ctx()->is_init) {
+        (void)xf_fal_check_and_update_cache();
+    }
+
+    (void)msync(file->map, file->dev.len, MS_SYNC);
+    munmap(file->map, file->dev.len);
+    close(file->fd);
+    file->map   = NULL;
+    file->fd    = -1;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_file_sync(const char *dev_name)
+{
+    xf_fal_file_ctx_t *file;
+
+    if (NULL == dev_name) {
+        return XF_ERR_INVALID_ARG;
+    }
+    file = xf_fal_file_find(dev_name);
+    if (NULL == file) {
+        return XF_ERR_NOT_FOUND;
+    }
+
+    return (0 == msync(file->map, file->dev.len, MS_SYNC)) ? XF_OK : XF_FAIL;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_fal_file_ctx_t *xf_fal_file_find(const char *dev_name)
+{
+    for (size_t i = 0; i < XF_FAL_FILE_NUM; i++) {
+        if ((sp_file(i)->is_used)
+                && (0 == xf_strncmp(sp_file(i)->name, dev_name, XF_FAL_DEV_NAME_MAX))) {
+            return sp_file(i);
+        }
+    }
+    return NULL;
+}
+
+static xf_err_t xf_fal_file_read(xf_fal_file_ctx_t *file, size_t src_offset, void *dst, size_t size)
+{
+    if ((src_offset > file->dev.len) || (size > file->dev.len - src_offset)) {
+        return XF_FAIL;
+    }
+    memcpy(dst, &file->map[src_offset], size);
+    return XF_OK;
+}
+
+static xf_err_t xf_fal_file_write(
+    xf_fal_file_ctx_t *file, size_t dst_offset, const void *src, size_t size)
+{
+    if ((dst_offset > file->dev.len) || (size > file->dev.len - dst_offset)) {
+        return XF_FAIL;
+    }
+    xf_fal_file_program(&file->map[dst_offset], src, size);
+    return XF_OK;
+}
+
+static xf_err_t xf_fal_file_erase(xf_fal_file_ctx_t *file, size_t offset, size_t size)
+{
+    if ((offset > file->dev.len) || (size > file->dev.len - offset)) {
+        return XF_FAIL;
+    }
+    memset(&file->map[offset], 0xFF, size);
+    return XF_OK;
+}
+
+static xf_err_t xf_fal_file_blank_check(
+    xf_fal_file_ctx_t *file, size_t offset, size_t size, bool *p_is_blank)
+{
+    const uint8_t *p;
+    uint64_t acc = UINT64_MAX;
+    uint64_t word;
+    size_t i = 0;
+
+    if ((offset > file->dev.len) || (size > file->dev.len - offset)) {
+        return XF_FAIL;
+    }
+    p = &file->map[offset];
+    for (; i + sizeof(word) <= size; i += sizeof(word)) {
+        memcpy(&word, &p[i], sizeof(word));
+        acc &= word;
+    }
+    for (; i < size; i++) {
+        acc &= (uint64_t)p[i] | ~(uint64_t)0xFF;
+    }
+    *p_is_blank = (UINT64_MAX == acc);
+    return XF_OK;
+}
+
+/**
+ * @brief NOR flash 编程：dst &= src.
+ *
+ * 按 SIMD 寄存器（SSE2 / NEON）或 64 位机器字处理，
+ * 非对齐访问通过 loadu/memcpy 完成，编译器会生成单条访存指令。
+ */
+static void xf_fal_file_program(uint8_t *dst, const uint8_t *src, size_t size)
+{
+    size_t i = 0;
+    uint64_t d;
+    uint64_t s;
+
+#if XF_FAL_FILE_SIMD_SSE2
+    for (; i + 16 <= size; i += 16) {
+        _mm_storeu_si128((__m128i *)&dst[i],
+                         _mm_and_si128(_mm_loadu_si128((const __m128i *)&dst[i]),
+                                       _mm_loadu_si128((const __m128i *)&src[i])));
+    }
+#elif XF_FAL_FILE_SIMD_NEON
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(&dst[i], vandq_u8(vld1q_u8(&dst[i]), vld1q_u8(&src[i])));
+    }
+#endif
+    for (; i + sizeof(d) <= size; i += sizeof(d)) {
+        memcpy(&d, &dst[i], sizeof(d));
+        memcpy(&s, &src[i], sizeof(s));
+        d &= s;
+        memcpy(&dst[i], &d, sizeof(d));
+    }
+    for (; i < size; i++) {
+        dst[i] &= src[i];
+    }
+}
+
+/**
+ * @brief 打开（必要时创建）镜像文件，扩展到 len 后映射。扩展部分填充为 0xFF.
+ */
+static xf_err_t xf_fal_file_map(xf_fal_file_ctx_t *file, const char *path, size_t len)
+{
+    struct stat st;
+    size_t old_len;
+    void *map;
+
+    file->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (file->fd < 0) {
+        XF_LOGE(TAG, "Can NOT open %s.", path);
+        return XF_FAIL;
+    }
+    if (0 != fstat(file->fd, &st)) {
+        goto l_err;
+    }
+    old_len = (size_t)st.st_size;
+    if ((old_len < len) && (0 != ftruncate(file->fd, (off_t)len))) {
+        XF_LOGE(TAG, "Can NOT extend %s to %lu bytes.", path, (unsigned long)len);
+        goto l_err;
+    }
+
+    map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    if (MAP_FAILED == map) {
+        XF_LOGE(TAG, "Can NOT map %s.", path);
+        goto l_err;
+    }
+    file->map = map;
+    if (old_len < len) {
+        memset(&file->map[old_len], 0xFF, len - old_len);
+    }
+
+    return XF_OK;
+
+l_err:
+    close(file->fd);
+    file->fd = -1;
+    return XF_FAIL;
+}
+
+#endif // XF_FAL_FILE_ENABLE
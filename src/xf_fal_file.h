@@ -0,0 +1,126 @@
+/**
+ * @file xf_fal_file.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 主机端文件映射 flash 设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_FILE_H__
+#define __XF_FAL_FILE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#if XF_FAL_FILE_ENABLE || defined(__DOXYGEN__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 文件映射 flash 设备的配置，见 xf_fal_file_init().
+ */
+typedef struct _xf_fal_file_cfg_t {
+    const char     *path;           /*!< 镜像文件路径，不存在时创建 */
+    size_t          len;            /*!< 设备长度，单位：字节。为扇区大小的整数倍 */
+    size_t          sector_size;    /*!< 扇区大小，单位：字节 */
+    size_t          page_size;      /*!< 页大小，单位：字节。0 表示不分页 */
+    size_t          io_size;        /*!< 最小写入单位，单位：字节 */
+} xf_fal_file_cfg_t;
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 以 mmap 映射镜像文件，创建 flash 设备并注册到 xf_fal.
+ *
+ * 用于在 Linux 等主机上以真实容量（可达 GB 级）运行 xf_fal 和上层模块，或回放现场导出的镜像：
+ *
+ * - 读直接从映射区复制；
+ * - 写按 NOR flash 的编程语义只能将 1 变为 0（按 SIMD 寄存器或机器字做与运算）；
+ * - 擦除将范围置为 0xFF.
+ *
+ * 镜像文件的内容在多次运行之间保留。文件比 len 短时扩展到 len, 扩展部分为 0xFF（擦除状态）；
+ * 比 len 长时只使用前 len 字节。
+ *
+ * @attention 可以在 xf_fal_init() 之前或之后调用，之后调用时立即生效。
+ *
+ * @param dev_name  flash 设备名，最长 XF_FAL_DEV_NAME_MAX.
+ * @param cfg       设备配置，函数返回后不再使用。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数或设备几何参数不合法
+ *      - XF_ERR_INITED         dev_name 已创建
+ *      - XF_ERR_RESOURCE       已创建 XF_FAL_FILE_NUM 个设备
+ *      - XF_FAIL               打开、扩展或映射文件失败
+ *      - (OTHER)               注册 flash 设备或刷新分区缓存失败，设备已撤销
+ */
+xf_err_t xf_fal_file_init(const char *dev_name, const xf_fal_file_cfg_t *cfg);
+
+/**
+ * @brief 注销 flash 设备，将映射区写回文件后解除映射。
+ *
+ * @param dev_name flash 设备名。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      未找到
+ *      - (OTHER)               注销 flash 设备失败
+ */
+xf_err_t xf_fal_file_deinit(const char *dev_name);
+
+/**
+ * @brief 将映射区中修改过的内容同步写入镜像文件（msync），用于模拟掉电前落盘。
+ *
+ * 不调用时内容由操作系统在适当时机或 xf_fal_file_deinit() 时写回。
+ *
+ * @param dev_name flash 设备名。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      未找到
+ *      - XF_FAIL               同步失败
+ */
+xf_err_t xf_fal_file_sync(const char *dev_name);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // XF_FAL_FILE_ENABLE
+
+#endif // __XF_FAL_FILE_H__
@@ -0,0 +1,718 @@
+/**
+ * @file xf_fal_kv.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 日志结构键值存储。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_kv.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_kv"
+
+/*
+ * 分区格式（多字节字段为小端）：
+ *
+ * 扇区头: {magic u32, seq u32, crc32 u32}，seq 每启用一个扇区加 1, 没有有效扇区头的扇区为空闲扇区。
+ * 记录:   {crc32 u32, key_len u8, flags u8, value_len u16, key[key_len], value[value_len]}
+ *         按 io_size 对齐，crc32 覆盖其后的头部、键和值。空白（0xFF）处为扇区内日志末尾。
+ *
+ * 同一个键以序号更大的扇区、同一扇区内偏移更大的记录为准；flags 含 XF_FAL_KV_FLAG_DELETED
+ * 的记录表示删除。总是回收最旧的扇区，因此删除记录随所在扇区一起丢弃时，
+ * 该键更旧的记录必然已被回收，不会重新出现。
+ */
+#define XF_FAL_KV_SECTOR_MAGIC          0x564B4658u     /*!< "XFKV" */
+#define XF_FAL_KV_SECTOR_HDR_SIZE       12
+#define XF_FAL_KV_REC_HDR_SIZE          8
+#define XF_FAL_KV_FLAG_DELETED          0x01
+#define XF_FAL_KV_OFFSET_NONE           UINT32_MAX
+#define XF_FAL_KV_VALUE_MAX             0xFFFF
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 解析后的记录头。
+ */
+typedef struct _xf_fal_kv_rec_t {
+    uint32_t    crc;
+    uint8_t     key_len;
+    uint8_t     flags;
+    uint16_t    value_len;
+    size_t      size;       /*!< 对齐后的记录大小 */
+} xf_fal_kv_rec_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void xf_fal_kv_put_u32(uint8_t *p, uint32_t v);
+static uint32_t xf_fal_kv_get_u32(const uint8_t *p);
+static size_t xf_fal_kv_align(const xf_fal_kv_t *kv, size_t size);
+static size_t xf_fal_kv_data_start(const xf_fal_kv_t *kv);
+static size_t xf_fal_kv_free_num(const xf_fal_kv_t *kv);
+static xf_err_t xf_fal_kv_read_rec(const xf_fal_kv_t *kv, size_t offset, xf_fal_kv_rec_t *p_rec);
+static xf_err_t xf_fal_kv_lookup(
+    xf_fal_kv_t *kv, const char *key, size_t key_len, uint32_t hash,
+    size_t *p_slot, xf_fal_kv_rec_t *p_rec);
+static void xf_fal_kv_index_remove(xf_fal_kv_t *kv, size_t slot);
+static xf_err_t xf_fal_kv_append(
+    xf_fal_kv_t *kv, uint8_t flags, const char *key, size_t key_len,
+    const void *value, size_t value_len, uint32_t *p_offset);
+static xf_err_t xf_fal_kv_new_sector(xf_fal_kv_t *kv);
+static xf_err_t xf_fal_kv_gc(xf_fal_kv_t *kv);
+static xf_err_t xf_fal_kv_reserve(xf_fal_kv_t *kv, size_t size);
+static xf_err_t xf_fal_kv_scan(xf_fal_kv_t *kv, size_t sector, size_t *p_end);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_fal_kv_open(xf_fal_kv_t *kv, const xf_fal_partition_t *part)
+{
+    xf_err_t xf_ret;
+    xf_fal_erase_result_t result;
+    uint8_t hdr[XF_FAL_KV_SECTOR_HDR_SIZE];
+    uint32_t seq;
+    uint32_t last = 0;
+    size_t next;
+    size_t end;
+
+    if ((NULL == kv) || (NULL == part)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_ret = xf_fal_partition_get_handle(part, &kv->handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    kv->sector_size = kv->handle.flash_dev->sector_size;
+    kv->align       = (kv->handle.flash_dev->io_size) ? kv->handle.flash_dev->io_size : 1;
+    kv->sector_num  = (kv->sector_size) ? (kv->handle.len / kv->sector_size) : 0;
+    if ((kv->sector_num < 2) || (kv->sector_num > XF_FAL_KV_SECTOR_NUM)
+            || (kv->handle.base % kv->sector_size)
+            || (xf_fal_kv_align(kv, XF_FAL_KV_SECTOR_HDR_SIZE) > XF_FAL_KV_BUF_SIZE)
+            || (xf_fal_kv_data_start(kv) + xf_fal_kv_align(kv, XF_FAL_KV_REC_HDR_SIZE
+                    + XF_FAL_KV_KEY_MAX) > kv->sector_size)) {
+        XF_LOGE(TAG, "Partition(%s) can NOT be used as key-value store.", part->name);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    memset(&kv->stat, 0, sizeof(kv->stat));
+    memset(kv->seq, 0, sizeof(kv->seq));
+    for (size_t i = 0; i < XF_FAL_KV_INDEX_NUM; i++) {
+        kv->index[i].offset = XF_FAL_KV_OFFSET_NONE;
+    }
+    kv->seq_max     = 0;
+    kv->active      = kv->sector_num - 1;
+    kv->write_off   = kv->sector_size;
+
+    /* 空闲扇区在打开时就擦除，启用时无需再擦除 */
+    for (size_t i = 0; i < kv->sector_num; i++) {
+        xf_ret = xf_fal_handle_read(&kv->handle, i * kv->sector_size, hdr, sizeof(hdr));
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        seq = xf_fal_kv_get_u32(&hdr[4]);
+        if ((XF_FAL_KV_SECTOR_MAGIC == xf_fal_kv_get_u32(&hdr[0])) && (seq)
+                && (xf_fal_kv_get_u32(&hdr[8]) == xf_fal_crc32(0, hdr, 8))) {
+            kv->seq[i] = seq;
+            continue;
+        }
+        xf_ret = xf_fal_handle_erase_ex(&kv->handle, i * kv->sector_size, kv->sector_size,
+                                        XF_FAL_ERASE_FLAG_SKIP_BLANK, &result);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        kv->stat.erase_num += result.erased_num;
+    }
+
+    /* 按序号从旧到新重放 */
+    for (;;) {
+        next = kv->sector_num;
+        for (size_t i = 0; i < kv->sector_num; i++) {
+            if ((kv->seq[i]) && (kv->seq[i] > last)
+                    && ((next == kv->sector_num) || (kv->seq[i] < kv->seq[next]))) {
+                next = i;
+            }
+        }
+        if (next == kv->sector_num) {
+            break;
+        }
+        xf_ret = xf_fal_kv_scan(kv, next, &end);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        last            = kv->seq[next];
+        kv->seq_max     = last;
+        kv->active      = next;
+        kv->write_off   = end;
+    }
+    /* 打开期间的统计只反映之后的写入 */
+    kv->stat.user_bytes     = 0;
+    kv->stat.flash_bytes    = 0;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_kv_set(xf_fal_kv_t *kv, const char *key, const void *value, size_t size)
+{
+    xf_err_t xf_ret;
+    xf_fal_kv_rec_t old;
+    size_t key_len;
+    size_t rec_size;
+    size_t slot;
+    uint32_t hash;
+    uint32_t offset;
+    bool is_found;
+
+    if ((NULL == kv) || (NULL == key) || ((NULL == value) && (size))) {
+        return XF_ERR_INVALID_ARG;
+    }
+    key_len     = xf_strlen(key);
+    rec_size    = xf_fal_kv_align(kv, XF_FAL_KV_REC_HDR_SIZE + key_len + size);
+    if ((0 == key_len) || (key_len > XF_FAL_KV_KEY_MAX) || (size > XF_FAL_KV_VALUE_MAX)
+            || (rec_size > kv->sector_size - xf_fal_kv_data_start(kv))) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    hash    = xf_fal_crc32(0, key, key_len);
+    xf_ret  = xf_fal_kv_lookup(kv, key, key_len, hash, &slot, &old);
+    if ((xf_ret != XF_OK) && (xf_ret != XF_ERR_NOT_FOUND)) {
+        return xf_ret;
+    }
+    is_found = (XF_OK == xf_ret);
+    if ((!is_found) && (kv->stat.key_num >= XF_FAL_KV_INDEX_NUM - 1)) {
+        return XF_ERR_NO_MEM;
+    }
+
+    /* 回收只移动已有记录的位置（就地更新索引项），slot 仍然有效 */
+    xf_ret = xf_fal_kv_reserve(kv, rec_size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    xf_ret = xf_fal_kv_append(kv, 0, key, key_len, value, size, &offset);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    if (is_found) {
+        kv->stat.live_bytes -= old.size;
+    } else {
+        kv->index[slot].hash = hash;
+        kv->stat.key_num++;
+    }
+    kv->index[slot].offset  = offset;
+    kv->stat.live_bytes     += rec_size;
+    kv->stat.user_bytes     += key_len + size;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_kv_get(
+    xf_fal_kv_t *kv, const char *key, void *value, size_t size, size_t *p_len)
+{
+    xf_err_t xf_ret;
+    xf_fal_kv_rec_t rec;
+    size_t key_len;
+    size_t slot;
+
+    if ((NULL == kv) || (NULL == key) || ((NULL == value) && (size))) {
+        return XF_ERR_INVALID_ARG;
+    }
+    key_len = xf_strlen(key);
+    if ((0 == key_len) || (key_len > XF_FAL_KV_KEY_MAX)) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    xf_ret = xf_fal_kv_lookup(kv, key, key_len, xf_fal_crc32(0, key, key_len), &slot, &rec);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    if (p_len) {
+        *p_len = rec.value_len;
+    }
+    size = (size < rec.value_len) ? size : rec.value_len;
+    if (0 == size) {
+        return XF_OK;
+    }
+
+    return xf_fal_handle_read(
+               &kv->handle, kv->index[slot].offset + XF_FAL_KV_REC_HDR_SIZE + key_len, value, size);
+}
+
+xf_err_t xf_fal_kv_delete(xf_fal_kv_t *kv, const char *key)
+{
+    xf_err_t xf_ret;
+    xf_fal_kv_rec_t old;
+    size_t key_len;
+    size_t slot;
+    uint32_t offset;
+
+    if ((NULL == kv) || (NULL == key)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    key_len = xf_strlen(key);
+    if ((0 == key_len) || (key_len > XF_FAL_KV_KEY_MAX)) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    xf_ret = xf_fal_kv_lookup(kv, key, key_len, xf_fal_crc32(0, key, key_len), &slot, &old);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    xf_ret = xf_fal_kv_reserve(kv, xf_fal_kv_align(kv, XF_FAL_KV_REC_HDR_SIZE + key_len));
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    xf_ret = xf_fal_kv_append(kv, XF_FAL_KV_FLAG_DELETED, key, key_len, NULL, 0, &offset);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    xf_fal_kv_index_remove(kv, slot);
+    kv->stat.key_num--;
+    kv->stat.live_bytes -= old.size;
+    kv->stat.user_bytes += key_len;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_kv_get_stat(const xf_fal_kv_t *kv, xf_fal_kv_stat_t *p_stat)
+{
+    if ((NULL == kv) || (NULL == p_stat)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    *p_stat = kv->stat;
+    p_stat->free_sector_num = xf_fal_kv_free_num(kv);
+
+    return XF_OK;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void xf_fal_kv_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t xf_fal_kv_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8)
+           | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t xf_fal_kv_align(const xf_fal_kv_t *kv, size_t size)
+{
+    return (size + kv->align - 1) / kv->align * kv->align;
+}
+
+static size_t xf_fal_kv_data_start(const xf_fal_kv_t *kv)
+{
+    return xf_fal_kv_align(kv, XF_FAL_KV_SECTOR_HDR_SIZE);
+}
+
+static size_t xf_fal_kv_free_num(const xf_fal_kv_t *kv)
+{
+    size_t num = 0;
+
+    for (size_t i = 0; i < kv->sector_num; i++) {
+        num += (0 == kv->seq[i]);
+    }
+    return num;
+}
+
+/**
+ * @brief 读取并解析 offset 处的记录头，不校验 CRC.
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      空白
+ *      - XF_FAIL               不是有效的记录头
+ *      - (OTHER)               读取失败
+ */
+static xf_err_t xf_fal_kv_read_rec(const xf_fal_kv_t *kv, size_t offset, xf_fal_kv_rec_t *p_rec)
+{
+    xf_err_t xf_ret;
+    uint8_t hdr[XF_FAL_KV_REC_HDR_SIZE];
+    size_t sector_end = (offset / kv->sector_size + 1) * kv->sector_size;
+    size_t i;
+
+    if (offset + sizeof(hdr) > sector_end) {
+        return XF_ERR_NOT_FOUND;
+    }
+    xf_ret = xf_fal_handle_read(&kv->handle, offset, hdr, sizeof(hdr));
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    for (i = 0; (i < sizeof(hdr)) && (0xFF == hdr[i]); i++) {
+    }
+    if (i == sizeof(hdr)) {
+        return XF_ERR_NOT_FOUND;
+    }
+
+    p_rec->crc          = xf_fal_kv_get_u32(&hdr[0]);
+    p_rec->key_len      = hdr[4];
+    p_rec->flags        = hdr[5];
+    p_rec->value_len    = (uint16_t)(hdr[6] | (hdr[7] << 8));
+    p_rec->size         = xf_fal_kv_align(
+                              kv, XF_FAL_KV_REC_HDR_SIZE + p_rec->key_len + p_rec->value_len);
+    if ((0 == p_rec->key_len) || (p_rec->key_len > XF_FAL_KV_KEY_MAX)
+            || (offset + p_rec->size > sector_end)) {
+        return XF_FAIL;
+    }
+
+    return XF_OK;
+}
+
+/**
+ * @brief 在索引中查找键。
+ *
+ * @param[out] p_slot   找到时为键所在的索引项，否则为可以插入的空项。
+ * @param[out] p_rec    找到时为键的记录头。
+ * @return xf_err_t
+ *      - XF_OK                 找到
+ *      - XF_ERR_NOT_FOUND      未找到
+ *      - (OTHER)               读取失败
+ */
+static xf_err_t xf_fal_kv_lookup(
+    xf_fal_kv_t *kv, const char *key, size_t key_len, uint32_t hash,
+    size_t *p_slot, xf_fal_kv_rec_t *p_rec)
+{
+    xf_err_t xf_ret;
+    const size_t mask = XF_FAL_KV_INDEX_NUM - 1;
+    xf_fal_kv_index_t *entry;
+    size_t slot = hash & mask;
+
+    for (;; slot = (slot + 1) & mask) {
+        entry = &kv->index[slot];
+        if (XF_FAL_KV_OFFSET_NONE == entry->offset) {
+            *p_slot = slot;
+            return XF_ERR_NOT_FOUND;
+        }
+        if (entry->hash != hash) {
+            continue;
+        }
+        /* 哈希相同时读出键确认 */
+        xf_ret = xf_fal_kv_read_rec(kv, entry->offset, p_rec);
+        if (xf_ret != XF_OK) {
+            return (XF_ERR_NOT_FOUND == xf_ret) ? XF_FAIL : xf_ret;
+        }
+        if (p_rec->key_len != key_len) {
+            continue;
+        }
+        xf_ret = xf_fal_handle_read(
+                     &kv->handle, entry->offset + XF_FAL_KV_REC_HDR_SIZE, kv->buf, key_len);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if (0 == memcmp(kv->buf, key, key_len)) {
+            *p_slot = slot;
+            return XF_OK;
+        }
+    }
+}
+
+/**
+ * @brief 删除索引项，并把之后同一探测链上的项前移，保持查找不中断。
+ */
+static void xf_fal_kv_index_remove(xf_fal_kv_t *kv, size_t slot)
+{
+    const size_t mask = XF_FAL_KV_INDEX_NUM - 1;
+    size_t i = slot;
+    size_t j = slot;
+    size_t home;
+
+    for (;;) {
+        kv->index[i].offset = XF_FAL_KV_OFFSET_NONE;
+        for (;;) {
+            j = (j + 1) & mask;
+            if (XF_FAL_KV_OFFSET_NONE == kv->index[j].offset) {
+                return;
+            }
+            /* 理想位置在 (i, j] 之间的项不能前移到 i */
+            home = kv->index[j].hash & mask;
+            if ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+                continue;
+            }
+            break;
+        }
+        kv->index[i] = kv->index[j];
+        i = j;
+    }
+}
+
+/**
+ * @brief 在当前扇区末尾写入一条记录，调用者已通过 xf_fal_kv_reserve() 确保空间足够。
+ */
+static xf_err_t xf_fal_kv_append(
+    xf_fal_kv_t *kv, uint8_t flags, const char *key, size_t key_len,
+    const void *value, size_t value_len, uint32_t *p_offset)
+{
+    xf_err_t xf_ret;
+    uint8_t hdr[XF_FAL_KV_REC_HDR_SIZE];
+    xf_fal_iovec_t iov[4];
+    size_t size = XF_FAL_KV_REC_HDR_SIZE + key_len + value_len;
+    size_t offset = kv->active * kv->sector_size + kv->write_off;
+    uint32_t crc;
+
+    hdr[4]  = (uint8_t)key_len;
+    hdr[5]  = flags;
+    hdr[6]  = (uint8_t)value_len;
+    hdr[7]  = (uint8_t)(value_len >> 8);
+    crc     = xf_fal_crc32(0, &hdr[4], 4);
+    crc     = xf_fal_crc32(crc, key, key_len);
+    crc     = xf_fal_crc32(crc, value, value_len);
+    xf_fal_kv_put_u32(&hdr[0], crc);
+
+    memset(kv->buf, 0xFF, kv->align);
+    iov[0].base = hdr;
+    iov[0].len  = sizeof(hdr);
+    iov[1].base = (void *)key;
+    iov[1].len  = key_len;
+    iov[2].base = (void *)value;
+    iov[2].len  = value_len;
+    iov[3].base = kv->buf;
+    iov[3].len  = xf_fal_kv_align(kv, size) - size;
+
+    xf_ret = xf_fal_handle_writev(&kv->handle, offset, iov, 4);
+    if (xf_ret != XF_OK) {
+        /* 写了一半的记录之后不能再追加 */
+        kv->write_off = kv->sector_size;
+        return xf_ret;
+    }
+    kv->write_off           += xf_fal_kv_align(kv, size);
+    kv->stat.flash_bytes    += xf_fal_kv_align(kv, size);
+    *p_offset = (uint32_t)offset;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 启用当前扇区之后的第一个空闲扇区（已擦除），写入扇区头。
+ */
+static xf_err_t xf_fal_kv_new_sector(xf_fal_kv_t *kv)
+{
+    xf_err_t xf_ret;
+    size_t sector = kv->sector_num;
+    size_t size = xf_fal_kv_data_start(kv);
+    uint32_t seq = kv->seq_max + 1;
+
+    for (size_t k = 1; k <= kv->sector_num; k++) {
+        if (0 == kv->seq[(kv->active + k) % kv->sector_num]) {
+            sector = (kv->active + k) % kv->sector_num;
+            break;
+        }
+    }
+    if (sector == kv->sector_num) {
+        return XF_ERR_NO_MEM;
+    }
+
+    memset(kv->buf, 0xFF, size);
+    xf_fal_kv_put_u32(&kv->buf[0], XF_FAL_KV_SECTOR_MAGIC);
+    xf_fal_kv_put_u32(&kv->buf[4], seq);
+    xf_fal_kv_put_u32(&kv->buf[8], xf_fal_crc32(0, kv->buf, 8));
+    xf_ret = xf_fal_handle_write(&kv->handle, sector * kv->sector_size, kv->buf, size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    kv->seq[sector]         = seq;
+    kv->seq_max             = seq;
+    kv->active              = sector;
+    kv->write_off           = size;
+    kv->stat.flash_bytes    += size;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 回收最旧的扇区：把仍在索引中的记录原样复制到当前扇区末尾，然后擦除。
+ *
+ * 擦除前掉电时，旧扇区和复制出的记录同时存在，较新的副本优先，内容相同。
+ */
+static xf_err_t xf_fal_kv_gc(xf_fal_kv_t *kv)
+{
+    xf_err_t xf_ret;
+    xf_fal_kv_rec_t rec;
+    size_t victim = kv->sector_num;
+    size_t base;
+    size_t src;
+    size_t dst;
+    size_t len;
+
+    for (size_t i = 0; i < kv->sector_num; i++) {
+        if ((kv->seq[i])
+                && ((victim == kv->sector_num) || ((int32_t)(kv->seq[i] - kv->seq[victim]) < 0))) {
+            victim = i;
+        }
+    }
+    if (victim == kv->sector_num) {
+        return XF_ERR_NO_MEM;
+    }
+    if (victim == kv->active) {
+        xf_ret = xf_fal_kv_new_sector(kv);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+    }
+
+    base = victim * kv->sector_size;
+    for (size_t slot = 0; slot < XF_FAL_KV_INDEX_NUM; slot++) {
+        src = kv->index[slot].offset;
+        if ((XF_FAL_KV_OFFSET_NONE == src) || (src < base) || (src >= base + kv->sector_size)) {
+            continue;
+        }
+        xf_ret = xf_fal_kv_read_rec(kv, src, &rec);
+        if (xf_ret != XF_OK) {
+            return (XF_ERR_NOT_FOUND == xf_ret) ? XF_FAIL : xf_ret;
+        }
+        if (kv->write_off + rec.size > kv->sector_size) {
+            xf_ret = xf_fal_kv_new_sector(kv);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+        }
+        dst = kv->active * kv->sector_size + kv->write_off;
+        for (size_t off = 0; off < rec.size; off += len) {
+            len = rec.size - off;
+            len = (len < XF_FAL_KV_BUF_SIZE) ? len : XF_FAL_KV_BUF_SIZE;
+            xf_ret = xf_fal_handle_read(&kv->handle, src + off, kv->buf, len);
+            if (XF_OK == xf_ret) {
+                xf_ret = xf_fal_handle_write(&kv->handle, dst + off, kv->buf, len);
+            }
+            if (xf_ret != XF_OK) {
+                kv->write_off = kv->sector_size;
+                return xf_ret;
+            }
+        }
+        kv->index[slot].offset  = (uint32_t)dst;
+        kv->write_off           += rec.size;
+        kv->stat.flash_bytes    += rec.size;
+    }
+
+    xf_ret = xf_fal_handle_erase(&kv->handle, base, kv->sector_size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    kv->seq[victim] = 0;
+    kv->stat.gc_num++;
+    kv->stat.erase_num++;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 确保当前扇区末尾有 size 字节空间，必要时启用新扇区或回收最旧的扇区。
+ *
+ * 始终保留 1 个空闲扇区，使回收时总有地方存放复制的记录。
+ */
+static xf_err_t xf_fal_kv_reserve(xf_fal_kv_t *kv, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+
+    for (size_t tries = 0; kv->write_off + size > kv->sector_size; tries++) {
+        if (tries >= 2 * kv->sector_num) {
+            return XF_ERR_NO_MEM;
+        }
+        if (xf_fal_kv_free_num(kv) >= 2) {
+            xf_ret = xf_fal_kv_new_sector(kv);
+        } else {
+            xf_ret = xf_fal_kv_gc(kv);
+        }
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 打开时重放一个扇区的记录到索引。
+ *
+ * @param[out] p_end 最后一条有效记录之后的偏移；其后有损坏的记录时为扇区大小（不再追加）。
+ */
+static xf_err_t xf_fal_kv_scan(xf_fal_kv_t *kv, size_t sector, size_t *p_end)
+{
+    xf_err_t xf_ret;
+    xf_fal_kv_rec_t rec;
+    xf_fal_kv_rec_t old;
+    char key[XF_FAL_KV_KEY_MAX];
+    uint8_t hdr[4];
+    uint32_t crc;
+    uint32_t hash;
+    size_t base = sector * kv->sector_size;
+    size_t off;
+    size_t slot;
+
+    for (off = xf_fal_kv_data_start(kv); off < kv->sector_size; off += rec.size) {
+        xf_ret = xf_fal_kv_read_rec(kv, base + off, &rec);
+        if (XF_ERR_NOT_FOUND == xf_ret) {
+            break;
+        }
+        if (XF_OK == xf_ret) {
+            hdr[0]  = rec.key_len;
+            hdr[1]  = rec.flags;
+            hdr[2]  = (uint8_t)rec.value_len;
+            hdr[3]  = (uint8_t)(rec.value_len >> 8);
+            crc     = xf_fal_crc32(0, hdr, sizeof(hdr));
+            xf_ret  = xf_fal_handle_crc32(&kv->handle, base + off + XF_FAL_KV_REC_HDR_SIZE,
+                                          rec.key_len + rec.value_len, &crc);
+        }
+        if ((XF_OK == xf_ret) && (crc != rec.crc)) {
+            xf_ret = XF_FAIL;
+        }
+        if (XF_FAIL == xf_ret) {
+            XF_LOGW(TAG, "Corrupted record at 0x%08x, skip the rest of sector %d.",
+                    (int)(base + off), (int)sector);
+            *p_end = kv->sector_size;
+            return XF_OK;
+        }
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+
+        xf_ret = xf_fal_handle_read(&kv->handle, base + off + XF_FAL_KV_REC_HDR_SIZE,
+                                    key, rec.key_len);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        hash    = xf_fal_crc32(0, key, rec.key_len);
+        xf_ret  = xf_fal_kv_lookup(kv, key, rec.key_len, hash, &slot, &old);
+        if (XF_OK == xf_ret) {
+            kv->stat.live_bytes -= old.size;
+            if (rec.flags & XF_FAL_KV_FLAG_DELETED) {
+                xf_fal_kv_index_remove(kv, slot);
+                kv->stat.key_num--;
+                continue;
+            }
+        } else if (XF_ERR_NOT_FOUND == xf_ret) {
+            if (rec.flags & XF_FAL_KV_FLAG_DELETED) {
+                continue;
+            }
+            if (kv->stat.key_num >= XF_FAL_KV_INDEX_NUM - 1) {
+                return XF_ERR_NO_MEM;
+            }
+            kv->index[slot].hash = hash;
+            kv->stat.key_num++;
+        } else {
+            return xf_ret;
+        }
+        kv->index[slot].offset  = (uint32_t)(base + off);
+        kv->stat.live_bytes     += rec.size;
+    }
+    *p_end = (off < kv->sector_size) ? off : kv->sector_size;
+
+    return XF_OK;
+}
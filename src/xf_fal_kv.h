@@ -0,0 +1,182 @@
+/**
+ * @file xf_fal_kv.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 日志结构键值存储。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_KV_H__
+#define __XF_FAL_KV_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 键值存储的内存索引项。
+ */
+typedef struct _xf_fal_kv_index_t {
+    uint32_t        hash;                   /*!< 键的 CRC-32 */
+    uint32_t        offset;                 /*!< 记录在分区内的偏移，空项为 UINT32_MAX */
+} xf_fal_kv_index_t;
+
+/**
+ * @brief 键值存储统计，见 xf_fal_kv_get_stat().
+ */
+typedef struct _xf_fal_kv_stat_t {
+    size_t          key_num;                /*!< 键个数 */
+    size_t          live_bytes;             /*!< 有效记录占用的 flash 字节数（含记录头） */
+    size_t          free_sector_num;        /*!< 空闲扇区数（含 1 个保留扇区） */
+    size_t          user_bytes;             /*!< 打开以来 set/delete 的键和值的字节数 */
+    size_t          flash_bytes;            /*!< 打开以来写入 flash 的字节数（含记录头、对齐和 GC 复制） */
+    size_t          gc_num;                 /*!< 打开以来回收的扇区数 */
+    size_t          erase_num;              /*!< 打开以来擦除的扇区数 */
+} xf_fal_kv_stat_t;
+
+/**
+ * @brief 键值存储对象。
+ *
+ * 分区按扇区组成循环日志，set 和 delete 都在当前扇区末尾追加带 CRC-32 的记录，
+ * 不改写已有数据；内存中的哈希索引记录每个键最新记录的位置，get 只需一次索引查找。
+ * 当前扇区写满时换到空闲扇区，空闲扇区不足时回收最旧的扇区：
+ * 将其中仍有效的记录复制到当前扇区末尾后擦除（始终保留 1 个空闲扇区用于复制）。
+ *
+ * 掉电时写了一半的记录在下次打开时被忽略，键保持上一次的值。
+ *
+ * 对象由用户提供，xf_fal 不做任何动态分配，
+ * 占用内存约为 8 * XF_FAL_KV_INDEX_NUM + 4 * XF_FAL_KV_SECTOR_NUM + XF_FAL_KV_BUF_SIZE 字节。
+ *
+ * @note 同一对象不能被多个线程同时使用，同一分区也不能同时被多个对象打开。
+ */
+typedef struct _xf_fal_kv_t {
+    xf_fal_handle_t     handle;             /*!< 分区句柄 */
+    size_t              sector_size;
+    size_t              sector_num;
+    size_t              align;              /*!< 记录对齐，即 io_size */
+    size_t              active;             /*!< 当前写入的扇区 */
+    size_t              write_off;          /*!< 当前扇区内下一条记录的偏移 */
+    uint32_t            seq_max;            /*!< 最新扇区的序号 */
+    xf_fal_kv_stat_t    stat;
+    uint32_t            seq[XF_FAL_KV_SECTOR_NUM];      /*!< 各扇区序号，0 表示空闲 */
+    xf_fal_kv_index_t   index[XF_FAL_KV_INDEX_NUM];     /*!< 开放寻址哈希表 */
+    uint8_t             buf[XF_FAL_KV_BUF_SIZE];
+} xf_fal_kv_t;
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 打开分区上的键值存储，扫描所有记录建立索引。
+ *
+ * 分区中没有有效扇区时（如首次使用）视为空的存储，无需事先擦除。
+ *
+ * @param kv    键值存储对象。
+ * @param part  分区，按扇区对齐，2 ~ XF_FAL_KV_SECTOR_NUM 个扇区。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数、分区未对齐或扇区数不符
+ *      - XF_ERR_NO_MEM         键个数超过 XF_FAL_KV_INDEX_NUM - 1
+ *      - (OTHER)               读写擦分区失败
+ */
+xf_err_t xf_fal_kv_open(xf_fal_kv_t *kv, const xf_fal_partition_t *part);
+
+/**
+ * @brief 设置键的值。
+ *
+ * @param kv    键值存储对象。
+ * @param key   键，以 '\0' 结尾，长度 1 ~ XF_FAL_KV_KEY_MAX.
+ * @param value 值，size 为 0 时可以为 NULL.
+ * @param size  值的大小，单位：字节。记录（8 字节头 + 键 + 值）不能超过一个扇区。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数或记录超过一个扇区
+ *      - XF_ERR_NO_MEM         分区已满或键个数已达上限
+ *      - (OTHER)               读写擦分区失败
+ */
+xf_err_t xf_fal_kv_set(xf_fal_kv_t *kv, const char *key, const void *value, size_t size);
+
+/**
+ * @brief 读取键的值。
+ *
+ * @param kv            键值存储对象。
+ * @param key           键。
+ * @param[out] value    值的缓冲区，可以为 NULL（只获取大小）。
+ * @param size          缓冲区大小，超出部分不读取。
+ * @param[out] p_len    值的实际大小，可以为 NULL.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      键不存在
+ *      - (OTHER)               读取分区失败
+ */
+xf_err_t xf_fal_kv_get(
+    xf_fal_kv_t *kv, const char *key, void *value, size_t size, size_t *p_len);
+
+/**
+ * @brief 删除键。
+ *
+ * @param kv    键值存储对象。
+ * @param key   键。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      键不存在
+ *      - XF_ERR_NO_MEM         分区已满，无法写入删除记录
+ *      - (OTHER)               读写擦分区失败
+ */
+xf_err_t xf_fal_kv_delete(xf_fal_kv_t *kv, const char *key);
+
+/**
+ * @brief 获取键值存储统计。
+ *
+ * @param kv            键值存储对象。
+ * @param[out] p_stat   统计结果。写放大为 flash_bytes / user_bytes.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_kv_get_stat(const xf_fal_kv_t *kv, xf_fal_kv_stat_t *p_stat);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __XF_FAL_KV_H__
@@ -0,0 +1,491 @@
+/**
+ * @file xf_fal_ring.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 环形日志分区。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_ring.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_ring"
+
+/*
+ * 分区格式（多字节字段为小端）：
+ *
+ * 扇区头: {magic u32, seq u32, crc32 u32}，按 io_size 对齐。
+ *         扇区按环的顺序启用，每启用一个扇区 seq 加 1, 因此从任一有效扇区 r 起，
+ *         扇区 r + i 属于同一圈当且仅当 seq[r + i] - seq[r] == i, 且该性质在最新扇区之后失效。
+ * 条目:   {len u16, ~len u16, crc32 u32, data[len]}，按 io_size 对齐，crc32 只覆盖 data.
+ *         条目不跨扇区，空白（0xFF）处为扇区内日志末尾。
+ *
+ * 启用扇区时先擦除再写扇区头，掉电可能在环中留下至多 1 个空白扇区，恢复时跳过。
+ */
+#define XF_FAL_RING_SECTOR_MAGIC        0x47524658u     /*!< "XFRG" */
+#define XF_FAL_RING_SECTOR_HDR_SIZE     12
+#define XF_FAL_RING_ENTRY_HDR_SIZE      8
+#define XF_FAL_RING_ENTRY_MAX           0xFFFF
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void xf_fal_ring_put_u32(uint8_t *p, uint32_t v);
+static uint32_t xf_fal_ring_get_u32(const uint8_t *p);
+static size_t xf_fal_ring_align(const xf_fal_ring_t *ring, size_t size);
+static xf_err_t xf_fal_ring_read_seq(
+    xf_fal_ring_t *ring, size_t sector, uint32_t *p_seq, bool *p_valid);
+static xf_err_t xf_fal_ring_find_head(xf_fal_ring_t *ring);
+static xf_err_t xf_fal_ring_find_end(xf_fal_ring_t *ring);
+static xf_err_t xf_fal_ring_put(xf_fal_ring_t *ring, const void *src, size_t size);
+static xf_err_t xf_fal_ring_advance(xf_fal_ring_t *ring);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_fal_ring_open(xf_fal_ring_t *ring, const xf_fal_partition_t *part)
+{
+    xf_err_t xf_ret;
+    size_t page_size;
+
+    if ((NULL == ring) || (NULL == part)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_ret = xf_fal_partition_get_handle(part, &ring->handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    page_size           = ring->handle.flash_dev->page_size;
+    ring->sector_size   = ring->handle.flash_dev->sector_size;
+    ring->align         = (ring->handle.flash_dev->io_size) ? ring->handle.flash_dev->io_size : 1;
+    ring->buf_unit      = ((page_size) && (page_size < XF_FAL_RING_BUF_SIZE))
+                          ? page_size : XF_FAL_RING_BUF_SIZE;
+    ring->sector_num    = (ring->sector_size) ? (ring->handle.len / ring->sector_size) : 0;
+    if ((ring->sector_num < 2) || (ring->handle.base % ring->sector_size)
+            || (ring->sector_size % ring->buf_unit) || (ring->buf_unit % ring->align)
+            || (xf_fal_ring_entry_max(ring) == 0)) {
+        XF_LOGE(TAG, "Partition(%s) can NOT be used as ring log.", part->name);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    xf_ret = xf_fal_ring_find_head(ring);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    xf_ret = xf_fal_ring_find_end(ring);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    /* write_off 之前的字节已在 flash 上，从缓冲区的这个位置继续 */
+    ring->buf_len   = ring->write_off % ring->buf_unit;
+    ring->buf_start = ring->buf_len;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_ring_append(xf_fal_ring_t *ring, const void *data, size_t size)
+{
+    xf_err_t xf_ret;
+    uint8_t hdr[XF_FAL_RING_ENTRY_HDR_SIZE];
+    size_t entry_size;
+
+    if ((NULL == ring) || (NULL == ring->handle.partition) || ((NULL == data) && (size))) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if (size > xf_fal_ring_entry_max(ring)) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    entry_size = xf_fal_ring_align(ring, XF_FAL_RING_ENTRY_HDR_SIZE + size);
+    if ((0 == ring->used_num)
+            || (ring->write_off + entry_size > (ring->head + 1) * ring->sector_size)) {
+        xf_ret = xf_fal_ring_advance(ring);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+    }
+
+    hdr[0] = (uint8_t)size;
+    hdr[1] = (uint8_t)(size >> 8);
+    hdr[2] = (uint8_t)~hdr[0];
+    hdr[3] = (uint8_t)~hdr[1];
+    xf_fal_ring_put_u32(&hdr[4], xf_fal_crc32(0, data, size));
+
+    xf_ret = xf_fal_ring_put(ring, hdr, sizeof(hdr));
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    xf_ret = xf_fal_ring_put(ring, data, size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    return xf_fal_ring_put(ring, NULL, entry_size - XF_FAL_RING_ENTRY_HDR_SIZE - size);
+}
+
+xf_err_t xf_fal_ring_flush(xf_fal_ring_t *ring)
+{
+    xf_err_t xf_ret;
+
+    if ((NULL == ring) || (NULL == ring->handle.partition)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if (ring->buf_len == ring->buf_start) {
+        return XF_OK;
+    }
+
+    xf_ret = xf_fal_handle_write(
+                 &ring->handle, ring->write_off - (ring->buf_len - ring->buf_start),
+                 &ring->buf[ring->buf_start], ring->buf_len - ring->buf_start);
+    ring->buf_start = ring->buf_len;
+
+    return xf_ret;
+}
+
+size_t xf_fal_ring_entry_max(const xf_fal_ring_t *ring)
+{
+    size_t max;
+
+    if ((NULL == ring) || (ring->sector_size < xf_fal_ring_align(ring, XF_FAL_RING_SECTOR_HDR_SIZE)
+                           + xf_fal_ring_align(ring, XF_FAL_RING_ENTRY_HDR_SIZE))) {
+        return 0;
+    }
+    max = ring->sector_size - xf_fal_ring_align(ring, XF_FAL_RING_SECTOR_HDR_SIZE)
+          - XF_FAL_RING_ENTRY_HDR_SIZE;
+    max -= max % ring->align;
+
+    return (max < XF_FAL_RING_ENTRY_MAX) ? max : XF_FAL_RING_ENTRY_MAX;
+}
+
+xf_err_t xf_fal_ring_iter_begin(xf_fal_ring_t *ring, xf_fal_ring_iter_t *it)
+{
+    if ((NULL == ring) || (NULL == ring->handle.partition) || (NULL == it)) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    it->sector  = ring->tail;
+    it->left    = ring->used_num;
+    it->offset  = ring->tail * ring->sector_size
+                  + xf_fal_ring_align(ring, XF_FAL_RING_SECTOR_HDR_SIZE);
+
+    return xf_fal_ring_flush(ring);
+}
+
+xf_err_t xf_fal_ring_iter_next(
+    xf_fal_ring_t *ring, xf_fal_ring_iter_t *it, void *data, size_t size, size_t *p_len)
+{
+    xf_err_t xf_ret;
+    uint8_t hdr[XF_FAL_RING_ENTRY_HDR_SIZE];
+    size_t sector_end;
+    size_t len;
+    size_t n;
+    uint32_t crc;
+
+    if ((NULL == ring) || (NULL == ring->handle.partition) || (NULL == it)
+            || ((NULL == data) && (size))) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    while (it->left) {
+        sector_end = (it->sector + 1) * ring->sector_size;
+        if (it->offset + XF_FAL_RING_ENTRY_HDR_SIZE <= sector_end) {
+            xf_ret = xf_fal_handle_read(&ring->handle, it->offset, hdr, sizeof(hdr));
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+            len = (size_t)hdr[0] | ((size_t)hdr[1] << 8);
+            if (((uint8_t)(hdr[0] ^ hdr[2]) == 0xFF) && ((uint8_t)(hdr[1] ^ hdr[3]) == 0xFF)
+                    && (it->offset + xf_fal_ring_align(ring, XF_FAL_RING_ENTRY_HDR_SIZE + len)
+                        <= sector_end)) {
+                n = (size < len) ? size : len;
+                if (n) {
+                    xf_ret = xf_fal_handle_read(
+                                 &ring->handle, it->offset + XF_FAL_RING_ENTRY_HDR_SIZE, data, n);
+                    if (xf_ret != XF_OK) {
+                        return xf_ret;
+                    }
+                }
+                crc = xf_fal_crc32(0, data, n);
+                if (len > n) {
+                    xf_ret = xf_fal_handle_crc32(
+                                 &ring->handle, it->offset + XF_FAL_RING_ENTRY_HDR_SIZE + n,
+                                 len - n, &crc);
+                    if (xf_ret != XF_OK) {
+                        return xf_ret;
+                    }
+                }
+                it->offset += xf_fal_ring_align(ring, XF_FAL_RING_ENTRY_HDR_SIZE + len);
+                if (crc == xf_fal_ring_get_u32(&hdr[4])) {
+                    if (p_len) {
+                        *p_len = len;
+                    }
+                    return XF_OK;
+                }
+                XF_LOGW(TAG, "Entry at 0x%08x CRC mismatch, skipped.",
+                        (int)(it->offset - xf_fal_ring_align(ring, XF_FAL_RING_ENTRY_HDR_SIZE + len)));
+                continue;
+            }
+        }
+        /* 空白、写了一半的条目头或扇区末尾：转到下一个扇区 */
+        it->left--;
+        it->sector = (it->sector + 1) % ring->sector_num;
+        it->offset = it->sector * ring->sector_size
+                     + xf_fal_ring_align(ring, XF_FAL_RING_SECTOR_HDR_SIZE);
+    }
+
+    return XF_ERR_NOT_FOUND;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void xf_fal_ring_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t xf_fal_ring_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8)
+           | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t xf_fal_ring_align(const xf_fal_ring_t *ring, size_t size)
+{
+    return (size + ring->align - 1) / ring->align * ring->align;
+}
+
+/**
+ * @brief 读取扇区头，p_valid 返回扇区头是否有效（空白或损坏为无效）。
+ */
+static xf_err_t xf_fal_ring_read_seq(
+    xf_fal_ring_t *ring, size_t sector, uint32_t *p_seq, bool *p_valid)
+{
+    xf_err_t xf_ret;
+    uint8_t hdr[XF_FAL_RING_SECTOR_HDR_SIZE];
+
+    xf_ret = xf_fal_handle_read(&ring->handle, sector * ring->sector_size, hdr, sizeof(hdr));
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    *p_seq      = xf_fal_ring_get_u32(&hdr[4]);
+    *p_valid    = (XF_FAL_RING_SECTOR_MAGIC == xf_fal_ring_get_u32(&hdr[0]))
+                  && (xf_fal_ring_get_u32(&hdr[8]) == xf_fal_crc32(0, hdr, 8));
+
+    return XF_OK;
+}
+
+/**
+ * @brief 二分查找最新的扇区，再根据序号确定最旧的扇区。
+ *
+ * 以扇区 0（为空白时以扇区 1）为参照 r, 扇区 i 属于与 r 同一圈的条件
+ * seq[i] - seq[r] == i - r 在 [r, head] 上成立、在 head 之后不成立，满足二分查找的单调性。
+ */
+static xf_err_t xf_fal_ring_find_head(xf_fal_ring_t *ring)
+{
+    xf_err_t xf_ret;
+    uint32_t ref_seq;
+    uint32_t seq;
+    size_t ref = 0;
+    size_t lo;
+    size_t hi;
+    size_t mid;
+    size_t next;
+    bool is_valid;
+
+    xf_ret = xf_fal_ring_read_seq(ring, 0, &ref_seq, &is_valid);
+    if ((XF_OK == xf_ret) && (!is_valid)) {
+        ref     = 1;
+        xf_ret  = xf_fal_ring_read_seq(ring, 1, &ref_seq, &is_valid);
+    }
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    if (!is_valid) {
+        /* 空日志，第一次追加时启用扇区 0 */
+        ring->head      = ring->sector_num - 1;
+        ring->tail      = 0;
+        ring->used_num  = 0;
+        ring->head_seq  = 0;
+        ring->write_off = ring->sector_num * ring->sector_size;
+        return XF_OK;
+    }
+
+    /* 在 (lo, hi] 中查找最后一个满足条件的扇区，lo 已知满足 */
+    lo = ref;
+    hi = ring->sector_num - 1;
+    while (lo < hi) {
+        mid = lo + (hi - lo + 1) / 2;
+        xf_ret = xf_fal_ring_read_seq(ring, mid, &seq, &is_valid);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if ((is_valid) && ((uint32_t)(seq - ref_seq) == (uint32_t)(mid - ref))) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    ring->head      = lo;
+    ring->head_seq  = ref_seq + (uint32_t)(lo - ref);
+
+    /* 最旧的扇区是 head 之后第一个属于上一圈的扇区，中间可能有 1 个空白扇区 */
+    ring->tail = ref;
+    for (size_t i = 1; i <= 2; i++) {
+        next = (ring->head + i) % ring->sector_num;
+        if (next == ref) {
+            break;
+        }
+        xf_ret = xf_fal_ring_read_seq(ring, next, &seq, &is_valid);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if ((is_valid) && (seq == ring->head_seq - (uint32_t)(ring->sector_num - i))) {
+            ring->tail = next;
+            break;
+        }
+    }
+    ring->used_num = (ring->head + ring->sector_num - ring->tail) % ring->sector_num + 1;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 扫描最新扇区内的条目头，找到写入位置。
+ */
+static xf_err_t xf_fal_ring_find_end(xf_fal_ring_t *ring)
+{
+    xf_err_t xf_ret;
+    uint8_t hdr[XF_FAL_RING_ENTRY_HDR_SIZE];
+    size_t sector_end;
+    size_t len;
+    size_t off;
+
+    if (0 == ring->used_num) {
+        return XF_OK;
+    }
+
+    sector_end  = (ring->head + 1) * ring->sector_size;
+    off         = ring->head * ring->sector_size
+                  + xf_fal_ring_align(ring, XF_FAL_RING_SECTOR_HDR_SIZE);
+    while (off + XF_FAL_RING_ENTRY_HDR_SIZE <= sector_end) {
+        xf_ret = xf_fal_handle_read(&ring->handle, off, hdr, sizeof(hdr));
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if ((0xFF == hdr[0]) && (0xFF == hdr[1]) && (0xFF == hdr[2]) && (0xFF == hdr[3])) {
+            break;
+        }
+        len = (size_t)hdr[0] | ((size_t)hdr[1] << 8);
+        if (((uint8_t)(hdr[0] ^ hdr[2]) != 0xFF) || ((uint8_t)(hdr[1] ^ hdr[3]) != 0xFF)
+                || (off + xf_fal_ring_align(ring, XF_FAL_RING_ENTRY_HDR_SIZE + len) > sector_end)) {
+            /* 写了一半的条目头，放弃该扇区的剩余空间 */
+            XF_LOGW(TAG, "Corrupted entry at 0x%08x, skip the rest of sector %d.",
+                    (int)off, (int)ring->head);
+            off = sector_end;
+            break;
+        }
+        off += xf_fal_ring_align(ring, XF_FAL_RING_ENTRY_HDR_SIZE + len);
+    }
+    ring->write_off = (off < sector_end) ? off : sector_end;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 将数据放入缓冲区，凑满一个缓冲边界时写入 flash. src 为 NULL 时填充 0xFF.
+ *
+ * 调用者保证数据不超出当前扇区。
+ */
+static xf_err_t xf_fal_ring_put(xf_fal_ring_t *ring, const void *src, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+    const uint8_t *src_u8 = src;
+    size_t len;
+
+    while (size > 0) {
+        len = ring->buf_unit - ring->buf_len;
+        len = (len < size) ? len : size;
+        if (src_u8) {
+            memcpy(&ring->buf[ring->buf_len], src_u8, len);
+            src_u8 += len;
+        } else {
+            memset(&ring->buf[ring->buf_len], 0xFF, len);
+        }
+        ring->buf_len   += len;
+        ring->write_off += len;
+        size            -= len;
+        if (ring->buf_len == ring->buf_unit) {
+            xf_ret = xf_fal_ring_flush(ring);
+            ring->buf_len   = 0;
+            ring->buf_start = 0;
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+        }
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 写入当前扇区的剩余数据，擦除并启用下一个扇区。日志已满时丢弃最旧的扇区。
+ */
+static xf_err_t xf_fal_ring_advance(xf_fal_ring_t *ring)
+{
+    xf_err_t xf_ret;
+    xf_fal_erase_result_t result;
+    uint8_t hdr[XF_FAL_RING_SECTOR_HDR_SIZE];
+    size_t next;
+
+    xf_ret = xf_fal_ring_flush(ring);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    next = (ring->head + 1) % ring->sector_num;
+    if ((ring->used_num) && (next == ring->tail)) {
+        ring->tail = (ring->tail + 1) % ring->sector_num;
+        ring->used_num--;
+    }
+    xf_ret = xf_fal_handle_erase_ex(&ring->handle, next * ring->sector_size, ring->sector_size,
+                                    XF_FAL_ERASE_FLAG_SKIP_BLANK, &result);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    if (0 == ring->used_num) {
+        ring->tail = next;
+    }
+    ring->head      = next;
+    ring->head_seq++;
+    ring->used_num++;
+    ring->write_off = next * ring->sector_size;
+    ring->buf_len   = 0;
+    ring->buf_start = 0;
+
+    xf_fal_ring_put_u32(&hdr[0], XF_FAL_RING_SECTOR_MAGIC);
+    xf_fal_ring_put_u32(&hdr[4], ring->head_seq);
+    xf_fal_ring_put_u32(&hdr[8], xf_fal_crc32(0, hdr, 8));
+    xf_ret = xf_fal_ring_put(ring, hdr, sizeof(hdr));
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    return xf_fal_ring_put(ring, NULL,
+                           xf_fal_ring_align(ring, XF_FAL_RING_SECTOR_HDR_SIZE)
+                           - XF_FAL_RING_SECTOR_HDR_SIZE);
+}
@@ -0,0 +1,184 @@
+/**
+ * @file xf_fal_ring.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 环形日志分区。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_RING_H__
+#define __XF_FAL_RING_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 环形日志对象。
+ *
+ * 分区按扇区组成环，只在末尾追加条目，写满后擦除最旧的扇区继续写入。
+ * 每个扇区开头有带 CRC-32 的序号，相邻扇区的序号连续递增，
+ * 因此打开时只需二分查找扇区头（约 log2(扇区数) 次读取）即可找到最新和最旧的扇区，
+ * 再扫描最新扇区内的条目头得到写入位置，不需要读取整个分区。
+ *
+ * 追加的条目先放入页缓冲区，凑满一页（或 XF_FAL_RING_BUF_SIZE）才写入 flash,
+ * 每次写入不跨页。xf_fal_ring_flush() 写入缓冲区中剩余的数据，之后的条目从原位置继续，
+ * 不会重复编程已写入的字节。
+ *
+ * 对象由用户提供，xf_fal 不做任何动态分配，占用内存约为一页。
+ *
+ * @note 同一对象不能被多个线程同时使用，同一分区也不能同时被多个对象打开。
+ */
+typedef struct _xf_fal_ring_t {
+    xf_fal_handle_t handle;                 /*!< 分区句柄 */
+    size_t          sector_size;
+    size_t          sector_num;
+    size_t          align;                  /*!< 条目对齐，即 io_size */
+    size_t          buf_unit;               /*!< 缓冲边界 = min(页大小, XF_FAL_RING_BUF_SIZE) */
+    size_t          head;                   /*!< 最新（正在写入）的扇区 */
+    size_t          tail;                   /*!< 最旧的扇区 */
+    size_t          used_num;               /*!< 已使用的扇区数，0 表示空日志 */
+    uint32_t        head_seq;               /*!< 最新扇区的序号 */
+    size_t          write_off;              /*!< 下一个条目的偏移（相对分区起始地址，含缓冲中的数据） */
+    size_t          buf_start;              /*!< 缓冲区中尚未写入 flash 的数据起点 */
+    size_t          buf_len;                /*!< 缓冲区中数据的末尾 */
+    uint8_t         buf[XF_FAL_RING_BUF_SIZE];
+} xf_fal_ring_t;
+
+/**
+ * @brief 环形日志遍历位置，见 xf_fal_ring_iter_begin().
+ */
+typedef struct _xf_fal_ring_iter_t {
+    size_t          sector;                 /*!< 当前扇区 */
+    size_t          left;                   /*!< 含当前扇区在内尚未遍历的扇区数 */
+    size_t          offset;                 /*!< 下一个条目的偏移（相对分区起始地址） */
+} xf_fal_ring_iter_t;
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 打开分区上的环形日志，恢复最新和最旧的扇区及写入位置。
+ *
+ * 分区中没有有效扇区时（如首次使用）视为空日志，无需事先擦除。
+ * 掉电时写了一半的扇区头或条目头会使该扇区剩余部分被跳过，之后的条目写入下一个扇区。
+ *
+ * @param ring  环形日志对象。
+ * @param part  分区，按扇区对齐，至少 2 个扇区；扇区大小须为缓冲边界的整数倍。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或分区不满足要求
+ *      - (OTHER)               读取分区失败
+ */
+xf_err_t xf_fal_ring_open(xf_fal_ring_t *ring, const xf_fal_partition_t *part);
+
+/**
+ * @brief 追加一个条目。
+ *
+ * 当前扇区剩余空间不足时换到下一个扇区，日志已满时擦除最旧的扇区（其中的条目被丢弃）。
+ * 条目可能仍在缓冲区中，需要落盘时调用 xf_fal_ring_flush().
+ *
+ * @param ring  环形日志对象。
+ * @param data  条目数据，size 为 0 时可以为 NULL.
+ * @param size  条目大小，单位：字节。不超过 xf_fal_ring_entry_max().
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数或条目过大
+ *      - (OTHER)               写入或擦除分区失败
+ */
+xf_err_t xf_fal_ring_append(xf_fal_ring_t *ring, const void *data, size_t size);
+
+/**
+ * @brief 将缓冲区中的条目写入 flash.
+ *
+ * @param ring  环形日志对象。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               写入分区失败
+ */
+xf_err_t xf_fal_ring_flush(xf_fal_ring_t *ring);
+
+/**
+ * @brief 获取单个条目的最大大小，单位：字节。
+ *
+ * @param ring  已打开的环形日志对象。
+ * @return size_t 条目最大大小，ring 无效时为 0.
+ */
+size_t xf_fal_ring_entry_max(const xf_fal_ring_t *ring);
+
+/**
+ * @brief 从最旧的条目开始遍历。
+ *
+ * 先写入缓冲区中的条目。遍历期间不能追加条目。
+ *
+ * @param ring      环形日志对象。
+ * @param[out] it   遍历位置。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               写入分区失败
+ */
+xf_err_t xf_fal_ring_iter_begin(xf_fal_ring_t *ring, xf_fal_ring_iter_t *it);
+
+/**
+ * @brief 读取下一个条目。
+ *
+ * CRC 校验失败的条目被跳过。
+ *
+ * @param ring          环形日志对象。
+ * @param it            遍历位置。
+ * @param[out] data     条目缓冲区，可以为 NULL（只获取大小）。
+ * @param size          缓冲区大小，超出部分不读取（仍校验整个条目）。
+ * @param[out] p_len    条目的实际大小，可以为 NULL.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      没有更多条目
+ *      - (OTHER)               读取分区失败
+ */
+xf_err_t xf_fal_ring_iter_next(
+    xf_fal_ring_t *ring, xf_fal_ring_iter_t *it, void *data, size_t size, size_t *p_len);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __XF_FAL_RING_H__
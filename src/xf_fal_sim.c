@@ -0,0 +1,357 @@
+/**
+ * @file xf_fal_sim.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal flash 时序模拟设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_sim.h"
+
+#if XF_FAL_SIM_ENABLE
+
+#if defined(__unix__) || defined(__APPLE__)
+#   include <time.h>
+#   define XF_FAL_SIM_CAN_WAIT      1
+#else
+#   define XF_FAL_SIM_CAN_WAIT      0
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_sim"
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 模拟设备上下文。
+ *
+ * 读写擦由 xf_fal 按设备串行化，统计无需加锁。
+ */
+typedef struct _xf_fal_sim_ctx_t {
+    bool                        is_used;
+    xf_fal_flash_dev_t          dev;        /*!< 返回给用户注册的模拟设备 */
+    const xf_fal_flash_dev_t   *backing;
+    xf_fal_sim_model_t          model;
+    xf_fal_sim_stat_t           stat;
+} xf_fal_sim_ctx_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_fal_sim_ctx_t *xf_fal_sim_find(const char *dev_name);
+static xf_err_t xf_fal_sim_init(xf_fal_sim_ctx_t *sim);
+static xf_err_t xf_fal_sim_deinit(xf_fal_sim_ctx_t *sim);
+static xf_err_t xf_fal_sim_read(xf_fal_sim_ctx_t *sim, size_t src_offset, void *dst, size_t size);
+static xf_err_t xf_fal_sim_write(
+    xf_fal_sim_ctx_t *sim, size_t dst_offset, const void *src, size_t size);
+static xf_err_t xf_fal_sim_erase(xf_fal_sim_ctx_t *sim, size_t offset, size_t size);
+static uint64_t xf_fal_sim_erase_ns(const xf_fal_sim_ctx_t *sim, size_t size);
+static void xf_fal_sim_wait(const xf_fal_sim_ctx_t *sim, uint64_t ns);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_fal_sim_ctx_t s_sim_ctx[XF_FAL_SIM_NUM] = {0};
+#define sp_sim(_idx)    (&s_sim_ctx[_idx])
+
+static const xf_fal_sim_model_t s_sim_model_default = XF_FAL_SIM_MODEL_SPI_NOR_DEFAULT;
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief xf_fal_flash_ops_t 不带上下文参数，此处为每个设备生成一组转发函数。
+ */
+#define XF_FAL_SIM_OPS_DEFINE(_idx) \
+    static xf_err_t xf_fal_sim##_idx##_init(void) \
+    { return xf_fal_sim_init(sp_sim(_idx)); } \
+    static xf_err_t xf_fal_sim##_idx##_deinit(void) \
+    { return xf_fal_sim_deinit(sp_sim(_idx)); } \
+    static xf_err_t xf_fal_sim##_idx##_read(size_t src_offset, void *dst, size_t size) \
+    { return xf_fal_sim_read(sp_sim(_idx), src_offset, dst, size); } \
+    static xf_err_t xf_fal_sim##_idx##_write(size_t dst_offset, const void *src, size_t size) \
+    { return xf_fal_sim_write(sp_sim(_idx), dst_offset, src, size); } \
+    static xf_err_t xf_fal_sim##_idx##_erase(size_t offset, size_t size) \
+    { return xf_fal_sim_erase(sp_sim(_idx), offset, size); }
+
+#define XF_FAL_SIM_OPS_INIT(_idx) \
+    { \
+        .init   = xf_fal_sim##_idx##_init, \
+        .deinit = xf_fal_sim##_idx##_deinit, \
+        .read   = xf_fal_sim##_idx##_read, \
+        .write  = xf_fal_sim##_idx##_write, \
+        .erase  = xf_fal_sim##_idx##_erase, \
+    }
+
+XF_FAL_SIM_OPS_DEFINE(0)
+#if XF_FAL_SIM_NUM > 1
+XF_FAL_SIM_OPS_DEFINE(1)
+#endif
+#if XF_FAL_SIM_NUM > 2
+XF_FAL_SIM_OPS_DEFINE(2)
+#endif
+#if XF_FAL_SIM_NUM > 3
+XF_FAL_SIM_OPS_DEFINE(3)
+#endif
+
+static const xf_fal_flash_ops_t s_sim_ops[XF_FAL_SIM_NUM] = {
+    XF_FAL_SIM_OPS_INIT(0),
+#if XF_FAL_SIM_NUM > 1
+    XF_FAL_SIM_OPS_INIT(1),
+#endif
+#if XF_FAL_SIM_NUM > 2
+    XF_FAL_SIM_OPS_INIT(2),
+#endif
+#if XF_FAL_SIM_NUM > 3
+    XF_FAL_SIM_OPS_INIT(3),
+#endif
+};
+
+/* ==================== [Global Functions] ================================== */
+
+const xf_fal_flash_dev_t *xf_fal_sim_wrap(
+    const xf_fal_flash_dev_t *backing, const xf_fal_sim_model_t *model)
+{
+    xf_fal_sim_ctx_t *sim = NULL;
+    size_t idx;
+
+    if ((NULL == backing) || (NULL == backing->name)
+            || (NULL == backing->ops.read) || (NULL == backing->ops.write)
+            || (NULL == backing->ops.erase)) {
+        return NULL;
+    }
+    for (idx = 0; idx < XF_FAL_SIM_NUM; idx++) {
+        if ((sp_sim(idx)->is_used) && (sp_sim(idx)->backing == backing)) {
+            return &sp_sim(idx)->dev;
+        }
+    }
+    for (idx = 0; idx < XF_FAL_SIM_NUM; idx++) {
+        if (!sp_sim(idx)->is_used) {
+            sim = sp_sim(idx);
+            break;
+        }
+    }
+    if (NULL == sim) {
+        XF_LOGE(TAG, "Can NOT wrap %s, XF_FAL_SIM_NUM reached.", backing->name);
+        return NULL;
+    }
+
+    memset(sim, 0, sizeof(*sim));
+    sim->backing    = backing;
+    sim->model      = (model) ? *model : s_sim_model_default;
+    sim->dev        = *backing;
+    sim->dev.ops    = s_sim_ops[idx];
+    sim->is_used    = true;
+#if !XF_FAL_SIM_CAN_WAIT
+    if (sim->model.wait != XF_FAL_SIM_WAIT_NONE) {
+        XF_LOGW(TAG, "Waiting is NOT supported on this platform, virtual clock only.");
+        sim->model.wait = XF_FAL_SIM_WAIT_NONE;
+    }
+#endif
+
+    return &sim->dev;
+}
+
+xf_err_t xf_fal_sim_get_stat(const char *dev_name, xf_fal_sim_stat_t *p_stat)
+{
+    const xf_fal_sim_ctx_t *sim;
+
+    if ((NULL == dev_name) || (NULL == p_stat)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    sim = xf_fal_sim_find(dev_name);
+    if (NULL == sim) {
+        return XF_ERR_NOT_FOUND;
+    }
+    *p_stat = sim->stat;
+
+    return XF_OK;
+}
+
+void xf_fal_sim_reset_stat(const char *dev_name)
+{
+    for (size_t i = 0; i < XF_FAL_SIM_NUM; i++) {
+        if ((sp_sim(i)->is_used) && ((NULL == dev_name)
+                                     || (0 == xf_strncmp(sp_sim(i)->dev.name, dev_name,
+                                             XF_FAL_DEV_NAME_MAX)))) {
+            memset(&sp_sim(i)->stat, 0, sizeof(sp_sim(i)->stat));
+        }
+    }
+}
+
+void xf_fal_sim_set_wait(const char *dev_name, xf_fal_sim_wait_t wait)
+{
+#if !XF_FAL_SIM_CAN_WAIT
+    wait = XF_FAL_SIM_WAIT_NONE;
+#endif
+    for (size_t i = 0; i < XF_FAL_SIM_NUM; i++) {
+        if ((sp_sim(i)->is_used) && ((NULL == dev_name)
+                                     || (0 == xf_strncmp(sp_sim(i)->dev.name, dev_name,
+                                             XF_FAL_DEV_NAME_MAX)))) {
+            sp_sim(i)->model.wait = wait;
+        }
+    }
+}
+
+uint64_t xf_fal_sim_now_ns(void)
+{
+    uint64_t ns = 0;
+
+    for (size_t i = 0; i < XF_FAL_SIM_NUM; i++) {
+        if (sp_sim(i)->is_used) {
+            ns += sp_sim(i)->stat.time_ns;
+        }
+    }
+    return ns;
+}
+
+void xf_fal_show_sim(void)
+{
+    const xf_fal_sim_stat_t *stat;
+
+    XF_LOGI(TAG, "==================== FAL simulated timing ===================");
+    XF_LOGI(TAG, "| %-16s | %10s | %10s | %10s | %10s |",
+            "device", "total ms", "read ms", "program ms", "erase ms");
+    for (size_t i = 0; i < XF_FAL_SIM_NUM; i++) {
+        if (!sp_sim(i)->is_used) {
+            continue;
+        }
+        stat = &sp_sim(i)->stat;
+        XF_LOGI(TAG, "| %-16s | %10.3f | %10.3f | %10.3f | %10.3f |",
+                sp_sim(i)->dev.name, stat->time_ns / 1e6, stat->read_ns / 1e6,
+                stat->program_ns / 1e6, stat->erase_ns / 1e6);
+    }
+    XF_LOGI(TAG, "=============================================================");
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_fal_sim_ctx_t *xf_fal_sim_find(const char *dev_name)
+{
+    for (size_t i = 0; i < XF_FAL_SIM_NUM; i++) {
+        if ((sp_sim(i)->is_used)
+                && (0 == xf_strncmp(sp_sim(i)->dev.name, dev_name, XF_FAL_DEV_NAME_MAX))) {
+            return sp_sim(i);
+        }
+    }
+    return NULL;
+}
+
+static xf_err_t xf_fal_sim_init(xf_fal_sim_ctx_t *sim)
+{
+    return (sim->backing->ops.init) ? sim->backing->ops.init() : XF_OK;
+}
+
+static xf_err_t xf_fal_sim_deinit(xf_fal_sim_ctx_t *sim)
+{
+    return (sim->backing->ops.deinit) ? sim->backing->ops.deinit() : XF_OK;
+}
+
+static xf_err_t xf_fal_sim_read(xf_fal_sim_ctx_t *sim, size_t src_offset, void *dst, size_t size)
+{
+    xf_err_t xf_ret;
+    uint64_t ns;
+
+    xf_ret  = sim->backing->ops.read(src_offset, dst, size);
+    ns      = sim->model.cmd_ns + (uint64_t)size * sim->model.byte_ns;
+    sim->stat.read_cnt++;
+    sim->stat.read_ns   += ns;
+    sim->stat.time_ns   += ns;
+    xf_fal_sim_wait(sim, ns);
+
+    return xf_ret;
+}
+
+static xf_err_t xf_fal_sim_write(
+    xf_fal_sim_ctx_t *sim, size_t dst_offset, const void *src, size_t size)
+{
+    xf_err_t xf_ret;
+    size_t page_num = 1;
+    uint64_t ns;
+
+    if ((sim->dev.page_size) && (size)) {
+        page_num = (dst_offset + size - 1) / sim->dev.page_size
+                   - dst_offset / sim->dev.page_size + 1;
+    }
+    xf_ret  = sim->backing->ops.write(dst_offset, src, size);
+    ns      = page_num * (sim->model.cmd_ns + (uint64_t)sim->model.page_program_us * 1000)
+              + (uint64_t)size * sim->model.byte_ns;
+    sim->stat.program_cnt   += page_num;
+    sim->stat.program_ns    += ns;
+    sim->stat.time_ns       += ns;
+    xf_fal_sim_wait(sim, ns);
+
+    return xf_ret;
+}
+
+static xf_err_t xf_fal_sim_erase(xf_fal_sim_ctx_t *sim, size_t offset, size_t size)
+{
+    xf_err_t xf_ret;
+    uint64_t ns;
+
+    xf_ret  = sim->backing->ops.erase(offset, size);
+    ns      = xf_fal_sim_erase_ns(sim, size);
+    sim->stat.erase_cnt++;
+    sim->stat.erase_ns  += ns;
+    sim->stat.time_ns   += ns;
+    xf_fal_sim_wait(sim, ns);
+
+    return xf_ret;
+}
+
+/**
+ * @brief 单次擦除的模型耗时。扇区、块和整片以外的大小按逐扇区擦除计算。
+ */
+static uint64_t xf_fal_sim_erase_ns(const xf_fal_sim_ctx_t *sim, size_t size)
+{
+    uint64_t us;
+
+    if (size == sim->dev.len) {
+        us = sim->model.chip_erase_us;
+    } else if (size == 64 * 1024) {
+        us = sim->model.block64_erase_us;
+    } else if (size == 32 * 1024) {
+        us = sim->model.block32_erase_us;
+    } else if (sim->dev.sector_size) {
+        us = (uint64_t)((size + sim->dev.sector_size - 1) / sim->dev.sector_size)
+             * sim->model.sector_erase_us;
+    } else {
+        us = sim->model.sector_erase_us;
+    }
+    return sim->model.cmd_ns + us * 1000;
+}
+
+static void xf_fal_sim_wait(const xf_fal_sim_ctx_t *sim, uint64_t ns)
+{
+#if XF_FAL_SIM_CAN_WAIT
+    struct timespec ts;
+    struct timespec now;
+    uint64_t end;
+
+    switch (sim->model.wait) {
+    case XF_FAL_SIM_WAIT_SLEEP:
+        ts.tv_sec   = (time_t)(ns / 1000000000ull);
+        ts.tv_nsec  = (long)(ns % 1000000000ull);
+        nanosleep(&ts, NULL);
+        break;
+    case XF_FAL_SIM_WAIT_BUSY:
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        end = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec + ns;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+        } while ((uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec < end);
+        break;
+    default:
+        break;
+    }
+#else
+    (void)sim;
+    (void)ns;
+#endif
+}
+
+#endif // XF_FAL_SIM_ENABLE
@@ -0,0 +1,178 @@
+/**
+ * @file xf_fal_sim.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal flash 时序模拟设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_SIM_H__
+#define __XF_FAL_SIM_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#if XF_FAL_SIM_ENABLE || defined(__DOXYGEN__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief 默认的 SPI NOR 时序模型（参考常见 4 KiB 扇区 SPI NOR 的典型值），见 xf_fal_sim_model_t.
+ */
+#define XF_FAL_SIM_MODEL_SPI_NOR_DEFAULT { \
+        .cmd_ns             = 2000, \
+        .byte_ns            = 80, \
+        .page_program_us    = 700, \
+        .sector_erase_us    = 45000, \
+        .block32_erase_us   = 120000, \
+        .block64_erase_us   = 150000, \
+        .chip_erase_us      = 10000000, \
+        .wait               = XF_FAL_SIM_WAIT_NONE, \
+    }
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 模拟设备在每次操作后如何等待。
+ */
+typedef enum _xf_fal_sim_wait_t {
+    XF_FAL_SIM_WAIT_NONE = 0,           /*!< 只累计到虚拟时钟，立即返回 */
+    XF_FAL_SIM_WAIT_SLEEP,              /*!< 线程睡眠模型耗时，不占用 CPU（模拟等待忙标志时让出 CPU 的驱动） */
+    XF_FAL_SIM_WAIT_BUSY,               /*!< 忙等模型耗时（模拟轮询忙标志的驱动） */
+} xf_fal_sim_wait_t;
+
+/**
+ * @brief 时序模型。
+ *
+ * - 读：cmd_ns + 字节数 * byte_ns;
+ * - 写：每个涉及的页 cmd_ns + page_program_us, 另加字节数 * byte_ns;
+ * - 擦除：按 size 选择扇区、32 KiB / 64 KiB 块或整片擦除的耗时，其他大小按扇区数计算。
+ */
+typedef struct _xf_fal_sim_model_t {
+    uint32_t            cmd_ns;             /*!< 每条命令的指令、地址和片选开销 */
+    uint32_t            byte_ns;            /*!< 每字节传输耗时（读出和写入的数据） */
+    uint32_t            page_program_us;    /*!< 页编程耗时 tPP, 不足一页也按一页计 */
+    uint32_t            sector_erase_us;    /*!< 扇区擦除耗时 */
+    uint32_t            block32_erase_us;   /*!< 32 KiB 块擦除耗时 */
+    uint32_t            block64_erase_us;   /*!< 64 KiB 块擦除耗时 */
+    uint32_t            chip_erase_us;      /*!< 整片擦除耗时 */
+    xf_fal_sim_wait_t   wait;
+} xf_fal_sim_model_t;
+
+/**
+ * @brief 模拟设备的虚拟时钟和操作计数，见 xf_fal_sim_get_stat().
+ */
+typedef struct _xf_fal_sim_stat_t {
+    uint64_t    time_ns;            /*!< 虚拟时钟：所有操作的模型耗时之和 */
+    uint64_t    read_ns;
+    uint64_t    program_ns;
+    uint64_t    erase_ns;
+    size_t      read_cnt;           /*!< 读命令数 */
+    size_t      program_cnt;        /*!< 页编程次数 */
+    size_t      erase_cnt;          /*!< 擦除命令数 */
+} xf_fal_sim_stat_t;
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 为 flash 设备套上时序模型，返回可以直接注册的模拟设备。
+ *
+ * 模拟设备与 backing 同名、几何参数和擦除粒度表相同，读写擦转发给 backing 的操作集后
+ * 按时序模型累计虚拟时钟（并按 wait 等待），因此已有的分区表无需修改：
+ *
+ * @code
+ * static const xf_fal_sim_model_t model = XF_FAL_SIM_MODEL_SPI_NOR_DEFAULT;
+ * xf_fal_register_flash_device(xf_fal_sim_wrap(&mock_flash_dev, &model));
+ * @endcode
+ *
+ * 同一个 backing 只创建一个模拟设备，再次调用返回已创建的设备（忽略 model）。
+ * backing 本身不应再注册。backing 的可选操作（readv、blank_check 等）不转发，
+ * xf_fal 退回到 read/write, 按实际的读写计时。
+ *
+ * @param backing   实际存储数据的 flash 设备，须在模拟设备注销前保持有效。
+ * @param model     时序模型，NULL 时为 XF_FAL_SIM_MODEL_SPI_NOR_DEFAULT. 函数返回后不再使用。
+ * @return const xf_fal_flash_dev_t* 模拟设备；参数无效或已创建 XF_FAL_SIM_NUM 个设备时为 NULL.
+ */
+const xf_fal_flash_dev_t *xf_fal_sim_wrap(
+    const xf_fal_flash_dev_t *backing, const xf_fal_sim_model_t *model);
+
+/**
+ * @brief 获取模拟设备的虚拟时钟和操作计数。
+ *
+ * @param dev_name      模拟设备名（即 backing 的设备名）。
+ * @param[out] p_stat   统计结果。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      未找到
+ */
+xf_err_t xf_fal_sim_get_stat(const char *dev_name, xf_fal_sim_stat_t *p_stat);
+
+/**
+ * @brief 清零模拟设备的虚拟时钟和操作计数。
+ *
+ * @param dev_name 模拟设备名，NULL 表示所有模拟设备。
+ */
+void xf_fal_sim_reset_stat(const char *dev_name);
+
+/**
+ * @brief 修改模拟设备的等待方式。
+ *
+ * @param dev_name  模拟设备名，NULL 表示所有模拟设备。
+ * @param wait      等待方式。
+ */
+void xf_fal_sim_set_wait(const char *dev_name, xf_fal_sim_wait_t wait);
+
+/**
+ * @brief 获取所有模拟设备的虚拟时钟之和，单位: ns.
+ *
+ * 即按模型串行执行迄今所有操作所需的设备时间。
+ */
+uint64_t xf_fal_sim_now_ns(void);
+
+/**
+ * @brief 打印各模拟设备的虚拟时钟和操作计数。
+ */
+void xf_fal_show_sim(void);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // XF_FAL_SIM_ENABLE
+
+#endif // __XF_FAL_SIM_H__
@@ -0,0 +1,243 @@
+/**
+ * @file xf_fal_static.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 编译期分区表。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * 分区表用 X 宏声明一次，编译期生成分区 ID 枚举和已解析的分区句柄表
+ * (见 xf_fal_handle_t), 并在编译期检查分区越界和重叠。
+ * 通过 ID 直接索引句柄表访问分区，无需注册分区表、按名查找和分区缓存，
+ * xf_fal_init() 也不再校验这些分区。
+ *
+ * 设备列表的每一项为 X(dev, dev_name, dev_len):
+ * - dev        flash 设备对象（xf_fal_flash_dev_t 变量名，不是指针）；
+ * - dev_name   设备名（字符串常量），与 dev.name 相同；
+ * - dev_len    设备长度，须为整数常量表达式，且不超过 dev.len.
+ *
+ * 分区列表的每一项为 X(id, name, dev, offset, len):
+ * - id         分区 ID, 生成为枚举常量；
+ * - name       分区名（字符串常量），仅用于日志；
+ * - dev        分区所在的 flash 设备对象，须出现在设备列表中；
+ * - offset/len 分区在设备上的偏移和长度，须为整数常量表达式。
+ *
+ * @code
+ * // app_part.h
+ * #define APP_DEV_LIST(X)                                              \
+ *     X(mock_flash_dev,   MOCK_FLASH_NAME,    MOCK_FLASH_LEN)
+ *
+ * #define APP_PART_LIST(X)                                             \
+ *     X(APP_PART_BL,      "bl",       mock_flash_dev, 0,          4096 )  \
+ *     X(APP_PART_APP,     "app",      mock_flash_dev, 4096,       12288)
+ *
+ * XF_FAL_STATIC_TABLE_DECLARE(app, APP_DEV_LIST, APP_PART_LIST);
+ *
+ * // mock_flash.c, mock_flash_dev 在此可见
+ * XF_FAL_STATIC_TABLE_DEFINE(app, APP_DEV_LIST, APP_PART_LIST);
+ *
+ * // 使用
+ * app_register();      // 注册设备列表中的 flash 设备
+ * xf_fal_init();
+ * xf_fal_handle_read(XF_FAL_STATIC_HANDLE(app, APP_PART_APP), 0, buf, size);
+ * @endcode
+ *
+ * @note 设备列表中的设备在注册表中的下标在编译期确定为其在列表中的序号，
+ *       因此须先调用 <tbl>_register() 再注册其他 flash 设备。
+ *       设备对象须是变量本身，不能是 xf_fal_sim_wrap() 等运行时返回的设备。
+ * @note 重叠检查使用 GNU C 的 case 范围扩展，其他编译器只检查越界。
+ *       重叠时编译报错 "duplicate (or overlapping) case value".
+ */
+
+#ifndef __XF_FAL_STATIC_H__
+#define __XF_FAL_STATIC_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 声明编译期分区表，放在头文件中。
+ *
+ * 生成:
+ * - 分区 ID 枚举 <tbl>_part_id_t 及分区数 XF_FAL_STATIC_PART_NUM(tbl);
+ * - 设备下标和设备长度常量，见 XF_FAL_STATIC_DEV_IDX(), XF_FAL_STATIC_DEV_LEN();
+ * - 句柄表 <tbl>_handle[] 和设备注册函数 <tbl>_register() 的声明。
+ *
+ * <tbl>_register() 按列表顺序注册设备列表中的 flash 设备（已注册的不重复注册），
+ * 设备的注册下标与列表序号不符或设备长度小于 dev_len 时返回 XF_ERR_INVALID_PORT.
+ *
+ * @param _tbl          表名，作为生成的标识符的前缀。
+ * @param _dev_list     设备列表 X 宏。
+ * @param _part_list    分区列表 X 宏。
+ */
+#define XF_FAL_STATIC_TABLE_DECLARE(_tbl, _dev_list, _part_list) \
+    enum { _dev_list(XF_FAL_STATIC__DEV_IDX_ITEM) XF_FAL_STATIC_DEV_NUM(_tbl) }; \
+    _dev_list(XF_FAL_STATIC__DEV_LEN_ITEM) \
+    typedef enum { \
+        _part_list(XF_FAL_STATIC__PART_ID_ITEM) \
+        XF_FAL_STATIC_PART_NUM(_tbl) \
+    } _tbl##_part_id_t; \
+    extern const xf_fal_handle_t _tbl##_handle[XF_FAL_STATIC_PART_NUM(_tbl)]; \
+    xf_err_t _tbl##_register(void)
+
+/**
+ * @brief 定义编译期分区表，放在能看到设备列表中所有设备对象的一个源文件中。
+ *
+ * 编译期检查：设备数不超过 XF_FAL_FLASH_DEVICE_NUM; 各分区长度非 0 且不超出设备；
+ * 同一设备上的分区互不重叠（仅 GNU C）。
+ *
+ * @param _tbl          表名，与 XF_FAL_STATIC_TABLE_DECLARE() 相同。
+ * @param _dev_list     设备列表 X 宏。
+ * @param _part_list    分区列表 X 宏。
+ */
+#define XF_FAL_STATIC_TABLE_DEFINE(_tbl, _dev_list, _part_list) \
+    XF_FAL_STATIC_ASSERT(XF_FAL_STATIC_DEV_NUM(_tbl) <= XF_FAL_FLASH_DEVICE_NUM, \
+                         _tbl##__too_many_flash_devices); \
+    _part_list(XF_FAL_STATIC__PART_CHECK_ITEM) \
+    XF_FAL_STATIC__OVERLAP_CHECK(_tbl, _part_list) \
+    _dev_list(XF_FAL_STATIC__DEV_NAME_ITEM) \
+    xf_err_t _tbl##_register(void) \
+    { \
+        xf_err_t xf_ret; \
+        _dev_list(XF_FAL_STATIC__DEV_REGISTER_ITEM) \
+        return XF_OK; \
+    } \
+    const xf_fal_handle_t _tbl##_handle[XF_FAL_STATIC_PART_NUM(_tbl)] = { \
+        _part_list(XF_FAL_STATIC__HANDLE_ITEM) \
+    }
+
+/**
+ * @brief 通过分区 ID 获取分区句柄（const xf_fal_handle_t *）。
+ */
+#define XF_FAL_STATIC_HANDLE(_tbl, _id)     (&_tbl##_handle[(_id)])
+
+/**
+ * @brief 分区表中的分区数。
+ */
+#define XF_FAL_STATIC_PART_NUM(_tbl)        _tbl##__xf_fal_part_num
+
+/**
+ * @brief 分区表中的设备数。
+ */
+#define XF_FAL_STATIC_DEV_NUM(_tbl)         _tbl##__xf_fal_dev_num
+
+/**
+ * @brief 设备在注册表中的下标（即在设备列表中的序号）。
+ */
+#define XF_FAL_STATIC_DEV_IDX(_dev)         _dev##__xf_fal_dev_idx
+
+/**
+ * @brief 设备列表中给出的设备长度。
+ */
+#define XF_FAL_STATIC_DEV_LEN(_dev)         _dev##__xf_fal_dev_len
+
+/**
+ * @brief 编译期断言，_name 为标识符，断言失败时出现在编译错误中。
+ */
+#if (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)) || defined(__GNUC__)
+#   define XF_FAL_STATIC_ASSERT(_cond, _name)   _Static_assert((_cond), #_name)
+#else
+#   define XF_FAL_STATIC_ASSERT(_cond, _name)   typedef char _name[(_cond) ? 1 : -1]
+#endif
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* 以下为生成代码用的内部宏 */
+
+#define XF_FAL_STATIC__DEV_NAME(_dev)       _dev##__xf_fal_dev_name
+
+#define XF_FAL_STATIC__DEV_IDX_ITEM(_dev, _dev_name, _dev_len) \
+    XF_FAL_STATIC_DEV_IDX(_dev),
+
+#define XF_FAL_STATIC__DEV_LEN_ITEM(_dev, _dev_name, _dev_len) \
+    enum { XF_FAL_STATIC_DEV_LEN(_dev) = (_dev_len) };
+
+#define XF_FAL_STATIC__PART_ID_ITEM(_id, _name, _dev, _offset, _len) \
+    _id,
+
+#define XF_FAL_STATIC__PART_CHECK_ITEM(_id, _name, _dev, _offset, _len) \
+    XF_FAL_STATIC_ASSERT(((_len) > 0) \
+                         && ((_offset) + (_len) <= XF_FAL_STATIC_DEV_LEN(_dev)), \
+                         _id##__out_of_flash_device);
+
+/* 设备名供分区的 flash_name 使用（设备对象的 name 不能用于静态初始化） */
+#define XF_FAL_STATIC__DEV_NAME_ITEM(_dev, _dev_name, _dev_len) \
+    static char XF_FAL_STATIC__DEV_NAME(_dev)[] = _dev_name;
+
+#define XF_FAL_STATIC__DEV_REGISTER_ITEM(_dev, _dev_name, _dev_len) \
+    xf_ret = xf_fal_register_flash_device(&(_dev)); \
+    if ((XF_OK != xf_ret) && (XF_ERR_INITED != xf_ret)) { \
+        return xf_ret; \
+    } \
+    if ((xf_fal_get_ctx()->p_snapshot->flash_device_table[XF_FAL_STATIC_DEV_IDX(_dev)] \
+            != &(_dev)) || ((_dev).len < XF_FAL_STATIC_DEV_LEN(_dev))) { \
+        return XF_ERR_INVALID_PORT; \
+    }
+
+#define XF_FAL_STATIC__HANDLE_ITEM(_id, _name, _dev, _offset, _len) \
+    [_id] = { \
+        .partition  = &(const xf_fal_partition_t) { \
+            (char *)(_name), XF_FAL_STATIC__DEV_NAME(_dev), (_offset), (_len) \
+        }, \
+        .flash_dev  = &(_dev), \
+        .dev_idx    = XF_FAL_STATIC_DEV_IDX(_dev), \
+        .base       = (_offset), \
+        .len        = (_len), \
+        XF_FAL_STATIC__TRACE_ID(_id) \
+    },
+
+/* 跟踪记录中的分区 id 取分区 ID */
+#if XF_FAL_TRACE_ENABLE
+#   define XF_FAL_STATIC__TRACE_ID(_id)     .part_id = (uint16_t)(_id),
+#else
+#   define XF_FAL_STATIC__TRACE_ID(_id)
+#endif
+
+/* 每个设备占用 2^32 的地址空间，同一设备上的分区范围重叠时 case 值重复 */
+#if defined(__GNUC__)
+#   define XF_FAL_STATIC__OVERLAP_CHECK(_tbl, _part_list) \
+    static inline void _tbl##__xf_fal_overlap_check(uint64_t addr) \
+    { \
+        switch (addr) { \
+        _part_list(XF_FAL_STATIC__OVERLAP_CASE) \
+        default: \
+            break; \
+        } \
+    }
+#   define XF_FAL_STATIC__OVERLAP_CASE(_id, _name, _dev, _offset, _len) \
+    case ((uint64_t)XF_FAL_STATIC_DEV_IDX(_dev) << 32) + (_offset) \
+        ... ((uint64_t)XF_FAL_STATIC_DEV_IDX(_dev) << 32) + (_offset) + (_len) - 1: \
+        break;
+#else
+#   define XF_FAL_STATIC__OVERLAP_CHECK(_tbl, _part_list)
+#endif
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __XF_FAL_STATIC_H__
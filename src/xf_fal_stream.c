@@ -0,0 +1,160 @@
+/**
+ * @file xf_fal_stream.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 流式写入（如 OTA 镜像接收）。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_stream.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_stream"
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_err_t xf_fal_stream_program(
+    xf_fal_stream_t *stream, size_t offset, const uint8_t *src, size_t size);
+
+/* ==================== [Static Variables] ================================== */
+
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_fal_stream_open(
+    xf_fal_stream_t *stream, const xf_fal_partition_t *part, size_t offset)
+{
+    xf_err_t xf_ret;
+    size_t page_size;
+
+    if (!stream) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_ret = xf_fal_partition_get_handle(part, &stream->handle);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    if (offset > stream->handle.len) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if ((stream->handle.flash_dev->sector_size)
+            && ((stream->handle.base + offset) % stream->handle.flash_dev->sector_size)) {
+        XF_LOGE(TAG, "Stream open error! "
+                "Partition(%s) offset(0x%08x) not aligned to sector.",
+                part->name, (int)offset);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    page_size           = stream->handle.flash_dev->page_size;
+    stream->start       = offset;
+    stream->offset      = offset;
+    stream->erase_end   = offset;
+    stream->erase_step  = stream->handle.flash_dev->sector_size;
+    stream->buf_unit    = ((page_size) && (page_size < XF_FAL_STREAM_BUF_SIZE))
+                          ? page_size : XF_FAL_STREAM_BUF_SIZE;
+    stream->buf_len     = 0;
+    stream->crc         = 0;
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_stream_write(xf_fal_stream_t *stream, const void *src, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+    const uint8_t *src_u8 = src;
+    size_t len;
+
+    if ((!stream) || (!stream->handle.partition) || ((!src) && (size))) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if (size > stream->handle.len - stream->offset) {
+        XF_LOGE(TAG, "Stream write error! "
+                "Partition(%s) address(0x%08x) out of bound(0x%08x).",
+                stream->handle.partition->name,
+                (int)(stream->offset + size), (int)stream->handle.len);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    stream->crc = xf_fal_crc32(stream->crc, src_u8, size);
+    while ((size > 0) && (XF_OK == xf_ret)) {
+        if ((0 == stream->buf_len) && (size >= stream->buf_unit)) {
+            /* 缓冲区为空时整页部分直接写入，不经过缓冲区 */
+            len     = size - size % stream->buf_unit;
+            xf_ret  = xf_fal_stream_program(stream, stream->offset, src_u8, len);
+        } else {
+            len = stream->buf_unit - stream->buf_len;
+            len = (len < size) ? len : size;
+            memcpy(&stream->buf[stream->buf_len], src_u8, len);
+            stream->buf_len += len;
+            if (stream->buf_len == stream->buf_unit) {
+                xf_ret = xf_fal_stream_program(
+                             stream, stream->offset + len - stream->buf_len,
+                             stream->buf, stream->buf_len);
+                stream->buf_len = 0;
+            }
+        }
+        stream->offset += len;
+        src_u8 += len;
+        size   -= len;
+    }
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_stream_finish(xf_fal_stream_t *stream, uint32_t *p_crc32)
+{
+    xf_err_t xf_ret = XF_OK;
+
+    if ((!stream) || (!stream->handle.partition)) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    if (stream->buf_len) {
+        xf_ret = xf_fal_stream_program(
+                     stream, stream->offset - stream->buf_len,
+                     stream->buf, stream->buf_len);
+        stream->buf_len = 0;
+    }
+    if (p_crc32) {
+        *p_crc32 = stream->crc;
+    }
+
+    return xf_ret;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 擦除到覆盖 [offset, offset + size) 为止，再写入。
+ */
+static xf_err_t xf_fal_stream_program(
+    xf_fal_stream_t *stream, size_t offset, const uint8_t *src, size_t size)
+{
+    xf_err_t xf_ret = XF_OK;
+    size_t len;
+
+    while (stream->erase_end < offset + size) {
+        len = (stream->erase_step) ? stream->erase_step : (offset + size - stream->erase_end);
+        if (len > stream->handle.len - stream->erase_end) {
+            len = stream->handle.len - stream->erase_end;
+        }
+        xf_ret = xf_fal_handle_erase(&stream->handle, stream->erase_end, len);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        stream->erase_end += len;
+    }
+
+    return xf_fal_handle_write(&stream->handle, offset, src, size);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file xf_fal_stream.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 流式写入（如 OTA 镜像接收）。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_STREAM_H__
+#define __XF_FAL_STREAM_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 流式写入对象。
+ *
+ * 接收任意大小的数据块，缓冲到页边界后写入分区；
+ * 每个扇区在第一次写入前才擦除，不需要事先擦除整个分区。
+ * 同时计算已接收数据的 CRC-32.
+ *
+ * 对象由用户提供，xf_fal 不做任何动态分配，占用内存约为一页。
+ *
+ * @note 同一对象不能被多个线程同时使用。
+ */
+typedef struct _xf_fal_stream_t {
+    xf_fal_handle_t handle;                 /*!< 目标分区句柄 */
+    size_t          start;                  /*!< 起始偏移（相对分区起始地址） */
+    size_t          offset;                 /*!< 已接收数据的末尾（含缓冲中的数据） */
+    size_t          erase_end;              /*!< 已擦除到的偏移 */
+    /**
+     * @brief 每次擦除的大小，xf_fal_stream_open() 时设为扇区大小。
+     *
+     * open 后可以改为擦除块大小（如 64 KiB）的整数倍，
+     * 利用块擦除减少总擦除耗时，代价是单次擦除（即首次写入）延迟变长。
+     */
+    size_t          erase_step;
+    size_t          buf_unit;               /*!< 缓冲边界 = min(页大小, XF_FAL_STREAM_BUF_SIZE) */
+    size_t          buf_len;                /*!< 缓冲中数据长度 */
+    uint32_t        crc;                    /*!< 已接收数据的 CRC-32, 见 xf_fal_crc32() */
+    uint8_t         buf[XF_FAL_STREAM_BUF_SIZE];
+} xf_fal_stream_t;
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 开始向分区流式写入。
+ *
+ * 不擦除任何数据，第一次写入时才擦除第一个扇区。
+ *
+ * @param stream 流式写入对象。
+ * @param part   目标分区。
+ * @param offset 起始偏移（相对分区起始地址），必须对齐到扇区。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数、越界或未对齐到扇区
+ */
+xf_err_t xf_fal_stream_open(
+    xf_fal_stream_t *stream, const xf_fal_partition_t *part, size_t offset);
+
+/**
+ * @brief 追加数据。
+ *
+ * 不足一页的数据留在缓冲区中，整页的部分直接写入分区。
+ *
+ * @attention 返回失败后流处于未知状态，应放弃本次写入。
+ *
+ * @param stream 流式写入对象。
+ * @param src    数据。
+ * @param size   数据大小，单位：字节。可以为任意值。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_INVALID_ARG    无效参数或超出分区
+ */
+xf_err_t xf_fal_stream_write(xf_fal_stream_t *stream, const void *src, size_t size);
+
+/**
+ * @brief 写入缓冲区中剩余的数据并结束流式写入。
+ *
+ * @param stream        流式写入对象。
+ * @param[out] p_crc32  已接收全部数据的 CRC-32 (IEEE 802.3)，可以为 NULL.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_fal_stream_finish(xf_fal_stream_t *stream, uint32_t *p_crc32);
+
+/**
+ * @brief 获取已接收的数据大小。
+ *
+ * @param stream 流式写入对象。
+ * @return size_t 已接收的字节数（含缓冲中尚未写入的数据）。
+ */
+static inline size_t xf_fal_stream_get_size(const xf_fal_stream_t *stream)
+{
+    return stream->offset - stream->start;
+}
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __XF_FAL_STREAM_H__
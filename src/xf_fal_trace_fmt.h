@@ -0,0 +1,87 @@
+/**
+ * @file xf_fal_trace_fmt.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 操作跟踪的二进制格式。
+ *
+ * 只依赖 stdint.h, 设备端 (xf_fal_trace_dump()) 与主机端解码工具
+ * (tools/trace_decode) 共用。
+ *
+ * 导出数据依次为：
+ * - xf_fal_trace_hdr_t
+ * - xf_fal_trace_hdr_t.part_num 个 xf_fal_trace_part_t
+ * - xf_fal_trace_hdr_t.rec_num 个 xf_fal_trace_rec_t, 从旧到新，seq 为 0 的是空记录
+ *
+ * 所有字段为设备端的字节序，主机端通过 magic 判断是否需要翻转。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_TRACE_FMT_H__
+#define __XF_FAL_TRACE_FMT_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_FAL_TRACE_MAGIC              0x52544658u     /*!< "XFTR" */
+#define XF_FAL_TRACE_VERSION            1
+#define XF_FAL_TRACE_NAME_SIZE          24              /*!< 分区名最大长度（不足时补 0, 可能没有结束符）*/
+#define XF_FAL_TRACE_IN_FLIGHT          0xFFFFFFFFu     /*!< duration 为此值表示操作未完成 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 导出数据头。
+ */
+typedef struct _xf_fal_trace_hdr_t {
+    uint32_t    magic;                  /*!< XF_FAL_TRACE_MAGIC */
+    uint16_t    version;                /*!< XF_FAL_TRACE_VERSION */
+    uint16_t    rec_size;               /*!< sizeof(xf_fal_trace_rec_t) */
+    uint32_t    rec_num;                /*!< 记录条数 */
+    uint32_t    part_num;               /*!< 分区名表项数 */
+    uint32_t    head;                   /*!< 下一条记录的 seq - 1, 即已写入的总条数 */
+    uint32_t    reserved;
+} xf_fal_trace_hdr_t;
+
+/**
+ * @brief 分区名表项，用于把 xf_fal_trace_rec_t.part_id 还原为分区名。
+ */
+typedef struct _xf_fal_trace_part_t {
+    uint16_t    part_id;
+    uint16_t    reserved;
+    uint32_t    len;                    /*!< 分区长度 */
+    char        name[XF_FAL_TRACE_NAME_SIZE];
+} xf_fal_trace_part_t;
+
+/**
+ * @brief 一次分区读写擦的跟踪记录。
+ */
+typedef struct _xf_fal_trace_rec_t {
+    uint32_t    seq;                    /*!< 序号，从 1 开始，0 表示空记录 */
+    uint32_t    timestamp;              /*!< 开始时间，单位同跟踪时钟 */
+    uint32_t    duration;               /*!< 耗时，XF_FAL_TRACE_IN_FLIGHT 表示未完成 */
+    uint32_t    offset;                 /*!< 相对分区起始地址的偏移 */
+    uint32_t    size;                   /*!< 大小，单位：字节 */
+    uint16_t    part_id;                /*!< 分区名哈希（FNV-1a 折叠为 16 位）*/
+    uint8_t     op;                     /*!< 同 xf_fal_op_t: 0 读，1 写，2 擦除 */
+    uint8_t     result;                 /*!< xf_err_t 的低 8 位，0 为成功 */
+} xf_fal_trace_rec_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __XF_FAL_TRACE_FMT_H__
@@ -15,6 +15,7 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_fal_config_internal.h"
+#include "xf_fal_trace_fmt.h"
 #include "xf_utils.h"
 
 #ifdef __cplusplus
@@ -34,6 +35,119 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief flash 操作类型。
+ */
+typedef enum _xf_fal_op_t {
+    XF_FAL_OP_READ = 0,                 /*!< 读 */
+    XF_FAL_OP_WRITE,                    /*!< 写 */
+    XF_FAL_OP_ERASE,                    /*!< 擦除 */
+    XF_FAL_OP_MAX,
+} xf_fal_op_t;
+
+/**
+ * @brief 分散/聚集读写的数据段描述，含义同 POSIX struct iovec.
+ */
+typedef struct _xf_fal_iovec_t {
+    void       *base;                   /*!< 数据段起始地址 */
+    size_t      len;                    /*!< 数据段长度，单位：字节 */
+} xf_fal_iovec_t;
+
+/**
+ * @brief 擦除选项，用于 xf_fal_partition_erase_ex().
+ */
+typedef enum _xf_fal_erase_flag_t {
+    XF_FAL_ERASE_FLAG_NONE          = 0,
+    /**
+     * @brief 逐扇区检查，已是擦除状态（全 0xFF）的扇区跳过不擦。
+     */
+    XF_FAL_ERASE_FLAG_SKIP_BLANK    = (1u << 0),
+} xf_fal_erase_flag_t;
+
+/**
+ * @brief 擦除结果统计，单位：扇区。
+ *
+ * 设备 sector_size 为 0 时整个擦除范围计为 1 个扇区。
+ */
+typedef struct _xf_fal_erase_result_t {
+    size_t erased_num;                  /*!< 实际擦除的扇区数 */
+    size_t skipped_num;                 /*!< 已是擦除状态而跳过的扇区数 */
+} xf_fal_erase_result_t;
+
+/**
+ * @brief 按需更新结果统计，见 xf_fal_partition_update().
+ *
+ * 页指 min(页大小, XF_FAL_PAGE_BUF_SIZE) 对齐的块。
+ */
+typedef struct _xf_fal_update_result_t {
+    size_t skipped_page_num;            /*!< 内容未变而跳过的页数 */
+    size_t programmed_page_num;         /*!< 编程的页数（含擦除后重新编程的页） */
+    size_t erased_sector_num;           /*!< 因需要 0 变 1 而擦除的扇区数 */
+} xf_fal_update_result_t;
+
+/**
+ * @brief CRC-32 计算实现，见 xf_fal_crc32_ex().
+ */
+typedef enum _xf_fal_crc32_impl_t {
+    XF_FAL_CRC32_IMPL_AUTO = 0,         /*!< 自动选择可用的最快实现 */
+    XF_FAL_CRC32_IMPL_NIBBLE,           /*!< 半字节查表，表只占 64 字节 */
+    XF_FAL_CRC32_IMPL_SLICE8,           /*!< slice-by-8 查表，需 XF_FAL_CRC32_SLICE_BY_8 */
+    XF_FAL_CRC32_IMPL_ACCEL,            /*!< CPU 指令加速 (x86 PCLMULQDQ / ARMv8 CRC32) */
+    XF_FAL_CRC32_IMPL_MAX,
+} xf_fal_crc32_impl_t;
+
+/**
+ * @brief 哈希更新回调，见 xf_fal_partition_hash().
+ *
+ * 通常对接为哈希库的 update 函数（如 SHA-256）。
+ *
+ * @param user_data  用户数据，通常为哈希上下文。
+ * @param data       本次读出的数据。
+ * @param size       数据大小，单位：字节。
+ * @return xf_err_t
+ *      - XF_OK                 继续
+ *      - (OTHER)               中止，xf_fal_partition_hash() 返回此值
+ */
+typedef xf_err_t (*xf_fal_hash_update_cb_t)(void *user_data, const void *data, size_t size);
+
+/**
+ * @brief 统计和跟踪用时钟，返回单调递增的时间戳。
+ *
+ * 单位由对接层决定（推荐 us），耗时按无符号差值计算，允许回绕。
+ */
+typedef uint32_t (*xf_fal_stat_clock_t)(void);
+
+/**
+ * @brief 一种操作（读/写/擦除）的统计。
+ */
+typedef struct _xf_fal_stat_op_t {
+    size_t cnt;                         /*!< 调用次数 */
+    size_t err_cnt;                     /*!< 失败次数 */
+    size_t bytes;                       /*!< 字节数 */
+    size_t time_sum;                    /*!< 总耗时，单位同时钟。未设置时钟时为 0 */
+    size_t hist[XF_FAL_STAT_HIST_NUM];  /*!< 耗时直方图，见 XF_FAL_STAT_HIST_NUM */
+} xf_fal_stat_op_t;
+
+/**
+ * @brief 分区或 flash 设备的统计，按 @ref xf_fal_op_t 分类。
+ *
+ * 分区统计的是 xf_fal_handle_read() 等接口的调用；
+ * flash 设备统计的是 xf_fal_flash_ops_t 的 read/write/erase (含 readv/writev) 调用。
+ */
+typedef struct _xf_fal_stat_t {
+    xf_fal_stat_op_t op[XF_FAL_OP_MAX];
+} xf_fal_stat_t;
+
+/**
+ * @brief 跟踪数据的输出回调，见 xf_fal_trace_dump().
+ *
+ * @param user_data 用户数据。
+ * @param data      数据。
+ * @param size      大小，单位：字节。
+ * @return xf_err_t 非 XF_OK 时停止输出。
+ */
+typedef xf_err_t (*xf_fal_trace_write_cb_t)(void *user_data, const void *data, size_t size);
+
 /**
  * @brief flash 操作集。
  *
@@ -75,7 +189,10 @@ typedef struct _xf_fal_flash_ops_t {
      * @brief 写数据到 flash 的指定偏移地址。
      *
      * @note xf_fal 只保证写入大小不超过分区长度。
-     *       对于跨页的写入，接口需要自行处理。
+     * @note 启用 XF_FAL_WRITE_SPLIT_ENABLE 时（默认启用），
+     *       xf_fal 保证单次写入不跨页，且 dst_offset 和 size
+     *       按 xf_fal_flash_dev_t.io_size 对齐，接口可以直接整页编程；
+     *       否则对于跨页的写入，接口需要自行处理。
      * @attention xf_fal 对于传入的 dst_offset, @b 不 加上 flash 的起始地址。
      *            对接层需要自行加上 xf_fal_flash_dev_t.addr .
      *
@@ -94,6 +211,10 @@ typedef struct _xf_fal_flash_ops_t {
     /**
      * @brief 擦除 flash 的指定偏移地址指定长度。
      *
+     * @note sector_size 不为 0 时，xf_fal 保证 offset 和 size 对齐到扇区；
+     *       设置了 xf_fal_flash_dev_t.erase_size_table 时，
+     *       size 为表中某一项且 offset 按 size 对齐。
+     *
      * @param offset     待擦除的地址。
      *                   已在 xf_fal 内加上分区的偏移地址。
      * @param size       需要擦除的大小，单位：字节。
@@ -103,6 +224,87 @@ typedef struct _xf_fal_flash_ops_t {
      *      - XF_FAIL               失败，其他情况
      */
     xf_err_t (*erase)(size_t offset, size_t size);
+    /**
+     * @brief 分散读（可选）。
+     *
+     * 从 src_offset 开始连续读取数据，依次填入 iov 描述的各数据段。
+     * 未实现时 xf_fal 对每个数据段分别调用 read.
+     *
+     * @param src_offset 要读取的数据的地址，含义同 read.
+     * @param iov        数据段数组。已在 xf_fal 内跳过长度为 0 的数据段。
+     * @param iovcnt     数据段个数。
+     * @return xf_err_t
+     *      - XF_OK                 成功
+     *      - XF_FAIL               失败
+     */
+    xf_err_t (*readv)(size_t src_offset, const xf_fal_iovec_t *iov, size_t iovcnt);
+    /**
+     * @brief 聚集写（可选）。
+     *
+     * 将 iov 描述的各数据段依次连续写入 dst_offset 开始的地址。
+     * 未实现时 xf_fal 按页合并数据段后调用 write.
+     *
+     * @param dst_offset 待写入数据的目标地址，含义同 write.
+     * @param iov        数据段数组。
+     * @param iovcnt     数据段个数。
+     * @return xf_err_t
+     *      - XF_OK                 成功
+     *      - XF_FAIL               失败
+     */
+    xf_err_t (*writev)(size_t dst_offset, const xf_fal_iovec_t *iov, size_t iovcnt);
+    /**
+     * @brief 检查指定范围是否为擦除状态（可选）。
+     *
+     * 用于 XF_FAL_ERASE_FLAG_SKIP_BLANK. 硬件支持空白检查指令，
+     * 或可以直接映射访问时实现此接口比读出再比较更快。
+     * 未实现时 xf_fal 分块读出后检查是否全为 0xFF.
+     *
+     * @param offset     flash 上的偏移地址，含义同 erase. 已对齐到扇区。
+     * @param size       检查的大小，单位：字节。通常为一个扇区。
+     * @param[out] p_is_blank 是否全部为擦除状态。
+     * @return xf_err_t
+     *      - XF_OK                 成功
+     *      - XF_FAIL               失败
+     */
+    xf_err_t (*blank_check)(size_t offset, size_t size, bool *p_is_blank);
+    /**
+     * @brief 启动一次异步读写擦（可选）。
+     *
+     * 用于可以在中断或 DMA 中完成操作的硬件，仅由 xf_fal_async 使用。
+     * 未实现时 xf_fal_async 在工作线程中调用同步的 read/write/erase.
+     *
+     * @note 返回 XF_OK 后，操作完成时（可以在中断中）
+     *       必须调用 xf_fal_async_done(token, result) 通知 xf_fal.
+     *       同一设备上一次异步操作完成前，xf_fal 不会启动下一次。
+     *
+     * @param op         操作类型，见 @ref xf_fal_op_t .
+     * @param offset     flash 上的偏移地址，含义同 read/write/erase.
+     * @param buf        读操作的目标缓冲区或写操作的数据来源，擦除时为 NULL.
+     * @param size       操作大小，单位：字节。
+     *                   xf_fal 不拆分异步请求：擦除范围已对齐到扇区，
+     *                   但不按 erase_size_table 拆分；写入不按页拆分。
+     * @param token      完成时原样传给 xf_fal_async_done().
+     * @return xf_err_t
+     *      - XF_OK                 已启动
+     *      - (OTHER)               启动失败，xf_fal 直接以此结果完成请求
+     */
+    xf_err_t (*async_start)(xf_fal_op_t op, size_t offset,
+                            void *buf, size_t size, void *token);
+    /**
+     * @brief 计算指定范围的 CRC-32（可选）。
+     *
+     * 用于带 CRC 计算引擎的 flash 控制器，仅由 xf_fal_partition_crc32() 使用。
+     * 未实现时 xf_fal 分块读出后由 CPU 计算。
+     *
+     * @param offset     flash 上的偏移地址，含义同 read.
+     * @param size       计算的大小，单位：字节。
+     * @param crc        之前数据的 CRC-32，首次为 0. 语义同 xf_fal_crc32().
+     * @param[out] p_crc 包含本范围数据后的 CRC-32 (IEEE 802.3).
+     * @return xf_err_t
+     *      - XF_OK                 成功
+     *      - XF_FAIL               失败
+     */
+    xf_err_t (*crc32)(size_t offset, size_t size, uint32_t crc, uint32_t *p_crc);
 } xf_fal_flash_ops_t;
 
 /**
@@ -131,7 +333,7 @@ typedef struct _xf_fal_flash_dev_t {
     size_t      sector_size;
     /**
      * @brief 页大小。页大小是单次写入时无需等待的最大大小。单位: byte.
-     * 通常为 256 字节。
+     * 通常为 256 字节。为 0 时 xf_fal 不按页拆分写入。
      */
     size_t      page_size;
     /**
@@ -143,6 +345,16 @@ typedef struct _xf_fal_flash_dev_t {
      * @brief flash 操作集，见 @ref xf_fal_flash_ops_t .
      */
     xf_fal_flash_ops_t  ops;
+    /**
+     * @brief 擦除粒度表（可选），单位: byte. 如 {4K, 32K, 64K}.
+     *
+     * 每项必须是 sector_size 的整数倍，顺序不限。
+     * 设置后 xf_fal 将擦除范围拆分为若干次按粒度对齐的 ops.erase,
+     * 优先使用大粒度，驱动可以根据 size 选择块擦除或整片擦除指令；
+     * 为 NULL 时已按扇区对齐的整个范围一次交给 ops.erase.
+     */
+    const size_t       *erase_size_table;
+    size_t              erase_size_num;     /*!< erase_size_table 的项数 */
 } xf_fal_flash_dev_t;
 
 /**
@@ -173,6 +385,27 @@ typedef struct _xf_fal_partition_t {
     size_t  len;
 } xf_fal_partition_t;
 
+/**
+ * @brief 已解析的分区句柄。
+ *
+ * 由 xf_fal_partition_get_handle() 填充，预先解析了分区关联的 flash 设备
+ * 和分区在 flash 设备上的起始偏移，
+ * 通过 xf_fal_handle_read() 等接口读写时无需加锁和查找。
+ *
+ * @attention 结构体是可见的，但禁止用户修改其中内容。
+ * @attention 注销分区表或 flash 设备后句柄失效，需要重新获取。
+ */
+typedef struct _xf_fal_handle_t {
+    const xf_fal_partition_t   *partition;  /*!< 分区 */
+    const xf_fal_flash_dev_t   *flash_dev;  /*!< 分区关联的 flash 设备 */
+    size_t                      dev_idx;    /*!< flash 设备的注册下标，用于设备锁 */
+    size_t                      base;       /*!< 分区在 flash 设备上的起始偏移 */
+    size_t                      len;        /*!< 分区长度 */
+#if XF_FAL_TRACE_ENABLE
+    uint16_t                    part_id;    /*!< 跟踪记录中的分区 id, 见 xf_fal_trace_rec_t.part_id */
+#endif
+} xf_fal_handle_t;
+
 /**
  * End of addtogroup group_xf_fal
  * @}
@@ -197,28 +430,24 @@ typedef struct _xf_fal_cache_t {
      * @brief 分区对应的 flash 设备对象。
      */
     const xf_fal_flash_dev_t   *flash_dev;
-} xf_fal_cache_t;
-
-/**
- * @brief xf_fal 对象上下文结构体。
- */
-typedef struct _xf_fal_ctx_t {
     /**
-     * @brief 用于判断 xf_fal 是否已初始化。
+     * @brief flash 设备在 xf_fal_snapshot_t.flash_device_table 中的下标。
      */
-    volatile uint8_t            is_init;
-
-#if XF_FAL_LOCK_IS_ENABLE
-    /**
-     * @brief 互斥锁失效时的临时手段。
-     */
-    volatile uint8_t            is_lock;
+    size_t                      dev_idx;
     /**
-     * @brief 保护 xf_fal_ctx_t 的互斥锁。
+     * @brief 分区名的哈希值，见 xf_fal_snapshot_t.hash_index .
      */
-    xf_lock_t                   mutex;
-#endif
+    uint32_t                    name_hash;
+} xf_fal_cache_t;
 
+/**
+ * @brief xf_fal 注册表快照。
+ *
+ * 包含注册的 flash 设备表、分区表以及由其生成的缓存和索引。
+ * 已发布的快照不再修改，注册、注销和更新缓存时在另一份快照上修改后整体切换，
+ * 查找接口因此无需加锁。见 xf_fal_ctx_t.p_snapshot .
+ */
+typedef struct _xf_fal_snapshot_t {
     /**
      * @brief flash 设备表（数组）指针。
      *
@@ -232,16 +461,16 @@ typedef struct _xf_fal_ctx_t {
     /**
      * @brief 分区表（数组）的数组。
      * @code
-     * xf_fal_ctx_t.partition_table[IDX]     --> xf_fal_partition_t partition_table[N]
-     * // xf_fal_ctx_t.partition_table 内的每个元素指向含有 N 个分区的分区表.
+     * xf_fal_snapshot_t.partition_table[IDX]     --> xf_fal_partition_t partition_table[N]
+     * // xf_fal_snapshot_t.partition_table 内的每个元素指向含有 N 个分区的分区表.
      * @endcode
      */
     const xf_fal_partition_t   *partition_table[XF_FAL_PARTITION_TABLE_NUM];
     /**
      * @brief 分区表（数组）表长（分区表内所有分区的总个数）数组。
      * @code
-     * xf_fal_ctx_t.partition_table[IDX]     --> xf_fal_partition_t partition_table[N]
-     * xf_fal_ctx_t.partition_table_len[IDX] --> N
+     * xf_fal_snapshot_t.partition_table[IDX]     --> xf_fal_partition_t partition_table[N]
+     * xf_fal_snapshot_t.partition_table_len[IDX] --> N
      * @endcode
      */
     size_t                      partition_table_len[XF_FAL_PARTITION_TABLE_NUM];
@@ -258,7 +487,216 @@ typedef struct _xf_fal_ctx_t {
     /**
      * @brief 已缓存的个数。
      */
-    volatile size_t             cached_num;
+    size_t                      cached_num;
+    /**
+     * @brief 更新缓存时遍历到的分区总数。
+     *
+     * 与 cached_num 不等时说明有分区未进入缓存（缓存不足或未找到 flash 设备），
+     * 此时哈希索引未命中需要回退到遍历分区表。
+     */
+    size_t                      part_num;
+    /**
+     * @brief 缓存建立后又注册或注销了分区表或 flash 设备。
+     *
+     * 此时缓存和哈希索引不再可信，查找时回退到遍历，
+     * 直到再次调用 xf_fal_check_and_update_cache().
+     */
+    uint8_t                     is_stale;
+    /**
+     * @brief 分区名哈希索引（开放寻址，线性探测）。
+     *
+     * 由 xf_fal_check_and_update_cache() 构建。
+     * 值为 cache 下标加 1, 0 表示空槽。
+     */
+    uint16_t                    hash_index[XF_FAL_HASH_INDEX_NUM];
+} xf_fal_snapshot_t;
+
+#if XF_FAL_WRITE_BUFFER_ENABLE
+typedef struct _xf_fal_write_buffer_t xf_fal_write_buffer_t;
+
+/**
+ * @brief 分区写缓冲。
+ *
+ * 由用户分配（通常为静态变量），通过 xf_fal_write_buffer_attach() 挂接到分区，
+ * 挂接期间必须保持有效，成员由 xf_fal 维护，用户不应访问。
+ */
+struct _xf_fal_write_buffer_t {
+    xf_fal_handle_t             handle;     /*!< 挂接的分区 */
+    size_t                      page_size;  /*!< 合并边界 */
+    size_t                      addr;       /*!< 待写入数据在 flash 设备上的起始偏移 */
+    size_t                      len;        /*!< 待写入数据长度，0 表示空 */
+    xf_fal_write_buffer_t      *next;       /*!< 同一 flash 设备上的写缓冲链表 */
+    uint8_t                     data[XF_FAL_WRITE_BUFFER_SIZE];
+};
+#endif
+
+/**
+ * @brief 读缓存命中统计，单位：缓存行访问次数。
+ */
+typedef struct _xf_fal_read_cache_stat_t {
+    size_t hit_cnt;                     /*!< 命中 */
+    size_t miss_cnt;                    /*!< 未命中，从 flash 读入整行 */
+    size_t bypass_cnt;                  /*!< 未经过缓存直接读 flash 的读取次数（含未命中但不读入整行） */
+} xf_fal_read_cache_stat_t;
+
+#if XF_FAL_READ_CACHE_NUM > 0
+/**
+ * @brief 读缓存行。
+ */
+typedef struct _xf_fal_read_cache_line_t {
+    uint32_t                    stamp;      /*!< 最近访问时间，用于 LRU. 0 表示无效 */
+    uint32_t                    dev_idx;    /*!< flash 设备的注册下标 */
+    size_t                      addr;       /*!< 行在 flash 设备上的起始偏移 */
+    uint8_t                     is_filling; /*!< 正在不持读缓存锁地从 flash 读入 */
+    uint8_t                     is_stale;   /*!< 读入期间被失效，读入的数据不可用 */
+    uint8_t                     data[XF_FAL_READ_CACHE_LINE_SIZE];
+} xf_fal_read_cache_line_t;
+
+/**
+ * @brief 最近未命中而未读入的行，再次未命中时才读入整行。
+ */
+typedef struct _xf_fal_read_cache_ghost_t {
+    uint32_t                    dev_idx;    /*!< flash 设备的注册下标 */
+    size_t                      addr;       /*!< 行在 flash 设备上的起始偏移 */
+} xf_fal_read_cache_ghost_t;
+
+/**
+ * @brief 读缓存。
+ */
+typedef struct _xf_fal_read_cache_t {
+    uint32_t                    clock;      /*!< 访问计数，作为 LRU 时间戳 */
+    /**
+     * @brief 近期命中率，定点数，1024 表示 100%.
+     *
+     * 低于小块读取读入整行的收益点时，未命中的行先记入 ghost, 再次未命中才读入。
+     */
+    uint32_t                    hit_avg;
+    uint32_t                    ghost_pos;  /*!< ghost 的下一个写入位置 */
+    xf_fal_read_cache_stat_t    stat;
+    xf_fal_read_cache_ghost_t   ghost[XF_FAL_READ_CACHE_NUM];
+    xf_fal_read_cache_line_t    line[XF_FAL_READ_CACHE_NUM];
+} xf_fal_read_cache_t;
+#endif
+
+/**
+ * @brief xf_fal 对象上下文结构体。
+ */
+typedef struct _xf_fal_ctx_t {
+    /**
+     * @brief 用于判断 xf_fal 是否已初始化。
+     */
+    volatile uint8_t            is_init;
+
+#if XF_FAL_LOCK_IS_ENABLE
+    /**
+     * @brief 互斥锁失效时的临时手段。
+     */
+    volatile uint8_t            is_lock;
+    /**
+     * @brief 保护 xf_fal_ctx_t 的互斥锁。
+     *
+     * 只用于串行化注册、注销和更新缓存，查找接口不加锁。
+     */
+    xf_lock_t                   mutex;
+    /**
+     * @brief 每个 flash 设备的互斥锁，与 flash_device_table 下标对应。
+     *
+     * 串行化同一 flash 设备上的读写擦操作，不同设备之间互不阻塞。
+     * 在首次向该下标注册设备时创建，注销设备后保留给后续注册复用。
+     */
+    xf_lock_t                   dev_mutex[XF_FAL_FLASH_DEVICE_NUM];
+#if XF_FAL_READ_CACHE_NUM > 0
+    /**
+     * @brief 保护读缓存的互斥锁。
+     *
+     * 所有设备共用读缓存，加锁顺序为先设备锁后读缓存锁。
+     * 只保护查找和替换，未命中时不持此锁读 flash, 不阻塞其他设备的命中。
+     */
+    xf_lock_t                   rcache_mutex;
+#endif
+    /**
+     * @brief 保护分区间复制的缓冲区，加锁顺序为先此锁后设备锁。
+     */
+    xf_lock_t                   copy_mutex;
+#if XF_FAL_UPDATE_SECTOR_BUF_SIZE > 0
+    /**
+     * @brief 保护按需更新的扇区缓冲区，加锁顺序为先设备锁后此锁。
+     */
+    xf_lock_t                   update_mutex;
+#endif
+#endif
+
+#if XF_FAL_WRITE_BUFFER_ENABLE
+    /**
+     * @brief 各 flash 设备上挂接的写缓冲链表，由对应的设备锁保护。
+     */
+    xf_fal_write_buffer_t      *wbuf_list[XF_FAL_FLASH_DEVICE_NUM];
+#endif
+
+#if XF_FAL_ASYNC_ENABLE
+    /**
+     * @brief 各 flash 设备上是否有经 async_start 启动、尚未完成的操作。
+     *
+     * 异步操作从启动到 xf_fal_async_done() 期间逻辑上占有设备锁。
+     * 互斥锁不能跨线程或在中断中释放，因此用此标志代替：
+     * 取得设备锁后若标志置位，则持有设备锁等待其清零。
+     * 清零标志的 xf_fal_async_op_end() 不需要设备锁，因此不会死锁。
+     */
+    volatile uint8_t            dev_async_busy[XF_FAL_FLASH_DEVICE_NUM];
+#endif
+
+#if XF_FAL_READ_CACHE_NUM > 0
+    /**
+     * @brief 扇区读缓存，见 XF_FAL_READ_CACHE_NUM.
+     */
+    xf_fal_read_cache_t         rcache;
+#endif
+
+#if XF_FAL_STAT_ENABLE
+    /**
+     * @brief 统计用时钟，NULL 时不统计耗时。
+     */
+    xf_fal_stat_clock_t         stat_clock;
+    /**
+     * @brief 各 flash 设备的驱动调用统计，下标同 flash_device_table.
+     */
+    xf_fal_stat_t               stat_dev[XF_FAL_FLASH_DEVICE_NUM];
+    /**
+     * @brief 分区统计槽的键（开放寻址，线性探测），NULL 表示空槽。
+     *
+     * 更新缓存时在写者锁内插入，此后只读，读写路径查找无需加锁。
+     */
+    const xf_fal_partition_t   *stat_part_key[XF_FAL_STAT_PART_NUM];
+    xf_fal_stat_t               stat_part[XF_FAL_STAT_PART_NUM];
+#endif
+
+#if XF_FAL_TRACE_ENABLE
+    /**
+     * @brief 跟踪用时钟，NULL 时时间戳和耗时为 0.
+     */
+    xf_fal_stat_clock_t         trace_clock;
+    /**
+     * @brief 已占用的跟踪记录总数，原子递增，取模后为下一条记录的下标。
+     */
+    uint32_t                    trace_head;
+    xf_fal_trace_rec_t          trace_ring[XF_FAL_TRACE_NUM];
+#endif
+
+    /**
+     * @brief 快照序号。
+     *
+     * 开始修改未发布的快照时加 1 (变为奇数)，发布或放弃后再加 1.
+     * 查找前后序号不变说明查找期间读到的快照未被修改。
+     */
+    volatile uint32_t           seq;
+    /**
+     * @brief 当前发布的快照，指向 snapshot[0] 或 snapshot[1].
+     */
+    xf_fal_snapshot_t *volatile p_snapshot;
+    /**
+     * @brief 双缓冲快照。
+     */
+    xf_fal_snapshot_t           snapshot[2];
 } xf_fal_ctx_t;
 
 /**
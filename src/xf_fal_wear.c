@@ -0,0 +1,1027 @@
+/**
+ * @file xf_fal_wear.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 扇区擦除次数（磨损）统计。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_wear.h"
+
+#if XF_FAL_WEAR_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_wear"
+
+/*
+ * 元数据分区格式（所有多字节字段为小端）：
+ *
+ * 块 = 元数据分区的一个扇区，开头为块头 {magic u32, seq u32, crc32 u32},
+ * 之后依次追加记录，每条记录按 io_size 对齐，空白（0xFF）处为日志末尾：
+ *     {type u8, ~type u8, len u16, payload[len], crc32 u32}
+ *
+ * - SNAP:     {设备 id u32, 起始扇区 varint, token...}
+ *             token 为 varint: 最低位为 1 时表示与前一扇区相同的次数重复 (token >> 1) 个扇区，
+ *             否则表示一个扇区，次数 = 前一扇区次数 + zigzag 解码 (token >> 1).
+ * - SNAP_END: 快照结束，之前的 SNAP 记录组成全部计数，块至此才有效。
+ * - DELTA:    {设备 id u32, (扇区间隔 varint, 增量 varint)...}
+ *
+ * 设备 id 为 flash 设备名的 CRC-32, 因此设备注册顺序变化不影响加载。
+ */
+#define XF_FAL_WEAR_BLOCK_MAGIC         0x4C574658u     /*!< "XFWL" */
+#define XF_FAL_WEAR_HDR_SIZE            12
+#define XF_FAL_WEAR_REC_SNAP            0x01
+#define XF_FAL_WEAR_REC_DELTA           0x02
+#define XF_FAL_WEAR_REC_SNAP_END        0x03
+#define XF_FAL_WEAR_REC_OVERHEAD        8               /*!< 记录头 4 + CRC 4 */
+#define XF_FAL_WEAR_VARINT_MAX          5
+#define XF_FAL_WEAR_ALIGN_MAX           16
+#define XF_FAL_WEAR_CNT_MAX             0x3FFFFFFFu     /*!< 保证 zigzag 后的 token 不溢出 */
+#define XF_FAL_WEAR_PENDING_MAX         0xFFFFu
+#define XF_FAL_WEAR_SHOW_WIDTH_MAX      128
+#define XF_FAL_WEAR_SHOW_ROW_MAX        32
+
+#if XF_FAL_WEAR_BUF_SIZE < (XF_FAL_WEAR_REC_OVERHEAD + XF_FAL_WEAR_ALIGN_MAX + 4 + 4 * XF_FAL_WEAR_VARINT_MAX)
+#   error "XF_FAL_WEAR_BUF_SIZE too small."
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 统计擦除次数的 flash 设备。
+ */
+typedef struct _xf_fal_wear_dev_t {
+    const xf_fal_flash_dev_t   *flash_dev;
+    uint32_t                    id;         /*!< flash 设备名的 CRC-32 */
+    size_t                      base;       /*!< 第 0 个扇区在 cnt/pending 中的下标 */
+    size_t                      sector_num; /*!< 0 表示计数空间不足，不统计 */
+} xf_fal_wear_dev_t;
+
+/**
+ * @brief 擦除次数统计上下文。
+ */
+typedef struct _xf_fal_wear_ctx_t {
+    volatile uint8_t            is_init;
+    volatile uint8_t            is_syncing;
+    uint8_t                     need_snapshot;  /*!< 下次持久化时换块并重写快照 */
+    xf_lock_t                   mutex;          /*!< 保护设备表和计数 */
+    xf_fal_wear_dev_t           dev[XF_FAL_FLASH_DEVICE_NUM];
+    size_t                      dev_num;
+    size_t                      slot_num;       /*!< 已分配的计数个数 */
+    size_t                      pending_total;  /*!< 未持久化的擦除次数之和 */
+
+    /* 元数据日志，只在持久化（is_syncing）或初始化时访问 */
+    xf_fal_handle_t             meta;
+    size_t                      block_size;
+    size_t                      block_num;
+    size_t                      block_idx;      /*!< 当前块 */
+    size_t                      write_off;      /*!< 当前块内下一条记录的偏移 */
+    size_t                      align;          /*!< 记录对齐，即 io_size */
+    uint32_t                    seq;            /*!< 当前块的序号 */
+
+    uint32_t                    cnt[XF_FAL_WEAR_SECTOR_NUM];        /*!< 擦除次数 */
+    uint16_t                    pending[XF_FAL_WEAR_SECTOR_NUM];    /*!< 未持久化的擦除次数 */
+    uint8_t                     buf[XF_FAL_WEAR_BUF_SIZE];
+} xf_fal_wear_ctx_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_fal_wear_dev_t *xf_fal_wear_dev_add(const xf_fal_flash_dev_t *flash_dev);
+static xf_fal_wear_dev_t *xf_fal_wear_dev_find(const xf_fal_flash_dev_t *flash_dev);
+static xf_fal_wear_dev_t *xf_fal_wear_dev_find_id(uint32_t id);
+static size_t xf_fal_wear_put_varint(uint8_t *p, uint32_t v);
+static bool xf_fal_wear_get_varint(const uint8_t **pp, const uint8_t *end, uint32_t *p_v);
+static void xf_fal_wear_put_u32(uint8_t *p, uint32_t v);
+static uint32_t xf_fal_wear_get_u32(const uint8_t *p);
+static size_t xf_fal_wear_align(size_t size);
+static size_t xf_fal_wear_payload_cap(size_t off);
+static void xf_fal_wear_clear_pending(size_t slot);
+static size_t xf_fal_wear_encode_snap(
+    const xf_fal_wear_dev_t *dev, size_t *p_sector, uint8_t *payload, size_t cap);
+static size_t xf_fal_wear_encode_delta(uint8_t *payload, size_t cap);
+static xf_err_t xf_fal_wear_write_record(size_t block_off, size_t *p_off, uint8_t type, size_t len);
+static xf_err_t xf_fal_wear_switch_block(void);
+static xf_err_t xf_fal_wear_flush(void);
+static void xf_fal_wear_add_cnt(const xf_fal_wear_dev_t *dev, size_t sector, uint32_t v);
+static void xf_fal_wear_apply(uint8_t type, const uint8_t *payload, size_t len);
+static xf_err_t xf_fal_wear_parse(
+    size_t block, bool is_apply, size_t *p_end, bool *p_is_clean, bool *p_is_complete);
+static xf_err_t xf_fal_wear_load(void);
+static char *xf_fal_wear_fmt_u32(char *p, uint32_t v, bool is_hex);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_fal_wear_ctx_t s_wear_ctx = {0};
+#define sp_wear()       (&s_wear_ctx)
+
+/* ==================== [Macros] ============================================ */
+
+#define XF_FAL_WEAR_LOCK() \
+    do { \
+        if (sp_wear()->mutex) { \
+            xf_lock_lock(sp_wear()->mutex); \
+        } \
+    } while (0)
+
+#define XF_FAL_WEAR_UNLOCK() \
+    do { \
+        if (sp_wear()->mutex) { \
+            xf_lock_unlock(sp_wear()->mutex); \
+        } \
+    } while (0)
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_fal_wear_init(const xf_fal_partition_t *meta_part)
+{
+    xf_err_t xf_ret;
+    xf_err_t xf_ret_alloc = XF_OK;
+    const xf_fal_snapshot_t *snap;
+    xf_fal_handle_t meta;
+    size_t sector_size;
+    size_t align;
+
+    if (sp_wear()->is_init) {
+        return XF_ERR_INITED;
+    }
+    if (NULL == meta_part) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_ret = xf_fal_partition_get_handle(meta_part, &meta);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    sector_size = meta.flash_dev->sector_size;
+    align       = (meta.flash_dev->io_size) ? meta.flash_dev->io_size : 1;
+    if ((0 == sector_size) || (meta.base % sector_size) || (meta.len / sector_size < 2)
+            || (align > XF_FAL_WEAR_ALIGN_MAX)
+            || (sector_size < XF_FAL_WEAR_HDR_SIZE + XF_FAL_WEAR_ALIGN_MAX + XF_FAL_WEAR_BUF_SIZE)) {
+        XF_LOGE(TAG, "Partition(%s) can NOT be used as wear metadata.", meta_part->name);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    if (NULL == sp_wear()->mutex) {
+        xf_lock_init(&sp_wear()->mutex);
+    }
+    sp_wear()->need_snapshot    = false;
+    sp_wear()->dev_num          = 0;
+    sp_wear()->slot_num         = 0;
+    sp_wear()->pending_total    = 0;
+    sp_wear()->meta             = meta;
+    sp_wear()->block_size       = sector_size;
+    sp_wear()->block_num        = meta.len / sector_size;
+    sp_wear()->align            = align;
+    memset(sp_wear()->cnt, 0, sizeof(sp_wear()->cnt));
+    memset(sp_wear()->pending, 0, sizeof(sp_wear()->pending));
+
+    snap = xf_fal_get_ctx()->p_snapshot;
+    for (size_t i = 0; i < XF_FAL_FLASH_DEVICE_NUM; i++) {
+        if ((snap->flash_device_table[i])
+                && (NULL == xf_fal_wear_dev_find(snap->flash_device_table[i]))) {
+            if (0 == xf_fal_wear_dev_add(snap->flash_device_table[i])->sector_num) {
+                xf_ret_alloc = XF_ERR_NO_MEM;
+            }
+        }
+    }
+
+    xf_ret = xf_fal_wear_load();
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    sp_wear()->is_init = true;
+
+    return xf_ret_alloc;
+}
+
+xf_err_t xf_fal_wear_deinit(void)
+{
+    xf_err_t xf_ret = XF_OK;
+
+    if (!sp_wear()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+
+    XF_FAL_WEAR_LOCK();
+    if (sp_wear()->is_syncing) {
+        xf_ret = XF_ERR_BUSY;
+    } else {
+        sp_wear()->is_init = false;
+    }
+    XF_FAL_WEAR_UNLOCK();
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_wear_sync(void)
+{
+    xf_err_t xf_ret;
+
+    if (!sp_wear()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+
+    XF_FAL_WEAR_LOCK();
+    if (sp_wear()->is_syncing) {
+        XF_FAL_WEAR_UNLOCK();
+        return XF_ERR_BUSY;
+    }
+    sp_wear()->is_syncing = true;
+    XF_FAL_WEAR_UNLOCK();
+
+    xf_ret = xf_fal_wear_flush();
+
+    XF_FAL_WEAR_LOCK();
+    if (xf_ret != XF_OK) {
+        /* 已清零的增量没有写入，只能靠新的快照补上 */
+        sp_wear()->need_snapshot = true;
+        XF_LOGE(TAG, "Wear sync failed(%d).", (int)xf_ret);
+    }
+    sp_wear()->is_syncing = false;
+    XF_FAL_WEAR_UNLOCK();
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_wear_get_count(
+    const xf_fal_flash_dev_t *flash_dev, size_t sector, uint32_t *p_cnt)
+{
+    const xf_fal_wear_dev_t *dev;
+
+    if (!sp_wear()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if ((NULL == flash_dev) || (NULL == p_cnt)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    dev = xf_fal_wear_dev_find(flash_dev);
+    if ((NULL == dev) || (0 == dev->sector_num)) {
+        return XF_ERR_NOT_FOUND;
+    }
+    if (sector >= dev->sector_num) {
+        return XF_ERR_INVALID_ARG;
+    }
+    *p_cnt = sp_wear()->cnt[dev->base + sector];
+
+    return XF_OK;
+}
+
+size_t xf_fal_wear_get_hot(xf_fal_wear_hot_t *p_hot, size_t num)
+{
+    const xf_fal_wear_dev_t *dev;
+    uint32_t cnt;
+    size_t hot_num = 0;
+    size_t k;
+
+    if ((!sp_wear()->is_init) || (NULL == p_hot) || (0 == num)) {
+        return 0;
+    }
+
+    XF_FAL_WEAR_LOCK();
+    for (size_t d = 0; d < sp_wear()->dev_num; d++) {
+        dev = &sp_wear()->dev[d];
+        for (size_t i = 0; i < dev->sector_num; i++) {
+            cnt = sp_wear()->cnt[dev->base + i];
+            if ((0 == cnt) || ((hot_num == num) && (cnt <= p_hot[num - 1].erase_cnt))) {
+                continue;
+            }
+            /* 插入排序，满时挤掉最后一个 */
+            k = (hot_num < num) ? hot_num++ : (num - 1);
+            for (; (k > 0) && (p_hot[k - 1].erase_cnt < cnt); k--) {
+                p_hot[k] = p_hot[k - 1];
+            }
+            p_hot[k].flash_dev  = dev->flash_dev;
+            p_hot[k].sector     = i;
+            p_hot[k].erase_cnt  = cnt;
+        }
+    }
+    XF_FAL_WEAR_UNLOCK();
+
+    return hot_num;
+}
+
+xf_err_t xf_fal_wear_dump(xf_fal_wear_write_cb_t write, void *user_data)
+{
+    static const char header[] = "flash_dev,sector,addr,erase_cnt\n";
+    xf_err_t xf_ret;
+    const xf_fal_wear_dev_t *dev;
+    char line[XF_FAL_DEV_NAME_MAX + 40];
+    char *p;
+    size_t len;
+
+    if (!sp_wear()->is_init) {
+        return XF_ERR_UNINIT;
+    }
+    if (NULL == write) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    xf_ret = write(user_data, header, sizeof(header) - 1);
+    for (size_t d = 0; (XF_OK == xf_ret) && (d < sp_wear()->dev_num); d++) {
+        dev = &sp_wear()->dev[d];
+        len = xf_strlen(dev->flash_dev->name);
+        if (len > XF_FAL_DEV_NAME_MAX) {
+            len = XF_FAL_DEV_NAME_MAX;
+        }
+        for (size_t i = 0; (XF_OK == xf_ret) && (i < dev->sector_num); i++) {
+            memcpy(line, dev->flash_dev->name, len);
+            p = &line[len];
+            *p++ = ',';
+            p = xf_fal_wear_fmt_u32(p, (uint32_t)i, false);
+            *p++ = ',';
+            p = xf_fal_wear_fmt_u32(p, (uint32_t)(i * dev->flash_dev->sector_size), true);
+            *p++ = ',';
+            p = xf_fal_wear_fmt_u32(p, sp_wear()->cnt[dev->base + i], false);
+            *p++ = '\n';
+            xf_ret = write(user_data, line, (size_t)(p - line));
+        }
+    }
+
+    return xf_ret;
+}
+
+void xf_fal_show_wear(size_t width)
+{
+    static const char shade[] = " .:-=+*#%@";
+    const xf_fal_wear_dev_t *dev;
+    char line[XF_FAL_WEAR_SHOW_WIDTH_MAX + 1];
+    uint32_t max;
+    uint32_t v;
+    uint64_t total;
+    size_t group;
+    size_t col;
+    size_t i;
+    size_t j;
+
+    if (!sp_wear()->is_init) {
+        return;
+    }
+    if ((0 == width) || (width > XF_FAL_WEAR_SHOW_WIDTH_MAX)) {
+        width = (0 == width) ? 64 : XF_FAL_WEAR_SHOW_WIDTH_MAX;
+    }
+
+    XF_LOGI(TAG, "====================== FAL wear heatmap =====================");
+    for (size_t d = 0; d < sp_wear()->dev_num; d++) {
+        dev = &sp_wear()->dev[d];
+        if (0 == dev->sector_num) {
+            continue;
+        }
+        max     = 0;
+        total   = 0;
+        for (i = 0; i < dev->sector_num; i++) {
+            v = sp_wear()->cnt[dev->base + i];
+            max = (v > max) ? v : max;
+            total += v;
+        }
+        /* 行数过多时每个字符代表多个扇区 */
+        group = (dev->sector_num + width * XF_FAL_WEAR_SHOW_ROW_MAX - 1)
+                / (width * XF_FAL_WEAR_SHOW_ROW_MAX);
+        XF_LOGI(TAG, "%s: %lu sectors, %lu sector(s)/char, max %lu, total %lu",
+                dev->flash_dev->name, (unsigned long)dev->sector_num,
+                (unsigned long)group, (unsigned long)max, (unsigned long)total);
+        for (i = 0; i < dev->sector_num; i += width * group) {
+            for (col = 0; col < width; col++) {
+                v = 0;
+                for (j = i + col * group; (j < i + (col + 1) * group) && (j < dev->sector_num); j++) {
+                    v = (sp_wear()->cnt[dev->base + j] > v) ? sp_wear()->cnt[dev->base + j] : v;
+                }
+                if (i + col * group >= dev->sector_num) {
+                    break;
+                }
+                line[col] = (0 == v) ? shade[0]
+                            : shade[1 + (size_t)((uint64_t)v * (sizeof(shade) - 3) / max)];
+            }
+            line[col] = '\0';
+            XF_LOGI(TAG, "0x%08lx |%s|",
+                    (unsigned long)(i * dev->flash_dev->sector_size), line);
+        }
+    }
+    XF_LOGI(TAG, "=============================================================");
+}
+
+void xf_fal_wear_record(const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size)
+{
+    xf_fal_wear_dev_t *dev;
+    size_t sector_size;
+    size_t sector;
+    size_t last;
+    size_t slot;
+
+    if ((!sp_wear()->is_init) || (0 == size)) {
+        return;
+    }
+
+    XF_FAL_WEAR_LOCK();
+    dev = xf_fal_wear_dev_find(flash_dev);
+    if (NULL == dev) {
+        /* 初始化后注册的 flash 设备 */
+        dev = xf_fal_wear_dev_add(flash_dev);
+    }
+    if ((dev) && (dev->sector_num)) {
+        sector_size = flash_dev->sector_size;
+        last        = (addr + size - 1) / sector_size;
+        if (last >= dev->sector_num) {
+            last = dev->sector_num - 1;
+        }
+        for (sector = addr / sector_size; sector <= last; sector++) {
+            slot = dev->base + sector;
+            if (sp_wear()->cnt[slot] < XF_FAL_WEAR_CNT_MAX) {
+                sp_wear()->cnt[slot]++;
+            }
+            if (sp_wear()->pending[slot] < XF_FAL_WEAR_PENDING_MAX) {
+                sp_wear()->pending[slot]++;
+                sp_wear()->pending_total++;
+            } else {
+                sp_wear()->need_snapshot = true;
+            }
+        }
+    }
+    XF_FAL_WEAR_UNLOCK();
+}
+
+void xf_fal_wear_sync_if_needed(void)
+{
+#if XF_FAL_WEAR_SYNC_THRESHOLD > 0
+    /* 持久化自身的擦除也会进入这里，由 is_syncing 挡住 */
+    if ((sp_wear()->is_init) && (!sp_wear()->is_syncing)
+            && (sp_wear()->pending_total >= XF_FAL_WEAR_SYNC_THRESHOLD)) {
+        (void)xf_fal_wear_sync();
+    }
+#endif
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 为 flash 设备分配计数。计数空间不足时仍占用设备表项（sector_num 为 0），避免重复尝试。
+ *
+ * @return xf_fal_wear_dev_t* 设备表项，设备表已满时返回 NULL.
+ */
+static xf_fal_wear_dev_t *xf_fal_wear_dev_add(const xf_fal_flash_dev_t *flash_dev)
+{
+    xf_fal_wear_dev_t *dev;
+    size_t sector_num = 0;
+    size_t len;
+
+    if (sp_wear()->dev_num >= XF_FAL_FLASH_DEVICE_NUM) {
+        return NULL;
+    }
+    if (flash_dev->sector_size) {
+        sector_num = (flash_dev->len + flash_dev->sector_size - 1) / flash_dev->sector_size;
+    }
+    if (sector_num > XF_FAL_WEAR_SECTOR_NUM - sp_wear()->slot_num) {
+        XF_LOGW(TAG, "Flash device(%s) has %d sectors, exceeds XF_FAL_WEAR_SECTOR_NUM.",
+                flash_dev->name, (int)sector_num);
+        sector_num = 0;
+    }
+
+    len = xf_strlen(flash_dev->name);
+    if (len > XF_FAL_DEV_NAME_MAX) {
+        len = XF_FAL_DEV_NAME_MAX;
+    }
+    dev = &sp_wear()->dev[sp_wear()->dev_num];
+    dev->flash_dev      = flash_dev;
+    dev->id             = xf_fal_crc32(0, flash_dev->name, len);
+    dev->base           = sp_wear()->slot_num;
+    dev->sector_num     = sector_num;
+    sp_wear()->slot_num += sector_num;
+    sp_wear()->dev_num++;
+
+    return dev;
+}
+
+static xf_fal_wear_dev_t *xf_fal_wear_dev_find(const xf_fal_flash_dev_t *flash_dev)
+{
+    for (size_t i = 0; i < sp_wear()->dev_num; i++) {
+        if (sp_wear()->dev[i].flash_dev == flash_dev) {
+            return &sp_wear()->dev[i];
+        }
+    }
+    return NULL;
+}
+
+static xf_fal_wear_dev_t *xf_fal_wear_dev_find_id(uint32_t id)
+{
+    for (size_t i = 0; i < sp_wear()->dev_num; i++) {
+        if ((sp_wear()->dev[i].id == id) && (sp_wear()->dev[i].sector_num)) {
+            return &sp_wear()->dev[i];
+        }
+    }
+    return NULL;
+}
+
+static size_t xf_fal_wear_put_varint(uint8_t *p, uint32_t v)
+{
+    size_t n = 0;
+
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+
+    return n;
+}
+
+static bool xf_fal_wear_get_varint(const uint8_t **pp, const uint8_t *end, uint32_t *p_v)
+{
+    const uint8_t *p = *pp;
+    uint32_t v = 0;
+
+    for (size_t shift = 0; (p < end) && (shift < 7 * XF_FAL_WEAR_VARINT_MAX); shift += 7) {
+        v |= (uint32_t)(*p & 0x7F) << shift;
+        if (0 == (*p++ & 0x80)) {
+            *pp     = p;
+            *p_v    = v;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void xf_fal_wear_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t xf_fal_wear_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8)
+           | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t xf_fal_wear_align(size_t size)
+{
+    return (size + sp_wear()->align - 1) / sp_wear()->align * sp_wear()->align;
+}
+
+/**
+ * @brief 在当前块 off 处还能写入的记录负载长度上限，放不下最小的记录时返回 0.
+ */
+static size_t xf_fal_wear_payload_cap(size_t off)
+{
+    size_t cap = XF_FAL_WEAR_BUF_SIZE - XF_FAL_WEAR_REC_OVERHEAD - (sp_wear()->align - 1);
+    size_t room;
+
+    if (off >= sp_wear()->block_size) {
+        return 0;
+    }
+    room = sp_wear()->block_size - off;
+    if (room < XF_FAL_WEAR_REC_OVERHEAD + (sp_wear()->align - 1)) {
+        return 0;
+    }
+    room -= XF_FAL_WEAR_REC_OVERHEAD + (sp_wear()->align - 1);
+    cap = (room < cap) ? room : cap;
+
+    return (cap >= 4 + 2 * XF_FAL_WEAR_VARINT_MAX) ? cap : 0;
+}
+
+static void xf_fal_wear_clear_pending(size_t slot)
+{
+    sp_wear()->pending_total -= sp_wear()->pending[slot];
+    sp_wear()->pending[slot] = 0;
+}
+
+/**
+ * @brief 从 *p_sector 开始编码设备的快照，写满 cap 为止。调用者持有 mutex.
+ *
+ * @return size_t 负载长度。*p_sector 更新为下一个未编码的扇区。
+ */
+static size_t xf_fal_wear_encode_snap(
+    const xf_fal_wear_dev_t *dev, size_t *p_sector, uint8_t *payload, size_t cap)
+{
+    const uint32_t *cnt = &sp_wear()->cnt[dev->base];
+    size_t i = *p_sector;
+    size_t len;
+    size_t run;
+    uint32_t prev = 0;
+    uint32_t token;
+    int32_t delta;
+
+    xf_fal_wear_put_u32(payload, dev->id);
+    len = 4 + xf_fal_wear_put_varint(&payload[4], (uint32_t)i);
+    while ((i < dev->sector_num) && (len + XF_FAL_WEAR_VARINT_MAX <= cap)) {
+        if (cnt[i] == prev) {
+            for (run = 1; (i + run < dev->sector_num) && (cnt[i + run] == prev)
+                    && (run < 0x7FFFFFFF); run++) {
+            }
+            token = ((uint32_t)run << 1) | 1;
+        } else {
+            run     = 1;
+            delta   = (int32_t)(cnt[i] - prev);
+            token   = (((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31)) << 1;
+            prev    = cnt[i];
+        }
+        len += xf_fal_wear_put_varint(&payload[len], token);
+        for (size_t k = 0; k < run; k++) {
+            xf_fal_wear_clear_pending(dev->base + i + k);
+        }
+        i += run;
+    }
+    *p_sector = i;
+
+    return len;
+}
+
+/**
+ * @brief 编码第一个有未持久化擦除的设备的增量，写满 cap 为止。调用者持有 mutex.
+ *
+ * @return size_t 负载长度，0 表示没有未持久化的擦除。
+ */
+static size_t xf_fal_wear_encode_delta(uint8_t *payload, size_t cap)
+{
+    const xf_fal_wear_dev_t *dev;
+    size_t len;
+    size_t next;
+    uint16_t inc;
+
+    for (size_t d = 0; d < sp_wear()->dev_num; d++) {
+        dev     = &sp_wear()->dev[d];
+        len     = 0;
+        next    = 0;
+        for (size_t i = 0; i < dev->sector_num; i++) {
+            inc = sp_wear()->pending[dev->base + i];
+            if (0 == inc) {
+                continue;
+            }
+            if (0 == len) {
+                xf_fal_wear_put_u32(payload, dev->id);
+                len = 4;
+            }
+            if (len + 2 * XF_FAL_WEAR_VARINT_MAX > cap) {
+                break;
+            }
+            len += xf_fal_wear_put_varint(&payload[len], (uint32_t)(i - next));
+            len += xf_fal_wear_put_varint(&payload[len], inc);
+            xf_fal_wear_clear_pending(dev->base + i);
+            next = i + 1;
+        }
+        if (len) {
+            return len;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 为 buf 中已编码的负载（位于 buf + 4）加上头和 CRC, 写入 block_off + *p_off 处。
+ *
+ * @param p_off 块内偏移，成功时更新为下一条记录的偏移。
+ */
+static xf_err_t xf_fal_wear_write_record(size_t block_off, size_t *p_off, uint8_t type, size_t len)
+{
+    xf_err_t xf_ret;
+    uint8_t *buf = sp_wear()->buf;
+    size_t total;
+
+    buf[0] = type;
+    buf[1] = (uint8_t)~type;
+    buf[2] = (uint8_t)len;
+    buf[3] = (uint8_t)(len >> 8);
+    xf_fal_wear_put_u32(&buf[4 + len], xf_fal_crc32(0, buf, 4 + len));
+    total = xf_fal_wear_align(XF_FAL_WEAR_REC_OVERHEAD + len);
+    memset(&buf[XF_FAL_WEAR_REC_OVERHEAD + len], 0xFF, total - (XF_FAL_WEAR_REC_OVERHEAD + len));
+
+    xf_ret = xf_fal_handle_write(&sp_wear()->meta, block_off + *p_off, buf, total);
+    if (XF_OK == xf_ret) {
+        *p_off += total;
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 擦除下一块，写入块头和全部计数的快照。
+ *
+ * 快照写完（SNAP_END）前当前块仍然有效，失败时不切换。
+ */
+static xf_err_t xf_fal_wear_switch_block(void)
+{
+    xf_err_t xf_ret;
+    const xf_fal_wear_dev_t *dev;
+    uint8_t *buf = sp_wear()->buf;
+    size_t next = (sp_wear()->block_idx + 1) % sp_wear()->block_num;
+    size_t block_off = next * sp_wear()->block_size;
+    size_t off;
+    size_t cap;
+    size_t len;
+    size_t sector;
+
+    xf_ret = xf_fal_handle_erase(&sp_wear()->meta, block_off, sp_wear()->block_size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    xf_fal_wear_put_u32(&buf[0], XF_FAL_WEAR_BLOCK_MAGIC);
+    xf_fal_wear_put_u32(&buf[4], sp_wear()->seq + 1);
+    xf_fal_wear_put_u32(&buf[8], xf_fal_crc32(0, buf, 8));
+    off = xf_fal_wear_align(XF_FAL_WEAR_HDR_SIZE);
+    memset(&buf[XF_FAL_WEAR_HDR_SIZE], 0xFF, off - XF_FAL_WEAR_HDR_SIZE);
+    xf_ret = xf_fal_handle_write(&sp_wear()->meta, block_off, buf, off);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    XF_FAL_WEAR_LOCK();
+    sp_wear()->need_snapshot = false;
+    XF_FAL_WEAR_UNLOCK();
+    for (size_t d = 0; d < sp_wear()->dev_num; d++) {
+        dev = &sp_wear()->dev[d];
+        for (sector = 0; sector < dev->sector_num;) {
+            cap = xf_fal_wear_payload_cap(off);
+            if (0 == cap) {
+                XF_LOGE(TAG, "Wear snapshot does NOT fit in one sector.");
+                return XF_ERR_NO_MEM;
+            }
+            XF_FAL_WEAR_LOCK();
+            len = xf_fal_wear_encode_snap(dev, &sector, &buf[4], cap);
+            XF_FAL_WEAR_UNLOCK();
+            xf_ret = xf_fal_wear_write_record(block_off, &off, XF_FAL_WEAR_REC_SNAP, len);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+        }
+    }
+    if (0 == xf_fal_wear_payload_cap(off)) {
+        return XF_ERR_NO_MEM;
+    }
+    xf_ret = xf_fal_wear_write_record(block_off, &off, XF_FAL_WEAR_REC_SNAP_END, 0);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    sp_wear()->block_idx    = next;
+    sp_wear()->write_off    = off;
+    sp_wear()->seq++;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 追加增量记录，当前块写满或需要重写快照时换块。调用者已置 is_syncing.
+ */
+static xf_err_t xf_fal_wear_flush(void)
+{
+    xf_err_t xf_ret = XF_OK;
+    size_t cap;
+    size_t len;
+
+    if (sp_wear()->need_snapshot) {
+        xf_ret = xf_fal_wear_switch_block();
+    }
+    while (XF_OK == xf_ret) {
+        cap = xf_fal_wear_payload_cap(sp_wear()->write_off);
+        if (0 == cap) {
+            /* 新块的快照已包含所有计数，之后只需写入换块期间新增的擦除 */
+            xf_ret = xf_fal_wear_switch_block();
+            continue;
+        }
+        XF_FAL_WEAR_LOCK();
+        len = xf_fal_wear_encode_delta(&sp_wear()->buf[4], cap);
+        XF_FAL_WEAR_UNLOCK();
+        if (0 == len) {
+            break;
+        }
+        xf_ret = xf_fal_wear_write_record(
+                     sp_wear()->block_idx * sp_wear()->block_size, &sp_wear()->write_off,
+                     XF_FAL_WEAR_REC_DELTA, len);
+    }
+
+    return xf_ret;
+}
+
+static void xf_fal_wear_add_cnt(const xf_fal_wear_dev_t *dev, size_t sector, uint32_t v)
+{
+    uint32_t *p_cnt;
+
+    if (sector >= dev->sector_num) {
+        return;
+    }
+    p_cnt = &sp_wear()->cnt[dev->base + sector];
+    *p_cnt = (v > XF_FAL_WEAR_CNT_MAX - *p_cnt) ? XF_FAL_WEAR_CNT_MAX : (*p_cnt + v);
+}
+
+/**
+ * @brief 把一条记录加到计数上。加载前已有的计数（初始化前的擦除）保留。
+ */
+static void xf_fal_wear_apply(uint8_t type, const uint8_t *payload, size_t len)
+{
+    const uint8_t *p = payload + 4;
+    const uint8_t *end = payload + len;
+    const xf_fal_wear_dev_t *dev;
+    uint32_t prev = 0;
+    uint32_t sector = 0;
+    uint32_t a;
+    uint32_t b;
+
+    if (len < 4) {
+        return;
+    }
+    dev = xf_fal_wear_dev_find_id(xf_fal_wear_get_u32(payload));
+    if (NULL == dev) {
+        /* 已不存在（或不再统计）的 flash 设备 */
+        return;
+    }
+
+    if (XF_FAL_WEAR_REC_SNAP == type) {
+        if (!xf_fal_wear_get_varint(&p, end, &sector)) {
+            return;
+        }
+        while ((p < end) && (xf_fal_wear_get_varint(&p, end, &a))
+                && (sector < dev->sector_num)) {
+            if (a & 1) {
+                for (b = 0; (b < (a >> 1)) && (sector < dev->sector_num); b++) {
+                    xf_fal_wear_add_cnt(dev, sector++, prev);
+                }
+            } else {
+                a >>= 1;
+                prev += (uint32_t)((a >> 1) ^ (0u - (a & 1)));
+                xf_fal_wear_add_cnt(dev, sector++, prev);
+            }
+        }
+    } else if (XF_FAL_WEAR_REC_DELTA == type) {
+        while ((p < end) && (xf_fal_wear_get_varint(&p, end, &a))
+                && (xf_fal_wear_get_varint(&p, end, &b))) {
+            sector += a;
+            xf_fal_wear_add_cnt(dev, sector++, b);
+        }
+    }
+}
+
+/**
+ * @brief 解析一块中的记录。
+ *
+ * @param block         块下标。
+ * @param is_apply      是否把记录加到计数上。
+ * @param[out] p_end        最后一条有效记录之后的块内偏移。
+ * @param[out] p_is_clean   有效记录之后是否为空白（或块已满），否则有写了一半的记录。
+ * @param[out] p_is_complete 块内快照是否完整。
+ */
+static xf_err_t xf_fal_wear_parse(
+    size_t block, bool is_apply, size_t *p_end, bool *p_is_clean, bool *p_is_complete)
+{
+    xf_err_t xf_ret;
+    uint8_t *buf = sp_wear()->buf;
+    size_t block_off = block * sp_wear()->block_size;
+    size_t off = xf_fal_wear_align(XF_FAL_WEAR_HDR_SIZE);
+    size_t len;
+    size_t total;
+
+    *p_is_clean     = false;
+    *p_is_complete  = false;
+    while (off + XF_FAL_WEAR_REC_OVERHEAD <= sp_wear()->block_size) {
+        xf_ret = xf_fal_handle_read(&sp_wear()->meta, block_off + off, buf, 4);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if ((0xFF == buf[0]) && (0xFF == buf[1]) && (0xFF == buf[2]) && (0xFF == buf[3])) {
+            *p_is_clean = true;
+            break;
+        }
+        len     = (size_t)buf[2] | ((size_t)buf[3] << 8);
+        total   = xf_fal_wear_align(XF_FAL_WEAR_REC_OVERHEAD + len);
+        if (((uint8_t)(buf[0] ^ buf[1]) != 0xFF) || (XF_FAL_WEAR_REC_OVERHEAD + len > XF_FAL_WEAR_BUF_SIZE)
+                || (off + total > sp_wear()->block_size)) {
+            break;
+        }
+        xf_ret = xf_fal_handle_read(&sp_wear()->meta, block_off + off + 4, &buf[4], len + 4);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if (xf_fal_wear_get_u32(&buf[4 + len]) != xf_fal_crc32(0, buf, 4 + len)) {
+            break;
+        }
+        if (XF_FAL_WEAR_REC_SNAP_END == buf[0]) {
+            *p_is_complete = true;
+        } else if (is_apply) {
+            xf_fal_wear_apply(buf[0], &buf[4], len);
+        }
+        off += total;
+    }
+    if (off + XF_FAL_WEAR_REC_OVERHEAD > sp_wear()->block_size) {
+        *p_is_clean = true;
+    }
+    *p_end = off;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 从最新的完整块加载计数，并确定下一条记录的写入位置。
+ */
+static xf_err_t xf_fal_wear_load(void)
+{
+    xf_err_t xf_ret;
+    uint8_t hdr[XF_FAL_WEAR_HDR_SIZE];
+    uint32_t seq;
+    uint32_t seq_max = 0;
+    uint32_t tried_seq = 0;
+    bool is_tried = false;
+    bool is_found;
+    bool is_clean;
+    bool is_complete;
+    size_t block;
+    size_t block_max = sp_wear()->block_num - 1;
+    size_t end;
+
+    /* 依次尝试从新到旧的块，直到找到快照完整的块 */
+    for (size_t attempt = 0; attempt < sp_wear()->block_num; attempt++) {
+        is_found    = false;
+        block       = 0;
+        for (size_t i = 0; i < sp_wear()->block_num; i++) {
+            xf_ret = xf_fal_handle_read(&sp_wear()->meta, i * sp_wear()->block_size,
+                                        hdr, sizeof(hdr));
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+            if ((XF_FAL_WEAR_BLOCK_MAGIC != xf_fal_wear_get_u32(&hdr[0]))
+                    || (xf_fal_wear_get_u32(&hdr[8]) != xf_fal_crc32(0, hdr, 8))) {
+                continue;
+            }
+            seq = xf_fal_wear_get_u32(&hdr[4]);
+            if ((0 == attempt) && ((!is_tried) || ((int32_t)(seq - seq_max) > 0))) {
+                seq_max     = seq;
+                block_max   = i;
+                is_tried    = true;
+            }
+            if (((attempt) && ((int32_t)(tried_seq - seq) <= 0))
+                    || ((is_found) && ((int32_t)(seq - sp_wear()->seq) <= 0))) {
+                continue;
+            }
+            is_found        = true;
+            block           = i;
+            sp_wear()->seq  = seq;
+        }
+        if (!is_found) {
+            break;
+        }
+
+        xf_ret = xf_fal_wear_parse(block, false, &end, &is_clean, &is_complete);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if (is_complete) {
+            xf_ret = xf_fal_wear_parse(block, true, &end, &is_clean, &is_complete);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+            sp_wear()->block_idx    = block;
+            /* 写了一半的记录之后不能再追加，下次持久化时换块 */
+            sp_wear()->write_off    = (is_clean) ? end : sp_wear()->block_size;
+            /* 新块的序号要大于所有已有的块 */
+            sp_wear()->seq          = seq_max;
+            return XF_OK;
+        }
+        tried_seq = sp_wear()->seq;
+    }
+
+    /* 没有有效的块：从 0 开始，第一次持久化时写入快照 */
+    sp_wear()->block_idx    = block_max;
+    sp_wear()->write_off    = sp_wear()->block_size;
+    sp_wear()->seq          = seq_max;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 把 v 格式化为十进制或 "0x" 开头的十六进制（8 位），不写结束符。
+ *
+ * @return char* 写入的末尾。
+ */
+static char *xf_fal_wear_fmt_u32(char *p, uint32_t v, bool is_hex)
+{
+    static const char digit[] = "0123456789abcdef";
+    char tmp[10];
+    size_t n = 0;
+
+    if (is_hex) {
+        *p++ = '0';
+        *p++ = 'x';
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            *p++ = digit[(v >> shift) & 0xF];
+        }
+        return p;
+    }
+    do {
+        tmp[n++] = digit[v % 10];
+        v /= 10;
+    } while (v);
+    while (n) {
+        *p++ = tmp[--n];
+    }
+
+    return p;
+}
+
+#endif // XF_FAL_WEAR_ENABLE
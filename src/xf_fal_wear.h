@@ -0,0 +1,205 @@
+/**
+ * @file xf_fal_wear.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 扇区擦除次数（磨损）统计。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_WEAR_H__
+#define __XF_FAL_WEAR_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#if XF_FAL_WEAR_ENABLE || defined(__DOXYGEN__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 擦除次数最多的扇区，见 xf_fal_wear_get_hot().
+ */
+typedef struct _xf_fal_wear_hot_t {
+    const xf_fal_flash_dev_t   *flash_dev;  /*!< flash 设备 */
+    size_t                      sector;     /*!< 扇区号，地址为 sector * sector_size */
+    uint32_t                    erase_cnt;  /*!< 擦除次数 */
+} xf_fal_wear_hot_t;
+
+/**
+ * @brief 擦除次数导出的输出回调，见 xf_fal_wear_dump().
+ *
+ * @param user_data 用户数据。
+ * @param data      数据（文本）。
+ * @param size      大小，单位：字节。
+ * @return xf_err_t 非 XF_OK 时停止输出。
+ */
+typedef xf_err_t (*xf_fal_wear_write_cb_t)(void *user_data, const void *data, size_t size);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 初始化擦除次数统计，并从元数据分区加载已持久化的次数。
+ *
+ * 为当前已注册的每个 flash 设备按扇区分配计数，之后通过 xf_fal 的每次扇区擦除
+ * （含异步擦除）都会计数。应在注册 flash 设备并调用 xf_fal_init() 后立即调用。
+ *
+ * 元数据分区按扇区划分为块，作为只追加的日志使用：每块以全部计数的快照开始
+ * （相邻扇区差值 + 游程编码），之后追加自上次持久化以来变化的扇区的增量记录，
+ * 每条记录带 CRC-32. 写满后轮换到下一块，因此持久化本身很少擦除；
+ * 掉电时未写完的记录被丢弃，最多回退到上一次持久化。
+ *
+ * @param meta_part 元数据分区，至少 2 个扇区，不应被其他模块使用。
+ * @return xf_err_t
+ *      - XF_OK                 成功（元数据分区为空或无法解析时从 0 开始）
+ *      - XF_ERR_INITED         已初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或元数据分区小于 2 个扇区
+ *      - XF_ERR_NO_MEM         已注册设备的扇区总数超过 XF_FAL_WEAR_SECTOR_NUM
+ *                              （超出的设备不统计，其余正常工作）
+ *      - (OTHER)               读取元数据分区失败
+ */
+xf_err_t xf_fal_wear_init(const xf_fal_partition_t *meta_part);
+
+/**
+ * @brief 反初始化，丢弃内存中的计数（未持久化的部分丢失）。
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_BUSY           正在持久化
+ */
+xf_err_t xf_fal_wear_deinit(void);
+
+/**
+ * @brief 持久化自上次持久化以来的擦除次数。
+ *
+ * 通常由定时任务周期调用，或通过 XF_FAL_WEAR_SYNC_THRESHOLD 在擦除时自动调用。
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_BUSY           其他线程正在持久化
+ *      - XF_ERR_NO_MEM         一块放不下全部计数的快照（元数据分区扇区太小）
+ *      - (OTHER)               读写擦元数据分区失败，下次持久化时重写快照
+ */
+xf_err_t xf_fal_wear_sync(void);
+
+/**
+ * @brief 获取扇区的擦除次数。
+ *
+ * @param flash_dev flash 设备。
+ * @param sector    扇区号。
+ * @param[out] p_cnt 擦除次数（含未持久化的部分）。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数或扇区号越界
+ *      - XF_ERR_NOT_FOUND      该 flash 设备未统计
+ */
+xf_err_t xf_fal_wear_get_count(
+    const xf_fal_flash_dev_t *flash_dev, size_t sector, uint32_t *p_cnt);
+
+/**
+ * @brief 获取擦除次数最多的扇区。
+ *
+ * @param[out] p_hot 结果，按擦除次数从多到少排列。
+ * @param num        p_hot 的个数。
+ * @return size_t 实际填写的个数（不含从未擦除的扇区）。
+ */
+size_t xf_fal_wear_get_hot(xf_fal_wear_hot_t *p_hot, size_t num);
+
+/**
+ * @brief 以 CSV 文本导出所有扇区的擦除次数，用于绘制热力图。
+ *
+ * 每行为 "flash 设备名,扇区号,地址,擦除次数"，第一行为表头。
+ * 不加锁，可以在回调中通过 xf_fal 写入 flash.
+ *
+ * @param write     输出回调，每次输出一行。
+ * @param user_data 传给 write 的用户数据。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         未初始化
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               write 返回的错误
+ */
+xf_err_t xf_fal_wear_dump(xf_fal_wear_write_cb_t write, void *user_data);
+
+/**
+ * @brief 以字符热力图打印各 flash 设备的扇区擦除次数。
+ *
+ * 每个字符代表一个或多个相邻扇区（取最大值），深浅按该设备的最大次数归一化。
+ *
+ * @param width 每行字符数，0 时为 64.
+ */
+void xf_fal_show_wear(size_t width);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/**
+ * @cond (XFAPI_INTERNAL)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 记录一次成功的擦除。由 xf_fal 内部在擦除驱动调用成功后调用。
+ *
+ * @param flash_dev flash 设备。
+ * @param addr      擦除起始地址（flash 设备上的偏移）。
+ * @param size      擦除大小，单位：字节。
+ */
+void xf_fal_wear_record(const xf_fal_flash_dev_t *flash_dev, size_t addr, size_t size);
+
+/**
+ * @brief 未持久化的擦除次数达到 XF_FAL_WEAR_SYNC_THRESHOLD 时持久化。
+ *
+ * 由 xf_fal 内部在擦除接口返回前（已释放设备锁）调用。
+ */
+void xf_fal_wear_sync_if_needed(void);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // XF_FAL_WEAR_ENABLE
+
+#endif // __XF_FAL_WEAR_H__
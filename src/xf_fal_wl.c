@@ -0,0 +1,691 @@
+/**
+ * @file xf_fal_wl.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 动态磨损均衡虚拟 flash 设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_fal_wl.h"
+
+#if XF_FAL_WL_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_fal_wl"
+
+/*
+ * 物理分区布局：[日志 0][日志 1][数据扇区 0]...[数据扇区 sector_num - 1]
+ *
+ * 日志为定长记录（小端）：
+ *     {type u8, ~type u8, lsec u16, psec u16, 0xFFFF, cnt u32, crc32 u32}
+ *
+ * 每个日志扇区以 HDR 记录（cnt 为序号）开头，随后是当时全部映射的快照
+ * （MAP 记录，以及擦除过的空闲扇区的 FREE 记录），以 END 记录结束，
+ * 之后追加 MAP/UNMAP 记录。日志扇区写满后擦除另一个扇区并写入新的快照。
+ * 加载时取序号最大且快照完整的日志扇区，依次重放到空白或损坏的记录为止。
+ */
+#define XF_FAL_WL_JOURNAL_NUM           2
+#define XF_FAL_WL_REC_SIZE              16
+#define XF_FAL_WL_REC_HDR               0x5A    /*!< lsec 为 XF_FAL_WL_HDR_MAGIC, cnt 为序号 */
+#define XF_FAL_WL_REC_MAP               0x01    /*!< lsec 映射到 psec, cnt 为 psec 的擦除次数 */
+#define XF_FAL_WL_REC_UNMAP             0x02    /*!< 解除 lsec 的映射 */
+#define XF_FAL_WL_REC_FREE              0x03    /*!< 空闲的 psec 的擦除次数（仅在快照中） */
+#define XF_FAL_WL_REC_END               0x04    /*!< 快照结束 */
+#define XF_FAL_WL_HDR_MAGIC             0x4C57  /*!< "WL" */
+#define XF_FAL_WL_UNMAPPED              0xFFFF
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 磨损均衡设备上下文。
+ *
+ * 虚拟设备的读写擦由 xf_fal 按设备串行化，因此除初始化外无需加锁。
+ */
+typedef struct _xf_fal_wl_ctx_t {
+    bool                is_used;
+    char                name[XF_FAL_DEV_NAME_MAX + 1];
+    xf_fal_flash_dev_t  dev;            /*!< 注册到 xf_fal 的虚拟设备 */
+    xf_fal_handle_t     phys;           /*!< 物理分区 */
+    size_t              sector_size;
+    size_t              logical_num;    /*!< 逻辑扇区数 */
+    size_t              sector_num;     /*!< 物理数据扇区数 */
+    size_t              cursor;         /*!< 下次分配时从此物理扇区开始查找，擦除次数相同时轮流使用 */
+    size_t              journal_idx;    /*!< 当前日志扇区 */
+    size_t              write_off;      /*!< 当前日志扇区内下一条记录的偏移 */
+    uint32_t            seq;            /*!< 当前日志扇区的序号 */
+    size_t              journal_erase;
+    uint16_t            l2p[XF_FAL_WL_SECTOR_NUM];  /*!< 逻辑扇区 -> 物理数据扇区 */
+    uint16_t            p2l[XF_FAL_WL_SECTOR_NUM];  /*!< 物理数据扇区 -> 逻辑扇区 */
+    uint32_t            cnt[XF_FAL_WL_SECTOR_NUM];  /*!< 物理数据扇区的擦除次数 */
+} xf_fal_wl_ctx_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_fal_wl_ctx_t *xf_fal_wl_find(const char *dev_name);
+static xf_err_t xf_fal_wl_read(xf_fal_wl_ctx_t *wl, size_t src_offset, void *dst, size_t size);
+static xf_err_t xf_fal_wl_write(xf_fal_wl_ctx_t *wl, size_t dst_offset, const void *src, size_t size);
+static xf_err_t xf_fal_wl_erase(xf_fal_wl_ctx_t *wl, size_t offset, size_t size);
+static size_t xf_fal_wl_data_offset(const xf_fal_wl_ctx_t *wl, size_t psec);
+static xf_err_t xf_fal_wl_alloc(xf_fal_wl_ctx_t *wl, size_t lsec);
+static void xf_fal_wl_map(xf_fal_wl_ctx_t *wl, size_t lsec, size_t psec);
+static void xf_fal_wl_unmap(xf_fal_wl_ctx_t *wl, size_t lsec);
+static void xf_fal_wl_rec_encode(
+    uint8_t *rec, uint8_t type, uint16_t lsec, uint16_t psec, uint32_t cnt);
+static bool xf_fal_wl_rec_decode(
+    const uint8_t *rec, uint8_t *p_type, uint16_t *p_lsec, uint16_t *p_psec, uint32_t *p_cnt);
+static xf_err_t xf_fal_wl_append(xf_fal_wl_ctx_t *wl, uint8_t type, size_t lsec, size_t psec);
+static xf_err_t xf_fal_wl_rotate(xf_fal_wl_ctx_t *wl);
+static xf_err_t xf_fal_wl_replay(
+    xf_fal_wl_ctx_t *wl, size_t journal, bool is_apply, size_t *p_end, bool *p_is_complete);
+static xf_err_t xf_fal_wl_load(xf_fal_wl_ctx_t *wl);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_fal_wl_ctx_t s_wl_ctx[XF_FAL_WL_NUM] = {0};
+#define sp_wl(_idx)     (&s_wl_ctx[_idx])
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief xf_fal_flash_ops_t 不带上下文参数，此处为每个设备生成一组转发函数。
+ */
+#define XF_FAL_WL_OPS_DEFINE(_idx) \
+    static xf_err_t xf_fal_wl##_idx##_read(size_t src_offset, void *dst, size_t size) \
+    { return xf_fal_wl_read(sp_wl(_idx), src_offset, dst, size); } \
+    static xf_err_t xf_fal_wl##_idx##_write(size_t dst_offset, const void *src, size_t size) \
+    { return xf_fal_wl_write(sp_wl(_idx), dst_offset, src, size); } \
+    static xf_err_t xf_fal_wl##_idx##_erase(size_t offset, size_t size) \
+    { return xf_fal_wl_erase(sp_wl(_idx), offset, size); }
+
+#define XF_FAL_WL_OPS_INIT(_idx) \
+    { \
+        .read   = xf_fal_wl##_idx##_read, \
+        .write  = xf_fal_wl##_idx##_write, \
+        .erase  = xf_fal_wl##_idx##_erase, \
+    }
+
+XF_FAL_WL_OPS_DEFINE(0)
+#if XF_FAL_WL_NUM > 1
+XF_FAL_WL_OPS_DEFINE(1)
+#endif
+#if XF_FAL_WL_NUM > 2
+XF_FAL_WL_OPS_DEFINE(2)
+#endif
+#if XF_FAL_WL_NUM > 3
+XF_FAL_WL_OPS_DEFINE(3)
+#endif
+
+static const xf_fal_flash_ops_t s_wl_ops[XF_FAL_WL_NUM] = {
+    XF_FAL_WL_OPS_INIT(0),
+#if XF_FAL_WL_NUM > 1
+    XF_FAL_WL_OPS_INIT(1),
+#endif
+#if XF_FAL_WL_NUM > 2
+    XF_FAL_WL_OPS_INIT(2),
+#endif
+#if XF_FAL_WL_NUM > 3
+    XF_FAL_WL_OPS_INIT(3),
+#endif
+};
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_fal_wl_init(const char *dev_name, const xf_fal_partition_t *phys_part, size_t len)
+{
+    xf_err_t xf_ret;
+    xf_fal_wl_ctx_t *wl = NULL;
+    xf_fal_handle_t phys;
+    const xf_fal_flash_dev_t *flash_dev;
+    size_t sector_size;
+    size_t sector_num;
+    size_t logical_num;
+    size_t name_len;
+    size_t idx = 0;
+
+    if ((NULL == dev_name) || (NULL == phys_part)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if (xf_fal_wl_find(dev_name)) {
+        return XF_ERR_INITED;
+    }
+    for (idx = 0; idx < XF_FAL_WL_NUM; idx++) {
+        if (!sp_wl(idx)->is_used) {
+            wl = sp_wl(idx);
+            break;
+        }
+    }
+    if (NULL == wl) {
+        return XF_ERR_RESOURCE;
+    }
+
+    xf_ret = xf_fal_partition_get_handle(phys_part, &phys);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    flash_dev   = phys.flash_dev;
+    sector_size = flash_dev->sector_size;
+    if ((0 == sector_size) || (phys.base % sector_size)
+            || (phys.len / sector_size <= XF_FAL_WL_JOURNAL_NUM)) {
+        XF_LOGE(TAG, "Partition(%s) is NOT sector aligned or too small.", phys_part->name);
+        return XF_ERR_INVALID_ARG;
+    }
+    sector_num  = phys.len / sector_size - XF_FAL_WL_JOURNAL_NUM;
+    logical_num = (0 == len) ? (sector_num - 1) : (len / sector_size);
+    /* 一个日志扇区要放下完整快照（HDR + 每个物理扇区一条 + END）并留出追加的余量 */
+    if ((sector_num > XF_FAL_WL_SECTOR_NUM) || (0 == logical_num) || (logical_num >= sector_num)
+            || ((sector_num + 2) * 2 * XF_FAL_WL_REC_SIZE > sector_size)
+            || (flash_dev->io_size > XF_FAL_WL_REC_SIZE)
+            || ((flash_dev->io_size) && (XF_FAL_WL_REC_SIZE % flash_dev->io_size))) {
+        XF_LOGE(TAG, "Partition(%s): %d data sectors can NOT hold %d logical sectors.",
+                phys_part->name, (int)sector_num, (int)logical_num);
+        return XF_ERR_INVALID_ARG;
+    }
+
+    memset(wl, 0, sizeof(*wl));
+    name_len = xf_strlen(dev_name);
+    if (name_len > XF_FAL_DEV_NAME_MAX) {
+        name_len = XF_FAL_DEV_NAME_MAX;
+    }
+    memcpy(wl->name, dev_name, name_len);
+    wl->name[name_len]  = '\0';
+    wl->phys            = phys;
+    wl->sector_size     = sector_size;
+    wl->logical_num     = logical_num;
+    wl->sector_num      = sector_num;
+
+    xf_ret = xf_fal_wl_load(wl);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    wl->dev.name        = wl->name;
+    wl->dev.addr        = 0;
+    wl->dev.len         = logical_num * sector_size;
+    wl->dev.sector_size = sector_size;
+    wl->dev.page_size   = flash_dev->page_size;
+    wl->dev.io_size     = flash_dev->io_size;
+    wl->dev.ops         = s_wl_ops[idx];
+    wl->is_used         = true;
+    xf_ret = xf_fal_register_flash_device_apply(&wl->dev);
+    if (xf_ret != XF_OK) {
+        wl->is_used = false;
+        return xf_ret;
+    }
+    XF_LOGD(TAG, "%s: %d logical sectors on %d data sectors of %s.",
+            wl->name, (int)logical_num, (int)sector_num, phys_part->name);
+
+    return xf_ret;
+}
+
+xf_err_t xf_fal_wl_deinit(const char *dev_name)
+{
+    xf_err_t xf_ret;
+    xf_fal_wl_ctx_t *wl;
+
+    if (NULL == dev_name) {
+        return XF_ERR_INVALID_ARG;
+    }
+    wl = xf_fal_wl_find(dev_name);
+    if (NULL == wl) {
+        return XF_ERR_NOT_FOUND;
+    }
+
+    xf_ret = xf_fal_unregister_flash_device(&wl->dev);
+    if ((xf_ret != XF_OK) && (xf_ret != XF_ERR_NOT_FOUND)) {
+        return xf_ret;
+    }
+    wl->is_used = false;
+    if (xf_fal_get_ctx()->is_init) {
+        (void)xf_fal_check_and_update_cache();
+    }
+
+    return XF_OK;
+}
+
+xf_err_t xf_fal_wl_get_stat(const char *dev_name, xf_fal_wl_stat_t *p_stat)
+{
+    const xf_fal_wl_ctx_t *wl;
+
+    if ((NULL == dev_name) || (NULL == p_stat)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    wl = xf_fal_wl_find(dev_name);
+    if (NULL == wl) {
+        return XF_ERR_NOT_FOUND;
+    }
+
+    memset(p_stat, 0, sizeof(*p_stat));
+    p_stat->logical_num     = wl->logical_num;
+    p_stat->sector_num      = wl->sector_num;
+    p_stat->journal_erase   = wl->journal_erase;
+    p_stat->erase_min       = wl->cnt[0];
+    for (size_t i = 0; i < wl->sector_num; i++) {
+        p_stat->erase_min   = (wl->cnt[i] < p_stat->erase_min) ? wl->cnt[i] : p_stat->erase_min;
+        p_stat->erase_max   = (wl->cnt[i] > p_stat->erase_max) ? wl->cnt[i] : p_stat->erase_max;
+        p_stat->erase_total += wl->cnt[i];
+        if (XF_FAL_WL_UNMAPPED != wl->p2l[i]) {
+            p_stat->mapped_num++;
+        }
+    }
+
+    return XF_OK;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_fal_wl_ctx_t *xf_fal_wl_find(const char *dev_name)
+{
+    for (size_t i = 0; i < XF_FAL_WL_NUM; i++) {
+        if ((sp_wl(i)->is_used)
+                && (0 == xf_strncmp(sp_wl(i)->name, dev_name, XF_FAL_DEV_NAME_MAX))) {
+            return sp_wl(i);
+        }
+    }
+    return NULL;
+}
+
+static xf_err_t xf_fal_wl_read(xf_fal_wl_ctx_t *wl, size_t src_offset, void *dst, size_t size)
+{
+    xf_err_t xf_ret;
+    uint8_t *p = dst;
+    size_t lsec;
+    size_t off;
+    size_t len;
+
+    while (size > 0) {
+        lsec    = src_offset / wl->sector_size;
+        off     = src_offset % wl->sector_size;
+        len     = wl->sector_size - off;
+        len     = (len < size) ? len : size;
+        if (XF_FAL_WL_UNMAPPED == wl->l2p[lsec]) {
+            memset(p, 0xFF, len);
+        } else {
+            xf_ret = xf_fal_handle_read(
+                         &wl->phys, xf_fal_wl_data_offset(wl, wl->l2p[lsec]) + off, p, len);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+        }
+        p           += len;
+        src_offset  += len;
+        size        -= len;
+    }
+
+    return XF_OK;
+}
+
+static xf_err_t xf_fal_wl_write(xf_fal_wl_ctx_t *wl, size_t dst_offset, const void *src, size_t size)
+{
+    xf_err_t xf_ret;
+    const uint8_t *p = src;
+    size_t lsec;
+    size_t off;
+    size_t len;
+
+    while (size > 0) {
+        lsec    = dst_offset / wl->sector_size;
+        off     = dst_offset % wl->sector_size;
+        len     = wl->sector_size - off;
+        len     = (len < size) ? len : size;
+        /* 首次写入擦除过的逻辑扇区时才占用物理扇区 */
+        if (XF_FAL_WL_UNMAPPED == wl->l2p[lsec]) {
+            xf_ret = xf_fal_wl_alloc(wl, lsec);
+            if (xf_ret != XF_OK) {
+                return xf_ret;
+            }
+        }
+        xf_ret = xf_fal_handle_write(
+                     &wl->phys, xf_fal_wl_data_offset(wl, wl->l2p[lsec]) + off, p, len);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        p           += len;
+        dst_offset  += len;
+        size        -= len;
+    }
+
+    return XF_OK;
+}
+
+static xf_err_t xf_fal_wl_erase(xf_fal_wl_ctx_t *wl, size_t offset, size_t size)
+{
+    xf_err_t xf_ret;
+    size_t lsec = offset / wl->sector_size;
+    size_t last = (offset + size - 1) / wl->sector_size;
+
+    for (; lsec <= last; lsec++) {
+        if (XF_FAL_WL_UNMAPPED == wl->l2p[lsec]) {
+            continue;
+        }
+        /* 先记录再修改映射，掉电时要么仍是原内容，要么为空 */
+        xf_ret = xf_fal_wl_append(wl, XF_FAL_WL_REC_UNMAP, lsec, wl->l2p[lsec]);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        xf_fal_wl_unmap(wl, lsec);
+    }
+
+    return XF_OK;
+}
+
+static size_t xf_fal_wl_data_offset(const xf_fal_wl_ctx_t *wl, size_t psec)
+{
+    return (XF_FAL_WL_JOURNAL_NUM + psec) * wl->sector_size;
+}
+
+/**
+ * @brief 为逻辑扇区分配擦除次数最少的空闲物理扇区并擦除。
+ */
+static xf_err_t xf_fal_wl_alloc(xf_fal_wl_ctx_t *wl, size_t lsec)
+{
+    xf_err_t xf_ret;
+    size_t psec = XF_FAL_WL_UNMAPPED;
+    size_t i;
+
+    for (size_t k = 0; k < wl->sector_num; k++) {
+        i = (wl->cursor + k) % wl->sector_num;
+        if ((XF_FAL_WL_UNMAPPED == wl->p2l[i])
+                && ((XF_FAL_WL_UNMAPPED == psec) || (wl->cnt[i] < wl->cnt[psec]))) {
+            psec = i;
+        }
+    }
+    if (XF_FAL_WL_UNMAPPED == psec) {
+        /* 逻辑扇区数小于物理数据扇区数，不应发生 */
+        return XF_FAIL;
+    }
+    wl->cursor = (psec + 1) % wl->sector_num;
+
+    xf_ret = xf_fal_handle_erase(&wl->phys, xf_fal_wl_data_offset(wl, psec), wl->sector_size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    wl->cnt[psec]++;
+    xf_ret = xf_fal_wl_append(wl, XF_FAL_WL_REC_MAP, lsec, psec);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    xf_fal_wl_map(wl, lsec, psec);
+
+    return XF_OK;
+}
+
+static void xf_fal_wl_map(xf_fal_wl_ctx_t *wl, size_t lsec, size_t psec)
+{
+    xf_fal_wl_unmap(wl, lsec);
+    if (XF_FAL_WL_UNMAPPED != wl->p2l[psec]) {
+        wl->l2p[wl->p2l[psec]] = XF_FAL_WL_UNMAPPED;
+    }
+    wl->l2p[lsec] = (uint16_t)psec;
+    wl->p2l[psec] = (uint16_t)lsec;
+}
+
+static void xf_fal_wl_unmap(xf_fal_wl_ctx_t *wl, size_t lsec)
+{
+    if (XF_FAL_WL_UNMAPPED != wl->l2p[lsec]) {
+        wl->p2l[wl->l2p[lsec]]  = XF_FAL_WL_UNMAPPED;
+        wl->l2p[lsec]           = XF_FAL_WL_UNMAPPED;
+    }
+}
+
+static void xf_fal_wl_rec_encode(
+    uint8_t *rec, uint8_t type, uint16_t lsec, uint16_t psec, uint32_t cnt)
+{
+    uint32_t crc;
+
+    rec[0]  = type;
+    rec[1]  = (uint8_t)~type;
+    rec[2]  = (uint8_t)lsec;
+    rec[3]  = (uint8_t)(lsec >> 8);
+    rec[4]  = (uint8_t)psec;
+    rec[5]  = (uint8_t)(psec >> 8);
+    rec[6]  = 0xFF;
+    rec[7]  = 0xFF;
+    rec[8]  = (uint8_t)cnt;
+    rec[9]  = (uint8_t)(cnt >> 8);
+    rec[10] = (uint8_t)(cnt >> 16);
+    rec[11] = (uint8_t)(cnt >> 24);
+    crc     = xf_fal_crc32(0, rec, 12);
+    rec[12] = (uint8_t)crc;
+    rec[13] = (uint8_t)(crc >> 8);
+    rec[14] = (uint8_t)(crc >> 16);
+    rec[15] = (uint8_t)(crc >> 24);
+}
+
+static bool xf_fal_wl_rec_decode(
+    const uint8_t *rec, uint8_t *p_type, uint16_t *p_lsec, uint16_t *p_psec, uint32_t *p_cnt)
+{
+    uint32_t crc = (uint32_t)rec[12] | ((uint32_t)rec[13] << 8)
+                   | ((uint32_t)rec[14] << 16) | ((uint32_t)rec[15] << 24);
+
+    if ((0xFF != (uint8_t)(rec[0] ^ rec[1])) || (crc != xf_fal_crc32(0, rec, 12))) {
+        return false;
+    }
+    *p_type = rec[0];
+    *p_lsec = (uint16_t)(rec[2] | (rec[3] << 8));
+    *p_psec = (uint16_t)(rec[4] | (rec[5] << 8));
+    *p_cnt  = (uint32_t)rec[8] | ((uint32_t)rec[9] << 8)
+              | ((uint32_t)rec[10] << 16) | ((uint32_t)rec[11] << 24);
+
+    return true;
+}
+
+/**
+ * @brief 追加一条映射变化记录，当前日志扇区已满时先换到另一个日志扇区。
+ */
+static xf_err_t xf_fal_wl_append(xf_fal_wl_ctx_t *wl, uint8_t type, size_t lsec, size_t psec)
+{
+    xf_err_t xf_ret;
+    uint8_t rec[XF_FAL_WL_REC_SIZE];
+
+    if (wl->write_off + XF_FAL_WL_REC_SIZE > wl->sector_size) {
+        xf_ret = xf_fal_wl_rotate(wl);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+    }
+    xf_fal_wl_rec_encode(rec, type, (uint16_t)lsec, (uint16_t)psec, wl->cnt[psec]);
+    xf_ret = xf_fal_handle_write(
+                 &wl->phys, wl->journal_idx * wl->sector_size + wl->write_off, rec, sizeof(rec));
+    if (XF_OK == xf_ret) {
+        wl->write_off += XF_FAL_WL_REC_SIZE;
+    } else {
+        /* 写了一半的记录之后不能再追加 */
+        wl->write_off = wl->sector_size;
+    }
+
+    return xf_ret;
+}
+
+/**
+ * @brief 擦除另一个日志扇区，写入当前映射的快照。快照完整前原日志扇区仍然有效。
+ */
+static xf_err_t xf_fal_wl_rotate(xf_fal_wl_ctx_t *wl)
+{
+    xf_err_t xf_ret;
+    uint8_t rec[XF_FAL_WL_REC_SIZE];
+    size_t next = (wl->journal_idx + 1) % XF_FAL_WL_JOURNAL_NUM;
+    size_t base = next * wl->sector_size;
+    size_t off = 0;
+
+    xf_ret = xf_fal_handle_erase(&wl->phys, base, wl->sector_size);
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+    wl->journal_erase++;
+
+    xf_fal_wl_rec_encode(rec, XF_FAL_WL_REC_HDR, XF_FAL_WL_HDR_MAGIC, 0, wl->seq + 1);
+    xf_ret = xf_fal_handle_write(&wl->phys, base + off, rec, sizeof(rec));
+    off += XF_FAL_WL_REC_SIZE;
+    for (size_t i = 0; (XF_OK == xf_ret) && (i < wl->sector_num); i++) {
+        if (XF_FAL_WL_UNMAPPED != wl->p2l[i]) {
+            xf_fal_wl_rec_encode(rec, XF_FAL_WL_REC_MAP, wl->p2l[i], (uint16_t)i, wl->cnt[i]);
+        } else if (wl->cnt[i]) {
+            xf_fal_wl_rec_encode(rec, XF_FAL_WL_REC_FREE, XF_FAL_WL_UNMAPPED, (uint16_t)i, wl->cnt[i]);
+        } else {
+            continue;
+        }
+        xf_ret = xf_fal_handle_write(&wl->phys, base + off, rec, sizeof(rec));
+        off += XF_FAL_WL_REC_SIZE;
+    }
+    if (XF_OK == xf_ret) {
+        xf_fal_wl_rec_encode(rec, XF_FAL_WL_REC_END, XF_FAL_WL_UNMAPPED, 0, 0);
+        xf_ret = xf_fal_handle_write(&wl->phys, base + off, rec, sizeof(rec));
+        off += XF_FAL_WL_REC_SIZE;
+    }
+    if (xf_ret != XF_OK) {
+        return xf_ret;
+    }
+
+    wl->journal_idx = next;
+    wl->write_off   = off;
+    wl->seq++;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 解析一个日志扇区。
+ *
+ * @param journal       日志扇区下标。
+ * @param is_apply      是否重放到映射表。
+ * @param[out] p_end    最后一条有效记录之后的偏移，之后不是空白时为扇区大小。
+ * @param[out] p_is_complete 快照是否完整。
+ */
+static xf_err_t xf_fal_wl_replay(
+    xf_fal_wl_ctx_t *wl, size_t journal, bool is_apply, size_t *p_end, bool *p_is_complete)
+{
+    xf_err_t xf_ret;
+    uint8_t rec[XF_FAL_WL_REC_SIZE];
+    uint8_t type;
+    uint16_t lsec;
+    uint16_t psec;
+    uint32_t cnt;
+    size_t off;
+    size_t i;
+
+    *p_is_complete = false;
+    for (off = XF_FAL_WL_REC_SIZE; off + XF_FAL_WL_REC_SIZE <= wl->sector_size;
+            off += XF_FAL_WL_REC_SIZE) {
+        xf_ret = xf_fal_handle_read(&wl->phys, journal * wl->sector_size + off, rec, sizeof(rec));
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        for (i = 0; (i < sizeof(rec)) && (0xFF == rec[i]); i++) {
+        }
+        if (i == sizeof(rec)) {
+            break;
+        }
+        if (!xf_fal_wl_rec_decode(rec, &type, &lsec, &psec, &cnt)) {
+            /* 写了一半的记录，之后不能再追加 */
+            *p_end = wl->sector_size;
+            return XF_OK;
+        }
+        if (XF_FAL_WL_REC_END == type) {
+            *p_is_complete = true;
+        }
+        if ((!is_apply) || (psec >= wl->sector_num)) {
+            continue;
+        }
+        switch (type) {
+        case XF_FAL_WL_REC_MAP:
+            wl->cnt[psec] = cnt;
+            if (lsec < wl->logical_num) {
+                xf_fal_wl_map(wl, lsec, psec);
+            } else if (XF_FAL_WL_UNMAPPED != wl->p2l[psec]) {
+                /* 逻辑扇区数变小，超出的逻辑扇区丢弃 */
+                xf_fal_wl_unmap(wl, wl->p2l[psec]);
+            }
+            break;
+        case XF_FAL_WL_REC_UNMAP:
+            if ((lsec < wl->logical_num) && (wl->l2p[lsec] == psec)) {
+                xf_fal_wl_unmap(wl, lsec);
+            }
+            break;
+        case XF_FAL_WL_REC_FREE:
+            wl->cnt[psec] = cnt;
+            break;
+        default:
+            break;
+        }
+    }
+    *p_end = off;
+
+    return XF_OK;
+}
+
+/**
+ * @brief 从序号最大且快照完整的日志扇区加载映射，都无效时格式化。
+ */
+static xf_err_t xf_fal_wl_load(xf_fal_wl_ctx_t *wl)
+{
+    xf_err_t xf_ret;
+    uint8_t rec[XF_FAL_WL_REC_SIZE];
+    uint8_t type;
+    uint16_t lsec;
+    uint16_t psec;
+    uint32_t seq[XF_FAL_WL_JOURNAL_NUM];
+    bool is_valid[XF_FAL_WL_JOURNAL_NUM];
+    bool is_complete;
+    size_t order[XF_FAL_WL_JOURNAL_NUM] = {0, 1};
+    size_t end;
+    size_t j;
+
+    memset(wl->l2p, 0xFF, sizeof(wl->l2p));
+    memset(wl->p2l, 0xFF, sizeof(wl->p2l));
+    memset(wl->cnt, 0, sizeof(wl->cnt));
+
+    for (j = 0; j < XF_FAL_WL_JOURNAL_NUM; j++) {
+        xf_ret = xf_fal_handle_read(&wl->phys, j * wl->sector_size, rec, sizeof(rec));
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        is_valid[j] = xf_fal_wl_rec_decode(rec, &type, &lsec, &psec, &seq[j])
+                      && (XF_FAL_WL_REC_HDR == type) && (XF_FAL_WL_HDR_MAGIC == lsec);
+    }
+    if ((is_valid[0]) && (is_valid[1]) && ((int32_t)(seq[1] - seq[0]) > 0)) {
+        order[0] = 1;
+        order[1] = 0;
+    } else if ((!is_valid[0]) && (is_valid[1])) {
+        order[0] = 1;
+        order[1] = 0;
+    }
+
+    for (size_t k = 0; k < XF_FAL_WL_JOURNAL_NUM; k++) {
+        j = order[k];
+        if (!is_valid[j]) {
+            continue;
+        }
+        xf_ret = xf_fal_wl_replay(wl, j, false, &end, &is_complete);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        if (!is_complete) {
+            continue;
+        }
+        xf_ret = xf_fal_wl_replay(wl, j, true, &end, &is_complete);
+        if (xf_ret != XF_OK) {
+            return xf_ret;
+        }
+        wl->journal_idx = j;
+        wl->write_off   = end;
+        /* 另一个日志扇区可能是序号更大但不完整的快照，换扇区时序号要跳过它 */
+        wl->seq         = ((is_valid[1 - j]) && ((int32_t)(seq[1 - j] - seq[j]) > 0))
+                          ? seq[1 - j] : seq[j];
+        return XF_OK;
+    }
+
+    /* 没有有效的日志：格式化，物理数据扇区全部空闲 */
+    XF_LOGI(TAG, "Format wear-leveling journal.");
+    wl->journal_idx = XF_FAL_WL_JOURNAL_NUM - 1;
+    wl->seq         = (is_valid[0]) ? seq[0] : ((is_valid[1]) ? seq[1] : 0);
+    return xf_fal_wl_rotate(wl);
+}
+
+#endif // XF_FAL_WL_ENABLE
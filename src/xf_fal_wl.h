@@ -0,0 +1,130 @@
+/**
+ * @file xf_fal_wl.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 动态磨损均衡虚拟 flash 设备。
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_FAL_WL_H__
+#define __XF_FAL_WL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_fal.h"
+
+#if XF_FAL_WL_ENABLE || defined(__DOXYGEN__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 磨损均衡设备的状态，见 xf_fal_wl_get_stat().
+ */
+typedef struct _xf_fal_wl_stat_t {
+    size_t      logical_num;    /*!< 逻辑扇区数 */
+    size_t      mapped_num;     /*!< 已映射到物理扇区的逻辑扇区数 */
+    size_t      sector_num;     /*!< 物理数据扇区数（不含映射日志） */
+    uint32_t    erase_min;      /*!< 物理数据扇区的最少擦除次数 */
+    uint32_t    erase_max;      /*!< 物理数据扇区的最多擦除次数 */
+    uint64_t    erase_total;    /*!< 物理数据扇区的擦除次数之和 */
+    size_t      journal_erase;  /*!< 映射日志的擦除次数（本次初始化以来） */
+} xf_fal_wl_stat_t;
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_fal
+ * @endcond
+ * @{
+ */
+
+/**
+ * @brief 在物理分区上创建磨损均衡虚拟 flash 设备，并注册到 xf_fal.
+ *
+ * 虚拟设备的扇区（逻辑扇区）通过内存中的映射表 O(1) 地换算到物理分区的扇区，
+ * 分区表中 flash_name 为 dev_name 的分区可以直接用 xf_fal_partition_read/write/erase 等接口访问。
+ *
+ * - 擦除逻辑扇区只解除映射，不擦除物理扇区，解除映射的逻辑扇区读出为 0xFF;
+ * - 写入未映射的逻辑扇区时，选择空闲物理扇区中擦除次数最少的一个，擦除后映射；
+ * - 映射变化记录在物理分区的前 2 个扇区中（交替使用的日志，每条记录带 CRC-32），
+ *   掉电时未写完的擦除或映射被丢弃，逻辑扇区保持原内容。
+ *
+ * 因此反复擦写的少数逻辑扇区会轮流使用所有空闲物理扇区，空闲物理扇区越多均衡效果越好。
+ *
+ * @attention 需在 xf_fal_init() 之后调用。使用 dev_name 的分区表可以在此之前注册。
+ * @attention 物理分区不应再被其他模块使用，首次使用时无需擦除。
+ *
+ * @param dev_name  虚拟 flash 设备名，最长 XF_FAL_DEV_NAME_MAX.
+ * @param phys_part 物理分区，按扇区对齐。
+ * @param len       虚拟设备的长度，按扇区向下取整。0 表示最大值，即物理数据扇区数 - 1 个扇区。
+ * @return xf_err_t
+ *      - XF_OK                 成功（物理分区为空或无法解析时格式化）
+ *      - XF_ERR_INVALID_ARG    无效参数：物理分区未对齐，或物理数据扇区（除去日志后）不比逻辑扇区多，
+ *                              或超过 XF_FAL_WL_SECTOR_NUM, 或扇区太小放不下映射快照
+ *      - XF_ERR_INITED         dev_name 已创建
+ *      - XF_ERR_RESOURCE       已创建 XF_FAL_WL_NUM 个设备
+ *      - (OTHER)               读写物理分区、注册 flash 设备或刷新分区缓存失败，
+ *                              失败时设备已撤销
+ */
+xf_err_t xf_fal_wl_init(const char *dev_name, const xf_fal_partition_t *phys_part, size_t len);
+
+/**
+ * @brief 注销并删除磨损均衡虚拟 flash 设备。映射已持久化，无需额外操作。
+ *
+ * @param dev_name 虚拟 flash 设备名。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      未找到
+ *      - (OTHER)               注销 flash 设备失败
+ */
+xf_err_t xf_fal_wl_deinit(const char *dev_name);
+
+/**
+ * @brief 获取磨损均衡虚拟 flash 设备的状态。
+ *
+ * @param dev_name      虚拟 flash 设备名。
+ * @param[out] p_stat   状态。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      未找到
+ */
+xf_err_t xf_fal_wl_get_stat(const char *dev_name, xf_fal_wl_stat_t *p_stat);
+
+/**
+ * End of addtogroup group_xf_fal
+ * @}
+ */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // XF_FAL_WL_ENABLE
+
+#endif // __XF_FAL_WL_H__
@@ -0,0 +1,338 @@
+/**
+ * @file main.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief xf_fal 操作跟踪解码工具（主机端）。
+ *
+ * 把 xf_fal_trace_dump() 导出的数据解码为时间线和各分区的访问热力图。
+ *
+ * 用法: trace_decode <dump.bin> [-n 最近条数] [-w 热力图列数]
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xf_fal_trace_fmt.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TRACE_OP_NUM                    (3)
+#define TRACE_HEAT_WIDTH_DEFAULT        (64)
+#define TRACE_HEAT_WIDTH_MAX            (256)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _trace_dump_t {
+    xf_fal_trace_hdr_t      hdr;
+    xf_fal_trace_part_t    *parts;
+    xf_fal_trace_rec_t     *recs;
+} trace_dump_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int trace_load(const char *path, trace_dump_t *dump);
+static const xf_fal_trace_part_t *trace_part_find(const trace_dump_t *dump, uint16_t part_id);
+static void trace_print_rec(const trace_dump_t *dump, const xf_fal_trace_rec_t *rec, uint32_t ts0);
+static void trace_timeline(const trace_dump_t *dump, size_t last_num);
+static void trace_heatmap(const trace_dump_t *dump, size_t width);
+
+/* ==================== [Static Variables] ================================== */
+
+/* 下标同 xf_fal_op_t */
+static const char *const s_op_name[TRACE_OP_NUM] = {"read", "write", "erase"};
+
+static const char s_shade[] = " .:-=+*#%@";
+
+/* ==================== [Macros] ============================================ */
+
+#define SWAP16(_v)  ((uint16_t)(((_v) >> 8) | ((_v) << 8)))
+#define SWAP32(_v)  ((((_v) >> 24) & 0xFFu) | (((_v) >> 8) & 0xFF00u) \
+                     | (((_v) << 8) & 0xFF0000u) | ((_v) << 24))
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char **argv)
+{
+    trace_dump_t dump;
+    const char *path = NULL;
+    size_t last_num = 0;
+    size_t width = TRACE_HEAT_WIDTH_DEFAULT;
+
+    for (int i = 1; i < argc; i++) {
+        if ((0 == strcmp(argv[i], "-n")) && (i + 1 < argc)) {
+            last_num = (size_t)strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp(argv[i], "-w")) && (i + 1 < argc)) {
+            width = (size_t)strtoul(argv[++i], NULL, 0);
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            path = NULL;
+            break;
+        }
+    }
+    if ((NULL == path) || (0 == width) || (width > TRACE_HEAT_WIDTH_MAX)) {
+        fprintf(stderr, "usage: %s <dump.bin> [-n last_num] [-w heatmap_width(1-%d)]\n",
+                argv[0], TRACE_HEAT_WIDTH_MAX);
+        return 1;
+    }
+
+    if (0 != trace_load(path, &dump)) {
+        return 1;
+    }
+    trace_timeline(&dump, last_num);
+    trace_heatmap(&dump, width);
+
+    free(dump.parts);
+    free(dump.recs);
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 读入导出数据，必要时翻转字节序。
+ */
+static int trace_load(const char *path, trace_dump_t *dump)
+{
+    FILE *fp;
+    xf_fal_trace_hdr_t *hdr = &dump->hdr;
+    int is_swap;
+    size_t i;
+
+    memset(dump, 0, sizeof(*dump));
+    fp = fopen(path, "rb");
+    if (NULL == fp) {
+        perror(path);
+        return -1;
+    }
+    if (1 != fread(hdr, sizeof(*hdr), 1, fp)) {
+        fprintf(stderr, "%s: truncated header\n", path);
+        goto l_err;
+    }
+    is_swap = (SWAP32(hdr->magic) == XF_FAL_TRACE_MAGIC);
+    if (is_swap) {
+        hdr->magic      = SWAP32(hdr->magic);
+        hdr->version    = SWAP16(hdr->version);
+        hdr->rec_size   = SWAP16(hdr->rec_size);
+        hdr->rec_num    = SWAP32(hdr->rec_num);
+        hdr->part_num   = SWAP32(hdr->part_num);
+        hdr->head       = SWAP32(hdr->head);
+    }
+    if ((hdr->magic != XF_FAL_TRACE_MAGIC) || (hdr->version != XF_FAL_TRACE_VERSION)
+            || (hdr->rec_size != sizeof(xf_fal_trace_rec_t))) {
+        fprintf(stderr, "%s: not a xf_fal trace dump (or unsupported version)\n", path);
+        goto l_err;
+    }
+
+    dump->parts = calloc(hdr->part_num + 1, sizeof(xf_fal_trace_part_t));
+    dump->recs  = calloc(hdr->rec_num + 1, sizeof(xf_fal_trace_rec_t));
+    if ((NULL == dump->parts) || (NULL == dump->recs)
+            || (hdr->part_num != fread(dump->parts, sizeof(xf_fal_trace_part_t),
+                                       hdr->part_num, fp))
+            || (hdr->rec_num != fread(dump->recs, sizeof(xf_fal_trace_rec_t),
+                                      hdr->rec_num, fp))) {
+        fprintf(stderr, "%s: truncated dump\n", path);
+        goto l_err;
+    }
+    fclose(fp);
+
+    if (is_swap) {
+        for (i = 0; i < hdr->part_num; i++) {
+            dump->parts[i].part_id  = SWAP16(dump->parts[i].part_id);
+            dump->parts[i].len      = SWAP32(dump->parts[i].len);
+        }
+        for (i = 0; i < hdr->rec_num; i++) {
+            xf_fal_trace_rec_t *rec = &dump->recs[i];
+            rec->seq        = SWAP32(rec->seq);
+            rec->timestamp  = SWAP32(rec->timestamp);
+            rec->duration   = SWAP32(rec->duration);
+            rec->offset     = SWAP32(rec->offset);
+            rec->size       = SWAP32(rec->size);
+            rec->part_id    = SWAP16(rec->part_id);
+        }
+    }
+    return 0;
+
+l_err:
+    fclose(fp);
+    free(dump->parts);
+    free(dump->recs);
+    dump->parts = NULL;
+    dump->recs  = NULL;
+    return -1;
+}
+
+static const xf_fal_trace_part_t *trace_part_find(const trace_dump_t *dump, uint16_t part_id)
+{
+    for (size_t i = 0; i < dump->hdr.part_num; i++) {
+        if (dump->parts[i].part_id == part_id) {
+            return &dump->parts[i];
+        }
+    }
+    return NULL;
+}
+
+static void trace_print_rec(const trace_dump_t *dump, const xf_fal_trace_rec_t *rec, uint32_t ts0)
+{
+    const xf_fal_trace_part_t *part = trace_part_find(dump, rec->part_id);
+    char name[XF_FAL_TRACE_NAME_SIZE + 1] = {0};
+    char dur[16];
+    char result[16];
+
+    if (part) {
+        memcpy(name, part->name, XF_FAL_TRACE_NAME_SIZE);
+    } else {
+        snprintf(name, sizeof(name), "#%04x", rec->part_id);
+    }
+    if (XF_FAL_TRACE_IN_FLIGHT == rec->duration) {
+        snprintf(dur, sizeof(dur), "IN FLIGHT");
+        snprintf(result, sizeof(result), "-");
+    } else {
+        snprintf(dur, sizeof(dur), "%u", (unsigned)rec->duration);
+        if (0 == rec->result) {
+            snprintf(result, sizeof(result), "ok");
+        } else {
+            snprintf(result, sizeof(result), "err(0x%02x)", (unsigned)rec->result);
+        }
+    }
+    printf("%10u %11u %10s  %-5s %-*s 0x%08x %8u  %s\n", (unsigned)rec->seq,
+           (unsigned)(uint32_t)(rec->timestamp - ts0), dur,
+           (rec->op < TRACE_OP_NUM) ? s_op_name[rec->op] : "?",
+           XF_FAL_TRACE_NAME_SIZE, name, (unsigned)rec->offset, (unsigned)rec->size, result);
+}
+
+/**
+ * @brief 按 seq 顺序打印时间线，最后单独列出未完成的操作。
+ */
+static void trace_timeline(const trace_dump_t *dump, size_t last_num)
+{
+    const xf_fal_trace_rec_t *rec;
+    size_t valid_num = 0;
+    size_t in_flight_num = 0;
+    size_t skip;
+    uint32_t ts0 = 0;
+    size_t i;
+
+    for (i = 0; i < dump->hdr.rec_num; i++) {
+        if (dump->recs[i].seq) {
+            if (0 == valid_num) {
+                ts0 = dump->recs[i].timestamp;
+            }
+            valid_num++;
+        }
+    }
+    skip = ((last_num) && (last_num < valid_num)) ? (valid_num - last_num) : 0;
+
+    printf("xf_fal trace: %u records (%u total, %u partitions)\n",
+           (unsigned)valid_num, (unsigned)dump->hdr.head, (unsigned)dump->hdr.part_num);
+    printf("%10s %11s %10s  %-5s %-*s %10s %8s  %s\n", "seq", "time", "duration",
+           "op", XF_FAL_TRACE_NAME_SIZE, "partition", "offset", "size", "result");
+    for (i = 0; i < dump->hdr.rec_num; i++) {
+        rec = &dump->recs[i];
+        if (0 == rec->seq) {
+            continue;
+        }
+        if (XF_FAL_TRACE_IN_FLIGHT == rec->duration) {
+            in_flight_num++;
+        }
+        if (skip) {
+            skip--;
+            continue;
+        }
+        trace_print_rec(dump, rec, ts0);
+    }
+
+    printf("\nin-flight operations: %u\n", (unsigned)in_flight_num);
+    for (i = 0; i < dump->hdr.rec_num; i++) {
+        rec = &dump->recs[i];
+        if ((rec->seq) && (XF_FAL_TRACE_IN_FLIGHT == rec->duration)) {
+            trace_print_rec(dump, rec, ts0);
+        }
+    }
+}
+
+/**
+ * @brief 打印各分区的访问热力图：分区按地址均分为 width 列，每行一种操作，
+ *        字符深浅表示该列被访问的字节数（按行内最大值归一化）。
+ */
+static void trace_heatmap(const trace_dump_t *dump, size_t width)
+{
+    static uint64_t heat[TRACE_OP_NUM][TRACE_HEAT_WIDTH_MAX];
+    const xf_fal_trace_part_t *part;
+    const xf_fal_trace_rec_t *rec;
+    char line[TRACE_HEAT_WIDTH_MAX + 1];
+    uint64_t total[TRACE_OP_NUM];
+    uint64_t max;
+    uint64_t start;
+    uint64_t end;
+    uint64_t col_start;
+    uint64_t col_end;
+    size_t col;
+    size_t op;
+
+    printf("\naccess heatmap (bytes per 1/%u of partition, '%s' = low..high)\n",
+           (unsigned)width, s_shade + 1);
+    for (size_t p = 0; p < dump->hdr.part_num; p++) {
+        part = &dump->parts[p];
+        if (0 == part->len) {
+            continue;
+        }
+        memset(heat, 0, sizeof(heat));
+        memset(total, 0, sizeof(total));
+        for (size_t i = 0; i < dump->hdr.rec_num; i++) {
+            rec = &dump->recs[i];
+            if ((0 == rec->seq) || (rec->part_id != part->part_id)
+                    || (rec->op >= TRACE_OP_NUM)) {
+                continue;
+            }
+            start   = rec->offset;
+            end     = (uint64_t)rec->offset + rec->size;
+            if (end > part->len) {
+                end = part->len;
+            }
+            total[rec->op] += rec->size;
+            /* 按重叠字节数分摊到覆盖的各列 */
+            for (col = (size_t)(start * width / part->len); col < width; col++) {
+                col_start   = (uint64_t)part->len * col / width;
+                col_end     = (uint64_t)part->len * (col + 1) / width;
+                if (col_start >= end) {
+                    break;
+                }
+                if (col_end <= start) {
+                    continue;
+                }
+                heat[rec->op][col] += ((end < col_end) ? end : col_end)
+                                      - ((start > col_start) ? start : col_start);
+            }
+        }
+        if (0 == total[0] + total[1] + total[2]) {
+            continue;
+        }
+
+        printf("%.*s (len 0x%08x)\n", XF_FAL_TRACE_NAME_SIZE, part->name, (unsigned)part->len);
+        for (op = 0; op < TRACE_OP_NUM; op++) {
+            if (0 == total[op]) {
+                continue;
+            }
+            max = 0;
+            for (col = 0; col < width; col++) {
+                if (heat[op][col] > max) {
+                    max = heat[op][col];
+                }
+            }
+            for (col = 0; col < width; col++) {
+                line[col] = (0 == heat[op][col]) ? s_shade[0]
+                            : s_shade[1 + (heat[op][col] * (sizeof(s_shade) - 3) / max)];
+            }
+            line[width] = '\0';
+            printf("  %-5s |%s| %llu bytes\n", s_op_name[op], line, (unsigned long long)total[op]);
+        }
+    }
+}
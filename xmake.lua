@@ -1,6 +1,14 @@
 add_rules("mode.debug", "mode.release")
 includes("xf_utils/xmake.lua")
 
+-- xmake f --flash_sim=y: 示例工程的 flash 设备套上时序模拟（xf_fal_sim），结束时打印设备耗时
+option("flash_sim")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Wrap example flash devices with the xf_fal_sim timing model")
+    add_defines("XF_FAL_SIM_ENABLE=1")
+option_end()
+
 -- xf_fal 所有的内容
 function add_xf_fal() 
     add_xf_utils("xf_utils/xf_utils")
@@ -8,17 +16,31 @@ function add_xf_fal()
     add_includedirs("src")
 end 
 
--- 模板化添加示例工程
-function add_target(name) 
+-- 模板化添加示例工程，opt 为优化选项，默认 -O0
+function add_target(name, opt) 
     target(name)
         set_kind("binary")
         add_cflags("-Wall")
-        add_cflags("-std=gnu99 -O0")
+        add_cflags("-std=gnu99 " .. (opt or "-O0"))
         add_xf_fal()
         add_files(string.format("example/%s/*.c", name))
         add_includedirs(string.format("example/%s", name))
+        add_options("flash_sim")
 end 
 
 
 add_target("base")
 add_target("multi_flash_device")
+add_target("ota_stream")
+add_target("static_table")
+-- 基准测试按发布版本的优化选项编译，`xmake r bench suite` 输出可跨版本对比的 CSV
+add_target("bench", "-O2")
+    add_syslinks("pthread")
+
+-- 主机端工具：解码 xf_fal_trace_dump() 导出的跟踪数据
+target("trace_decode")
+    set_kind("binary")
+    add_cflags("-Wall")
+    add_cflags("-std=gnu99 -O2")
+    add_files("tools/trace_decode/*.c")
+    add_includedirs("src")